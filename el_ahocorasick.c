@@ -0,0 +1,732 @@
+/* Extreme Library (EL). Aho-Corasick multi-pattern matcher. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include <string.h>
+
+#include "el_memory.h"
+
+#include "el_ahocorasick.h"
+
+#define isInvalid(s) ((s) == NULL)
+
+/**
+ * Marks the end of pattern list while the trie is built.
+ */
+#define EL_AHOCORASICK_NONE	UINT32_MAX
+/**
+ * Maximal number of edges of a node searched linearly. Edges of larger nodes 
+ * are searched binary.
+ */
+#define EL_AHOCORASICK_LINEAR_MAX	8
+/**
+ * Number of nodes per dense transition table allowed (each table takes 1 KB). 
+ * The root and its children always have dense tables.
+ */
+#define EL_AHOCORASICK_NODES_PER_ROW	128
+
+/**
+ * Node of the trie used while the automaton is built.
+ */
+typedef struct elahocorasick_trie {
+	uint32_t nFirstChild; /**< First child node (or 0). */
+	uint32_t nNextSibling; /**< Next child of the same parent (or 0). */
+	uint32_t nFirstPattern; /**< Last pattern added which ends here. */
+	uint8_t nLabel; /**< Character of the edge from parent. */
+} elahocorasick_trie;
+
+/**
+ * Holds the first match found by elahocorasickFindFirstView().
+ */
+typedef struct elahocorasick_first {
+	bool bFound; /**< @b True if a match was found. */
+	size_t nPattern; /**< Index of pattern matched. */
+	size_t nPos; /**< Position where the match starts. */
+} elahocorasick_first;
+
+/**
+ * Finds the edge of the node by character.
+ * @param  pThis   Automaton.
+ * @param  pNode   Node.
+ * @param  ch      Character.
+ * @param  pTarget Target node of the edge is returned here.
+ * @return         @b True if the edge exists.
+ */
+static inline bool elahocorasickFindEdge(ahocorasick *pThis, 
+	const elahocorasick_node *pNode, uint8_t ch, uint32_t *pTarget) {
+
+	const uint8_t *arrLabels = pThis->arrLabels + pNode->nFirstEdge;
+	size_t nCount = pNode->nCountEdges;
+
+	if(nCount <= EL_AHOCORASICK_LINEAR_MAX) {
+		for(size_t i = 0; i < nCount; i++)
+			if(arrLabels[i] == ch) {
+				*pTarget = pThis->arrTargets[pNode->nFirstEdge + i];
+				return true;
+			}
+		return false;
+	}
+
+	size_t nLow = 0;
+	size_t nHigh = nCount;
+	while(nLow < nHigh) {
+		size_t nMiddle = (nLow + nHigh) / 2;
+		if(arrLabels[nMiddle] < ch)
+			nLow = nMiddle + 1;
+		else
+			nHigh = nMiddle;
+	}
+	if(nLow < nCount && arrLabels[nLow] == ch) {
+		*pTarget = pThis->arrTargets[pNode->nFirstEdge + nLow];
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * Returns the node reached from the node by character (following failure 
+ * links while there is no edge).
+ * @param  pThis Automaton.
+ * @param  nNode Node.
+ * @param  ch    Character.
+ * @return       Next node.
+ */
+static inline uint32_t elahocorasickStep(ahocorasick *pThis, uint32_t nNode, 
+	uint8_t ch) {
+
+	for(;;) {
+		const elahocorasick_node *pNode = &pThis->arrNodes[nNode];
+		if(pNode->nRow != EL_AHOCORASICK_NONE)
+			return pThis->arrRows[(size_t)pNode->nRow * 256 + ch];
+
+		uint32_t nTarget;
+		if(elahocorasickFindEdge(pThis, pNode, ch, &nTarget))
+			return nTarget;
+		if(nNode == 0)
+			return 0;
+		nNode = pNode->nFail;
+	}
+}
+
+/**
+ * Builds the trie of patterns. Empty patterns and NaS are skipped.
+ * @param  pPatterns      An array of patterns.
+ * @param  nCountPatterns Number of patterns.
+ * @param  arrTrie        Trie (must have room for all nodes).
+ * @param  arrNext        Next pattern ending in the same node is returned here 
+ * for each pattern.
+ * @return                Number of nodes.
+ */
+static size_t elahocorasickBuildTrie(str **pPatterns, size_t nCountPatterns, 
+	elahocorasick_trie *arrTrie, uint32_t *arrNext) {
+
+	size_t nCountNodes = 1;
+	memset(&arrTrie[0], 0, sizeof(elahocorasick_trie));
+	arrTrie[0].nFirstPattern = EL_AHOCORASICK_NONE;
+
+	for(size_t i = 0; i < nCountPatterns; i++) {
+		strview view = elstrGetView(pPatterns[i]);
+		if(view.nLength == 0)
+			continue;
+
+		uint32_t nNode = 0;
+		for(size_t j = 0; j < view.nLength; j++) {
+			uint8_t ch = (uint8_t)view.szBuf[j];
+			uint32_t nChild = arrTrie[nNode].nFirstChild;
+			while(nChild != 0 && arrTrie[nChild].nLabel != ch)
+				nChild = arrTrie[nChild].nNextSibling;
+
+			if(nChild == 0) {
+				nChild = (uint32_t)nCountNodes++;
+				arrTrie[nChild].nFirstChild = 0;
+				arrTrie[nChild].nNextSibling = arrTrie[nNode].nFirstChild;
+				arrTrie[nChild].nFirstPattern = EL_AHOCORASICK_NONE;
+				arrTrie[nChild].nLabel = ch;
+				arrTrie[nNode].nFirstChild = nChild;
+			}
+			nNode = nChild;
+		}
+
+		arrNext[i] = arrTrie[nNode].nFirstPattern;
+		arrTrie[nNode].nFirstPattern = (uint32_t)i;
+	}
+
+	return nCountNodes;
+}
+
+/**
+ * Compiles the trie into the automaton: numbers nodes in breadth-first order, 
+ * sorts their edges and computes failure and dictionary links.
+ * @param  pThis    Automaton (arrays must be allocated).
+ * @param  arrTrie  Trie.
+ * @param  arrNext  Next pattern ending in the same node for each pattern.
+ * @param  arrQueue Temporary array of trie nodes (one element per node).
+ */
+static void elahocorasickCompile(ahocorasick *pThis, 
+	const elahocorasick_trie *arrTrie, const uint32_t *arrNext, 
+	uint32_t *arrQueue) {
+
+	size_t nCountQueued = 1;
+	size_t nCountEdges = 0;
+	size_t nCountOutputs = 0;
+	arrQueue[0] = 0;
+
+	// breadth-first order: node's index is its position in the queue
+	for(size_t nNode = 0; nNode < pThis->nCountNodes; nNode++) {
+		const elahocorasick_trie *pTrie = &arrTrie[arrQueue[nNode]];
+		elahocorasick_node *pNode = &pThis->arrNodes[nNode];
+
+		uint8_t *arrLabels = pThis->arrLabels + nCountEdges;
+		uint32_t *arrTargets = pThis->arrTargets + nCountEdges;
+		size_t nCount = 0;
+		for(uint32_t nChild = pTrie->nFirstChild; nChild != 0; 
+			nChild = arrTrie[nChild].nNextSibling) {
+
+			// insertion sort by label (nodes have few children)
+			uint8_t ch = arrTrie[nChild].nLabel;
+			size_t i = nCount++;
+			for(; i > 0 && arrLabels[i - 1] > ch; i--) {
+				arrLabels[i] = arrLabels[i - 1];
+				arrTargets[i] = arrTargets[i - 1];
+			}
+			arrLabels[i] = ch;
+			arrTargets[i] = nChild;
+		}
+		for(size_t i = 0; i < nCount; i++) {
+			arrQueue[nCountQueued] = arrTargets[i];
+			arrTargets[i] = (uint32_t)nCountQueued++;
+		}
+
+		pNode->nFirstEdge = (uint32_t)nCountEdges;
+		pNode->nCountEdges = (uint32_t)nCount;
+		nCountEdges += nCount;
+
+		// patterns are listed from the last added, so store them backwards
+		size_t nCountPatterns = 0;
+		for(uint32_t i = pTrie->nFirstPattern; i != EL_AHOCORASICK_NONE; 
+			i = arrNext[i])
+			nCountPatterns++;
+		size_t nOutput = nCountOutputs + nCountPatterns;
+		for(uint32_t i = pTrie->nFirstPattern; i != EL_AHOCORASICK_NONE; 
+			i = arrNext[i])
+			pThis->arrOutputs[--nOutput] = i;
+
+		pNode->nFirstOutput = (uint32_t)nCountOutputs;
+		pNode->nCountOutputs = (uint32_t)nCountPatterns;
+		nCountOutputs += nCountPatterns;
+
+		pNode->nFail = 0;
+		pNode->nDict = 0;
+		pNode->nCountMatches = (uint32_t)nCountPatterns;
+		pNode->nRow = EL_AHOCORASICK_NONE;
+	}
+
+	// parents are processed before children, so their links are ready
+	for(size_t nNode = 0; nNode < pThis->nCountNodes; nNode++) {
+		const elahocorasick_node *pNode = &pThis->arrNodes[nNode];
+		for(size_t i = 0; i < pNode->nCountEdges; i++) {
+			uint8_t ch = pThis->arrLabels[pNode->nFirstEdge + i];
+			elahocorasick_node *pChild = 
+				&pThis->arrNodes[pThis->arrTargets[pNode->nFirstEdge + i]];
+
+			uint32_t nFail = nNode == 0 ? 0 : 
+				elahocorasickStep(pThis, pNode->nFail, ch);
+			const elahocorasick_node *pFail = &pThis->arrNodes[nFail];
+
+			pChild->nFail = nFail;
+			pChild->nDict = pFail->nCountOutputs > 0 ? nFail : pFail->nDict;
+			pChild->nCountMatches += pFail->nCountMatches;
+		}
+	}
+}
+
+/**
+ * Checks if the node gets dense transition table.
+ * @param  pThis      Automaton.
+ * @param  nNode      Node.
+ * @param  nCountRows Number of tables given to the nodes before.
+ * @return            @b True if the node gets the table.
+ */
+static inline bool elahocorasickNeedsRow(ahocorasick *pThis, size_t nNode, 
+	size_t nCountRows) {
+
+	// nodes are in breadth-first order, so the root's children come first
+	if(nNode <= pThis->arrNodes[0].nCountEdges)
+		return true;
+
+	return pThis->arrNodes[nNode].nCountEdges > EL_AHOCORASICK_LINEAR_MAX && 
+		nCountRows < pThis->nCountNodes / EL_AHOCORASICK_NODES_PER_ROW;
+}
+
+/**
+ * Builds dense transition tables of the root, its children and (while the 
+ * memory limit allows) the shallowest nodes having many edges. Tables are 
+ * resolved through failure links, so a step from such node is one lookup.
+ * @param  pThis Automaton with failure links computed.
+ * @return       @b True if tables are built, or @b false if an error occured.
+ */
+static bool elahocorasickBuildRows(ahocorasick *pThis) {
+	size_t nCountRows = 0;
+	for(size_t nNode = 0; nNode < pThis->nCountNodes; nNode++)
+		if(elahocorasickNeedsRow(pThis, nNode, nCountRows))
+			nCountRows++;
+
+	pThis->arrRows = (uint32_t *)EL_ALLOC(nCountRows * 256 * sizeof(uint32_t));
+	if(isInvalid(pThis->arrRows))
+		return false;
+	pThis->nCountRows = nCountRows;
+
+	// failure links lead to shallower nodes, which tables are already built
+	nCountRows = 0;
+	for(size_t nNode = 0; nNode < pThis->nCountNodes; nNode++) {
+		if(!elahocorasickNeedsRow(pThis, nNode, nCountRows))
+			continue;
+
+		elahocorasick_node *pNode = &pThis->arrNodes[nNode];
+		uint32_t *arrRow = pThis->arrRows + nCountRows * 256;
+		for(size_t ch = 0; ch < 256; ch++)
+			arrRow[ch] = nNode == 0 ? 0 : 
+				elahocorasickStep(pThis, pNode->nFail, (uint8_t)ch);
+		for(size_t i = 0; i < pNode->nCountEdges; i++)
+			arrRow[pThis->arrLabels[pNode->nFirstEdge + i]] = 
+				pThis->arrTargets[pNode->nFirstEdge + i];
+
+		pNode->nRow = (uint32_t)nCountRows++;
+	}
+
+	return true;
+}
+
+/**
+ * Creates new automaton searching all of the patterns at once. Patterns are 
+ * compared byte by byte (they may contain null characters). Empty patterns 
+ * and NaS never match.
+ * @param  pPatterns      An array of patterns.
+ * @param  nCountPatterns Number of patterns.
+ * @return                Newly created automaton (or NULL if an error 
+ * occured).
+ */
+ahocorasick *elahocorasickCreate(str **pPatterns, size_t nCountPatterns) {
+	if(isInvalid(pPatterns) && nCountPatterns != 0)
+		return NULL;
+	if(nCountPatterns >= EL_AHOCORASICK_NONE)
+		return NULL;
+
+	size_t nCountBytes = 0;
+	for(size_t i = 0; i < nCountPatterns; i++) {
+		nCountBytes += elstrGetView(pPatterns[i]).nLength;
+		if(nCountBytes >= EL_AHOCORASICK_NONE)
+			return NULL;
+	}
+	size_t nCountNodesMax = nCountBytes + 1;
+
+	ahocorasick *pThis = (ahocorasick *)EL_CALLOC(1, sizeof(ahocorasick));
+	if(isInvalid(pThis))
+		return NULL;
+
+	pThis->nCountPatterns = nCountPatterns;
+	pThis->arrLengths = (size_t *)EL_ALLOC(
+		(nCountPatterns + 1) * sizeof(size_t));
+	elahocorasick_trie *arrTrie = (elahocorasick_trie *)EL_ALLOC(
+		nCountNodesMax * sizeof(elahocorasick_trie));
+	uint32_t *arrNext = (uint32_t *)EL_ALLOC(
+		(nCountPatterns + 1) * sizeof(uint32_t));
+	if(isInvalid(pThis->arrLengths) || isInvalid(arrTrie) || 
+		isInvalid(arrNext)) {
+
+		EL_FREE(arrTrie);
+		EL_FREE(arrNext);
+		elahocorasickDestroy(pThis);
+		return NULL;
+	}
+
+	for(size_t i = 0; i < nCountPatterns; i++)
+		pThis->arrLengths[i] = elstrGetView(pPatterns[i]).nLength;
+
+	pThis->nCountNodes = elahocorasickBuildTrie(pPatterns, nCountPatterns, 
+		arrTrie, arrNext);
+
+	// each node except the root has one incoming edge
+	pThis->arrNodes = (elahocorasick_node *)EL_ALLOC(
+		pThis->nCountNodes * sizeof(elahocorasick_node));
+	pThis->arrLabels = (uint8_t *)EL_ALLOC(pThis->nCountNodes);
+	pThis->arrTargets = (uint32_t *)EL_ALLOC(
+		pThis->nCountNodes * sizeof(uint32_t));
+	pThis->arrOutputs = (uint32_t *)EL_ALLOC(
+		(nCountPatterns + 1) * sizeof(uint32_t));
+	uint32_t *arrQueue = (uint32_t *)EL_ALLOC(
+		pThis->nCountNodes * sizeof(uint32_t));
+	if(isInvalid(pThis->arrNodes) || isInvalid(pThis->arrLabels) || 
+		isInvalid(pThis->arrTargets) || isInvalid(pThis->arrOutputs) || 
+		isInvalid(arrQueue)) {
+
+		EL_FREE(arrQueue);
+		EL_FREE(arrTrie);
+		EL_FREE(arrNext);
+		elahocorasickDestroy(pThis);
+		return NULL;
+	}
+
+	elahocorasickCompile(pThis, arrTrie, arrNext, arrQueue);
+
+	EL_FREE(arrQueue);
+	EL_FREE(arrTrie);
+	EL_FREE(arrNext);
+
+	if(!elahocorasickBuildRows(pThis)) {
+		elahocorasickDestroy(pThis);
+		return NULL;
+	}
+
+	return pThis;
+}
+
+/**
+ * Destroys the automaton. Patterns it was created from aren't destroyed.
+ * @param pThis Automaton to be destroyed.
+ */
+void elahocorasickDestroy(ahocorasick *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	EL_FREE(pThis->arrLengths);
+	EL_FREE(pThis->arrNodes);
+	EL_FREE(pThis->arrLabels);
+	EL_FREE(pThis->arrTargets);
+	EL_FREE(pThis->arrOutputs);
+	EL_FREE(pThis->arrRows);
+	EL_FREE(pThis);
+}
+
+/**
+ * Returns the number of patterns of the automaton.
+ * @param  pThis Automaton.
+ * @return       Number of patterns.
+ */
+size_t elahocorasickGetCountPatterns(ahocorasick *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	return pThis->nCountPatterns;
+}
+
+/**
+ * Runs the automaton over the buffer and calls specified function for each 
+ * match.
+ * @param  pThis           Automaton.
+ * @param  p               Buffer.
+ * @param  nLength         Length of the buffer.
+ * @param  pNode           Node to start from. Node reached is returned here.
+ * @param  nOffset         Position of the buffer in the whole text.
+ * @param  matchCallbackEx Callback function to be called for each match.
+ * @param  pEx             Pointer to custom data to be sent to callback.
+ * @return                 Number of matches reported.
+ */
+static size_t elahocorasickScan(ahocorasick *pThis, const char *p, 
+	size_t nLength, size_t *pNode, size_t nOffset, 
+	bool (*matchCallbackEx)(size_t nPattern, size_t nPos, void *pEx), 
+	void *pEx) {
+
+	uint32_t nNode = (uint32_t)*pNode;
+	size_t nResult = 0;
+
+	for(size_t i = 0; i < nLength; i++) {
+		nNode = elahocorasickStep(pThis, nNode, (uint8_t)p[i]);
+		const elahocorasick_node *pCur = &pThis->arrNodes[nNode];
+		if(pCur->nCountMatches == 0)
+			continue;
+
+		// longer patterns first: the node's own ones, then the failure chain
+		uint32_t nOut = pCur->nCountOutputs > 0 ? nNode : pCur->nDict;
+		for(; nOut != 0; nOut = pThis->arrNodes[nOut].nDict) {
+			const elahocorasick_node *pOut = &pThis->arrNodes[nOut];
+			for(size_t j = 0; j < pOut->nCountOutputs; j++) {
+				uint32_t nPattern = pThis->arrOutputs[pOut->nFirstOutput + j];
+				nResult++;
+				if(!matchCallbackEx(nPattern, 
+					nOffset + i + 1 - pThis->arrLengths[nPattern], pEx)) {
+
+					*pNode = nNode;
+					return nResult;
+				}
+			}
+		}
+	}
+
+	*pNode = nNode;
+	return nResult;
+}
+
+/**
+ * Runs the automaton over the buffer and counts matches.
+ * @param  pThis     Automaton.
+ * @param  p         Buffer.
+ * @param  nLength   Length of the buffer.
+ * @param  pNode     Node to start from. Node reached is returned here.
+ * @param  arrCounts Matches of each pattern are added here (if not NULL).
+ * @return           Number of matches.
+ */
+static size_t elahocorasickScanCount(ahocorasick *pThis, const char *p, 
+	size_t nLength, size_t *pNode, size_t *arrCounts) {
+
+	uint32_t nNode = (uint32_t)*pNode;
+	size_t nResult = 0;
+
+	for(size_t i = 0; i < nLength; i++) {
+		nNode = elahocorasickStep(pThis, nNode, (uint8_t)p[i]);
+		const elahocorasick_node *pCur = &pThis->arrNodes[nNode];
+		nResult += pCur->nCountMatches;
+		if(arrCounts == NULL || pCur->nCountMatches == 0)
+			continue;
+
+		uint32_t nOut = pCur->nCountOutputs > 0 ? nNode : pCur->nDict;
+		for(; nOut != 0; nOut = pThis->arrNodes[nOut].nDict) {
+			const elahocorasick_node *pOut = &pThis->arrNodes[nOut];
+			for(size_t j = 0; j < pOut->nCountOutputs; j++)
+				arrCounts[pThis->arrOutputs[pOut->nFirstOutput + j]]++;
+		}
+	}
+
+	*pNode = nNode;
+	return nResult;
+}
+
+/**
+ * Searches all patterns in the view and calls specified function for each 
+ * match (including overlapping ones). Matches are reported in the order of 
+ * their end positions. Passes the pointer to custom data to the callback 
+ * function. If function returns @b false - stops iteration.
+ * @param  pThis           Automaton.
+ * @param  view            Text where to search.
+ * @param  matchCallbackEx Callback function to be called for each match. Gets 
+ * the index of pattern and the position where the match starts.
+ * @param  pEx             Pointer to custom data to be sent to callback.
+ * @return                 Number of matches reported.
+ */
+size_t elahocorasickForEachExView(ahocorasick *pThis, strview view, 
+	bool (*matchCallbackEx)(size_t nPattern, size_t nPos, void *pEx), 
+	void *pEx) {
+
+	if(isInvalid(pThis) || isInvalid(view.szBuf) || matchCallbackEx == NULL)
+		return 0;
+
+	size_t nNode = 0;
+	return elahocorasickScan(pThis, view.szBuf, view.nLength, &nNode, 0, 
+		matchCallbackEx, pEx);
+}
+
+/**
+ * Searches all patterns in the dynamic string and calls specified function 
+ * for each match. See elahocorasickForEachExView().
+ * @param  pThis           Automaton.
+ * @param  pStr            Dynamic string where to search.
+ * @param  matchCallbackEx Callback function to be called for each match.
+ * @param  pEx             Pointer to custom data to be sent to callback.
+ * @return                 Number of matches reported.
+ */
+size_t elahocorasickForEachExELStr(ahocorasick *pThis, str *pStr, 
+	bool (*matchCallbackEx)(size_t nPattern, size_t nPos, void *pEx), 
+	void *pEx) {
+
+	return elahocorasickForEachExView(pThis, elstrGetView(pStr), 
+		matchCallbackEx, pEx);
+}
+
+/**
+ * Remembers the first match and stops the search.
+ */
+static bool elahocorasickFirstCallback(size_t nPattern, size_t nPos, 
+	void *pEx) {
+
+	elahocorasick_first *pFirst = (elahocorasick_first *)pEx;
+	pFirst->bFound = true;
+	pFirst->nPattern = nPattern;
+	pFirst->nPos = nPos;
+	return false;
+}
+
+/**
+ * Searches the match which ends first (the longest one if several matches 
+ * end at the same position).
+ * @param  pThis    Automaton.
+ * @param  view     Text where to search.
+ * @param  pPattern Index of pattern matched is returned here (if not NULL).
+ * @param  pPos     Position where the match starts is returned here (if not 
+ * NULL).
+ * @return          @b True if any pattern is found.
+ */
+bool elahocorasickFindFirstView(ahocorasick *pThis, strview view, 
+	size_t *pPattern, size_t *pPos) {
+
+	elahocorasick_first first = { false, 0, 0 };
+	elahocorasickForEachExView(pThis, view, elahocorasickFirstCallback, &first);
+	if(!first.bFound)
+		return false;
+
+	if(pPattern != NULL)
+		*pPattern = first.nPattern;
+	if(pPos != NULL)
+		*pPos = first.nPos;
+
+	return true;
+}
+
+/**
+ * Searches the match which ends first in the dynamic string. See 
+ * elahocorasickFindFirstView().
+ * @param  pThis    Automaton.
+ * @param  pStr     Dynamic string where to search.
+ * @param  pPattern Index of pattern matched is returned here (if not NULL).
+ * @param  pPos     Position where the match starts is returned here (if not 
+ * NULL).
+ * @return          @b True if any pattern is found.
+ */
+bool elahocorasickFindFirstELStr(ahocorasick *pThis, str *pStr, 
+	size_t *pPattern, size_t *pPos) {
+
+	return elahocorasickFindFirstView(pThis, elstrGetView(pStr), pPattern, 
+		pPos);
+}
+
+/**
+ * Counts matches of all patterns in the view (including overlapping ones). 
+ * Without per pattern counts only one lookup per character is made.
+ * @param  pThis     Automaton.
+ * @param  view      Text where to search.
+ * @param  arrCounts An array where matches of each pattern are added (one 
+ * element per pattern), or NULL.
+ * @return           Total number of matches.
+ */
+size_t elahocorasickCountView(ahocorasick *pThis, strview view, 
+	size_t *arrCounts) {
+
+	if(isInvalid(pThis) || isInvalid(view.szBuf))
+		return 0;
+
+	size_t nNode = 0;
+	return elahocorasickScanCount(pThis, view.szBuf, view.nLength, &nNode, 
+		arrCounts);
+}
+
+/**
+ * Counts matches of all patterns in the dynamic string. See 
+ * elahocorasickCountView().
+ * @param  pThis     Automaton.
+ * @param  pStr      Dynamic string where to search.
+ * @param  arrCounts An array where matches of each pattern are added, or NULL.
+ * @return           Total number of matches.
+ */
+size_t elahocorasickCountELStr(ahocorasick *pThis, str *pStr, 
+	size_t *arrCounts) {
+
+	return elahocorasickCountView(pThis, elstrGetView(pStr), arrCounts);
+}
+
+/**
+ * Creates new stream searching the patterns in a sequence of chunks. State is 
+ * kept between the chunks, so matches crossing their boundaries are found 
+ * and positions are counted from the start of the first chunk.
+ * @param  pAutomaton Automaton (must outlive the stream).
+ * @return            Newly created stream (or NULL if an error occured).
+ */
+ahocorasick_stream *elahocorasickStreamCreate(ahocorasick *pAutomaton) {
+	if(isInvalid(pAutomaton))
+		return NULL;
+
+	ahocorasick_stream *pThis = (ahocorasick_stream *)EL_CALLOC(1, 
+		sizeof(ahocorasick_stream));
+	if(isInvalid(pThis))
+		return NULL;
+
+	pThis->pAutomaton = pAutomaton;
+
+	return pThis;
+}
+
+/**
+ * Destroys the stream.
+ * @param pThis Stream to be destroyed.
+ */
+void elahocorasickStreamDestroy(ahocorasick_stream *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	EL_FREE(pThis);
+}
+
+/**
+ * Resets the stream to search in a new sequence of chunks.
+ * @param pThis Stream.
+ */
+void elahocorasickStreamReset(ahocorasick_stream *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	pThis->nNode = 0;
+	pThis->nOffset = 0;
+}
+
+/**
+ * Searches the patterns in the next chunk and calls specified function for 
+ * each match. Passes the pointer to custom data to the callback function. If 
+ * function returns @b false - stops iteration, the rest of the chunk is 
+ * skipped (so the stream should be reset).
+ * @param  pThis           Stream.
+ * @param  chunk           Next chunk of the text.
+ * @param  matchCallbackEx Callback function to be called for each match. Gets 
+ * the index of pattern and the position where the match starts (counted from 
+ * the start of the first chunk).
+ * @param  pEx             Pointer to custom data to be sent to callback.
+ * @return                 Number of matches reported.
+ */
+size_t elahocorasickStreamForEachEx(ahocorasick_stream *pThis, strview chunk, 
+	bool (*matchCallbackEx)(size_t nPattern, size_t nPos, void *pEx), 
+	void *pEx) {
+
+	if(isInvalid(pThis) || isInvalid(chunk.szBuf) || matchCallbackEx == NULL)
+		return 0;
+
+	size_t nResult = elahocorasickScan(pThis->pAutomaton, chunk.szBuf, 
+		chunk.nLength, &pThis->nNode, pThis->nOffset, matchCallbackEx, pEx);
+	pThis->nOffset += chunk.nLength;
+
+	return nResult;
+}
+
+/**
+ * Counts matches of the patterns ending in the next chunk.
+ * @param  pThis     Stream.
+ * @param  chunk     Next chunk of the text.
+ * @param  arrCounts An array where matches of each pattern are added (one 
+ * element per pattern), or NULL.
+ * @return           Number of matches.
+ */
+size_t elahocorasickStreamCount(ahocorasick_stream *pThis, strview chunk, 
+	size_t *arrCounts) {
+
+	if(isInvalid(pThis) || isInvalid(chunk.szBuf))
+		return 0;
+
+	size_t nResult = elahocorasickScanCount(pThis->pAutomaton, chunk.szBuf, 
+		chunk.nLength, &pThis->nNode, arrCounts);
+	pThis->nOffset += chunk.nLength;
+
+	return nResult;
+}
@@ -0,0 +1,122 @@
+/* Extreme Library (EL). Aho-Corasick multi-pattern matcher. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#ifndef _EL_AHOCORASICK_H_
+#define _EL_AHOCORASICK_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "el_str.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 
+ * @brief Pointer to callback function which's called for each match by 
+ * foreachex() enumerator. Gets the index of pattern and the position where 
+ * the match starts.
+ */
+#define EL_CB_MATCH_FOREACH_EX(s) (bool (*)(size_t, size_t, void *))(s)
+
+/** 
+ * @brief Node of the automaton. Edges and patterns of each node are stored 
+ * contiguously in the shared arrays.
+ */
+typedef struct elahocorasick_node {
+	uint32_t nFail; /**< Node of the longest proper suffix which is in the 
+	automaton (failure link). */
+	uint32_t nDict; /**< Nearest node on the failure chain which ends any 
+	pattern (or 0). */
+	uint32_t nFirstEdge; /**< Index of the first edge. */
+	uint32_t nCountEdges; /**< Number of edges. */
+	uint32_t nFirstOutput; /**< Index of the first pattern ending here. */
+	uint32_t nCountOutputs; /**< Number of patterns ending here. */
+	uint32_t nCountMatches; /**< Number of patterns ending here and on the 
+	failure chain. */
+	uint32_t nRow; /**< Index of dense transition table of the node (or 
+	UINT32_MAX if transitions are sparse). */
+} elahocorasick_node;
+
+/** 
+ * @brief Holds the automaton compiled from an array of patterns.
+ *
+ * Transitions from the root and its children (which are visited most often) 
+ * are looked up in dense tables already resolved through failure links. 
+ * Transitions from other nodes are sorted arrays of labels searched linearly 
+ * or binary.
+ */
+typedef struct ahocorasick {
+	size_t nCountPatterns; /**< Number of patterns. */
+	size_t *arrLengths; /**< Length of each pattern. */
+	size_t nCountNodes; /**< Number of nodes (root is the node 0). */
+	elahocorasick_node *arrNodes; /**< Nodes in breadth-first order. */
+	uint8_t *arrLabels; /**< Characters of all edges. */
+	uint32_t *arrTargets; /**< Target nodes of all edges. */
+	uint32_t *arrOutputs; /**< Indices of patterns ending in the nodes. */
+	size_t nCountRows; /**< Number of dense transition tables. */
+	uint32_t *arrRows; /**< Dense transition tables (256 nodes each), the 
+	first one is the root's. */
+} ahocorasick;
+
+/** 
+ * @brief Holds the state of the search over a sequence of chunks, so matches 
+ * crossing chunk boundaries are found.
+ */
+typedef struct ahocorasick_stream {
+	ahocorasick *pAutomaton; /**< Automaton used. */
+	size_t nNode; /**< Current node. */
+	size_t nOffset; /**< Number of bytes processed. */
+} ahocorasick_stream;
+
+ahocorasick *elahocorasickCreate(str **pPatterns, size_t nCountPatterns);
+void elahocorasickDestroy(ahocorasick *pThis);
+size_t elahocorasickGetCountPatterns(ahocorasick *pThis);
+size_t elahocorasickForEachExView(ahocorasick *pThis, strview view, 
+	bool (*matchCallbackEx)(size_t nPattern, size_t nPos, void *pEx), 
+	void *pEx);
+size_t elahocorasickForEachExELStr(ahocorasick *pThis, str *pStr, 
+	bool (*matchCallbackEx)(size_t nPattern, size_t nPos, void *pEx), 
+	void *pEx);
+bool elahocorasickFindFirstView(ahocorasick *pThis, strview view, 
+	size_t *pPattern, size_t *pPos);
+bool elahocorasickFindFirstELStr(ahocorasick *pThis, str *pStr, 
+	size_t *pPattern, size_t *pPos);
+size_t elahocorasickCountView(ahocorasick *pThis, strview view, 
+	size_t *arrCounts);
+size_t elahocorasickCountELStr(ahocorasick *pThis, str *pStr, 
+	size_t *arrCounts);
+
+ahocorasick_stream *elahocorasickStreamCreate(ahocorasick *pAutomaton);
+void elahocorasickStreamDestroy(ahocorasick_stream *pThis);
+void elahocorasickStreamReset(ahocorasick_stream *pThis);
+size_t elahocorasickStreamForEachEx(ahocorasick_stream *pThis, strview chunk, 
+	bool (*matchCallbackEx)(size_t nPattern, size_t nPos, void *pEx), 
+	void *pEx);
+size_t elahocorasickStreamCount(ahocorasick_stream *pThis, strview chunk, 
+	size_t *arrCounts);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
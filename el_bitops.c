@@ -0,0 +1,1126 @@
+/* Extreme Library (EL). Bit operations over arrays of words. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <string.h>
+#include <stdatomic.h>
+
+#include "el_cpu.h"
+
+#include "el_bitops.h"
+
+/**
+ * SIMD kernels work with 64-bit words only.
+ */
+#if EL_CPU_X86 && UINTMAX_MAX == UINT64_MAX
+#define EL_BITOPS_SIMD 1
+#include <immintrin.h>
+#else
+#define EL_BITOPS_SIMD 0
+#endif
+
+/**
+ * Minimal number of words processed by Harley-Seal popcount. Shorter arrays 
+ * are counted word by word.
+ */
+#define EL_BITOPS_HARLEY_SEAL_MIN	64
+
+/**
+ * Minimal number of bits set in a word to extract its positions with SIMD 
+ * instructions. Sparse words are processed bit by bit.
+ */
+#define EL_BITOPS_EXTRACT_DENSE_MIN	12
+
+/**
+ * Number of bits in a word.
+ */
+#define EL_BITOPS_WORD_BITS	(sizeof(uintmax_t) << 3)
+
+/**
+ * Counts bits which are set in a single word without special instructions.
+ * @param  nValue Word.
+ * @return        Number of bits set.
+ */
+static inline size_t elbitopsPopCountWord(uintmax_t nValue) {
+#if UINTMAX_MAX == UINT64_MAX
+	nValue = nValue - ((nValue >> 1) & 0x5555555555555555ull);
+	nValue = (nValue & 0x3333333333333333ull) + 
+		((nValue >> 2) & 0x3333333333333333ull);
+	nValue = (nValue + (nValue >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+	return (size_t)((nValue * 0x0101010101010101ull) >> 56);
+#else
+	size_t nCount = 0;
+	for (; nValue; nCount++)
+		nValue &= nValue - 1; // clear the least significant bit set
+	return nCount;
+#endif
+}
+
+/**
+ * Counts bits which are set (portable implementation).
+ */
+static size_t elbitopsCountScalar(const uintmax_t *pWords, size_t nCount) {
+	size_t nResult = 0;
+
+	for(size_t i = 0; i < nCount; i++)
+		nResult += elbitopsPopCountWord(pWords[i]);
+
+	return nResult;
+}
+
+/**
+ * Checks if any bit is set (portable implementation).
+ */
+static bool elbitopsAnyScalar(const uintmax_t *pWords, size_t nCount) {
+	size_t i = 0;
+
+	// OR several words at once to have less branches
+	for(; i + 4 <= nCount; i += 4)
+		if((pWords[i] | pWords[i + 1] | pWords[i + 2] | pWords[i + 3]) != 0)
+			return true;
+	for(; i < nCount; i++)
+		if(pWords[i] != 0)
+			return true;
+
+	return false;
+}
+
+/**
+ * Flips all bits (portable implementation).
+ */
+static void elbitopsFlipScalar(uintmax_t *pWords, size_t nCount) {
+	for(size_t i = 0; i < nCount; i++)
+		pWords[i] = ~pWords[i];
+}
+
+/**
+ * Checks if arrays of words are equal (portable implementation).
+ */
+static bool elbitopsEqualScalar(const uintmax_t *pWords1, 
+	const uintmax_t *pWords2, size_t nCount) {
+
+	return memcmp(pWords1, pWords2, nCount * sizeof(uintmax_t)) == 0;
+}
+
+/**
+ * Returns the index of the lowest bit set. The word must not be zero.
+ * @param  nValue Word.
+ * @return        Index of the lowest bit set.
+ */
+static inline unsigned elbitopsLowestBit(uintmax_t nValue) {
+#if defined(__GNUC__) && UINTMAX_MAX == UINT64_MAX
+	return (unsigned)__builtin_ctzll(nValue);
+#else
+	unsigned nIndex = 0;
+	for(; (nValue & 1) == 0; nValue >>= 1)
+		nIndex++;
+	return nIndex;
+#endif
+}
+
+/**
+ * Returns the index of the highest bit set. The word must not be zero.
+ * @param  nValue Word.
+ * @return        Index of the highest bit set.
+ */
+static inline unsigned elbitopsHighestBit(uintmax_t nValue) {
+#if defined(__GNUC__) && UINTMAX_MAX == UINT64_MAX
+	return 63 - (unsigned)__builtin_clzll(nValue);
+#else
+	unsigned nIndex = 0;
+	for(; nValue >>= 1; )
+		nIndex++;
+	return nIndex;
+#endif
+}
+
+#define wordOpAnd(a, b) ((a) & (b))
+#define wordOpOr(a, b) ((a) | (b))
+#define wordOpXor(a, b) ((a) ^ (b))
+#define wordOpAndNot(a, b) ((a) & ~(b))
+
+/**
+ * Defines portable function combining two arrays of words with operation 
+ * @e op. Destination may be the same as any of the sources.
+ */
+#define defineOpScalar(name, op) \
+static void name(uintmax_t *pDest, const uintmax_t *pWords1, \
+	const uintmax_t *pWords2, size_t nCount) { \
+	for(size_t i = 0; i < nCount; i++) \
+		pDest[i] = op(pWords1[i], pWords2[i]); \
+}
+
+/**
+ * Defines portable function counting bits set in the result of operation 
+ * @e op over two arrays of words (result itself is not stored).
+ */
+#define defineCountScalar(name, op) \
+static size_t name(const uintmax_t *pWords1, const uintmax_t *pWords2, \
+	size_t nCount) { \
+	size_t nResult = 0; \
+	for(size_t i = 0; i < nCount; i++) \
+		nResult += elbitopsPopCountWord(op(pWords1[i], pWords2[i])); \
+	return nResult; \
+}
+
+defineOpScalar(elbitopsAndScalar, wordOpAnd)
+defineOpScalar(elbitopsOrScalar, wordOpOr)
+defineOpScalar(elbitopsXorScalar, wordOpXor)
+defineOpScalar(elbitopsAndNotScalar, wordOpAndNot)
+defineCountScalar(elbitopsCountAndScalar, wordOpAnd)
+defineCountScalar(elbitopsCountOrScalar, wordOpOr)
+defineCountScalar(elbitopsCountXorScalar, wordOpXor)
+defineCountScalar(elbitopsCountAndNotScalar, wordOpAndNot)
+
+/**
+ * Defines portable function writing positions of bits set into the array of 
+ * type @e type. Stops when @e nCountMax positions are written.
+ */
+#define defineExtractScalar(name, type) \
+static size_t name(const uintmax_t *pWords, size_t nCount, size_t nPosBase, \
+	type *pDest, size_t nCountMax) { \
+	size_t nResult = 0; \
+	for(size_t i = 0; i < nCount; i++, nPosBase += EL_BITOPS_WORD_BITS) { \
+		uintmax_t nValue = pWords[i]; \
+		for(; nValue != 0; nValue &= nValue - 1) { \
+			if(nResult == nCountMax) \
+				return nResult; \
+			pDest[nResult++] = (type)(nPosBase + elbitopsLowestBit(nValue)); \
+		} \
+	} \
+	return nResult; \
+}
+
+defineExtractScalar(elbitopsExtract32Scalar, uint32_t)
+defineExtractScalar(elbitopsExtract64Scalar, uint64_t)
+
+static const elbitops_kernels g_kernelsScalar = {
+	"scalar",
+	elbitopsCountScalar,
+	elbitopsAnyScalar,
+	elbitopsFlipScalar,
+	elbitopsEqualScalar,
+	elbitopsAndScalar,
+	elbitopsOrScalar,
+	elbitopsXorScalar,
+	elbitopsAndNotScalar,
+	elbitopsCountAndScalar,
+	elbitopsCountOrScalar,
+	elbitopsCountXorScalar,
+	elbitopsCountAndNotScalar,
+	elbitopsExtract32Scalar,
+	elbitopsExtract64Scalar
+};
+
+#if EL_BITOPS_SIMD
+
+/**
+ * Counts bits which are set using POPCNT instruction.
+ */
+__attribute__((target("popcnt")))
+static size_t elbitopsCountPopcnt(const uintmax_t *pWords, size_t nCount) {
+	// Independent accumulators let several POPCNT run in parallel
+	uint64_t nCount0 = 0, nCount1 = 0, nCount2 = 0, nCount3 = 0;
+	size_t i = 0;
+
+	for(; i + 4 <= nCount; i += 4) {
+		nCount0 += __builtin_popcountll(pWords[i]);
+		nCount1 += __builtin_popcountll(pWords[i + 1]);
+		nCount2 += __builtin_popcountll(pWords[i + 2]);
+		nCount3 += __builtin_popcountll(pWords[i + 3]);
+	}
+	for(; i < nCount; i++)
+		nCount0 += __builtin_popcountll(pWords[i]);
+
+	return nCount0 + nCount1 + nCount2 + nCount3;
+}
+
+/**
+ * Defines function counting bits set in the result of operation @e op over 
+ * two arrays of words using POPCNT instruction.
+ */
+#define defineCountPopcnt(name, op) \
+__attribute__((target("popcnt"))) \
+static size_t name(const uintmax_t *pWords1, const uintmax_t *pWords2, \
+	size_t nCount) { \
+	uint64_t nCount0 = 0, nCount1 = 0; \
+	size_t i = 0; \
+	for(; i + 2 <= nCount; i += 2) { \
+		nCount0 += __builtin_popcountll(op(pWords1[i], pWords2[i])); \
+		nCount1 += __builtin_popcountll(op(pWords1[i + 1], pWords2[i + 1])); \
+	} \
+	for(; i < nCount; i++) \
+		nCount0 += __builtin_popcountll(op(pWords1[i], pWords2[i])); \
+	return nCount0 + nCount1; \
+}
+
+defineCountPopcnt(elbitopsCountAndPopcnt, wordOpAnd)
+defineCountPopcnt(elbitopsCountOrPopcnt, wordOpOr)
+defineCountPopcnt(elbitopsCountXorPopcnt, wordOpXor)
+defineCountPopcnt(elbitopsCountAndNotPopcnt, wordOpAndNot)
+
+static const elbitops_kernels g_kernelsPopcnt = {
+	"popcnt",
+	elbitopsCountPopcnt,
+	elbitopsAnyScalar,
+	elbitopsFlipScalar,
+	elbitopsEqualScalar,
+	elbitopsAndScalar,
+	elbitopsOrScalar,
+	elbitopsXorScalar,
+	elbitopsAndNotScalar,
+	elbitopsCountAndPopcnt,
+	elbitopsCountOrPopcnt,
+	elbitopsCountXorPopcnt,
+	elbitopsCountAndNotPopcnt,
+	elbitopsExtract32Scalar,
+	elbitopsExtract64Scalar
+};
+
+/**
+ * Counts bits set in each of four 64-bit lanes of AVX2 register (using 
+ * in-register lookup table of nibble counts).
+ * @param  v AVX2 register.
+ * @return   Four 64-bit counts.
+ */
+__attribute__((target("avx2")))
+static inline __m256i elbitopsPopCount256(__m256i v) {
+	const __m256i lookup = _mm256_setr_epi8(
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i maskLow = _mm256_set1_epi8(0x0F);
+
+	__m256i lo = _mm256_and_si256(v, maskLow);
+	__m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), maskLow);
+	__m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), 
+		_mm256_shuffle_epi8(lookup, hi));
+
+	return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+/**
+ * Carry-save adder of Harley-Seal algorithm.
+ */
+#define elbitopsCSA(h, l, a, b, c) { \
+	__m256i u = _mm256_xor_si256((a), (b)); \
+	(h) = _mm256_or_si256(_mm256_and_si256((a), (b)), \
+		_mm256_and_si256(u, (c))); \
+	(l) = _mm256_xor_si256(u, (c)); }
+
+/**
+ * Defines AVX2 Harley-Seal popcount function over @e nVectors vectors. 
+ * Sixteen vectors are reduced by the tree of carry-save adders, so that full 
+ * popcount is done only once per 16 vectors. @e loadVector(i) is an expression
+ * which returns i-th vector to be counted (so counts of AND, OR etc. don't 
+ * need a temporary array).
+ */
+#define defineHarleySealAVX2(name, loadVector) \
+__attribute__((target("avx2"))) \
+static uint64_t name(const __m256i *p1, const __m256i *p2, size_t nVectors) { \
+	__m256i total = _mm256_setzero_si256(); \
+	__m256i ones = _mm256_setzero_si256(); \
+	__m256i twos = _mm256_setzero_si256(); \
+	__m256i fours = _mm256_setzero_si256(); \
+	__m256i eights = _mm256_setzero_si256(); \
+	__m256i sixteens, twosA, twosB, foursA, foursB, eightsA, eightsB; \
+	size_t i = 0; \
+	(void)p2; \
+	for(; i + 16 <= nVectors; i += 16) { \
+		elbitopsCSA(twosA, ones, ones, loadVector(i), loadVector(i + 1)); \
+		elbitopsCSA(twosB, ones, ones, loadVector(i + 2), loadVector(i + 3)); \
+		elbitopsCSA(foursA, twos, twos, twosA, twosB); \
+		elbitopsCSA(twosA, ones, ones, loadVector(i + 4), loadVector(i + 5)); \
+		elbitopsCSA(twosB, ones, ones, loadVector(i + 6), loadVector(i + 7)); \
+		elbitopsCSA(foursB, twos, twos, twosA, twosB); \
+		elbitopsCSA(eightsA, fours, fours, foursA, foursB); \
+		elbitopsCSA(twosA, ones, ones, loadVector(i + 8), loadVector(i + 9)); \
+		elbitopsCSA(twosB, ones, ones, loadVector(i + 10), \
+			loadVector(i + 11)); \
+		elbitopsCSA(foursA, twos, twos, twosA, twosB); \
+		elbitopsCSA(twosA, ones, ones, loadVector(i + 12), \
+			loadVector(i + 13)); \
+		elbitopsCSA(twosB, ones, ones, loadVector(i + 14), \
+			loadVector(i + 15)); \
+		elbitopsCSA(foursB, twos, twos, twosA, twosB); \
+		elbitopsCSA(eightsB, fours, fours, foursA, foursB); \
+		elbitopsCSA(sixteens, eights, eights, eightsA, eightsB); \
+		total = _mm256_add_epi64(total, elbitopsPopCount256(sixteens)); \
+	} \
+	total = _mm256_slli_epi64(total, 4); \
+	total = _mm256_add_epi64(total, \
+		_mm256_slli_epi64(elbitopsPopCount256(eights), 3)); \
+	total = _mm256_add_epi64(total, \
+		_mm256_slli_epi64(elbitopsPopCount256(fours), 2)); \
+	total = _mm256_add_epi64(total, \
+		_mm256_slli_epi64(elbitopsPopCount256(twos), 1)); \
+	total = _mm256_add_epi64(total, elbitopsPopCount256(ones)); \
+	for(; i < nVectors; i++) \
+		total = _mm256_add_epi64(total, elbitopsPopCount256(loadVector(i))); \
+	uint64_t arrSums[2]; \
+	_mm_storeu_si128((__m128i *)arrSums, _mm_add_epi64( \
+		_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1))); \
+	return arrSums[0] + arrSums[1]; \
+}
+
+#define elbitopsLoad(i) _mm256_loadu_si256(p1 + (i))
+
+defineHarleySealAVX2(elbitopsHarleySeal, elbitopsLoad)
+
+/**
+ * Counts bits which are set using AVX2 Harley-Seal algorithm for long 
+ * arrays and POPCNT instruction for short ones.
+ */
+__attribute__((target("avx2,popcnt")))
+static size_t elbitopsCountAVX2(const uintmax_t *pWords, size_t nCount) {
+	if(nCount < EL_BITOPS_HARLEY_SEAL_MIN)
+		return elbitopsCountPopcnt(pWords, nCount);
+
+	size_t nVectors = nCount / 4;
+
+	return elbitopsHarleySeal((const __m256i *)pWords, NULL, nVectors) + 
+		elbitopsCountPopcnt(pWords + nVectors * 4, nCount % 4);
+}
+
+/**
+ * Checks if any bit is set using AVX2.
+ */
+__attribute__((target("avx2")))
+static bool elbitopsAnyAVX2(const uintmax_t *pWords, size_t nCount) {
+	const __m256i *p = (const __m256i *)pWords;
+	size_t i = 0;
+
+	for(; i + 16 <= nCount; i += 16, p += 4) {
+		__m256i v = _mm256_or_si256(
+			_mm256_or_si256(_mm256_loadu_si256(p), _mm256_loadu_si256(p + 1)),
+			_mm256_or_si256(_mm256_loadu_si256(p + 2), 
+				_mm256_loadu_si256(p + 3)));
+		if(!_mm256_testz_si256(v, v))
+			return true;
+	}
+
+	return elbitopsAnyScalar(pWords + i, nCount - i);
+}
+
+/**
+ * Flips all bits using AVX2.
+ */
+__attribute__((target("avx2")))
+static void elbitopsFlipAVX2(uintmax_t *pWords, size_t nCount) {
+	const __m256i ones = _mm256_set1_epi64x(-1);
+	__m256i *p = (__m256i *)pWords;
+	size_t i = 0;
+
+	for(; i + 4 <= nCount; i += 4, p++)
+		_mm256_storeu_si256(p, _mm256_xor_si256(_mm256_loadu_si256(p), ones));
+
+	elbitopsFlipScalar(pWords + i, nCount - i);
+}
+
+/**
+ * Checks if arrays of words are equal using AVX2.
+ */
+__attribute__((target("avx2")))
+static bool elbitopsEqualAVX2(const uintmax_t *pWords1, 
+	const uintmax_t *pWords2, size_t nCount) {
+
+	const __m256i *p1 = (const __m256i *)pWords1;
+	const __m256i *p2 = (const __m256i *)pWords2;
+	size_t i = 0;
+
+	for(; i + 8 <= nCount; i += 8, p1 += 2, p2 += 2) {
+		__m256i v = _mm256_or_si256(
+			_mm256_xor_si256(_mm256_loadu_si256(p1), _mm256_loadu_si256(p2)),
+			_mm256_xor_si256(_mm256_loadu_si256(p1 + 1), 
+				_mm256_loadu_si256(p2 + 1)));
+		if(!_mm256_testz_si256(v, v))
+			return false;
+	}
+
+	return elbitopsEqualScalar(pWords1 + i, pWords2 + i, nCount - i);
+}
+
+#define opAnd256(a, b) _mm256_and_si256((a), (b))
+#define opOr256(a, b) _mm256_or_si256((a), (b))
+#define opXor256(a, b) _mm256_xor_si256((a), (b))
+#define opAndNot256(a, b) _mm256_andnot_si256((b), (a))
+
+/**
+ * Defines function combining two arrays of words with operation @e op using 
+ * AVX2. Destination may be the same as any of the sources.
+ */
+#define defineOpAVX2(name, op256, nameScalar) \
+__attribute__((target("avx2"))) \
+static void name(uintmax_t *pDest, const uintmax_t *pWords1, \
+	const uintmax_t *pWords2, size_t nCount) { \
+	size_t i = 0; \
+	for(; i + 8 <= nCount; i += 8) { \
+		__m256i a0 = _mm256_loadu_si256((const __m256i *)(pWords1 + i)); \
+		__m256i a1 = _mm256_loadu_si256((const __m256i *)(pWords1 + i + 4)); \
+		__m256i b0 = _mm256_loadu_si256((const __m256i *)(pWords2 + i)); \
+		__m256i b1 = _mm256_loadu_si256((const __m256i *)(pWords2 + i + 4)); \
+		_mm256_storeu_si256((__m256i *)(pDest + i), op256(a0, b0)); \
+		_mm256_storeu_si256((__m256i *)(pDest + i + 4), op256(a1, b1)); \
+	} \
+	nameScalar(pDest + i, pWords1 + i, pWords2 + i, nCount - i); \
+}
+
+#define elbitopsLoadAnd(i) opAnd256(_mm256_loadu_si256(p1 + (i)), \
+	_mm256_loadu_si256(p2 + (i)))
+#define elbitopsLoadOr(i) opOr256(_mm256_loadu_si256(p1 + (i)), \
+	_mm256_loadu_si256(p2 + (i)))
+#define elbitopsLoadXor(i) opXor256(_mm256_loadu_si256(p1 + (i)), \
+	_mm256_loadu_si256(p2 + (i)))
+#define elbitopsLoadAndNot(i) opAndNot256(_mm256_loadu_si256(p1 + (i)), \
+	_mm256_loadu_si256(p2 + (i)))
+
+defineHarleySealAVX2(elbitopsHarleySealAnd, elbitopsLoadAnd)
+defineHarleySealAVX2(elbitopsHarleySealOr, elbitopsLoadOr)
+defineHarleySealAVX2(elbitopsHarleySealXor, elbitopsLoadXor)
+defineHarleySealAVX2(elbitopsHarleySealAndNot, elbitopsLoadAndNot)
+
+/**
+ * Defines function counting bits set in the result of operation over two 
+ * arrays of words using AVX2 Harley-Seal algorithm for long arrays and POPCNT
+ * instruction for short ones.
+ */
+#define defineCountAVX2(name, nameHarleySeal, namePopcnt) \
+__attribute__((target("avx2,popcnt"))) \
+static size_t name(const uintmax_t *pWords1, const uintmax_t *pWords2, \
+	size_t nCount) { \
+	if(nCount < EL_BITOPS_HARLEY_SEAL_MIN) \
+		return namePopcnt(pWords1, pWords2, nCount); \
+	size_t nVectors = nCount / 4; \
+	return nameHarleySeal((const __m256i *)pWords1, \
+		(const __m256i *)pWords2, nVectors) + \
+		namePopcnt(pWords1 + nVectors * 4, pWords2 + nVectors * 4, \
+			nCount % 4); \
+}
+
+defineOpAVX2(elbitopsAndAVX2, opAnd256, elbitopsAndScalar)
+defineOpAVX2(elbitopsOrAVX2, opOr256, elbitopsOrScalar)
+defineOpAVX2(elbitopsXorAVX2, opXor256, elbitopsXorScalar)
+defineOpAVX2(elbitopsAndNotAVX2, opAndNot256, elbitopsAndNotScalar)
+defineCountAVX2(elbitopsCountAndAVX2, elbitopsHarleySealAnd, 
+	elbitopsCountAndPopcnt)
+defineCountAVX2(elbitopsCountOrAVX2, elbitopsHarleySealOr, 
+	elbitopsCountOrPopcnt)
+defineCountAVX2(elbitopsCountXorAVX2, elbitopsHarleySealXor, 
+	elbitopsCountXorPopcnt)
+defineCountAVX2(elbitopsCountAndNotAVX2, elbitopsHarleySealAndNot, 
+	elbitopsCountAndNotPopcnt)
+
+/**
+ * Positions of bits set in a byte packed into bytes of a word (lowest first), 
+ * for every value of the byte.
+ */
+static const uint64_t g_arrBytePositions[256] = {
+	0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000001ull,
+	0x0000000000000100ull, 0x0000000000000002ull, 0x0000000000000200ull,
+	0x0000000000000201ull, 0x0000000000020100ull, 0x0000000000000003ull,
+	0x0000000000000300ull, 0x0000000000000301ull, 0x0000000000030100ull,
+	0x0000000000000302ull, 0x0000000000030200ull, 0x0000000000030201ull,
+	0x0000000003020100ull, 0x0000000000000004ull, 0x0000000000000400ull,
+	0x0000000000000401ull, 0x0000000000040100ull, 0x0000000000000402ull,
+	0x0000000000040200ull, 0x0000000000040201ull, 0x0000000004020100ull,
+	0x0000000000000403ull, 0x0000000000040300ull, 0x0000000000040301ull,
+	0x0000000004030100ull, 0x0000000000040302ull, 0x0000000004030200ull,
+	0x0000000004030201ull, 0x0000000403020100ull, 0x0000000000000005ull,
+	0x0000000000000500ull, 0x0000000000000501ull, 0x0000000000050100ull,
+	0x0000000000000502ull, 0x0000000000050200ull, 0x0000000000050201ull,
+	0x0000000005020100ull, 0x0000000000000503ull, 0x0000000000050300ull,
+	0x0000000000050301ull, 0x0000000005030100ull, 0x0000000000050302ull,
+	0x0000000005030200ull, 0x0000000005030201ull, 0x0000000503020100ull,
+	0x0000000000000504ull, 0x0000000000050400ull, 0x0000000000050401ull,
+	0x0000000005040100ull, 0x0000000000050402ull, 0x0000000005040200ull,
+	0x0000000005040201ull, 0x0000000504020100ull, 0x0000000000050403ull,
+	0x0000000005040300ull, 0x0000000005040301ull, 0x0000000504030100ull,
+	0x0000000005040302ull, 0x0000000504030200ull, 0x0000000504030201ull,
+	0x0000050403020100ull, 0x0000000000000006ull, 0x0000000000000600ull,
+	0x0000000000000601ull, 0x0000000000060100ull, 0x0000000000000602ull,
+	0x0000000000060200ull, 0x0000000000060201ull, 0x0000000006020100ull,
+	0x0000000000000603ull, 0x0000000000060300ull, 0x0000000000060301ull,
+	0x0000000006030100ull, 0x0000000000060302ull, 0x0000000006030200ull,
+	0x0000000006030201ull, 0x0000000603020100ull, 0x0000000000000604ull,
+	0x0000000000060400ull, 0x0000000000060401ull, 0x0000000006040100ull,
+	0x0000000000060402ull, 0x0000000006040200ull, 0x0000000006040201ull,
+	0x0000000604020100ull, 0x0000000000060403ull, 0x0000000006040300ull,
+	0x0000000006040301ull, 0x0000000604030100ull, 0x0000000006040302ull,
+	0x0000000604030200ull, 0x0000000604030201ull, 0x0000060403020100ull,
+	0x0000000000000605ull, 0x0000000000060500ull, 0x0000000000060501ull,
+	0x0000000006050100ull, 0x0000000000060502ull, 0x0000000006050200ull,
+	0x0000000006050201ull, 0x0000000605020100ull, 0x0000000000060503ull,
+	0x0000000006050300ull, 0x0000000006050301ull, 0x0000000605030100ull,
+	0x0000000006050302ull, 0x0000000605030200ull, 0x0000000605030201ull,
+	0x0000060503020100ull, 0x0000000000060504ull, 0x0000000006050400ull,
+	0x0000000006050401ull, 0x0000000605040100ull, 0x0000000006050402ull,
+	0x0000000605040200ull, 0x0000000605040201ull, 0x0000060504020100ull,
+	0x0000000006050403ull, 0x0000000605040300ull, 0x0000000605040301ull,
+	0x0000060504030100ull, 0x0000000605040302ull, 0x0000060504030200ull,
+	0x0000060504030201ull, 0x0006050403020100ull, 0x0000000000000007ull,
+	0x0000000000000700ull, 0x0000000000000701ull, 0x0000000000070100ull,
+	0x0000000000000702ull, 0x0000000000070200ull, 0x0000000000070201ull,
+	0x0000000007020100ull, 0x0000000000000703ull, 0x0000000000070300ull,
+	0x0000000000070301ull, 0x0000000007030100ull, 0x0000000000070302ull,
+	0x0000000007030200ull, 0x0000000007030201ull, 0x0000000703020100ull,
+	0x0000000000000704ull, 0x0000000000070400ull, 0x0000000000070401ull,
+	0x0000000007040100ull, 0x0000000000070402ull, 0x0000000007040200ull,
+	0x0000000007040201ull, 0x0000000704020100ull, 0x0000000000070403ull,
+	0x0000000007040300ull, 0x0000000007040301ull, 0x0000000704030100ull,
+	0x0000000007040302ull, 0x0000000704030200ull, 0x0000000704030201ull,
+	0x0000070403020100ull, 0x0000000000000705ull, 0x0000000000070500ull,
+	0x0000000000070501ull, 0x0000000007050100ull, 0x0000000000070502ull,
+	0x0000000007050200ull, 0x0000000007050201ull, 0x0000000705020100ull,
+	0x0000000000070503ull, 0x0000000007050300ull, 0x0000000007050301ull,
+	0x0000000705030100ull, 0x0000000007050302ull, 0x0000000705030200ull,
+	0x0000000705030201ull, 0x0000070503020100ull, 0x0000000000070504ull,
+	0x0000000007050400ull, 0x0000000007050401ull, 0x0000000705040100ull,
+	0x0000000007050402ull, 0x0000000705040200ull, 0x0000000705040201ull,
+	0x0000070504020100ull, 0x0000000007050403ull, 0x0000000705040300ull,
+	0x0000000705040301ull, 0x0000070504030100ull, 0x0000000705040302ull,
+	0x0000070504030200ull, 0x0000070504030201ull, 0x0007050403020100ull,
+	0x0000000000000706ull, 0x0000000000070600ull, 0x0000000000070601ull,
+	0x0000000007060100ull, 0x0000000000070602ull, 0x0000000007060200ull,
+	0x0000000007060201ull, 0x0000000706020100ull, 0x0000000000070603ull,
+	0x0000000007060300ull, 0x0000000007060301ull, 0x0000000706030100ull,
+	0x0000000007060302ull, 0x0000000706030200ull, 0x0000000706030201ull,
+	0x0000070603020100ull, 0x0000000000070604ull, 0x0000000007060400ull,
+	0x0000000007060401ull, 0x0000000706040100ull, 0x0000000007060402ull,
+	0x0000000706040200ull, 0x0000000706040201ull, 0x0000070604020100ull,
+	0x0000000007060403ull, 0x0000000706040300ull, 0x0000000706040301ull,
+	0x0000070604030100ull, 0x0000000706040302ull, 0x0000070604030200ull,
+	0x0000070604030201ull, 0x0007060403020100ull, 0x0000000000070605ull,
+	0x0000000007060500ull, 0x0000000007060501ull, 0x0000000706050100ull,
+	0x0000000007060502ull, 0x0000000706050200ull, 0x0000000706050201ull,
+	0x0000070605020100ull, 0x0000000007060503ull, 0x0000000706050300ull,
+	0x0000000706050301ull, 0x0000070605030100ull, 0x0000000706050302ull,
+	0x0000070605030200ull, 0x0000070605030201ull, 0x0007060503020100ull,
+	0x0000000007060504ull, 0x0000000706050400ull, 0x0000000706050401ull,
+	0x0000070605040100ull, 0x0000000706050402ull, 0x0000070605040200ull,
+	0x0000070605040201ull, 0x0007060504020100ull, 0x0000000706050403ull,
+	0x0000070605040300ull, 0x0000070605040301ull, 0x0007060504030100ull,
+	0x0000070605040302ull, 0x0007060504030200ull, 0x0007060504030201ull,
+	0x0706050403020100ull
+};
+
+/**
+ * Defines function writing positions of bits set into the array of type 
+ * @e type using AVX2. Positions of each byte of dense words are taken from 
+ * the table and widened by @e storeByte(pDest, nPositions, nPosBase) which 
+ * may write up to 8 elements, so SIMD path is taken only when there's enough 
+ * room in the destination.
+ */
+#define defineExtractAVX2(name, type, storeByte, nameScalar) \
+__attribute__((target("avx2,popcnt"))) \
+static size_t name(const uintmax_t *pWords, size_t nCount, size_t nPosBase, \
+	type *pDest, size_t nCountMax) { \
+	size_t nResult = 0; \
+	for(size_t i = 0; i < nCount; i++, nPosBase += EL_BITOPS_WORD_BITS) { \
+		uintmax_t nValue = pWords[i]; \
+		size_t nBits = (size_t)__builtin_popcountll(nValue); \
+		if(nBits >= EL_BITOPS_EXTRACT_DENSE_MIN && \
+			nResult + nBits + 8 <= nCountMax) { \
+			for(unsigned j = 0; j < 64; j += 8) { \
+				unsigned nByte = (unsigned)(nValue >> j) & 0xFF; \
+				storeByte(pDest + nResult, g_arrBytePositions[nByte], \
+					nPosBase + j); \
+				nResult += (size_t)__builtin_popcount(nByte); \
+			} \
+		} else { \
+			size_t nWritten = nameScalar(pWords + i, 1, nPosBase, \
+				pDest + nResult, nCountMax - nResult); \
+			nResult += nWritten; \
+			if(nWritten < nBits) \
+				break; \
+		} \
+	} \
+	return nResult; \
+}
+
+/**
+ * Writes 8 positions of 32 bits packed into @e nPositions plus base.
+ */
+__attribute__((target("avx2")))
+static inline void elbitopsStoreByte32(uint32_t *pDest, uint64_t nPositions, 
+	size_t nPosBase) {
+
+	__m256i v = _mm256_cvtepu8_epi32(
+		_mm_loadl_epi64((const __m128i *)&nPositions));
+	v = _mm256_add_epi32(v, _mm256_set1_epi32((int)(uint32_t)nPosBase));
+	_mm256_storeu_si256((__m256i *)pDest, v);
+}
+
+/**
+ * Writes 8 positions of 64 bits packed into @e nPositions plus base.
+ */
+__attribute__((target("avx2")))
+static inline void elbitopsStoreByte64(uint64_t *pDest, uint64_t nPositions, 
+	size_t nPosBase) {
+
+	__m128i bytes = _mm_loadl_epi64((const __m128i *)&nPositions);
+	__m256i base = _mm256_set1_epi64x((long long)nPosBase);
+	_mm256_storeu_si256((__m256i *)pDest, 
+		_mm256_add_epi64(_mm256_cvtepu8_epi64(bytes), base));
+	_mm256_storeu_si256((__m256i *)(pDest + 4), 
+		_mm256_add_epi64(_mm256_cvtepu8_epi64(_mm_srli_si128(bytes, 4)), base));
+}
+
+defineExtractAVX2(elbitopsExtract32AVX2, uint32_t, elbitopsStoreByte32, 
+	elbitopsExtract32Scalar)
+defineExtractAVX2(elbitopsExtract64AVX2, uint64_t, elbitopsStoreByte64, 
+	elbitopsExtract64Scalar)
+
+static const elbitops_kernels g_kernelsAVX2 = {
+	"avx2",
+	elbitopsCountAVX2,
+	elbitopsAnyAVX2,
+	elbitopsFlipAVX2,
+	elbitopsEqualAVX2,
+	elbitopsAndAVX2,
+	elbitopsOrAVX2,
+	elbitopsXorAVX2,
+	elbitopsAndNotAVX2,
+	elbitopsCountAndAVX2,
+	elbitopsCountOrAVX2,
+	elbitopsCountXorAVX2,
+	elbitopsCountAndNotAVX2,
+	elbitopsExtract32AVX2,
+	elbitopsExtract64AVX2
+};
+
+/**
+ * Counts bits which are set using AVX-512 VPOPCNTQ instruction.
+ */
+__attribute__((target("avx512f,avx512vpopcntdq")))
+static size_t elbitopsCountAVX512(const uintmax_t *pWords, size_t nCount) {
+	__m512i total0 = _mm512_setzero_si512();
+	__m512i total1 = _mm512_setzero_si512();
+	size_t i = 0;
+
+	for(; i + 16 <= nCount; i += 16) {
+		total0 = _mm512_add_epi64(total0, 
+			_mm512_popcnt_epi64(_mm512_loadu_si512(pWords + i)));
+		total1 = _mm512_add_epi64(total1, 
+			_mm512_popcnt_epi64(_mm512_loadu_si512(pWords + i + 8)));
+	}
+	for(; i < nCount; i += 8) {
+		__mmask8 mask = nCount - i >= 8 ? 0xFF : 
+			(__mmask8)((1u << (nCount - i)) - 1);
+		total0 = _mm512_add_epi64(total0, 
+			_mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(mask, pWords + i)));
+	}
+
+	return _mm512_reduce_add_epi64(_mm512_add_epi64(total0, total1));
+}
+
+#define opAnd512(a, b) _mm512_and_si512((a), (b))
+#define opOr512(a, b) _mm512_or_si512((a), (b))
+#define opXor512(a, b) _mm512_xor_si512((a), (b))
+#define opAndNot512(a, b) _mm512_andnot_si512((b), (a))
+
+/**
+ * Defines function counting bits set in the result of operation over two 
+ * arrays of words using AVX-512 VPOPCNTQ instruction.
+ */
+#define defineCountAVX512(name, op512) \
+__attribute__((target("avx512f,avx512vpopcntdq"))) \
+static size_t name(const uintmax_t *pWords1, const uintmax_t *pWords2, \
+	size_t nCount) { \
+	__m512i total = _mm512_setzero_si512(); \
+	for(size_t i = 0; i < nCount; i += 8) { \
+		__mmask8 mask = nCount - i >= 8 ? 0xFF : \
+			(__mmask8)((1u << (nCount - i)) - 1); \
+		__m512i v = op512(_mm512_maskz_loadu_epi64(mask, pWords1 + i), \
+			_mm512_maskz_loadu_epi64(mask, pWords2 + i)); \
+		total = _mm512_add_epi64(total, _mm512_popcnt_epi64(v)); \
+	} \
+	return _mm512_reduce_add_epi64(total); \
+}
+
+defineCountAVX512(elbitopsCountAndAVX512, opAnd512)
+defineCountAVX512(elbitopsCountOrAVX512, opOr512)
+defineCountAVX512(elbitopsCountXorAVX512, opXor512)
+defineCountAVX512(elbitopsCountAndNotAVX512, opAndNot512)
+
+/**
+ * Writes positions of bits set into the array of 32-bit integers using 
+ * AVX-512 compress store, 16 bits at once.
+ */
+__attribute__((target("avx512f,popcnt")))
+static size_t elbitopsExtract32AVX512(const uintmax_t *pWords, size_t nCount, 
+	size_t nPosBase, uint32_t *pDest, size_t nCountMax) {
+
+	const __m512i iota = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 
+		11, 12, 13, 14, 15);
+	size_t nResult = 0;
+	for(size_t i = 0; i < nCount; i++, nPosBase += EL_BITOPS_WORD_BITS) {
+		uintmax_t nValue = pWords[i];
+		size_t nBits = (size_t)__builtin_popcountll(nValue);
+		if(nResult + nBits > nCountMax) {
+			nResult += elbitopsExtract32Scalar(pWords + i, 1, nPosBase, 
+				pDest + nResult, nCountMax - nResult);
+			break;
+		}
+		for(unsigned j = 0; nValue != 0; j += 16, nValue >>= 16) {
+			__mmask16 mask = (__mmask16)nValue;
+			__m512i v = _mm512_add_epi32(iota, 
+				_mm512_set1_epi32((int)(uint32_t)(nPosBase + j)));
+			_mm512_mask_compressstoreu_epi32(pDest + nResult, mask, v);
+			nResult += (size_t)__builtin_popcount(mask);
+		}
+	}
+	return nResult;
+}
+
+/**
+ * Writes positions of bits set into the array of 64-bit integers using 
+ * AVX-512 compress store, 8 bits at once.
+ */
+__attribute__((target("avx512f,popcnt")))
+static size_t elbitopsExtract64AVX512(const uintmax_t *pWords, size_t nCount, 
+	size_t nPosBase, uint64_t *pDest, size_t nCountMax) {
+
+	const __m512i iota = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+	size_t nResult = 0;
+	for(size_t i = 0; i < nCount; i++, nPosBase += EL_BITOPS_WORD_BITS) {
+		uintmax_t nValue = pWords[i];
+		size_t nBits = (size_t)__builtin_popcountll(nValue);
+		if(nResult + nBits > nCountMax) {
+			nResult += elbitopsExtract64Scalar(pWords + i, 1, nPosBase, 
+				pDest + nResult, nCountMax - nResult);
+			break;
+		}
+		for(unsigned j = 0; nValue != 0; j += 8, nValue >>= 8) {
+			__mmask8 mask = (__mmask8)nValue;
+			__m512i v = _mm512_add_epi64(iota, 
+				_mm512_set1_epi64((long long)(nPosBase + j)));
+			_mm512_mask_compressstoreu_epi64(pDest + nResult, mask, v);
+			nResult += (size_t)__builtin_popcount(mask);
+		}
+	}
+	return nResult;
+}
+
+static const elbitops_kernels g_kernelsAVX512 = {
+	"avx512",
+	elbitopsCountAVX512,
+	elbitopsAnyAVX2,
+	elbitopsFlipAVX2,
+	elbitopsEqualAVX2,
+	elbitopsAndAVX2,
+	elbitopsOrAVX2,
+	elbitopsXorAVX2,
+	elbitopsAndNotAVX2,
+	elbitopsCountAndAVX512,
+	elbitopsCountOrAVX512,
+	elbitopsCountXorAVX512,
+	elbitopsCountAndNotAVX512,
+	elbitopsExtract32AVX512,
+	elbitopsExtract64AVX512
+};
+
+#endif
+
+static const elbitops_kernels *_Atomic g_pKernels = NULL;
+
+/**
+ * Returns the kernels best suited for the CPU. CPU is checked once, at first 
+ * call.
+ * @return Kernels.
+ */
+const elbitops_kernels *elbitopsGetKernels() {
+	const elbitops_kernels *pKernels = atomic_load_explicit(&g_pKernels, 
+		memory_order_relaxed);
+	if(pKernels != NULL)
+		return pKernels;
+
+	pKernels = &g_kernelsScalar;
+#if EL_BITOPS_SIMD
+	if(elcpuHas(EL_CPU_AVX512F | EL_CPU_AVX512VPOPCNTDQ | EL_CPU_AVX2))
+		pKernels = &g_kernelsAVX512;
+	else if(elcpuHas(EL_CPU_AVX2 | EL_CPU_POPCNT))
+		pKernels = &g_kernelsAVX2;
+	else if(elcpuHas(EL_CPU_POPCNT))
+		pKernels = &g_kernelsPopcnt;
+#endif
+
+	atomic_store_explicit(&g_pKernels, pKernels, memory_order_relaxed);
+
+	return pKernels;
+}
+
+/**
+ * Returns the name of kernels chosen for the CPU ("scalar", "popcnt", "avx2" 
+ * or "avx512").
+ * @return Name of kernels.
+ */
+const char *elbitopsGetKernelsName() {
+	return elbitopsGetKernels()->szName;
+}
+
+/**
+ * Counts bits which are set in an array of words.
+ * @param  pWords An array of words.
+ * @param  nCount Number of words.
+ * @return        Number of bits set.
+ */
+size_t elbitopsCount(const uintmax_t *pWords, size_t nCount) {
+	return elbitopsGetKernels()->count(pWords, nCount);
+}
+
+/**
+ * Checks if any bit of an array of words is set.
+ * @param  pWords An array of words.
+ * @param  nCount Number of words.
+ * @return        @b True if any of the bits is set, otherwise @b false.
+ */
+bool elbitopsAny(const uintmax_t *pWords, size_t nCount) {
+	return elbitopsGetKernels()->any(pWords, nCount);
+}
+
+/**
+ * Flips all bits of an array of words.
+ * @param pWords An array of words.
+ * @param nCount Number of words.
+ */
+void elbitopsFlip(uintmax_t *pWords, size_t nCount) {
+	elbitopsGetKernels()->flip(pWords, nCount);
+}
+
+/**
+ * Checks if two arrays of words are equal.
+ * @param  pWords1 First array of words.
+ * @param  pWords2 Second array of words.
+ * @param  nCount  Number of words in each array.
+ * @return         @b True if arrays are equal, otherwise @b false.
+ */
+bool elbitopsEqual(const uintmax_t *pWords1, const uintmax_t *pWords2, 
+	size_t nCount) {
+
+	return elbitopsGetKernels()->equal(pWords1, pWords2, nCount);
+}
+
+/**
+ * Combines two arrays of words with AND operation (pDest = p1 & p2). 
+ * Destination may be the same as any of the sources.
+ * @param pDest   Destination array of words.
+ * @param pWords1 First array of words.
+ * @param pWords2 Second array of words.
+ * @param nCount  Number of words in each array.
+ */
+void elbitopsAnd(uintmax_t *pDest, const uintmax_t *pWords1, 
+	const uintmax_t *pWords2, size_t nCount) {
+
+	elbitopsGetKernels()->opAnd(pDest, pWords1, pWords2, nCount);
+}
+
+/**
+ * Combines two arrays of words with OR operation (pDest = p1 | p2). 
+ * Destination may be the same as any of the sources.
+ * @param pDest   Destination array of words.
+ * @param pWords1 First array of words.
+ * @param pWords2 Second array of words.
+ * @param nCount  Number of words in each array.
+ */
+void elbitopsOr(uintmax_t *pDest, const uintmax_t *pWords1, 
+	const uintmax_t *pWords2, size_t nCount) {
+
+	elbitopsGetKernels()->opOr(pDest, pWords1, pWords2, nCount);
+}
+
+/**
+ * Combines two arrays of words with XOR operation (pDest = p1 ^ p2). 
+ * Destination may be the same as any of the sources.
+ * @param pDest   Destination array of words.
+ * @param pWords1 First array of words.
+ * @param pWords2 Second array of words.
+ * @param nCount  Number of words in each array.
+ */
+void elbitopsXor(uintmax_t *pDest, const uintmax_t *pWords1, 
+	const uintmax_t *pWords2, size_t nCount) {
+
+	elbitopsGetKernels()->opXor(pDest, pWords1, pWords2, nCount);
+}
+
+/**
+ * Combines two arrays of words with AND NOT operation (pDest = p1 & ~p2). 
+ * Destination may be the same as any of the sources.
+ * @param pDest   Destination array of words.
+ * @param pWords1 First array of words.
+ * @param pWords2 Second array of words.
+ * @param nCount  Number of words in each array.
+ */
+void elbitopsAndNot(uintmax_t *pDest, const uintmax_t *pWords1, 
+	const uintmax_t *pWords2, size_t nCount) {
+
+	elbitopsGetKernels()->opAndNot(pDest, pWords1, pWords2, nCount);
+}
+
+/**
+ * Counts bits which are set in the result of AND operation (p1 & p2) 
+ * without storing the result.
+ * @param  pWords1 First array of words.
+ * @param  pWords2 Second array of words.
+ * @param  nCount  Number of words in each array.
+ * @return         Number of bits set.
+ */
+size_t elbitopsCountAnd(const uintmax_t *pWords1, const uintmax_t *pWords2, 
+	size_t nCount) {
+
+	return elbitopsGetKernels()->countAnd(pWords1, pWords2, nCount);
+}
+
+/**
+ * Counts bits which are set in the result of OR operation (p1 | p2) 
+ * without storing the result.
+ * @param  pWords1 First array of words.
+ * @param  pWords2 Second array of words.
+ * @param  nCount  Number of words in each array.
+ * @return         Number of bits set.
+ */
+size_t elbitopsCountOr(const uintmax_t *pWords1, const uintmax_t *pWords2, 
+	size_t nCount) {
+
+	return elbitopsGetKernels()->countOr(pWords1, pWords2, nCount);
+}
+
+/**
+ * Counts bits which are set in the result of XOR operation (p1 ^ p2) 
+ * without storing the result.
+ * @param  pWords1 First array of words.
+ * @param  pWords2 Second array of words.
+ * @param  nCount  Number of words in each array.
+ * @return         Number of bits set.
+ */
+size_t elbitopsCountXor(const uintmax_t *pWords1, const uintmax_t *pWords2, 
+	size_t nCount) {
+
+	return elbitopsGetKernels()->countXor(pWords1, pWords2, nCount);
+}
+
+/**
+ * Counts bits which are set in the result of AND NOT operation (p1 & ~p2) 
+ * without storing the result.
+ * @param  pWords1 First array of words.
+ * @param  pWords2 Second array of words.
+ * @param  nCount  Number of words in each array.
+ * @return         Number of bits set.
+ */
+size_t elbitopsCountAndNot(const uintmax_t *pWords1, const uintmax_t *pWords2, 
+	size_t nCount) {
+
+	return elbitopsGetKernels()->countAndNot(pWords1, pWords2, nCount);
+}
+
+/**
+ * Finds the first bit having the specified value at or after the specified 
+ * position.
+ * @param  pWords An array of words.
+ * @param  nCount Number of words.
+ * @param  nPos   Position to start search from.
+ * @param  bValue Value of the bit to be found.
+ * @return        Position of the bit found or EL_BITOPS_NPOS if there's no 
+ * such bit.
+ */
+size_t elbitopsFindNext(const uintmax_t *pWords, size_t nCount, size_t nPos, 
+	bool bValue) {
+
+	size_t nIndex = nPos / EL_BITOPS_WORD_BITS;
+	if(nIndex >= nCount)
+		return EL_BITOPS_NPOS;
+
+	uintmax_t nInvert = bValue ? 0 : UINTMAX_MAX;
+	uintmax_t nValue = (pWords[nIndex] ^ nInvert) & 
+		(UINTMAX_MAX << (nPos % EL_BITOPS_WORD_BITS));
+	while(nValue == 0) {
+		if(++nIndex == nCount)
+			return EL_BITOPS_NPOS;
+		nValue = pWords[nIndex] ^ nInvert;
+	}
+
+	return nIndex * EL_BITOPS_WORD_BITS + elbitopsLowestBit(nValue);
+}
+
+/**
+ * Finds the last bit having the specified value at or before the specified 
+ * position.
+ * @param  pWords An array of words.
+ * @param  nCount Number of words.
+ * @param  nPos   Position to start search from (if it's beyond the end of 
+ * the array, search starts from the last bit).
+ * @param  bValue Value of the bit to be found.
+ * @return        Position of the bit found or EL_BITOPS_NPOS if there's no 
+ * such bit.
+ */
+size_t elbitopsFindPrev(const uintmax_t *pWords, size_t nCount, size_t nPos, 
+	bool bValue) {
+
+	if(nCount == 0)
+		return EL_BITOPS_NPOS;
+
+	size_t nIndex = nPos / EL_BITOPS_WORD_BITS;
+	if(nIndex >= nCount) {
+		nIndex = nCount - 1;
+		nPos = EL_BITOPS_WORD_BITS - 1;
+	}
+
+	uintmax_t nInvert = bValue ? 0 : UINTMAX_MAX;
+	uintmax_t nValue = (pWords[nIndex] ^ nInvert) & 
+		(UINTMAX_MAX >> (EL_BITOPS_WORD_BITS - 1 - nPos % EL_BITOPS_WORD_BITS));
+	while(nValue == 0) {
+		if(nIndex-- == 0)
+			return EL_BITOPS_NPOS;
+		nValue = pWords[nIndex] ^ nInvert;
+	}
+
+	return nIndex * EL_BITOPS_WORD_BITS + elbitopsHighestBit(nValue);
+}
+
+/**
+ * Writes positions of bits which are set into an array of 32-bit integers in 
+ * ascending order. Stops when @e nCountMax positions are written.
+ * @param  pWords       An array of words.
+ * @param  nCount       Number of words.
+ * @param  nPosBase     Position of the first bit of the array (added to each 
+ * position written).
+ * @param  arrPositions Destination array.
+ * @param  nCountMax    Capacity of the destination array.
+ * @return              Number of positions written.
+ */
+size_t elbitopsExtract32(const uintmax_t *pWords, size_t nCount, 
+	size_t nPosBase, uint32_t *arrPositions, size_t nCountMax) {
+
+	return elbitopsGetKernels()->extract32(pWords, nCount, nPosBase, 
+		arrPositions, nCountMax);
+}
+
+/**
+ * Writes positions of bits which are set into an array of 64-bit integers in 
+ * ascending order. Stops when @e nCountMax positions are written.
+ * @param  pWords       An array of words.
+ * @param  nCount       Number of words.
+ * @param  nPosBase     Position of the first bit of the array (added to each 
+ * position written).
+ * @param  arrPositions Destination array.
+ * @param  nCountMax    Capacity of the destination array.
+ * @return              Number of positions written.
+ */
+size_t elbitopsExtract64(const uintmax_t *pWords, size_t nCount, 
+	size_t nPosBase, uint64_t *arrPositions, size_t nCountMax) {
+
+	return elbitopsGetKernels()->extract64(pWords, nCount, nPosBase, 
+		arrPositions, nCountMax);
+}
@@ -0,0 +1,109 @@
+/* Extreme Library (EL). Bit operations over arrays of words. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _EL_BITOPS_H_
+#define _EL_BITOPS_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 
+ * @brief Kernels processing arrays of words. The best implementation for the 
+ * CPU is chosen at first use (scalar, POPCNT, AVX2 or AVX-512).
+ */
+typedef struct elbitops_kernels {
+	const char *szName; /**< Name of the implementation. */
+	size_t (*count)(const uintmax_t *pWords, size_t nCount); /**< Counts bits 
+	which are set. */
+	bool (*any)(const uintmax_t *pWords, size_t nCount); /**< Checks if any 
+	bit is set. */
+	void (*flip)(uintmax_t *pWords, size_t nCount); /**< Flips all bits. */
+	bool (*equal)(const uintmax_t *pWords1, const uintmax_t *pWords2, 
+		size_t nCount); /**< Checks if arrays are equal. */
+	void (*opAnd)(uintmax_t *pDest, const uintmax_t *pWords1, 
+		const uintmax_t *pWords2, size_t nCount); /**< pDest = p1 & p2. */
+	void (*opOr)(uintmax_t *pDest, const uintmax_t *pWords1, 
+		const uintmax_t *pWords2, size_t nCount); /**< pDest = p1 | p2. */
+	void (*opXor)(uintmax_t *pDest, const uintmax_t *pWords1, 
+		const uintmax_t *pWords2, size_t nCount); /**< pDest = p1 ^ p2. */
+	void (*opAndNot)(uintmax_t *pDest, const uintmax_t *pWords1, 
+		const uintmax_t *pWords2, size_t nCount); /**< pDest = p1 & ~p2. */
+	size_t (*countAnd)(const uintmax_t *pWords1, const uintmax_t *pWords2, 
+		size_t nCount); /**< Counts bits set in p1 & p2. */
+	size_t (*countOr)(const uintmax_t *pWords1, const uintmax_t *pWords2, 
+		size_t nCount); /**< Counts bits set in p1 | p2. */
+	size_t (*countXor)(const uintmax_t *pWords1, const uintmax_t *pWords2, 
+		size_t nCount); /**< Counts bits set in p1 ^ p2. */
+	size_t (*countAndNot)(const uintmax_t *pWords1, const uintmax_t *pWords2, 
+		size_t nCount); /**< Counts bits set in p1 & ~p2. */
+	size_t (*extract32)(const uintmax_t *pWords, size_t nCount, 
+		size_t nPosBase, uint32_t *pDest, size_t nCountMax); /**< Writes 
+	positions of bits set. */
+	size_t (*extract64)(const uintmax_t *pWords, size_t nCount, 
+		size_t nPosBase, uint64_t *pDest, size_t nCountMax); /**< Writes 
+	positions of bits set. */
+} elbitops_kernels;
+
+/** 
+ * @brief Position returned when the bit is not found.
+ */
+#define EL_BITOPS_NPOS ((size_t)-1)
+
+const elbitops_kernels *elbitopsGetKernels();
+const char *elbitopsGetKernelsName();
+size_t elbitopsCount(const uintmax_t *pWords, size_t nCount);
+bool elbitopsAny(const uintmax_t *pWords, size_t nCount);
+void elbitopsFlip(uintmax_t *pWords, size_t nCount);
+bool elbitopsEqual(const uintmax_t *pWords1, const uintmax_t *pWords2, 
+	size_t nCount);
+void elbitopsAnd(uintmax_t *pDest, const uintmax_t *pWords1, 
+	const uintmax_t *pWords2, size_t nCount);
+void elbitopsOr(uintmax_t *pDest, const uintmax_t *pWords1, 
+	const uintmax_t *pWords2, size_t nCount);
+void elbitopsXor(uintmax_t *pDest, const uintmax_t *pWords1, 
+	const uintmax_t *pWords2, size_t nCount);
+void elbitopsAndNot(uintmax_t *pDest, const uintmax_t *pWords1, 
+	const uintmax_t *pWords2, size_t nCount);
+size_t elbitopsCountAnd(const uintmax_t *pWords1, const uintmax_t *pWords2, 
+	size_t nCount);
+size_t elbitopsCountOr(const uintmax_t *pWords1, const uintmax_t *pWords2, 
+	size_t nCount);
+size_t elbitopsCountXor(const uintmax_t *pWords1, const uintmax_t *pWords2, 
+	size_t nCount);
+size_t elbitopsCountAndNot(const uintmax_t *pWords1, const uintmax_t *pWords2, 
+	size_t nCount);
+
+size_t elbitopsFindNext(const uintmax_t *pWords, size_t nCount, size_t nPos, 
+	bool bValue);
+size_t elbitopsFindPrev(const uintmax_t *pWords, size_t nCount, size_t nPos, 
+	bool bValue);
+size_t elbitopsExtract32(const uintmax_t *pWords, size_t nCount, 
+	size_t nPosBase, uint32_t *arrPositions, size_t nCountMax);
+size_t elbitopsExtract64(const uintmax_t *pWords, size_t nCount, 
+	size_t nPosBase, uint64_t *arrPositions, size_t nCountMax);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
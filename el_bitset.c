@@ -16,13 +16,23 @@
  */
 
 #include <string.h>
+#include <stdatomic.h>
 
 #include "el_memory.h"
 
 #include "el_bitset.h"
+#include "el_bitops.h"
 
 #define isInvalid(s) ((s) == NULL)
 
+/**
+ * Number of bits in each element of the data buffer. It's a constant, so 
+ * division and modulo below are compiled into shift and mask.
+ */
+#define EL_BITSET_WORD_BITS (sizeof(uintmax_t) << 3)
+#define wordIndex(nPos) ((nPos) / EL_BITSET_WORD_BITS)
+#define bitMask(nPos) ((uintmax_t)1 << ((nPos) % EL_BITSET_WORD_BITS))
+
 /**
  * Creates new empty bit set with the capacity not smaller than the specified 
  * one. C
@@ -50,6 +60,23 @@ bitset *elbitsetCreate(size_t nBitCapacityMin) {
 	return pThis;
 }
 
+/**
+ * Creates new empty dynamic bit set. Unlike the bit set created by 
+ * elbitsetCreate(), dynamic one grows when bits beyond its end are set 
+ * (capacity is at least doubled, so growth is amortized).
+ * @param  nBitCapacityMin Mimimal capacity required (may be zero).
+ * @return                 Newly created bit set (or NULL if an error occured).
+ */
+bitset *elbitsetCreateDynamic(size_t nBitCapacityMin) {
+	bitset *pThis = elbitsetCreate(nBitCapacityMin > 0 ? nBitCapacityMin : 1);
+	if(pThis == NULL)
+		return NULL;
+
+	pThis->bDynamic = true;
+
+	return pThis;
+}
+
 /**
  * Destroys the bit set.
  * @param pThis Bit set string to be destroyed.
@@ -58,9 +85,113 @@ void elbitsetDestroy(bitset *pThis) {
 	if(isInvalid(pThis))
 		return;
 
+	EL_FREE(pThis->pBuf);
 	EL_FREE(pThis);
 }
 
+/**
+ * Checks if the bit set is dynamic (grows when bits beyond its end are set).
+ * @param  pThis Bit set.
+ * @return       @b True if the bit set is dynamic, otherwise @b false.
+ */
+bool elbitsetIsDynamic(bitset *pThis) {
+	if(isInvalid(pThis))
+		return false;
+
+	return pThis->bDynamic;
+}
+
+/**
+ * Changes the number of words in data buffer. New words are cleared.
+ * @param  pThis     Bit set.
+ * @param  nCapacity New number of words (not zero).
+ * @return           @b True if succeeded, otherwise @b false.
+ */
+static bool elbitsetResize(bitset *pThis, size_t nCapacity) {
+	uintmax_t *pBufNew = EL_REALLOC(pThis->pBuf, nCapacity * sizeof(uintmax_t));
+	if(pBufNew == NULL)
+		return false;
+
+	if(nCapacity > pThis->nCapacity)
+		memset(pBufNew + pThis->nCapacity, 0, 
+			(nCapacity - pThis->nCapacity) * sizeof(uintmax_t));
+
+	pThis->pBuf = pBufNew;
+	pThis->nCapacity = nCapacity;
+
+	return true;
+}
+
+/**
+ * Makes sure the data buffer has at least specified number of words. Dynamic 
+ * bit set is grown at least twice, fixed one can't grow.
+ * @param  pThis        Bit set.
+ * @param  nCapacityMin Required number of words.
+ * @return              @b True if the data buffer is large enough, otherwise 
+ * @b false.
+ */
+static bool elbitsetGrow(bitset *pThis, size_t nCapacityMin) {
+	if(pThis->nCapacity >= nCapacityMin)
+		return true;
+
+	if(!pThis->bDynamic)
+		return false;
+
+	size_t nCapacity = pThis->nCapacity * 2;
+	if(nCapacity < nCapacityMin)
+		nCapacity = nCapacityMin;
+
+	return elbitsetResize(pThis, nCapacity);
+}
+
+/**
+ * Changes capacity of the dynamic bit set to ensure that it can hold at least 
+ * nBitCapacityMin bits. If current capacity is enough - does nothing. 
+ * Capacity of fixed bit sets can't be changed.
+ * @param  pThis           Bit set.
+ * @param  nBitCapacityMin Required capacity in bits.
+ * @return                 @b True if the bit set can hold required number of 
+ * bits, otherwise @b false.
+ */
+bool elbitsetEnsureCapacity(bitset *pThis, size_t nBitCapacityMin) {
+	if(isInvalid(pThis))
+		return false;
+
+	size_t nCapacityMin = nBitCapacityMin / EL_BITSET_WORD_BITS + 
+		(nBitCapacityMin % EL_BITSET_WORD_BITS != 0);
+	if(pThis->nCapacity >= nCapacityMin)
+		return true;
+
+	if(!pThis->bDynamic)
+		return false;
+
+	return elbitsetResize(pThis, nCapacityMin);
+}
+
+/**
+ * Truncates the data buffer of dynamic bit set after its highest bit which is 
+ * set (at least one word is kept). Does nothing on fixed bit sets as their 
+ * capacity can't be changed.
+ * @param  pThis Bit set.
+ * @return       @b True if succeeded, otherwise @b false.
+ */
+bool elbitsetRemoveExtraCapacity(bitset *pThis) {
+	if(isInvalid(pThis))
+		return false;
+
+	if(!pThis->bDynamic)
+		return true;
+
+	size_t nCapacity = pThis->nCapacity;
+	while(nCapacity > 1 && pThis->pBuf[nCapacity - 1] == 0)
+		nCapacity--;
+
+	if(nCapacity == pThis->nCapacity)
+		return true;
+
+	return elbitsetResize(pThis, nCapacity);
+}
+
 /**
  * Returns the total number of bits this bit set may hold.
  * @param  pThis Bit set.
@@ -82,19 +213,12 @@ size_t elbitsetGetCount(bitset *pThis) {
 	if(isInvalid(pThis))
 		return 0;
 
-	size_t nCount = 0;
-	uintmax_t *pEnd = pThis->pBuf + pThis->nCapacity;
-	for(uintmax_t *pCur = pThis->pBuf; pCur < pEnd; pCur++) {
-		uintmax_t nV = *pCur;
-		for (; nV; nCount++)
-			nV &= nV - 1; // clear the least significant bit set
-	}
-
-	return nCount;
+	return elbitopsCount(pThis->pBuf, pThis->nCapacity);
 }
 
 /**
- * Sets the bit at the specified position.
+ * Sets the bit at the specified position. Dynamic bit set grows if the 
+ * position is beyond its end, fixed one ignores such positions.
  * @param pThis Bit set.
  * @param nPos  Position of the bit.
  */
@@ -102,12 +226,11 @@ void elbitsetSet(bitset *pThis, size_t nPos) {
 	if(isInvalid(pThis))
 		return;
 
-	size_t nIndex = nPos / pThis->nBitsPerElement;
-	if(nIndex >= pThis->nCapacity)
+	size_t nIndex = wordIndex(nPos);
+	if(!elbitsetGrow(pThis, nIndex + 1))
 		return;
 
-	uintmax_t nValue = 1;
-	nValue <<= (nPos % pThis->nBitsPerElement);
+	uintmax_t nValue = bitMask(nPos);
 
 	pThis->pBuf[nIndex] |= nValue;
 }
@@ -132,12 +255,11 @@ void elbitsetReset(bitset *pThis, size_t nPos) {
 	if(isInvalid(pThis))
 		return;
 
-	size_t nIndex = nPos / pThis->nBitsPerElement;
+	size_t nIndex = wordIndex(nPos);
 	if(nIndex >= pThis->nCapacity)
 		return;
 
-	uintmax_t nValue = 1;
-	nValue <<= (nPos % pThis->nBitsPerElement);
+	uintmax_t nValue = bitMask(nPos);
 
 	pThis->pBuf[nIndex] &= ~nValue;
 }
@@ -154,17 +276,20 @@ void elbitsetResetAll(bitset *pThis) {
 }
 
 /**
- * Flips value of specified bit converting zero into one and one into zero.
- * @param pThis [description]
+ * Flips value of specified bit converting zero into one and one into zero. 
+ * Dynamic bit set grows if the position is beyond its end.
+ * @param pThis Bit set.
  * @param nPos  Position of the bit.
  */
 void elbitsetFlip(bitset *pThis, size_t nPos) {
-	size_t nIndex = nPos / pThis->nBitsPerElement;
-	if(nIndex >= pThis->nCapacity)
+	if(isInvalid(pThis))
+		return;
+
+	size_t nIndex = wordIndex(nPos);
+	if(!elbitsetGrow(pThis, nIndex + 1))
 		return;
 
-	uintmax_t nValue = 1;
-	nValue <<= (nPos % pThis->nBitsPerElement);
+	uintmax_t nValue = bitMask(nPos);
 
 	pThis->pBuf[nIndex] ^= nValue;
 }
@@ -174,12 +299,10 @@ void elbitsetFlip(bitset *pThis, size_t nPos) {
  * @param pThis Bit set.
  */
 void elbitsetFlipAll(bitset *pThis) {
-	uintmax_t nValue = 0;
-	nValue = ~nValue;
+	if(isInvalid(pThis))
+		return;
 
-	uintmax_t *pEnd = pThis->pBuf + pThis->nCapacity;
-	for(uintmax_t *pCur = pThis->pBuf; pCur < pEnd; pCur++)
-		*pCur ^= nValue;
+	elbitopsFlip(pThis->pBuf, pThis->nCapacity);
 }
 
 /**
@@ -191,12 +314,11 @@ bool elbitsetTest(bitset *pThis, size_t nPos) {
 	if(isInvalid(pThis))
 		return false;
 
-	size_t nIndex = nPos / pThis->nBitsPerElement;
+	size_t nIndex = wordIndex(nPos);
 	if(nIndex >= pThis->nCapacity)
 		return false;
 
-	uintmax_t nValue = 1;
-	nValue <<= (nPos % pThis->nBitsPerElement);
+	uintmax_t nValue = bitMask(nPos);
 
 	return (pThis->pBuf[nIndex] & nValue) != (uintmax_t)0;
 }
@@ -210,12 +332,7 @@ bool elbitsetAny(bitset *pThis) {
 	if(isInvalid(pThis))
 		return false;
 
-	uintmax_t *pEnd = pThis->pBuf + pThis->nCapacity;
-	for(uintmax_t *pCur = pThis->pBuf; pCur < pEnd; pCur++)
-		if(*pCur != 0)
-			return true;
-
-	return false;
+	return elbitopsAny(pThis->pBuf, pThis->nCapacity);
 }
 
 /**
@@ -243,8 +360,7 @@ bool elstrIsEqualTo(bitset *pThis, bitset *pOther) {
 		return false;
 
 	if(pThis->nCapacity == pOther->nCapacity) {
-		return memcmp(pThis->pBuf, pOther->pBuf, 
-			pThis->nCapacity * sizeof(uintmax_t)) == 0;
+		return elbitopsEqual(pThis->pBuf, pOther->pBuf, pThis->nCapacity);
 	} else
 		return false;
 }
@@ -268,31 +384,1052 @@ bool elstrIsEqualToEx(bitset *pThis, bitset *pOther) {
 		return false;
 
 	if(pThis->nCapacity == pOther->nCapacity) {
-		return memcmp(pThis->pBuf, pOther->pBuf, 
-			pThis->nCapacity * sizeof(uintmax_t)) == 0;
+		return elbitopsEqual(pThis->pBuf, pOther->pBuf, pThis->nCapacity);
 	} else {
 		size_t nCapacityMin;
 		uintmax_t *pCur;
-		uintmax_t *pEnd;
+		size_t nCountRest;
 
 		if(pThis->nCapacity < pOther->nCapacity) {
 			nCapacityMin = pThis->nCapacity;
 			pCur = pOther->pBuf + nCapacityMin;
-			pEnd = pOther->pBuf + pOther->nCapacity;
+			nCountRest = pOther->nCapacity - nCapacityMin;
 		} else {
 			nCapacityMin = pOther->nCapacity;
 			pCur = pThis->pBuf + nCapacityMin;
-			pEnd = pThis->pBuf + pThis->nCapacity;
+			nCountRest = pThis->nCapacity - nCapacityMin;
 		}
 
-		if(memcmp(pThis->pBuf, pOther->pBuf, 
-			nCapacityMin * sizeof(uintmax_t)) != 0)
+		if(!elbitopsEqual(pThis->pBuf, pOther->pBuf, nCapacityMin))
 			return false;
 		// If at least one bit after the end of smallest buffer is set, bit sets 
 		//   are different.
-		for(; pCur < pEnd; pCur++)
-			if(*pCur != 0)
-				return false;
+		if(elbitopsAny(pCur, nCountRest))
+			return false;
 	}
 	return true;
 }
+
+/**
+ * Creates new empty bit set having exactly the specified number of words.
+ * @param  nCapacity Number of words.
+ * @return           Newly created bit set (or NULL if an error occured).
+ */
+static bitset *elbitsetCreateWords(size_t nCapacity) {
+	return elbitsetCreate(nCapacity * (sizeof(uintmax_t) << 3));
+}
+
+/**
+ * Replaces the bit set with its intersection with another bit set. Bits 
+ * beyond the end of another bit set are treated as zeros, so they are cleared.
+ * @param  pThis  Bit set.
+ * @param  pOther Another bit set.
+ * @return        @b True if succeeded, otherwise @b false.
+ */
+bool elbitsetAnd(bitset *pThis, bitset *pOther) {
+	if(isInvalid(pThis) || isInvalid(pOther))
+		return false;
+
+	size_t nCapacityMin = pThis->nCapacity < pOther->nCapacity ? 
+		pThis->nCapacity : pOther->nCapacity;
+
+	elbitopsAnd(pThis->pBuf, pThis->pBuf, pOther->pBuf, nCapacityMin);
+	memset(pThis->pBuf + nCapacityMin, 0, 
+		(pThis->nCapacity - nCapacityMin) * sizeof(uintmax_t));
+
+	return true;
+}
+
+/**
+ * Replaces the bit set with its union with another bit set. Dynamic bit set 
+ * grows to the size of another one, otherwise bits of another bit set which 
+ * are beyond the end of this bit set are ignored.
+ * @param  pThis  Bit set.
+ * @param  pOther Another bit set.
+ * @return        @b True if succeeded, otherwise @b false.
+ */
+bool elbitsetOr(bitset *pThis, bitset *pOther) {
+	if(isInvalid(pThis) || isInvalid(pOther))
+		return false;
+
+	if(pThis->bDynamic && !elbitsetGrow(pThis, pOther->nCapacity))
+		return false;
+
+	size_t nCapacityMin = pThis->nCapacity < pOther->nCapacity ? 
+		pThis->nCapacity : pOther->nCapacity;
+
+	elbitopsOr(pThis->pBuf, pThis->pBuf, pOther->pBuf, nCapacityMin);
+
+	return true;
+}
+
+/**
+ * Replaces the bit set with its symmetric difference with another bit set. 
+ * Dynamic bit set grows to the size of another one, otherwise bits of another 
+ * bit set which are beyond the end of this bit set are ignored.
+ * @param  pThis  Bit set.
+ * @param  pOther Another bit set.
+ * @return        @b True if succeeded, otherwise @b false.
+ */
+bool elbitsetXor(bitset *pThis, bitset *pOther) {
+	if(isInvalid(pThis) || isInvalid(pOther))
+		return false;
+
+	if(pThis->bDynamic && !elbitsetGrow(pThis, pOther->nCapacity))
+		return false;
+
+	size_t nCapacityMin = pThis->nCapacity < pOther->nCapacity ? 
+		pThis->nCapacity : pOther->nCapacity;
+
+	elbitopsXor(pThis->pBuf, pThis->pBuf, pOther->pBuf, nCapacityMin);
+
+	return true;
+}
+
+/**
+ * Clears all bits of the bit set which are set in another bit set. Bits 
+ * beyond the end of another bit set are treated as zeros, so they are kept.
+ * @param  pThis  Bit set.
+ * @param  pOther Another bit set.
+ * @return        @b True if succeeded, otherwise @b false.
+ */
+bool elbitsetAndNot(bitset *pThis, bitset *pOther) {
+	if(isInvalid(pThis) || isInvalid(pOther))
+		return false;
+
+	size_t nCapacityMin = pThis->nCapacity < pOther->nCapacity ? 
+		pThis->nCapacity : pOther->nCapacity;
+
+	elbitopsAndNot(pThis->pBuf, pThis->pBuf, pOther->pBuf, nCapacityMin);
+
+	return true;
+}
+
+/**
+ * Creates new bit set which is an intersection of two bit sets. The size of 
+ * the new bit set is the size of the smaller one.
+ * @param  pFirst  First bit set.
+ * @param  pSecond Second bit set.
+ * @return         Newly created bit set (or NULL if an error occured).
+ */
+bitset *elbitsetCreateAnd(bitset *pFirst, bitset *pSecond) {
+	if(isInvalid(pFirst) || isInvalid(pSecond))
+		return NULL;
+
+	size_t nCapacityMin = pFirst->nCapacity < pSecond->nCapacity ? 
+		pFirst->nCapacity : pSecond->nCapacity;
+
+	bitset *pResult = elbitsetCreateWords(nCapacityMin);
+	if(pResult == NULL)
+		return NULL;
+
+	elbitopsAnd(pResult->pBuf, pFirst->pBuf, pSecond->pBuf, nCapacityMin);
+
+	return pResult;
+}
+
+/**
+ * Creates new bit set combining two bit sets with operation applied to 
+ * common words. Remaining words of the larger bit set are copied (that's 
+ * the result of OR and XOR with zeros).
+ * @param  pFirst  First bit set.
+ * @param  pSecond Second bit set.
+ * @param  combine Function combining common words.
+ * @return         Newly created bit set (or NULL if an error occured).
+ */
+static bitset *elbitsetCreateCombined(bitset *pFirst, bitset *pSecond, 
+	void (*combine)(uintmax_t *, const uintmax_t *, const uintmax_t *, 
+		size_t)) {
+
+	if(isInvalid(pFirst) || isInvalid(pSecond))
+		return NULL;
+
+	bitset *pLarger = pFirst->nCapacity >= pSecond->nCapacity ? 
+		pFirst : pSecond;
+	size_t nCapacityMin = pFirst->nCapacity < pSecond->nCapacity ? 
+		pFirst->nCapacity : pSecond->nCapacity;
+
+	bitset *pResult = elbitsetCreateWords(pLarger->nCapacity);
+	if(pResult == NULL)
+		return NULL;
+
+	combine(pResult->pBuf, pFirst->pBuf, pSecond->pBuf, nCapacityMin);
+	memcpy(pResult->pBuf + nCapacityMin, pLarger->pBuf + nCapacityMin, 
+		(pLarger->nCapacity - nCapacityMin) * sizeof(uintmax_t));
+
+	return pResult;
+}
+
+/**
+ * Creates new bit set which is an union of two bit sets. The size of the new 
+ * bit set is the size of the larger one.
+ * @param  pFirst  First bit set.
+ * @param  pSecond Second bit set.
+ * @return         Newly created bit set (or NULL if an error occured).
+ */
+bitset *elbitsetCreateOr(bitset *pFirst, bitset *pSecond) {
+	return elbitsetCreateCombined(pFirst, pSecond, elbitopsOr);
+}
+
+/**
+ * Creates new bit set which is a symmetric difference of two bit sets. The 
+ * size of the new bit set is the size of the larger one.
+ * @param  pFirst  First bit set.
+ * @param  pSecond Second bit set.
+ * @return         Newly created bit set (or NULL if an error occured).
+ */
+bitset *elbitsetCreateXor(bitset *pFirst, bitset *pSecond) {
+	return elbitsetCreateCombined(pFirst, pSecond, elbitopsXor);
+}
+
+/**
+ * Creates new bit set containing bits of the first bit set which are not set 
+ * in the second one. The size of the new bit set is the size of the first one.
+ * @param  pFirst  First bit set.
+ * @param  pSecond Second bit set.
+ * @return         Newly created bit set (or NULL if an error occured).
+ */
+bitset *elbitsetCreateAndNot(bitset *pFirst, bitset *pSecond) {
+	if(isInvalid(pFirst) || isInvalid(pSecond))
+		return NULL;
+
+	size_t nCapacityMin = pFirst->nCapacity < pSecond->nCapacity ? 
+		pFirst->nCapacity : pSecond->nCapacity;
+
+	bitset *pResult = elbitsetCreateWords(pFirst->nCapacity);
+	if(pResult == NULL)
+		return NULL;
+
+	elbitopsAndNot(pResult->pBuf, pFirst->pBuf, pSecond->pBuf, nCapacityMin);
+	memcpy(pResult->pBuf + nCapacityMin, pFirst->pBuf + nCapacityMin, 
+		(pFirst->nCapacity - nCapacityMin) * sizeof(uintmax_t));
+
+	return pResult;
+}
+
+/**
+ * Returns the number of bits which are set in both bit sets (the size of 
+ * intersection). No temporary bit set is created.
+ * @param  pFirst  First bit set.
+ * @param  pSecond Second bit set.
+ * @return         Number of bits set in both bit sets.
+ */
+size_t elbitsetGetCountAnd(bitset *pFirst, bitset *pSecond) {
+	if(isInvalid(pFirst) || isInvalid(pSecond))
+		return 0;
+
+	size_t nCapacityMin = pFirst->nCapacity < pSecond->nCapacity ? 
+		pFirst->nCapacity : pSecond->nCapacity;
+
+	return elbitopsCountAnd(pFirst->pBuf, pSecond->pBuf, nCapacityMin);
+}
+
+/**
+ * Counts bits set in the result of operation over two bit sets. Remaining 
+ * words of the larger bit set are counted as is (that's the result of OR and 
+ * XOR with zeros).
+ * @param  pFirst  First bit set.
+ * @param  pSecond Second bit set.
+ * @param  count   Function counting bits over common words.
+ * @return         Number of bits set.
+ */
+static size_t elbitsetGetCountCombined(bitset *pFirst, bitset *pSecond, 
+	size_t (*count)(const uintmax_t *, const uintmax_t *, size_t)) {
+
+	if(isInvalid(pFirst) || isInvalid(pSecond))
+		return 0;
+
+	bitset *pLarger = pFirst->nCapacity >= pSecond->nCapacity ? 
+		pFirst : pSecond;
+	size_t nCapacityMin = pFirst->nCapacity < pSecond->nCapacity ? 
+		pFirst->nCapacity : pSecond->nCapacity;
+
+	return count(pFirst->pBuf, pSecond->pBuf, nCapacityMin) + 
+		elbitopsCount(pLarger->pBuf + nCapacityMin, 
+			pLarger->nCapacity - nCapacityMin);
+}
+
+/**
+ * Returns the number of bits which are set in any of bit sets (the size of 
+ * union). No temporary bit set is created.
+ * @param  pFirst  First bit set.
+ * @param  pSecond Second bit set.
+ * @return         Number of bits set in any of bit sets.
+ */
+size_t elbitsetGetCountOr(bitset *pFirst, bitset *pSecond) {
+	return elbitsetGetCountCombined(pFirst, pSecond, elbitopsCountOr);
+}
+
+/**
+ * Returns the Hamming distance between two bit sets (number of positions at 
+ * which bits are different). No temporary bit set is created.
+ * @param  pFirst  First bit set.
+ * @param  pSecond Second bit set.
+ * @return         Hamming distance.
+ */
+size_t elbitsetGetHammingDistance(bitset *pFirst, bitset *pSecond) {
+	return elbitsetGetCountCombined(pFirst, pSecond, elbitopsCountXor);
+}
+
+/**
+ * Returns the Jaccard index of two bit sets (size of intersection divided by 
+ * size of union). Two empty bit sets are considered to be equal, so their 
+ * index is 1. No temporary bit set is created.
+ * @param  pFirst  First bit set.
+ * @param  pSecond Second bit set.
+ * @return         Jaccard index from 0 to 1 (or 0 if an error occured).
+ */
+double elbitsetGetJaccardIndex(bitset *pFirst, bitset *pSecond) {
+	if(isInvalid(pFirst) || isInvalid(pSecond))
+		return 0.0;
+
+	size_t nCountOr = elbitsetGetCountOr(pFirst, pSecond);
+	if(nCountOr == 0)
+		return 1.0;
+
+	return (double)elbitsetGetCountAnd(pFirst, pSecond) / (double)nCountOr;
+}
+
+/**
+ * Returns the position of the first bit which is set.
+ * @param  pThis Bit set.
+ * @return       Position of the bit or EL_BITSET_NPOS if no bits are set.
+ */
+size_t elbitsetFindFirst(bitset *pThis) {
+	if(isInvalid(pThis))
+		return EL_BITSET_NPOS;
+
+	return elbitopsFindNext(pThis->pBuf, pThis->nCapacity, 0, true);
+}
+
+/**
+ * Returns the position of the first bit which is set after the specified 
+ * position.
+ * @param  pThis Bit set.
+ * @param  nPos  Position of the bit to start search after.
+ * @return       Position of the bit or EL_BITSET_NPOS if there's no such bit.
+ */
+size_t elbitsetFindNext(bitset *pThis, size_t nPos) {
+	if(isInvalid(pThis) || nPos == EL_BITSET_NPOS)
+		return EL_BITSET_NPOS;
+
+	return elbitopsFindNext(pThis->pBuf, pThis->nCapacity, nPos + 1, true);
+}
+
+/**
+ * Returns the position of the last bit which is set.
+ * @param  pThis Bit set.
+ * @return       Position of the bit or EL_BITSET_NPOS if no bits are set.
+ */
+size_t elbitsetFindLast(bitset *pThis) {
+	if(isInvalid(pThis))
+		return EL_BITSET_NPOS;
+
+	return elbitopsFindPrev(pThis->pBuf, pThis->nCapacity, EL_BITSET_NPOS, 
+		true);
+}
+
+/**
+ * Returns the position of the last bit which is set before the specified 
+ * position.
+ * @param  pThis Bit set.
+ * @param  nPos  Position of the bit to start search before.
+ * @return       Position of the bit or EL_BITSET_NPOS if there's no such bit.
+ */
+size_t elbitsetFindPrev(bitset *pThis, size_t nPos) {
+	if(isInvalid(pThis) || nPos == 0)
+		return EL_BITSET_NPOS;
+
+	return elbitopsFindPrev(pThis->pBuf, pThis->nCapacity, nPos - 1, true);
+}
+
+/**
+ * Returns the position of the first bit which is not set.
+ * @param  pThis Bit set.
+ * @return       Position of the bit or EL_BITSET_NPOS if all bits are set.
+ */
+size_t elbitsetFindFirstUnset(bitset *pThis) {
+	if(isInvalid(pThis))
+		return EL_BITSET_NPOS;
+
+	return elbitopsFindNext(pThis->pBuf, pThis->nCapacity, 0, false);
+}
+
+/**
+ * Returns the position of the first bit which is not set after the specified 
+ * position.
+ * @param  pThis Bit set.
+ * @param  nPos  Position of the bit to start search after.
+ * @return       Position of the bit or EL_BITSET_NPOS if there's no such bit.
+ */
+size_t elbitsetFindNextUnset(bitset *pThis, size_t nPos) {
+	if(isInvalid(pThis) || nPos == EL_BITSET_NPOS)
+		return EL_BITSET_NPOS;
+
+	return elbitopsFindNext(pThis->pBuf, pThis->nCapacity, nPos + 1, false);
+}
+
+/**
+ * Returns the position of the last bit which is not set.
+ * @param  pThis Bit set.
+ * @return       Position of the bit or EL_BITSET_NPOS if all bits are set.
+ */
+size_t elbitsetFindLastUnset(bitset *pThis) {
+	if(isInvalid(pThis))
+		return EL_BITSET_NPOS;
+
+	return elbitopsFindPrev(pThis->pBuf, pThis->nCapacity, EL_BITSET_NPOS, 
+		false);
+}
+
+/**
+ * Returns the position of the last bit which is not set before the specified 
+ * position.
+ * @param  pThis Bit set.
+ * @param  nPos  Position of the bit to start search before.
+ * @return       Position of the bit or EL_BITSET_NPOS if there's no such bit.
+ */
+size_t elbitsetFindPrevUnset(bitset *pThis, size_t nPos) {
+	if(isInvalid(pThis) || nPos == 0)
+		return EL_BITSET_NPOS;
+
+	return elbitopsFindPrev(pThis->pBuf, pThis->nCapacity, nPos - 1, false);
+}
+
+/**
+ * Number of positions extracted at once by foreach enumerators.
+ */
+#define EL_BITSET_FOREACH_BATCH	256
+
+/**
+ * Iterates through the bits which are set in ascending order and calls 
+ * specified function for each of them. If function returns @b false - stops 
+ * iteration. Work is proportional to the number of bits set (plus the number 
+ * of words), not to the size of the bit set.
+ * @param pThis       Bit set.
+ * @param bitCallback Callback function to be called for each bit set.
+ */
+void elbitsetForEach(bitset *pThis, bool (*bitCallback)(size_t nPos)) {
+	if(isInvalid(pThis))
+		return;
+
+	if(bitCallback == NULL)
+		return;
+
+	uint64_t arrPositions[EL_BITSET_FOREACH_BATCH];
+	size_t nWordsPerBatch = EL_BITSET_FOREACH_BATCH / pThis->nBitsPerElement;
+
+	for(size_t i = 0; i < pThis->nCapacity; i += nWordsPerBatch) {
+		size_t nWords = pThis->nCapacity - i < nWordsPerBatch ? 
+			pThis->nCapacity - i : nWordsPerBatch;
+		size_t nCount = elbitopsExtract64(pThis->pBuf + i, nWords, 
+			i * pThis->nBitsPerElement, arrPositions, EL_BITSET_FOREACH_BATCH);
+
+		for(size_t j = 0; j < nCount; j++) {
+			if(!bitCallback((size_t)arrPositions[j]))
+				return;
+		}
+	}
+}
+
+/**
+ * Iterates through the bits which are set in ascending order and calls 
+ * specified function for each of them. Passes the pointer to custom data to 
+ * the callback function. If function returns @b false - stops iteration.
+ * @param pThis         Bit set.
+ * @param bitCallbackEx Callback function to be called for each bit set.
+ * @param pEx           Pointer to custom data to be sent to callback.
+ */
+void elbitsetForEachEx(bitset *pThis, 
+	bool (*bitCallbackEx)(size_t nPos, void *pEx), void *pEx) {
+
+	if(isInvalid(pThis))
+		return;
+
+	if(bitCallbackEx == NULL)
+		return;
+
+	uint64_t arrPositions[EL_BITSET_FOREACH_BATCH];
+	size_t nWordsPerBatch = EL_BITSET_FOREACH_BATCH / pThis->nBitsPerElement;
+
+	for(size_t i = 0; i < pThis->nCapacity; i += nWordsPerBatch) {
+		size_t nWords = pThis->nCapacity - i < nWordsPerBatch ? 
+			pThis->nCapacity - i : nWordsPerBatch;
+		size_t nCount = elbitopsExtract64(pThis->pBuf + i, nWords, 
+			i * pThis->nBitsPerElement, arrPositions, EL_BITSET_FOREACH_BATCH);
+
+		for(size_t j = 0; j < nCount; j++) {
+			if(!bitCallbackEx((size_t)arrPositions[j], pEx))
+				return;
+		}
+	}
+}
+
+/**
+ * Writes positions of the bits which are set into an array of 32-bit integers 
+ * in ascending order. Only positions which fit into 32 bits are written.
+ * @param  pThis        Bit set.
+ * @param  arrPositions Destination array.
+ * @param  nCountMax    Capacity of the destination array (use 
+ * elbitsetGetCount() to find out the capacity required).
+ * @return              Number of positions written.
+ */
+size_t elbitsetExtractPositions32(bitset *pThis, uint32_t *arrPositions, 
+	size_t nCountMax) {
+
+	if(isInvalid(pThis) || arrPositions == NULL)
+		return 0;
+
+	uint64_t nWordsMax = ((uint64_t)UINT32_MAX + 1) / pThis->nBitsPerElement;
+	size_t nWords = (uint64_t)pThis->nCapacity < nWordsMax ? 
+		pThis->nCapacity : (size_t)nWordsMax;
+
+	return elbitopsExtract32(pThis->pBuf, nWords, 0, arrPositions, nCountMax);
+}
+
+/**
+ * Writes positions of the bits which are set into an array of 64-bit integers 
+ * in ascending order.
+ * @param  pThis        Bit set.
+ * @param  arrPositions Destination array.
+ * @param  nCountMax    Capacity of the destination array (use 
+ * elbitsetGetCount() to find out the capacity required).
+ * @return              Number of positions written.
+ */
+size_t elbitsetExtractPositions64(bitset *pThis, uint64_t *arrPositions, 
+	size_t nCountMax) {
+
+	if(isInvalid(pThis) || arrPositions == NULL)
+		return 0;
+
+	return elbitopsExtract64(pThis->pBuf, pThis->nCapacity, 0, arrPositions, 
+		nCountMax);
+}
+
+/**
+ * Limits the range of positions [nFrom, nTo) by the size of the bit set and 
+ * computes masks of its first and last words.
+ * @param  pThis      Bit set.
+ * @param  nFrom      First position of the range.
+ * @param  pTo        Position after the last one (limited on return).
+ * @param  pMaskFirst Mask of bits of the range in its first word.
+ * @param  pMaskLast  Mask of bits of the range in its last word.
+ * @return            @b False if the range is empty, otherwise @b true.
+ */
+static bool elbitsetPrepareRange(bitset *pThis, size_t nFrom, size_t *pTo, 
+	uintmax_t *pMaskFirst, uintmax_t *pMaskLast) {
+
+	size_t nSize = pThis->nCapacity * EL_BITSET_WORD_BITS;
+	if(*pTo > nSize)
+		*pTo = nSize;
+	if(nFrom >= *pTo)
+		return false;
+
+	*pMaskFirst = UINTMAX_MAX << (nFrom % EL_BITSET_WORD_BITS);
+	*pMaskLast = UINTMAX_MAX >> 
+		(EL_BITSET_WORD_BITS - 1 - (*pTo - 1) % EL_BITSET_WORD_BITS);
+
+	return true;
+}
+
+/**
+ * Sets all bits in the range of positions [nFrom, nTo). Dynamic bit set 
+ * grows to hold the range, otherwise part of the range which is beyond the 
+ * end of the bit set is ignored.
+ * @param pThis Bit set.
+ * @param nFrom First position of the range.
+ * @param nTo   Position after the last one.
+ */
+void elbitsetSetRange(bitset *pThis, size_t nFrom, size_t nTo) {
+	uintmax_t nMaskFirst, nMaskLast;
+	if(isInvalid(pThis))
+		return;
+	if(pThis->bDynamic && nFrom < nTo && 
+		!elbitsetGrow(pThis, wordIndex(nTo - 1) + 1))
+		return;
+	if(!elbitsetPrepareRange(pThis, nFrom, &nTo, &nMaskFirst, &nMaskLast))
+		return;
+
+	size_t nFirst = wordIndex(nFrom);
+	size_t nLast = wordIndex(nTo - 1);
+	if(nFirst == nLast) {
+		pThis->pBuf[nFirst] |= nMaskFirst & nMaskLast;
+		return;
+	}
+
+	pThis->pBuf[nFirst] |= nMaskFirst;
+	memset(pThis->pBuf + nFirst + 1, 0xFF, 
+		(nLast - nFirst - 1) * sizeof(uintmax_t));
+	pThis->pBuf[nLast] |= nMaskLast;
+}
+
+/**
+ * Clears all bits in the range of positions [nFrom, nTo). Part of the range 
+ * which is beyond the end of the bit set is ignored.
+ * @param pThis Bit set.
+ * @param nFrom First position of the range.
+ * @param nTo   Position after the last one.
+ */
+void elbitsetResetRange(bitset *pThis, size_t nFrom, size_t nTo) {
+	uintmax_t nMaskFirst, nMaskLast;
+	if(isInvalid(pThis) || 
+		!elbitsetPrepareRange(pThis, nFrom, &nTo, &nMaskFirst, &nMaskLast))
+		return;
+
+	size_t nFirst = wordIndex(nFrom);
+	size_t nLast = wordIndex(nTo - 1);
+	if(nFirst == nLast) {
+		pThis->pBuf[nFirst] &= ~(nMaskFirst & nMaskLast);
+		return;
+	}
+
+	pThis->pBuf[nFirst] &= ~nMaskFirst;
+	memset(pThis->pBuf + nFirst + 1, 0, 
+		(nLast - nFirst - 1) * sizeof(uintmax_t));
+	pThis->pBuf[nLast] &= ~nMaskLast;
+}
+
+/**
+ * Flips all bits in the range of positions [nFrom, nTo). Dynamic bit set 
+ * grows to hold the range, otherwise part of the range which is beyond the 
+ * end of the bit set is ignored.
+ * @param pThis Bit set.
+ * @param nFrom First position of the range.
+ * @param nTo   Position after the last one.
+ */
+void elbitsetFlipRange(bitset *pThis, size_t nFrom, size_t nTo) {
+	uintmax_t nMaskFirst, nMaskLast;
+	if(isInvalid(pThis))
+		return;
+	if(pThis->bDynamic && nFrom < nTo && 
+		!elbitsetGrow(pThis, wordIndex(nTo - 1) + 1))
+		return;
+	if(!elbitsetPrepareRange(pThis, nFrom, &nTo, &nMaskFirst, &nMaskLast))
+		return;
+
+	size_t nFirst = wordIndex(nFrom);
+	size_t nLast = wordIndex(nTo - 1);
+	if(nFirst == nLast) {
+		pThis->pBuf[nFirst] ^= nMaskFirst & nMaskLast;
+		return;
+	}
+
+	pThis->pBuf[nFirst] ^= nMaskFirst;
+	elbitopsFlip(pThis->pBuf + nFirst + 1, nLast - nFirst - 1);
+	pThis->pBuf[nLast] ^= nMaskLast;
+}
+
+/**
+ * Checks if all bits in the range of positions [nFrom, nTo) are set. Part of 
+ * the range which is beyond the end of the bit set is ignored.
+ * @param  pThis Bit set.
+ * @param  nFrom First position of the range.
+ * @param  nTo   Position after the last one.
+ * @return       @b True if all bits of the range are set (or the range is 
+ * empty), otherwise @b false.
+ */
+bool elbitsetTestRangeAll(bitset *pThis, size_t nFrom, size_t nTo) {
+	uintmax_t nMaskFirst, nMaskLast;
+	if(isInvalid(pThis))
+		return false;
+	if(!elbitsetPrepareRange(pThis, nFrom, &nTo, &nMaskFirst, &nMaskLast))
+		return true;
+
+	return elbitopsFindNext(pThis->pBuf, wordIndex(nTo - 1) + 1, nFrom, 
+		false) >= nTo;
+}
+
+/**
+ * Checks if any bit in the range of positions [nFrom, nTo) is set. Part of 
+ * the range which is beyond the end of the bit set is ignored.
+ * @param  pThis Bit set.
+ * @param  nFrom First position of the range.
+ * @param  nTo   Position after the last one.
+ * @return       @b True if any bit of the range is set, otherwise @b false.
+ */
+bool elbitsetTestRangeAny(bitset *pThis, size_t nFrom, size_t nTo) {
+	uintmax_t nMaskFirst, nMaskLast;
+	if(isInvalid(pThis) || 
+		!elbitsetPrepareRange(pThis, nFrom, &nTo, &nMaskFirst, &nMaskLast))
+		return false;
+
+	return elbitopsFindNext(pThis->pBuf, wordIndex(nTo - 1) + 1, nFrom, 
+		true) < nTo;
+}
+
+/**
+ * Returns the number of bits which are set in the range of positions 
+ * [nFrom, nTo). Part of the range which is beyond the end of the bit set is 
+ * ignored.
+ * @param  pThis Bit set.
+ * @param  nFrom First position of the range.
+ * @param  nTo   Position after the last one.
+ * @return       Number of bits set in the range.
+ */
+size_t elbitsetGetCountRange(bitset *pThis, size_t nFrom, size_t nTo) {
+	uintmax_t nMaskFirst, nMaskLast;
+	if(isInvalid(pThis) || 
+		!elbitsetPrepareRange(pThis, nFrom, &nTo, &nMaskFirst, &nMaskLast))
+		return 0;
+
+	size_t nFirst = wordIndex(nFrom);
+	size_t nLast = wordIndex(nTo - 1);
+	uintmax_t nEdges[2];
+	if(nFirst == nLast) {
+		nEdges[0] = pThis->pBuf[nFirst] & nMaskFirst & nMaskLast;
+		return elbitopsCount(nEdges, 1);
+	}
+
+	nEdges[0] = pThis->pBuf[nFirst] & nMaskFirst;
+	nEdges[1] = pThis->pBuf[nLast] & nMaskLast;
+
+	return elbitopsCount(nEdges, 2) + 
+		elbitopsCount(pThis->pBuf + nFirst + 1, nLast - nFirst - 1);
+}
+
+/**
+ * Sets bits at the specified positions. Dynamic bit set grows to hold them, 
+ * otherwise positions which are beyond the end of the bit set are ignored. 
+ * Adjacent positions falling into the same word are merged into a single 
+ * update, so sorted positions are processed faster.
+ * @param pThis        Bit set.
+ * @param arrPositions An array of positions.
+ * @param nCount       Number of positions.
+ */
+void elbitsetSetBatch(bitset *pThis, const size_t *arrPositions, 
+	size_t nCount) {
+
+	if(isInvalid(pThis) || arrPositions == NULL)
+		return;
+
+	size_t i = 0;
+	while(i < nCount) {
+		size_t nIndex = wordIndex(arrPositions[i]);
+		uintmax_t nMask = bitMask(arrPositions[i]);
+		for(i++; i < nCount && wordIndex(arrPositions[i]) == nIndex; i++)
+			nMask |= bitMask(arrPositions[i]);
+
+		if(elbitsetGrow(pThis, nIndex + 1))
+			pThis->pBuf[nIndex] |= nMask;
+	}
+}
+
+/**
+ * Clears bits at the specified positions. Positions which are beyond the end 
+ * of the bit set are ignored. Adjacent positions falling into the same word 
+ * are merged into a single update, so sorted positions are processed faster.
+ * @param pThis        Bit set.
+ * @param arrPositions An array of positions.
+ * @param nCount       Number of positions.
+ */
+void elbitsetResetBatch(bitset *pThis, const size_t *arrPositions, 
+	size_t nCount) {
+
+	if(isInvalid(pThis) || arrPositions == NULL)
+		return;
+
+	size_t i = 0;
+	while(i < nCount) {
+		size_t nIndex = wordIndex(arrPositions[i]);
+		uintmax_t nMask = bitMask(arrPositions[i]);
+		for(i++; i < nCount && wordIndex(arrPositions[i]) == nIndex; i++)
+			nMask |= bitMask(arrPositions[i]);
+
+		if(nIndex < pThis->nCapacity)
+			pThis->pBuf[nIndex] &= ~nMask;
+	}
+}
+
+/**
+ * Checks bits at the specified positions. Positions which are beyond the end 
+ * of the bit set are treated as not set.
+ * @param  pThis        Bit set.
+ * @param  arrPositions An array of positions.
+ * @param  nCount       Number of positions.
+ * @param  arrResults   An array receiving the value of each bit (may be NULL 
+ * if only the number of bits set is required).
+ * @return              Number of positions where bits are set.
+ */
+size_t elbitsetTestBatch(bitset *pThis, const size_t *arrPositions, 
+	size_t nCount, bool *arrResults) {
+
+	if(isInvalid(pThis) || arrPositions == NULL)
+		return 0;
+
+	size_t nResult = 0;
+	for(size_t i = 0; i < nCount; i++) {
+		size_t nIndex = wordIndex(arrPositions[i]);
+		bool bValue = nIndex < pThis->nCapacity && 
+			(pThis->pBuf[nIndex] & bitMask(arrPositions[i])) != 0;
+
+		nResult += bValue;
+		if(arrResults != NULL)
+			arrResults[i] = bValue;
+	}
+
+	return nResult;
+}
+
+/**
+ * Data buffer word accessed atomically. Atomic word has the same size and 
+ * representation as the plain one, so atomic and plain functions share the 
+ * bit set layout.
+ */
+#define atomicWord(pThis, nIndex) \
+	((_Atomic uintmax_t *)(pThis)->pBuf + (nIndex))
+
+/**
+ * Atomically sets the bit and returns its previous value.
+ * @param  pThis  Bit set.
+ * @param  nPos   Position of the bit.
+ * @param  nOrder Memory order.
+ * @return        Previous value of the bit.
+ */
+static inline bool elbitsetAtomicFetchSet(bitset *pThis, size_t nPos, 
+	memory_order nOrder) {
+
+	size_t nIndex = wordIndex(nPos);
+	if(nIndex >= pThis->nCapacity)
+		return false;
+
+	uintmax_t nValue = bitMask(nPos);
+
+	return (atomic_fetch_or_explicit(atomicWord(pThis, nIndex), nValue, 
+		nOrder) & nValue) != 0;
+}
+
+/**
+ * Atomically clears the bit and returns its previous value.
+ * @param  pThis  Bit set.
+ * @param  nPos   Position of the bit.
+ * @param  nOrder Memory order.
+ * @return        Previous value of the bit.
+ */
+static inline bool elbitsetAtomicFetchReset(bitset *pThis, size_t nPos, 
+	memory_order nOrder) {
+
+	size_t nIndex = wordIndex(nPos);
+	if(nIndex >= pThis->nCapacity)
+		return false;
+
+	uintmax_t nValue = bitMask(nPos);
+
+	return (atomic_fetch_and_explicit(atomicWord(pThis, nIndex), ~nValue, 
+		nOrder) & nValue) != 0;
+}
+
+/**
+ * Atomically sets the bit at the specified position, so that the bit set can 
+ * be updated by many threads at once. Positions beyond the end of the bit set 
+ * are ignored (even dynamic bit set doesn't grow, as it can't be reallocated 
+ * concurrently). The update is a release operation.
+ * @param pThis Bit set.
+ * @param nPos  Position of the bit.
+ */
+void elbitsetAtomicSet(bitset *pThis, size_t nPos) {
+	if(isInvalid(pThis))
+		return;
+
+	elbitsetAtomicFetchSet(pThis, nPos, memory_order_release);
+}
+
+/**
+ * Atomically sets the bit at the specified position. Same as 
+ * elbitsetAtomicSet() but doesn't order other memory accesses.
+ * @param pThis Bit set.
+ * @param nPos  Position of the bit.
+ */
+void elbitsetAtomicSetRelaxed(bitset *pThis, size_t nPos) {
+	if(isInvalid(pThis))
+		return;
+
+	elbitsetAtomicFetchSet(pThis, nPos, memory_order_relaxed);
+}
+
+/**
+ * Atomically clears the bit at the specified position. Positions beyond the 
+ * end of the bit set are ignored. The update is a release operation.
+ * @param pThis Bit set.
+ * @param nPos  Position of the bit.
+ */
+void elbitsetAtomicReset(bitset *pThis, size_t nPos) {
+	if(isInvalid(pThis))
+		return;
+
+	elbitsetAtomicFetchReset(pThis, nPos, memory_order_release);
+}
+
+/**
+ * Atomically clears the bit at the specified position. Same as 
+ * elbitsetAtomicReset() but doesn't order other memory accesses.
+ * @param pThis Bit set.
+ * @param nPos  Position of the bit.
+ */
+void elbitsetAtomicResetRelaxed(bitset *pThis, size_t nPos) {
+	if(isInvalid(pThis))
+		return;
+
+	elbitsetAtomicFetchReset(pThis, nPos, memory_order_relaxed);
+}
+
+/**
+ * Atomically sets the bit at the specified position and returns its previous 
+ * value. Exactly one of the threads setting the same bit concurrently gets 
+ * @b false, so it can be used to claim an item (e.g. to mark it visited). The 
+ * update is an acquire-release operation.
+ * @param  pThis Bit set.
+ * @param  nPos  Position of the bit.
+ * @return       Previous value of the bit (@b false if the position is beyond 
+ * the end of the bit set).
+ */
+bool elbitsetAtomicTestAndSet(bitset *pThis, size_t nPos) {
+	if(isInvalid(pThis))
+		return false;
+
+	return elbitsetAtomicFetchSet(pThis, nPos, memory_order_acq_rel);
+}
+
+/**
+ * Atomically sets the bit at the specified position and returns its previous 
+ * value. Same as elbitsetAtomicTestAndSet() but doesn't order other memory 
+ * accesses.
+ * @param  pThis Bit set.
+ * @param  nPos  Position of the bit.
+ * @return       Previous value of the bit.
+ */
+bool elbitsetAtomicTestAndSetRelaxed(bitset *pThis, size_t nPos) {
+	if(isInvalid(pThis))
+		return false;
+
+	return elbitsetAtomicFetchSet(pThis, nPos, memory_order_relaxed);
+}
+
+/**
+ * Atomically clears the bit at the specified position and returns its 
+ * previous value. The update is an acquire-release operation.
+ * @param  pThis Bit set.
+ * @param  nPos  Position of the bit.
+ * @return       Previous value of the bit.
+ */
+bool elbitsetAtomicTestAndReset(bitset *pThis, size_t nPos) {
+	if(isInvalid(pThis))
+		return false;
+
+	return elbitsetAtomicFetchReset(pThis, nPos, memory_order_acq_rel);
+}
+
+/**
+ * Atomically clears the bit at the specified position and returns its 
+ * previous value. Same as elbitsetAtomicTestAndReset() but doesn't order 
+ * other memory accesses.
+ * @param  pThis Bit set.
+ * @param  nPos  Position of the bit.
+ * @return       Previous value of the bit.
+ */
+bool elbitsetAtomicTestAndResetRelaxed(bitset *pThis, size_t nPos) {
+	if(isInvalid(pThis))
+		return false;
+
+	return elbitsetAtomicFetchReset(pThis, nPos, memory_order_relaxed);
+}
+
+/**
+ * Atomically checks if the bit at specified position is set. The read is an 
+ * acquire operation, so data published before elbitsetAtomicSet() of the bit 
+ * is visible after the bit is seen set.
+ * @param  pThis Bit set.
+ * @param  nPos  Position of the bit.
+ * @return       @b True if the bit is set, otherwise @b false.
+ */
+bool elbitsetAtomicTest(bitset *pThis, size_t nPos) {
+	if(isInvalid(pThis))
+		return false;
+
+	size_t nIndex = wordIndex(nPos);
+	if(nIndex >= pThis->nCapacity)
+		return false;
+
+	return (atomic_load_explicit(atomicWord(pThis, nIndex), 
+		memory_order_acquire) & bitMask(nPos)) != 0;
+}
+
+/**
+ * Atomically checks if the bit at specified position is set. Same as 
+ * elbitsetAtomicTest() but doesn't order other memory accesses.
+ * @param  pThis Bit set.
+ * @param  nPos  Position of the bit.
+ * @return       @b True if the bit is set, otherwise @b false.
+ */
+bool elbitsetAtomicTestRelaxed(bitset *pThis, size_t nPos) {
+	if(isInvalid(pThis))
+		return false;
+
+	size_t nIndex = wordIndex(nPos);
+	if(nIndex >= pThis->nCapacity)
+		return false;
+
+	return (atomic_load_explicit(atomicWord(pThis, nIndex), 
+		memory_order_relaxed) & bitMask(nPos)) != 0;
+}
+
+/**
+ * Atomically sets bits at the specified positions. Positions beyond the end 
+ * of the bit set are ignored. Adjacent positions falling into the same word 
+ * are merged into a single atomic update, so sorted positions are processed 
+ * faster and cause less contention.
+ * @param pThis        Bit set.
+ * @param arrPositions An array of positions.
+ * @param nCount       Number of positions.
+ */
+void elbitsetAtomicSetBatch(bitset *pThis, const size_t *arrPositions, 
+	size_t nCount) {
+
+	if(isInvalid(pThis) || arrPositions == NULL)
+		return;
+
+	size_t i = 0;
+	while(i < nCount) {
+		size_t nIndex = wordIndex(arrPositions[i]);
+		uintmax_t nMask = bitMask(arrPositions[i]);
+		for(i++; i < nCount && wordIndex(arrPositions[i]) == nIndex; i++)
+			nMask |= bitMask(arrPositions[i]);
+
+		if(nIndex < pThis->nCapacity)
+			atomic_fetch_or_explicit(atomicWord(pThis, nIndex), nMask, 
+				memory_order_release);
+	}
+}
+
+/**
+ * Number of words copied at once by elbitsetAtomicGetCount().
+ */
+#define EL_BITSET_ATOMIC_COUNT_BATCH	64
+
+/**
+ * Returns the number of bits which are set while other threads may update 
+ * the bit set. Each word is read atomically exactly once, so the function is 
+ * wait-free; the result is exact for bits which don't change during the call.
+ * @param  pThis Bit set.
+ * @return       Number of bits set.
+ */
+size_t elbitsetAtomicGetCount(bitset *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	uintmax_t arrWords[EL_BITSET_ATOMIC_COUNT_BATCH];
+	size_t nResult = 0;
+
+	for(size_t i = 0; i < pThis->nCapacity; i += EL_BITSET_ATOMIC_COUNT_BATCH) {
+		size_t nWords = pThis->nCapacity - i < EL_BITSET_ATOMIC_COUNT_BATCH ? 
+			pThis->nCapacity - i : EL_BITSET_ATOMIC_COUNT_BATCH;
+
+		for(size_t j = 0; j < nWords; j++)
+			arrWords[j] = atomic_load_explicit(atomicWord(pThis, i + j), 
+				memory_order_relaxed);
+
+		nResult += elbitopsCount(arrWords, nWords);
+	}
+	atomic_thread_fence(memory_order_acquire);
+
+	return nResult;
+}
@@ -36,10 +36,31 @@ typedef struct bitset {
 	size_t nBitsPerElement; /**< Number of bits in each element of the data 
 	buffer. */
 	uintmax_t *pBuf; /**< Data buffer. */
+	bool bDynamic; /**< If @b true, data buffer grows when bits beyond its end 
+	are set. */
 } bitset;
 
+/** 
+ * @brief Position returned when the bit is not found.
+ */
+#define EL_BITSET_NPOS ((size_t)-1)
+
+/** 
+ * @brief Pointer to callback function which's called by foreach() enumerator.
+ */
+#define EL_CB_BIT_FOREACH(s) (bool (*)(size_t))(s)
+/** 
+ * @brief Pointer to extended callback function which's called by foreachex() 
+ * enumerator.
+ */
+#define EL_CB_BIT_FOREACH_EX(s) (bool (*)(size_t, void *))(s)
+
 bitset *elbitsetCreate(size_t nBitCapacityMin);
+bitset *elbitsetCreateDynamic(size_t nBitCapacityMin);
 void elbitsetDestroy(bitset *pThis);
+bool elbitsetIsDynamic(bitset *pThis);
+bool elbitsetEnsureCapacity(bitset *pThis, size_t nBitCapacityMin);
+bool elbitsetRemoveExtraCapacity(bitset *pThis);
 size_t elbitsetGetSize(bitset *pThis);
 size_t elbitsetGetCount(bitset *pThis);
 void elbitsetSet(bitset *pThis, size_t nPos);
@@ -53,6 +74,58 @@ bool elbitsetAny(bitset *pThis);
 bool elbitsetNone(bitset *pThis);
 bool elstrIsEqualTo(bitset *pThis, bitset *pOther);
 bool elstrIsEqualToEx(bitset *pThis, bitset *pOther);
+bool elbitsetAnd(bitset *pThis, bitset *pOther);
+bool elbitsetOr(bitset *pThis, bitset *pOther);
+bool elbitsetXor(bitset *pThis, bitset *pOther);
+bool elbitsetAndNot(bitset *pThis, bitset *pOther);
+bitset *elbitsetCreateAnd(bitset *pFirst, bitset *pSecond);
+bitset *elbitsetCreateOr(bitset *pFirst, bitset *pSecond);
+bitset *elbitsetCreateXor(bitset *pFirst, bitset *pSecond);
+bitset *elbitsetCreateAndNot(bitset *pFirst, bitset *pSecond);
+size_t elbitsetGetCountAnd(bitset *pFirst, bitset *pSecond);
+size_t elbitsetGetCountOr(bitset *pFirst, bitset *pSecond);
+size_t elbitsetGetHammingDistance(bitset *pFirst, bitset *pSecond);
+double elbitsetGetJaccardIndex(bitset *pFirst, bitset *pSecond);
+size_t elbitsetFindFirst(bitset *pThis);
+size_t elbitsetFindNext(bitset *pThis, size_t nPos);
+size_t elbitsetFindLast(bitset *pThis);
+size_t elbitsetFindPrev(bitset *pThis, size_t nPos);
+size_t elbitsetFindFirstUnset(bitset *pThis);
+size_t elbitsetFindNextUnset(bitset *pThis, size_t nPos);
+size_t elbitsetFindLastUnset(bitset *pThis);
+size_t elbitsetFindPrevUnset(bitset *pThis, size_t nPos);
+void elbitsetForEach(bitset *pThis, bool (*bitCallback)(size_t nPos));
+void elbitsetForEachEx(bitset *pThis, 
+	bool (*bitCallbackEx)(size_t nPos, void *pEx), void *pEx);
+size_t elbitsetExtractPositions32(bitset *pThis, uint32_t *arrPositions, 
+	size_t nCountMax);
+size_t elbitsetExtractPositions64(bitset *pThis, uint64_t *arrPositions, 
+	size_t nCountMax);
+void elbitsetSetRange(bitset *pThis, size_t nFrom, size_t nTo);
+void elbitsetResetRange(bitset *pThis, size_t nFrom, size_t nTo);
+void elbitsetFlipRange(bitset *pThis, size_t nFrom, size_t nTo);
+bool elbitsetTestRangeAll(bitset *pThis, size_t nFrom, size_t nTo);
+bool elbitsetTestRangeAny(bitset *pThis, size_t nFrom, size_t nTo);
+size_t elbitsetGetCountRange(bitset *pThis, size_t nFrom, size_t nTo);
+void elbitsetSetBatch(bitset *pThis, const size_t *arrPositions, 
+	size_t nCount);
+void elbitsetResetBatch(bitset *pThis, const size_t *arrPositions, 
+	size_t nCount);
+size_t elbitsetTestBatch(bitset *pThis, const size_t *arrPositions, 
+	size_t nCount, bool *arrResults);
+void elbitsetAtomicSet(bitset *pThis, size_t nPos);
+void elbitsetAtomicSetRelaxed(bitset *pThis, size_t nPos);
+void elbitsetAtomicReset(bitset *pThis, size_t nPos);
+void elbitsetAtomicResetRelaxed(bitset *pThis, size_t nPos);
+bool elbitsetAtomicTestAndSet(bitset *pThis, size_t nPos);
+bool elbitsetAtomicTestAndSetRelaxed(bitset *pThis, size_t nPos);
+bool elbitsetAtomicTestAndReset(bitset *pThis, size_t nPos);
+bool elbitsetAtomicTestAndResetRelaxed(bitset *pThis, size_t nPos);
+bool elbitsetAtomicTest(bitset *pThis, size_t nPos);
+bool elbitsetAtomicTestRelaxed(bitset *pThis, size_t nPos);
+void elbitsetAtomicSetBatch(bitset *pThis, const size_t *arrPositions, 
+	size_t nCount);
+size_t elbitsetAtomicGetCount(bitset *pThis);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,509 @@
+/* Extreme Library (EL). Bloom filters. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include <string.h>
+#include <math.h>
+
+#include "el_memory.h"
+
+#include "el_bloom.h"
+#include "el_bitops.h"
+
+#define isInvalid(s) ((s) == NULL)
+
+/**
+ * Number of bits in a word of the bit set.
+ */
+#define EL_BLOOM_WORD_BITS	(sizeof(uintmax_t) << 3)
+/**
+ * Number of words in a block of blocked Bloom filter.
+ */
+#define EL_BLOOM_BLOCK_WORDS	(EL_BLOOM_BLOCK_BITS / EL_BLOOM_WORD_BITS)
+/**
+ * Maximal number of bits set for each key.
+ */
+#define EL_BLOOM_HASHES_MAX	32
+/**
+ * Number of hash bits selecting a bit in the block of blocked filter.
+ */
+#define EL_BLOOM_BLOCK_POS_BITS	9
+/**
+ * Maximal number of bits per key of blocked filter (limits the lowest 
+ * probability of false positives to about 1e-8).
+ */
+#define EL_BLOOM_BLOCKED_BITS_MAX	64.0
+/**
+ * Number of keys hashed ahead by batch functions, so that memory accesses 
+ * can be prefetched.
+ */
+#define EL_BLOOM_BATCH	16
+
+#if defined(__GNUC__)
+#define elbloomPrefetch(p) __builtin_prefetch((p))
+#else
+#define elbloomPrefetch(p)
+#endif
+
+/**
+ * Mixes the bits of the hash code (finalizer of MurmurHash3). Used to get the 
+ * second hash code for double hashing.
+ * @param  nHash Hash code.
+ * @return       Mixed hash code.
+ */
+static inline uint64_t elbloomMix(uint64_t nHash) {
+	nHash ^= nHash >> 33;
+	nHash *= 0xFF51AFD7ED558CCDull;
+	nHash ^= nHash >> 33;
+	nHash *= 0xC4CEB9FE1A85EC53ull;
+	nHash ^= nHash >> 33;
+	return nHash;
+}
+
+/**
+ * Maps the hash code to the range [0, nRange) by multiplication instead of 
+ * slow division.
+ * @param  nHash  Hash code.
+ * @param  nRange Size of the range.
+ * @return        Value in the range.
+ */
+static inline size_t elbloomReduce(uint64_t nHash, size_t nRange) {
+#ifdef __SIZEOF_INT128__
+	return (size_t)(((unsigned __int128)nHash * nRange) >> 64);
+#else
+	return (size_t)(nHash % nRange);
+#endif
+}
+
+/**
+ * Computes the probability of false positives of blocked filter. Number of 
+ * keys in a block follows Poisson distribution, so the rate is the sum of 
+ * rates of blocks with each number of keys weighted by its probability 
+ * (Putze, Sanders, Singler. Cache-, hash- and space-efficient Bloom filters).
+ * @param  fBitsPerKey Number of bits per key.
+ * @param  nHashes     Number of bits set for each key.
+ * @return             Probability of false positives.
+ */
+static double elbloomBlockedRate(double fBitsPerKey, size_t nHashes) {
+	double fLambda = EL_BLOOM_BLOCK_BITS / fBitsPerKey;
+	// probability that one key doesn't set the bit
+	double fClearPerKey = pow(1.0 - 1.0 / EL_BLOOM_BLOCK_BITS, 
+		(double)nHashes);
+	size_t nKeysMax = (size_t)(fLambda + 10.0 * sqrt(fLambda)) + 20;
+
+	double fProbability = exp(-fLambda);
+	double fClear = 1.0;
+	double fRate = 0.0;
+	for(size_t i = 0; i <= nKeysMax; i++) {
+		fRate += fProbability * pow(1.0 - fClear, (double)nHashes);
+		fProbability *= fLambda / (double)(i + 1);
+		fClear *= fClearPerKey;
+	}
+
+	return fRate;
+}
+
+/**
+ * Finds the number of hashes giving the lowest probability of false 
+ * positives of blocked filter.
+ * @param  fBitsPerKey Number of bits per key.
+ * @param  pRate       Receives the probability of false positives.
+ * @return             Number of hashes.
+ */
+static size_t elbloomBlockedHashes(double fBitsPerKey, double *pRate) {
+	size_t nBest = 1;
+	*pRate = elbloomBlockedRate(fBitsPerKey, 1);
+	for(size_t i = 2; i <= EL_BLOOM_HASHES_MAX; i++) {
+		double fRate = elbloomBlockedRate(fBitsPerKey, i);
+		if(fRate < *pRate) {
+			*pRate = fRate;
+			nBest = i;
+		}
+	}
+
+	return nBest;
+}
+
+/**
+ * Creates new empty Bloom filter.
+ * @param  nCountExpected     Expected number of keys.
+ * @param  fFalsePositiveRate Target probability of false positives.
+ * @param  bBlocked           If @b true, blocked filter is created.
+ * @return                    Newly created Bloom filter (or NULL if an error 
+ * occured).
+ */
+static bloom *elbloomCreateEx(size_t nCountExpected, double fFalsePositiveRate, 
+	bool bBlocked) {
+
+	if(nCountExpected < 1)
+		return NULL;
+	if(!(fFalsePositiveRate > 0.0 && fFalsePositiveRate < 1.0))
+		return NULL;
+
+	// Optimal m = -n * ln(p) / ln(2)^2 and k = m / n * ln(2).
+	double fLn2 = log(2.0);
+	double fBits = -(double)nCountExpected * log(fFalsePositiveRate) / 
+		(fLn2 * fLn2);
+	double fHashes = fBits / (double)nCountExpected * fLn2 + 0.5;
+	size_t nHashes = fHashes < 1.0 ? 1 : (size_t)fHashes;
+	if(nHashes > EL_BLOOM_HASHES_MAX)
+		nHashes = EL_BLOOM_HASHES_MAX;
+
+	// Keys are distributed among blocks unevenly, so blocked filter needs 
+	//   more bits per key; the least number meeting the rate is searched 
+	//   (with a margin for the error of the model).
+	if(bBlocked) {
+		fFalsePositiveRate *= 0.9;
+		double fRate;
+		double fHigh = EL_BLOOM_BLOCKED_BITS_MAX;
+		nHashes = elbloomBlockedHashes(fHigh, &fRate);
+		if(fRate > fFalsePositiveRate)
+			return NULL;
+
+		double fLow = fBits / (double)nCountExpected;
+		while(fHigh - fLow > 0.05) {
+			double fMiddle = (fLow + fHigh) / 2;
+			size_t nHashesMiddle = elbloomBlockedHashes(fMiddle, &fRate);
+			if(fRate <= fFalsePositiveRate) {
+				fHigh = fMiddle;
+				nHashes = nHashesMiddle;
+			} else
+				fLow = fMiddle;
+		}
+		fBits = fHigh * (double)nCountExpected;
+	}
+
+	size_t nUnit = bBlocked ? EL_BLOOM_BLOCK_BITS : EL_BLOOM_WORD_BITS;
+	size_t nBits = ((size_t)ceil(fBits) + nUnit - 1) / nUnit * nUnit;
+
+	bloom *pThis = EL_CALLOC(1, sizeof(bloom));
+	if(pThis == NULL)
+		return NULL;
+
+	// Extra words let blocks start at cache line boundary.
+	size_t nBitsExtra = bBlocked ? EL_BLOOM_BLOCK_BITS - EL_BLOOM_WORD_BITS : 0;
+	pThis->pBits = elbitsetCreate(nBits + nBitsExtra);
+	if(pThis->pBits == NULL) {
+		EL_FREE(pThis);
+		return NULL;
+	}
+
+	pThis->nBits = nBits;
+	pThis->nHashes = nHashes;
+	pThis->bBlocked = bBlocked;
+	if(bBlocked) {
+		size_t nMisalignment = (uintptr_t)pThis->pBits->pBuf % 
+			(EL_BLOOM_BLOCK_BITS / 8);
+		if(nMisalignment != 0)
+			pThis->nOffset = (EL_BLOOM_BLOCK_BITS / 8 - nMisalignment) / 
+				sizeof(uintmax_t);
+	}
+
+	return pThis;
+}
+
+/**
+ * Creates new empty Bloom filter sized for the expected number of keys and 
+ * the target probability of false positives. Each key sets bits which are 
+ * chosen by double hashing from one 64-bit hash code.
+ * @param  nCountExpected     Expected number of keys.
+ * @param  fFalsePositiveRate Target probability of false positives (greater 
+ * than 0 and less than 1).
+ * @return                    Newly created Bloom filter (or NULL if an error 
+ * occured).
+ */
+bloom *elbloomCreate(size_t nCountExpected, double fFalsePositiveRate) {
+	return elbloomCreateEx(nCountExpected, fFalsePositiveRate, false);
+}
+
+/**
+ * Creates new empty blocked Bloom filter. All bits of a key are in the same 
+ * 512-bit block aligned to cache line, so adding or checking the key touches 
+ * only one cache line. Blocked filter takes somewhat more memory than the 
+ * normal one for the same probability of false positives.
+ * @param  nCountExpected     Expected number of keys.
+ * @param  fFalsePositiveRate Target probability of false positives (greater 
+ * than 0 and less than 1). Blocked filter can't get much below 1e-8.
+ * @return                    Newly created Bloom filter (or NULL if an error 
+ * occured or the target probability can't be reached).
+ */
+bloom *elbloomCreateBlocked(size_t nCountExpected, double fFalsePositiveRate) {
+	return elbloomCreateEx(nCountExpected, fFalsePositiveRate, true);
+}
+
+/**
+ * Destroys the Bloom filter.
+ * @param pThis Bloom filter to be destroyed.
+ */
+void elbloomDestroy(bloom *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	elbitsetDestroy(pThis->pBits);
+	EL_FREE(pThis);
+}
+
+/**
+ * Removes all keys from the Bloom filter.
+ * @param pThis Bloom filter.
+ */
+void elbloomClear(bloom *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	elbitsetResetAll(pThis->pBits);
+}
+
+/**
+ * Returns the address of the first word which is accessed for the hash code 
+ * (so it can be prefetched).
+ * @param  pThis Bloom filter.
+ * @param  nHash Hash code of the key.
+ * @return       Address of the word.
+ */
+static inline const uintmax_t *elbloomGetFirstWord(bloom *pThis, 
+	uint64_t nHash) {
+
+	uintmax_t *pWords = pThis->pBits->pBuf + pThis->nOffset;
+	if(pThis->bBlocked)
+		return pWords + elbloomReduce(nHash, 
+			pThis->nBits / EL_BLOOM_BLOCK_BITS) * EL_BLOOM_BLOCK_WORDS;
+
+	return pWords + elbloomReduce(nHash, pThis->nBits) / EL_BLOOM_WORD_BITS;
+}
+
+/**
+ * Sets or checks the bits of the key with the hash code.
+ * @param  pThis Bloom filter.
+ * @param  nHash Hash code of the key.
+ * @param  bAdd  If @b true, bits are set, otherwise only checked.
+ * @return       @b True if all bits were set before the call, otherwise 
+ * @b false.
+ */
+static inline bool elbloomProbe(bloom *pThis, uint64_t nHash, bool bAdd) {
+	uintmax_t *pWords = pThis->pBits->pBuf + pThis->nOffset;
+	uint64_t nHash2 = elbloomMix(nHash) | 1;
+	bool bResult = true;
+
+	if(pThis->bBlocked) {
+		uintmax_t *pBlock = pWords + elbloomReduce(nHash, 
+			pThis->nBits / EL_BLOOM_BLOCK_BITS) * EL_BLOOM_BLOCK_WORDS;
+		// positions are independent groups of bits of mixed hash codes 
+		//   (steps of double hashing within a block make keys correlated)
+		uint64_t nSeed = nHash2;
+		uint64_t nPositions = elbloomMix(nHash);
+		size_t nLeft = 64 / EL_BLOOM_BLOCK_POS_BITS;
+
+		for(size_t i = 0; i < pThis->nHashes; i++) {
+			if(nLeft == 0) {
+				nSeed += 0x9E3779B97F4A7C15ull;
+				nPositions = elbloomMix(nSeed);
+				nLeft = 64 / EL_BLOOM_BLOCK_POS_BITS;
+			}
+			size_t nBit = (size_t)(nPositions % EL_BLOOM_BLOCK_BITS);
+			nPositions >>= EL_BLOOM_BLOCK_POS_BITS;
+			nLeft--;
+			uintmax_t nMask = (uintmax_t)1 << (nBit % EL_BLOOM_WORD_BITS);
+			uintmax_t *pWord = pBlock + nBit / EL_BLOOM_WORD_BITS;
+
+			if((*pWord & nMask) == 0) {
+				if(!bAdd)
+					return false;
+				bResult = false;
+				*pWord |= nMask;
+			}
+		}
+		return bResult;
+	}
+
+	uint64_t nPos = nHash;
+	for(size_t i = 0; i < pThis->nHashes; i++, nPos += nHash2) {
+		size_t nBit = elbloomReduce(nPos, pThis->nBits);
+		uintmax_t nMask = (uintmax_t)1 << (nBit % EL_BLOOM_WORD_BITS);
+		uintmax_t *pWord = pWords + nBit / EL_BLOOM_WORD_BITS;
+
+		if((*pWord & nMask) == 0) {
+			if(!bAdd)
+				return false;
+			bResult = false;
+			*pWord |= nMask;
+		}
+	}
+	return bResult;
+}
+
+/**
+ * Adds the key with specified 64-bit hash code to the Bloom filter. Allows to 
+ * use keys of any type.
+ * @param pThis Bloom filter.
+ * @param nHash Hash code of the key (all bits should be well mixed).
+ */
+void elbloomAddHash(bloom *pThis, uint64_t nHash) {
+	if(isInvalid(pThis))
+		return;
+
+	elbloomProbe(pThis, nHash, true);
+}
+
+/**
+ * Checks if the key with specified 64-bit hash code may be in the Bloom 
+ * filter.
+ * @param  pThis Bloom filter.
+ * @param  nHash Hash code of the key.
+ * @return       @b False if the key is definitely not in the filter, @b true 
+ * if it may be there.
+ */
+bool elbloomMayContainHash(bloom *pThis, uint64_t nHash) {
+	if(isInvalid(pThis))
+		return false;
+
+	return elbloomProbe(pThis, nHash, false);
+}
+
+/**
+ * Adds the dynamic string to the Bloom filter.
+ * @param  pThis Bloom filter.
+ * @param  pKey  Dynamic string.
+ * @return       @b True if succeeded, otherwise @b false.
+ */
+bool elbloomAdd(bloom *pThis, str *pKey) {
+	if(isInvalid(pThis) || elstrGetRawBuf(pKey) == NULL)
+		return false;
+
+	elbloomProbe(pThis, elstrGetHashCode64(pKey), true);
+
+	return true;
+}
+
+/**
+ * Checks if the dynamic string may be in the Bloom filter.
+ * @param  pThis Bloom filter.
+ * @param  pKey  Dynamic string.
+ * @return       @b False if the string is definitely not in the filter, 
+ * @b true if it may be there.
+ */
+bool elbloomMayContain(bloom *pThis, str *pKey) {
+	if(isInvalid(pThis) || elstrGetRawBuf(pKey) == NULL)
+		return false;
+
+	return elbloomProbe(pThis, elstrGetHashCode64(pKey), false);
+}
+
+/**
+ * Adds the array of dynamic strings to the Bloom filter. Strings are hashed 
+ * in groups and memory is prefetched before bits are set, so random accesses 
+ * to the filter overlap. Invalid strings are skipped.
+ * @param  pThis      Bloom filter.
+ * @param  pKeys      An array of dynamic strings.
+ * @param  nCountKeys Number of strings.
+ * @return            Number of strings added.
+ */
+size_t elbloomAddBatch(bloom *pThis, str **pKeys, size_t nCountKeys) {
+	if(isInvalid(pThis) || pKeys == NULL)
+		return 0;
+
+	uint64_t arrHashes[EL_BLOOM_BATCH];
+	size_t nResult = 0;
+
+	for(size_t i = 0; i < nCountKeys; i += EL_BLOOM_BATCH) {
+		size_t nCount = nCountKeys - i < EL_BLOOM_BATCH ? 
+			nCountKeys - i : EL_BLOOM_BATCH;
+		size_t nValid = 0;
+
+		for(size_t j = 0; j < nCount; j++) {
+			if(elstrGetRawBuf(pKeys[i + j]) == NULL)
+				continue;
+			arrHashes[nValid] = elstrGetHashCode64(pKeys[i + j]);
+			elbloomPrefetch(elbloomGetFirstWord(pThis, arrHashes[nValid]));
+			nValid++;
+		}
+
+		for(size_t j = 0; j < nValid; j++)
+			elbloomProbe(pThis, arrHashes[j], true);
+		nResult += nValid;
+	}
+
+	return nResult;
+}
+
+/**
+ * Checks which strings of the array may be in the Bloom filter. Strings are 
+ * hashed in groups and memory is prefetched before bits are checked, so 
+ * random accesses to the filter overlap.
+ * @param  pThis      Bloom filter.
+ * @param  pKeys      An array of dynamic strings.
+ * @param  nCountKeys Number of strings.
+ * @param  arrResults An array receiving the result for each string (may be 
+ * NULL if only the number of strings is required).
+ * @return            Number of strings which may be in the filter.
+ */
+size_t elbloomMayContainBatch(bloom *pThis, str **pKeys, size_t nCountKeys, 
+	bool *arrResults) {
+
+	if(isInvalid(pThis) || pKeys == NULL)
+		return 0;
+
+	uint64_t arrHashes[EL_BLOOM_BATCH];
+	size_t nResult = 0;
+
+	for(size_t i = 0; i < nCountKeys; i += EL_BLOOM_BATCH) {
+		size_t nCount = nCountKeys - i < EL_BLOOM_BATCH ? 
+			nCountKeys - i : EL_BLOOM_BATCH;
+
+		for(size_t j = 0; j < nCount; j++) {
+			arrHashes[j] = elstrGetHashCode64(pKeys[i + j]);
+			elbloomPrefetch(elbloomGetFirstWord(pThis, arrHashes[j]));
+		}
+
+		for(size_t j = 0; j < nCount; j++) {
+			bool bResult = elstrGetRawBuf(pKeys[i + j]) != NULL && 
+				elbloomProbe(pThis, arrHashes[j], false);
+			nResult += bResult;
+			if(arrResults != NULL)
+				arrResults[i + j] = bResult;
+		}
+	}
+
+	return nResult;
+}
+
+/**
+ * Adds all keys of another Bloom filter to this one. Filters must be created 
+ * with the same parameters (same size, number of hashes and kind).
+ * @param  pThis  Bloom filter.
+ * @param  pOther Another Bloom filter.
+ * @return        @b True if succeeded, otherwise @b false.
+ */
+bool elbloomUnion(bloom *pThis, bloom *pOther) {
+	if(isInvalid(pThis) || isInvalid(pOther))
+		return false;
+
+	if(pThis->nBits != pOther->nBits || pThis->nHashes != pOther->nHashes || 
+		pThis->bBlocked != pOther->bBlocked)
+		return false;
+
+	if(pThis->nOffset == pOther->nOffset)
+		return elbitsetOr(pThis->pBits, pOther->pBits);
+
+	// Blocks of filters are aligned differently.
+	uintmax_t *pWords = pThis->pBits->pBuf + pThis->nOffset;
+	elbitopsOr(pWords, pWords, pOther->pBits->pBuf + pOther->nOffset, 
+		pThis->nBits / EL_BLOOM_WORD_BITS);
+
+	return true;
+}
@@ -0,0 +1,71 @@
+/* Extreme Library (EL). Bloom filters. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef _EL_BLOOM_H_
+#define _EL_BLOOM_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "el_str.h"
+#include "el_bitset.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of bits in a block of blocked Bloom filter (one cache line).
+ */
+#define EL_BLOOM_BLOCK_BITS	512
+
+/** 
+ * @brief Holds the data of Bloom filter.
+ *
+ * Filter answers whether a key is "definitely not present" or "may be 
+ * present". Blocked filter keeps all bits of a key within one cache line.
+ */
+typedef struct bloom {
+	bitset *pBits; /**< Bit set holding the filter. */
+	size_t nBits; /**< Number of bits used by the filter. */
+	size_t nHashes; /**< Number of bits set for each key. */
+	size_t nOffset; /**< Index of the first word of bit set used (blocks of 
+	blocked filter start at cache line boundary). */
+	bool bBlocked; /**< If @b true, bits of each key are in one block. */
+} bloom;
+
+bloom *elbloomCreate(size_t nCountExpected, double fFalsePositiveRate);
+bloom *elbloomCreateBlocked(size_t nCountExpected, double fFalsePositiveRate);
+void elbloomDestroy(bloom *pThis);
+void elbloomClear(bloom *pThis);
+void elbloomAddHash(bloom *pThis, uint64_t nHash);
+bool elbloomMayContainHash(bloom *pThis, uint64_t nHash);
+bool elbloomAdd(bloom *pThis, str *pKey);
+bool elbloomMayContain(bloom *pThis, str *pKey);
+size_t elbloomAddBatch(bloom *pThis, str **pKeys, size_t nCountKeys);
+size_t elbloomMayContainBatch(bloom *pThis, str **pKeys, size_t nCountKeys, 
+	bool *arrResults);
+bool elbloomUnion(bloom *pThis, bloom *pOther);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,76 @@
+/* Extreme Library (EL). CPU features detection. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdatomic.h>
+
+#include "el_cpu.h"
+
+/**
+ * Flag which tells that features were already detected.
+ */
+#define EL_CPU_DETECTED		(1u << 31)
+
+static atomic_uint g_nFeatures = 0;
+
+/**
+ * Detects features of the CPU the process runs on (via CPUID). Detection is 
+ * done once, next calls just return the cached value.
+ * @return Combination of EL_CPU_XX flags.
+ */
+unsigned elcpuGetFeatures() {
+	unsigned nFeatures = atomic_load_explicit(&g_nFeatures, 
+		memory_order_relaxed);
+	if(nFeatures != 0)
+		return nFeatures & ~EL_CPU_DETECTED;
+
+	nFeatures = EL_CPU_DETECTED;
+#if EL_CPU_X86
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("sse2"))
+		nFeatures |= EL_CPU_SSE2;
+	if(__builtin_cpu_supports("sse4.2"))
+		nFeatures |= EL_CPU_SSE42;
+	if(__builtin_cpu_supports("popcnt"))
+		nFeatures |= EL_CPU_POPCNT;
+	if(__builtin_cpu_supports("avx2"))
+		nFeatures |= EL_CPU_AVX2;
+	if(__builtin_cpu_supports("bmi2"))
+		nFeatures |= EL_CPU_BMI2;
+	if(__builtin_cpu_supports("avx512f"))
+		nFeatures |= EL_CPU_AVX512F;
+	if(__builtin_cpu_supports("avx512bw"))
+		nFeatures |= EL_CPU_AVX512BW;
+	if(__builtin_cpu_supports("avx512vpopcntdq"))
+		nFeatures |= EL_CPU_AVX512VPOPCNTDQ;
+	if(__builtin_cpu_supports("pclmul"))
+		nFeatures |= EL_CPU_PCLMUL;
+#endif
+
+	atomic_store_explicit(&g_nFeatures, nFeatures, memory_order_relaxed);
+
+	return nFeatures & ~EL_CPU_DETECTED;
+}
+
+/**
+ * Checks if the CPU supports all features specified.
+ * @param  nFeatures Combination of EL_CPU_XX flags.
+ * @return           @b True if all features are supported.
+ */
+bool elcpuHas(unsigned nFeatures) {
+	return (elcpuGetFeatures() & nFeatures) == nFeatures;
+}
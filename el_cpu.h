@@ -0,0 +1,57 @@
+/* Extreme Library (EL). CPU features detection. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _EL_CPU_H_
+#define _EL_CPU_H_
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Defined as 1 when the library is compiled for x86 by the compiler which 
+ * supports per-function target attributes and intrinsics (GCC or Clang). 
+ * Only in this case SIMD kernels are compiled; otherwise portable ones are used.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && \
+	(defined(__x86_64__) || defined(__i386__))
+#define EL_CPU_X86 1
+#else
+#define EL_CPU_X86 0
+#endif
+
+#define EL_CPU_SSE2				1
+#define EL_CPU_SSE42			2
+#define EL_CPU_POPCNT			4
+#define EL_CPU_AVX2				8
+#define EL_CPU_BMI2				16
+#define EL_CPU_AVX512F			32
+#define EL_CPU_AVX512BW			64
+#define EL_CPU_AVX512VPOPCNTDQ	128
+#define EL_CPU_PCLMUL			256
+
+unsigned elcpuGetFeatures();
+bool elcpuHas(unsigned nFeatures);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
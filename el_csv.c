@@ -0,0 +1,774 @@
+/* Extreme Library (EL). Delimited records (CSV/TSV) parser. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include <string.h>
+#include <stdatomic.h>
+
+#include "el_memory.h"
+#include "el_cpu.h"
+
+#include "el_csv.h"
+
+#if EL_CPU_X86
+#include <immintrin.h>
+#endif
+
+#define isInvalid(s) ((s) == NULL)
+
+/**
+ * Computes prefix XOR of the bits (each bit becomes XOR of itself and all 
+ * lower bits), so bits between pairs of quotes are set.
+ */
+static inline uint64_t elcsvPrefixXor(uint64_t nBits) {
+	nBits ^= nBits << 1;
+	nBits ^= nBits << 2;
+	nBits ^= nBits << 4;
+	nBits ^= nBits << 8;
+	nBits ^= nBits << 16;
+	nBits ^= nBits << 32;
+
+	return nBits;
+}
+
+/**
+ * Removes quoted bits from the mask of delimiters and line feeds and updates 
+ * the quote state.
+ * @param  nSeparators Delimiters and line feeds.
+ * @param  nInside     Prefix XOR of quotes.
+ * @param  pInQuote    Quote state (all zeros or all ones).
+ * @return             Separators which are not quoted.
+ */
+static inline uint64_t elcsvUnquoted(uint64_t nSeparators, uint64_t nInside, 
+	uint64_t *pInQuote) {
+
+	nInside ^= *pInQuote;
+	*pInQuote = (uint64_t)((int64_t)nInside >> 63);
+
+	return nSeparators & ~nInside;
+}
+
+/**
+ * Returns the mask of unquoted separators (portable implementation).
+ */
+static uint64_t elcsvStructuralScalar(const char *p, size_t nLength, 
+	char chDelimiter, char chQuote, uint64_t *pInQuote) {
+
+	uint64_t nQuotes = 0;
+	uint64_t nSeparators = 0;
+	for(size_t i = 0; i < nLength; i++) {
+		nQuotes |= (uint64_t)(p[i] == chQuote) << i;
+		nSeparators |= (uint64_t)(p[i] == chDelimiter || p[i] == '\n') << i;
+	}
+
+	return elcsvUnquoted(nSeparators, elcsvPrefixXor(nQuotes), pInQuote);
+}
+
+/**
+ * Portable kernels.
+ */
+static const elcsv_kernels g_kernelsScalar = {
+	"scalar",
+	elcsvStructuralScalar
+};
+
+#if EL_CPU_X86
+
+/**
+ * Returns the mask of unquoted separators (SSE2 implementation).
+ */
+static uint64_t elcsvStructuralSSE2(const char *p, size_t nLength, 
+	char chDelimiter, char chQuote, uint64_t *pInQuote) {
+
+	if(nLength < 64)
+		return elcsvStructuralScalar(p, nLength, chDelimiter, chQuote, 
+			pInQuote);
+
+	__m128i vDelimiter = _mm_set1_epi8(chDelimiter);
+	__m128i vQuote = _mm_set1_epi8(chQuote);
+	__m128i vLineFeed = _mm_set1_epi8('\n');
+
+	uint64_t nQuotes = 0;
+	uint64_t nSeparators = 0;
+	for(int i = 0; i < 64; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+		nQuotes |= (uint64_t)(uint16_t)_mm_movemask_epi8(
+			_mm_cmpeq_epi8(v, vQuote)) << i;
+		nSeparators |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_or_si128(
+			_mm_cmpeq_epi8(v, vDelimiter), _mm_cmpeq_epi8(v, vLineFeed))) << i;
+	}
+
+	return elcsvUnquoted(nSeparators, elcsvPrefixXor(nQuotes), pInQuote);
+}
+
+/**
+ * SSE2 kernels.
+ */
+static const elcsv_kernels g_kernelsSSE2 = {
+	"sse2",
+	elcsvStructuralSSE2
+};
+
+/**
+ * Returns the mask of unquoted separators (AVX2 implementation, prefix XOR 
+ * is carry-less multiplication by all ones).
+ */
+__attribute__((target("avx2,pclmul")))
+static uint64_t elcsvStructuralAVX2(const char *p, size_t nLength, 
+	char chDelimiter, char chQuote, uint64_t *pInQuote) {
+
+	if(nLength < 64)
+		return elcsvStructuralScalar(p, nLength, chDelimiter, chQuote, 
+			pInQuote);
+
+	__m256i vDelimiter = _mm256_set1_epi8(chDelimiter);
+	__m256i vQuote = _mm256_set1_epi8(chQuote);
+	__m256i vLineFeed = _mm256_set1_epi8('\n');
+
+	__m256i vLow = _mm256_loadu_si256((const __m256i *)p);
+	__m256i vHigh = _mm256_loadu_si256((const __m256i *)(p + 32));
+	uint64_t nQuotes = (uint64_t)(uint32_t)_mm256_movemask_epi8(
+		_mm256_cmpeq_epi8(vLow, vQuote)) | 
+		((uint64_t)(uint32_t)_mm256_movemask_epi8(
+		_mm256_cmpeq_epi8(vHigh, vQuote)) << 32);
+	uint64_t nSeparators = (uint64_t)(uint32_t)_mm256_movemask_epi8(
+		_mm256_or_si256(_mm256_cmpeq_epi8(vLow, vDelimiter), 
+		_mm256_cmpeq_epi8(vLow, vLineFeed))) | 
+		((uint64_t)(uint32_t)_mm256_movemask_epi8(
+		_mm256_or_si256(_mm256_cmpeq_epi8(vHigh, vDelimiter), 
+		_mm256_cmpeq_epi8(vHigh, vLineFeed))) << 32);
+
+	// words are moved through memory (32-bit targets have no 64-bit moves 
+	// between general and vector registers)
+	uint64_t nInside;
+	_mm_storel_epi64((__m128i *)&nInside, _mm_clmulepi64_si128(
+		_mm_loadl_epi64((const __m128i *)&nQuotes), _mm_set1_epi8((char)0xFF), 
+		0));
+
+	return elcsvUnquoted(nSeparators, nInside, pInQuote);
+}
+
+/**
+ * AVX2 kernels.
+ */
+static const elcsv_kernels g_kernelsAVX2 = {
+	"avx2",
+	elcsvStructuralAVX2
+};
+
+#endif
+
+static const elcsv_kernels *_Atomic g_pKernels = NULL;
+
+/**
+ * Returns the kernels best suited for the CPU. CPU is checked once, at first 
+ * call.
+ * @return Kernels.
+ */
+const elcsv_kernels *elcsvGetKernels() {
+	const elcsv_kernels *pKernels = atomic_load_explicit(&g_pKernels, 
+		memory_order_relaxed);
+	if(pKernels != NULL)
+		return pKernels;
+
+	pKernels = &g_kernelsScalar;
+#if EL_CPU_X86
+	if(elcpuHas(EL_CPU_AVX2 | EL_CPU_PCLMUL))
+		pKernels = &g_kernelsAVX2;
+	else if(elcpuHas(EL_CPU_SSE2))
+		pKernels = &g_kernelsSSE2;
+#endif
+
+	atomic_store_explicit(&g_pKernels, pKernels, memory_order_relaxed);
+
+	return pKernels;
+}
+
+/**
+ * Returns the name of kernels chosen for the CPU ("scalar", "sse2" or 
+ * "avx2").
+ * @return Name of kernels.
+ */
+const char *elcsvGetKernelsName() {
+	return elcsvGetKernels()->szName;
+}
+
+/**
+ * Reserves bytes in the arena. New block is allocated if the current one has 
+ * no room.
+ * @param  pThis   Parser.
+ * @param  nLength Number of bytes.
+ * @return         Pointer to reserved bytes (or NULL if an error occured).
+ */
+static char *elcsvReserve(csv *pThis, size_t nLength) {
+	elcsv_block *pBlock = pThis->pBlocks;
+	if(pBlock == NULL || pBlock->nCapacity - pBlock->nUsed < nLength) {
+		size_t nCapacity = nLength > EL_CSV_BLOCK_SIZE ? nLength : 
+			EL_CSV_BLOCK_SIZE;
+		pBlock = EL_ALLOC(sizeof(elcsv_block) + nCapacity);
+		if(pBlock == NULL)
+			return NULL;
+		pBlock->pNext = pThis->pBlocks;
+		pBlock->nUsed = 0;
+		pBlock->nCapacity = nCapacity;
+		pThis->pBlocks = pBlock;
+	}
+
+	return pBlock->arrData + pBlock->nUsed;
+}
+
+/**
+ * Makes the arena empty. The last allocated block is kept for reuse.
+ * @param pThis Parser.
+ */
+static void elcsvResetArena(csv *pThis) {
+	if(pThis->pBlocks == NULL)
+		return;
+
+	elcsv_block *pBlock = pThis->pBlocks->pNext;
+	while(pBlock != NULL) {
+		elcsv_block *pNext = pBlock->pNext;
+		EL_FREE(pBlock);
+		pBlock = pNext;
+	}
+	pThis->pBlocks->pNext = NULL;
+	pThis->pBlocks->nUsed = 0;
+}
+
+/**
+ * Copies the field into the arena.
+ * @param  pThis  Parser.
+ * @param  pField Field (receives the copy).
+ * @return        @b True if successful, @b false if an error occured.
+ */
+static bool elcsvCopyField(csv *pThis, strview *pField) {
+	char *pDest = elcsvReserve(pThis, pField->nLength);
+	if(pDest == NULL)
+		return false;
+
+	memcpy(pDest, pField->szBuf, pField->nLength);
+	pThis->pBlocks->nUsed += pField->nLength;
+	pField->szBuf = pDest;
+
+	return true;
+}
+
+/**
+ * Removes quotes from the field. Field which is quoted as a whole and has no 
+ * escaped quotes becomes the view of its inner part, others are unquoted 
+ * into the arena (doubled quote inside quotes means one quote).
+ * @param  pThis  Parser.
+ * @param  pField Field.
+ * @return        @b True if successful, @b false if an error occured.
+ */
+static bool elcsvUnquote(csv *pThis, strview *pField) {
+	const char *p = pField->szBuf;
+	size_t nLength = pField->nLength;
+	char chQuote = pThis->chQuote;
+	if(nLength == 0 || memchr(p, chQuote, nLength) == NULL)
+		return true;
+
+	if(nLength >= 2 && p[0] == chQuote && p[nLength - 1] == chQuote && 
+		memchr(p + 1, chQuote, nLength - 2) == NULL) {
+
+		pField->szBuf = p + 1;
+		pField->nLength = nLength - 2;
+		return true;
+	}
+
+	char *pDest = elcsvReserve(pThis, nLength);
+	if(pDest == NULL)
+		return false;
+
+	size_t nOut = 0;
+	bool bQuoted = false;
+	for(size_t i = 0; i < nLength; i++) {
+		if(p[i] != chQuote)
+			pDest[nOut++] = p[i];
+		else if(bQuoted && i + 1 < nLength && p[i + 1] == chQuote) {
+			pDest[nOut++] = chQuote;
+			i++;
+		} else
+			bQuoted = !bQuoted;
+	}
+	pThis->pBlocks->nUsed += nOut;
+
+	pField->szBuf = pDest;
+	pField->nLength = nOut;
+
+	return true;
+}
+
+/**
+ * Adds the field to the current record.
+ * @param  pThis   Parser.
+ * @param  p       Field (as it is in the text).
+ * @param  nLength Length of the field.
+ * @return         @b True if successful, @b false if an error occured.
+ */
+static bool elcsvAddField(csv *pThis, const char *p, size_t nLength) {
+	if(pThis->nCountFields == pThis->nCapacityFields) {
+		size_t nCapacity = pThis->nCapacityFields > 0 ? 
+			pThis->nCapacityFields * 2 : 16;
+		strview *arrFields = EL_REALLOC(pThis->arrFields, 
+			nCapacity * sizeof(strview));
+		if(arrFields == NULL)
+			return false;
+		pThis->arrFields = arrFields;
+		pThis->nCapacityFields = nCapacity;
+	}
+
+	pThis->arrFields[pThis->nCountFields].szBuf = p;
+	pThis->arrFields[pThis->nCountFields].nLength = nLength;
+	pThis->nCountFields++;
+
+	return true;
+}
+
+/**
+ * Adds the row to columns. Missing fields are empty, extra ones are ignored. 
+ * Fields from the carry buffer are copied into the arena.
+ * @param  pThis  Parser.
+ * @param  bCarry @b True if record is in the carry buffer.
+ * @return        @b True if successful, @b false if an error occured.
+ */
+static bool elcsvAddRow(csv *pThis, bool bCarry) {
+	if(pThis->nRows == pThis->nCapacityRows) {
+		size_t nCapacity = pThis->nCapacityRows > 0 ? 
+			pThis->nCapacityRows * 2 : 256;
+		for(size_t i = 0; i < pThis->nColumns; i++) {
+			strview *arrColumn = EL_REALLOC(pThis->arrColumns[i], 
+				nCapacity * sizeof(strview));
+			if(arrColumn == NULL)
+				return false;
+			pThis->arrColumns[i] = arrColumn;
+		}
+		pThis->nCapacityRows = nCapacity;
+	}
+
+	size_t nCount = pThis->nCountFields;
+	if(nCount != pThis->nColumns)
+		pThis->nMalformed++;
+
+	for(size_t i = 0; i < pThis->nColumns; i++) {
+		strview field = { "", 0 };
+		if(i < nCount) {
+			field = pThis->arrFields[i];
+			if(bCarry && field.szBuf >= pThis->pCarry && 
+				field.szBuf < pThis->pCarry + pThis->nCarry && 
+				!elcsvCopyField(pThis, &field))
+				return false;
+		}
+		pThis->arrColumns[i][pThis->nRows] = field;
+	}
+	pThis->nRows++;
+
+	return true;
+}
+
+/**
+ * Passes the current record to the callback or adds it to columns. Carriage 
+ * return ending the record is removed, empty lines are skipped.
+ * @param  pThis  Parser.
+ * @param  bCarry @b True if record is in the carry buffer.
+ * @return        @b False if parsing has to be stopped.
+ */
+static bool elcsvEmit(csv *pThis, bool bCarry) {
+	strview *arrFields = pThis->arrFields;
+	size_t nCount = pThis->nCountFields;
+
+	strview *pLast = &arrFields[nCount - 1];
+	if(pLast->nLength > 0 && pLast->szBuf[pLast->nLength - 1] == '\r')
+		pLast->nLength--;
+	if(nCount == 1 && pLast->nLength == 0)
+		return true;
+
+	for(size_t i = 0; i < nCount; i++)
+		if(!elcsvUnquote(pThis, &arrFields[i]))
+			return false;
+	pThis->nRecords++;
+
+	if(pThis->recordForEach == NULL)
+		return elcsvAddRow(pThis, bCarry);
+
+	bool bContinue = pThis->recordForEach(arrFields, nCount, pThis->pData);
+	elcsvResetArena(pThis);
+
+	return bContinue;
+}
+
+/**
+ * Parses complete records. Text starts at the beginning of record, fields are 
+ * found by the masks of unquoted separators computed for each 64 bytes.
+ * @param  pThis   Parser.
+ * @param  p       Text.
+ * @param  nLength Length of the text.
+ * @param  bFinal  If @b true, text after the last line feed is a record as 
+ * well.
+ * @param  bCarry  @b True if text is the carry buffer.
+ * @return         Length of complete records parsed (text after them has to 
+ * be carried to the next chunk). Quote state at the end is kept in the 
+ * parser.
+ */
+static size_t elcsvParse(csv *pThis, const char *p, size_t nLength, 
+	bool bFinal, bool bCarry) {
+
+	uint64_t (*structural)(const char *, size_t, char, char, uint64_t *) = 
+		elcsvGetKernels()->structural;
+	char chDelimiter = pThis->chDelimiter;
+	char chQuote = pThis->chQuote;
+	uint64_t nInQuote = 0;
+	size_t nRecordStart = 0;
+	size_t nFieldStart = 0;
+
+	pThis->nCountFields = 0;
+	for(size_t nBlock = 0; nBlock < nLength; nBlock += 64) {
+		size_t nBlockLength = nLength - nBlock < 64 ? nLength - nBlock : 64;
+		uint64_t nMask = structural(p + nBlock, nBlockLength, chDelimiter, 
+			chQuote, &nInQuote);
+		while(nMask != 0) {
+			size_t i = nBlock + (size_t)__builtin_ctzll(nMask);
+			nMask &= nMask - 1;
+			if(!elcsvAddField(pThis, p + nFieldStart, i - nFieldStart)) {
+				pThis->bStopped = true;
+				return nRecordStart;
+			}
+			nFieldStart = i + 1;
+			if(p[i] == '\n') {
+				if(!elcsvEmit(pThis, bCarry)) {
+					pThis->bStopped = true;
+					return nRecordStart;
+				}
+				pThis->nCountFields = 0;
+				nRecordStart = i + 1;
+			}
+		}
+	}
+
+	if(bFinal && nRecordStart < nLength) {
+		if(!elcsvAddField(pThis, p + nFieldStart, nLength - nFieldStart) || 
+			!elcsvEmit(pThis, bCarry))
+			pThis->bStopped = true;
+		nRecordStart = nLength;
+	}
+	pThis->nCountFields = 0;
+	pThis->nCarryInQuote = nInQuote;
+
+	return nRecordStart;
+}
+
+/**
+ * Finds the line feed ending the record started in the previous chunk.
+ * @param  pThis    Parser.
+ * @param  p        Text.
+ * @param  nLength  Length of the text.
+ * @param  pInQuote Quote state at the beginning (receives the state at the 
+ * end if line feed isn't found).
+ * @return          Position of the line feed (or SIZE_MAX if not found).
+ */
+static size_t elcsvFindRecordEnd(csv *pThis, const char *p, size_t nLength, 
+	uint64_t *pInQuote) {
+
+	const elcsv_kernels *pKernels = elcsvGetKernels();
+
+	for(size_t nBlock = 0; nBlock < nLength; nBlock += 64) {
+		size_t nBlockLength = nLength - nBlock < 64 ? nLength - nBlock : 64;
+		uint64_t nMask = pKernels->structural(p + nBlock, nBlockLength, 
+			pThis->chDelimiter, pThis->chQuote, pInQuote);
+		while(nMask != 0) {
+			size_t i = nBlock + (size_t)__builtin_ctzll(nMask);
+			nMask &= nMask - 1;
+			if(p[i] == '\n')
+				return i;
+		}
+	}
+
+	return SIZE_MAX;
+}
+
+/**
+ * Adds bytes to the carry buffer.
+ * @param  pThis   Parser.
+ * @param  p       Bytes.
+ * @param  nLength Number of bytes.
+ * @return         @b True if successful, @b false if an error occured.
+ */
+static bool elcsvAddCarry(csv *pThis, const char *p, size_t nLength) {
+	if(pThis->nCapacityCarry - pThis->nCarry < nLength) {
+		size_t nCapacity = pThis->nCapacityCarry > 0 ? 
+			pThis->nCapacityCarry * 2 : 256;
+		if(nCapacity < pThis->nCarry + nLength)
+			nCapacity = pThis->nCarry + nLength;
+		char *pCarry = EL_REALLOC(pThis->pCarry, nCapacity);
+		if(pCarry == NULL)
+			return false;
+		pThis->pCarry = pCarry;
+		pThis->nCapacityCarry = nCapacity;
+	}
+
+	memcpy(pThis->pCarry + pThis->nCarry, p, nLength);
+	pThis->nCarry += nLength;
+
+	return true;
+}
+
+/**
+ * Creates the parser passing each record to the callback.
+ * @param  chDelimiter   Delimiter of fields (like ',' or '\\t').
+ * @param  chQuote       Quote character (like '"').
+ * @param  recordForEach Callback receiving fields of the record, their 
+ * number and user data. Fields are valid only during the call. Parsing stops 
+ * when it returns @b false.
+ * @param  pData         User data passed to callback.
+ * @return               Newly created parser (or NULL if an error occured).
+ */
+csv *elcsvCreate(char chDelimiter, char chQuote, 
+	bool (*recordForEach)(const strview *arrFields, size_t nCount, 
+	void *pData), void *pData) {
+
+	if(recordForEach == NULL || chDelimiter == chQuote || 
+		chDelimiter == '\n' || chDelimiter == '\r' || 
+		chQuote == '\n' || chQuote == '\r')
+		return NULL;
+
+	csv *pThis = EL_CALLOC(1, sizeof(csv));
+	if(pThis == NULL)
+		return NULL;
+
+	pThis->chDelimiter = chDelimiter;
+	pThis->chQuote = chQuote;
+	pThis->recordForEach = recordForEach;
+	pThis->pData = pData;
+
+	return pThis;
+}
+
+/**
+ * Creates the parser gathering fields of records into columns. Fields are 
+ * views into chunks fed, so chunks have to stay valid and unchanged while 
+ * columns are used (unquoted fields and records split between chunks are 
+ * kept by the parser).
+ * @param  chDelimiter Delimiter of fields (like ',' or '\\t').
+ * @param  chQuote     Quote character (like '"').
+ * @param  nColumns    Number of columns.
+ * @return             Newly created parser (or NULL if an error occured).
+ */
+csv *elcsvCreateColumns(char chDelimiter, char chQuote, size_t nColumns) {
+	if(nColumns == 0 || chDelimiter == chQuote || 
+		chDelimiter == '\n' || chDelimiter == '\r' || 
+		chQuote == '\n' || chQuote == '\r')
+		return NULL;
+
+	csv *pThis = EL_CALLOC(1, sizeof(csv));
+	if(pThis == NULL)
+		return NULL;
+
+	pThis->arrColumns = EL_CALLOC(nColumns, sizeof(strview *));
+	if(pThis->arrColumns == NULL) {
+		EL_FREE(pThis);
+		return NULL;
+	}
+
+	pThis->chDelimiter = chDelimiter;
+	pThis->chQuote = chQuote;
+	pThis->nColumns = nColumns;
+
+	return pThis;
+}
+
+/**
+ * Destroys the parser.
+ * @param pThis Parser.
+ */
+void elcsvDestroy(csv *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	elcsvClear(pThis);
+
+	if(pThis->pBlocks != NULL)
+		EL_FREE(pThis->pBlocks);
+	if(pThis->arrFields != NULL)
+		EL_FREE(pThis->arrFields);
+	if(pThis->pCarry != NULL)
+		EL_FREE(pThis->pCarry);
+	for(size_t i = 0; i < pThis->nColumns; i++)
+		if(pThis->arrColumns[i] != NULL)
+			EL_FREE(pThis->arrColumns[i]);
+	if(pThis->arrColumns != NULL)
+		EL_FREE(pThis->arrColumns);
+
+	EL_FREE(pThis);
+}
+
+/**
+ * Resets the parser to the initial state. Rows of columns and the record 
+ * not completed are removed, memory is kept for reuse.
+ * @param pThis Parser.
+ */
+void elcsvClear(csv *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	elcsvResetArena(pThis);
+
+	pThis->nCountFields = 0;
+	pThis->nCarry = 0;
+	pThis->nCarryInQuote = 0;
+	pThis->nRows = 0;
+	pThis->nRecords = 0;
+	pThis->nMalformed = 0;
+	pThis->bStopped = false;
+}
+
+/**
+ * Parses the next chunk of text. Records may be split between chunks at any 
+ * position. Records end with line feed (carriage return before it is 
+ * removed), line feeds and delimiters inside quotes are parts of fields.
+ * @param  pThis Parser.
+ * @param  view  Chunk.
+ * @return       @b False if callback stopped parsing or an error occured.
+ */
+bool elcsvFeedView(csv *pThis, strview view) {
+	if(isInvalid(pThis) || pThis->bStopped)
+		return false;
+	if(view.szBuf == NULL || view.nLength == 0)
+		return true;
+
+	const char *p = view.szBuf;
+	size_t nLength = view.nLength;
+	if(pThis->nCarry > 0) {
+		uint64_t nInQuote = pThis->nCarryInQuote;
+		size_t nEnd = elcsvFindRecordEnd(pThis, p, nLength, &nInQuote);
+		if(nEnd == SIZE_MAX) {
+			if(!elcsvAddCarry(pThis, p, nLength)) {
+				pThis->bStopped = true;
+				return false;
+			}
+			pThis->nCarryInQuote = nInQuote;
+			return true;
+		}
+
+		if(!elcsvAddCarry(pThis, p, nEnd + 1)) {
+			pThis->bStopped = true;
+			return false;
+		}
+		elcsvParse(pThis, pThis->pCarry, pThis->nCarry, false, true);
+		pThis->nCarry = 0;
+		if(pThis->bStopped)
+			return false;
+		p += nEnd + 1;
+		nLength -= nEnd + 1;
+	}
+
+	size_t nParsed = elcsvParse(pThis, p, nLength, false, false);
+	if(pThis->bStopped)
+		return false;
+	if(nParsed < nLength && !elcsvAddCarry(pThis, p + nParsed, 
+		nLength - nParsed)) {
+
+		pThis->bStopped = true;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Parses the next chunk of text from dynamic string (see elcsvFeedView()).
+ * @param  pThis Parser.
+ * @param  pStr  Dynamic string.
+ * @return       @b False if callback stopped parsing or an error occured.
+ */
+bool elcsvFeedELStr(csv *pThis, str *pStr) {
+	return elcsvFeedView(pThis, elstrGetView(pStr));
+}
+
+/**
+ * Parses the last record if text doesn't end with line feed. Parser is ready 
+ * for the next text afterwards.
+ * @param  pThis Parser.
+ * @return       @b False if the last quote isn't closed, callback stopped 
+ * parsing or an error occured.
+ */
+bool elcsvFinish(csv *pThis) {
+	if(isInvalid(pThis) || pThis->bStopped)
+		return false;
+
+	bool bClosed = true;
+	if(pThis->nCarry > 0) {
+		elcsvParse(pThis, pThis->pCarry, pThis->nCarry, true, true);
+		bClosed = pThis->nCarryInQuote == 0;
+		pThis->nCarry = 0;
+	}
+	pThis->nCarryInQuote = 0;
+
+	return bClosed && !pThis->bStopped;
+}
+
+/**
+ * Returns the number of records parsed (empty lines are not counted).
+ * @param  pThis Parser.
+ * @return       Number of records.
+ */
+size_t elcsvGetCountRecords(csv *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	return pThis->nRecords;
+}
+
+/**
+ * Returns the number of records which number of fields differs from the 
+ * number of columns.
+ * @param  pThis Parser.
+ * @return       Number of malformed records (always 0 for callback).
+ */
+size_t elcsvGetCountMalformed(csv *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	return pThis->nMalformed;
+}
+
+/**
+ * Returns the number of rows in columns.
+ * @param  pThis Parser.
+ * @return       Number of rows.
+ */
+size_t elcsvGetCountRows(csv *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	return pThis->nRows;
+}
+
+/**
+ * Returns the column of fields. It's valid until the next chunk is fed or 
+ * parser is cleared.
+ * @param  pThis   Parser.
+ * @param  nColumn Index of the column.
+ * @return         Fields of the column (or NULL if there is no such column).
+ */
+const strview *elcsvGetColumn(csv *pThis, size_t nColumn) {
+	if(isInvalid(pThis) || nColumn >= pThis->nColumns)
+		return NULL;
+
+	return pThis->arrColumns[nColumn];
+}
@@ -0,0 +1,122 @@
+/* Extreme Library (EL). Delimited records (CSV/TSV) parser. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#ifndef _EL_CSV_H_
+#define _EL_CSV_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "el_str.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Size of arena block holding unquoted fields (in bytes).
+ */
+#define EL_CSV_BLOCK_SIZE	4096
+
+/**
+ * Casts the function to the type of callback receiving fields of records.
+ */
+#define EL_CB_RECORD_FOREACH_EX(s) (bool (*)(const strview *, size_t, void *))(s)
+
+/** 
+ * @brief Kernels classifying blocks of 64 bytes of delimited text. The best 
+ * implementation for the CPU is chosen at first use (scalar, SSE2 or AVX2).
+ */
+typedef struct elcsv_kernels {
+	const char *szName; /**< Name of the implementation. */
+	uint64_t (*structural)(const char *p, size_t nLength, char chDelimiter, 
+		char chQuote, uint64_t *pInQuote); /**< Returns the mask of 
+	delimiters and line feeds which are not quoted in up to 64 bytes. Quote 
+	state is passed in and out as all zeros or all ones. */
+} elcsv_kernels;
+
+/** 
+ * @brief Block of the arena holding unquoted fields.
+ */
+typedef struct elcsv_block {
+	struct elcsv_block *pNext; /**< Previously allocated block. */
+	size_t nUsed; /**< Number of bytes used. */
+	size_t nCapacity; /**< Number of bytes in @e arrData. */
+	char arrData[]; /**< Bytes of the block. */
+} elcsv_block;
+
+/** 
+ * @brief Holds the state of streaming parser of delimited records (CSV, TSV 
+ * and etc.).
+ *
+ * Text is fed in chunks of any size. Fields are views into the chunk fed, 
+ * only quoted fields with escaped quotes are unquoted into the arena, and 
+ * records split between chunks are completed in the carry buffer. Records 
+ * are passed to the callback or gathered into columns of views.
+ */
+typedef struct csv {
+	char chDelimiter; /**< Delimiter of fields. */
+	char chQuote; /**< Quote character. */
+	bool (*recordForEach)(const strview *arrFields, size_t nCount, 
+		void *pData); /**< Callback receiving records (NULL for columns). */
+	void *pData; /**< User data passed to callback. */
+	strview *arrFields; /**< Fields of the current record. */
+	size_t nCountFields; /**< Number of fields of the current record. */
+	size_t nCapacityFields; /**< Number of fields allocated. */
+	char *pCarry; /**< Beginning of the record not completed by the last 
+	chunk. */
+	size_t nCarry; /**< Number of bytes in carry buffer. */
+	size_t nCapacityCarry; /**< Number of bytes allocated for carry buffer. */
+	uint64_t nCarryInQuote; /**< All ones if carry buffer ends inside 
+	quotes. */
+	elcsv_block *pBlocks; /**< Arena blocks (the last allocated first). */
+	strview **arrColumns; /**< Columns of fields (NULL for callback). */
+	size_t nColumns; /**< Number of columns. */
+	size_t nRows; /**< Number of rows in columns. */
+	size_t nCapacityRows; /**< Number of rows allocated. */
+	size_t nRecords; /**< Number of records parsed. */
+	size_t nMalformed; /**< Number of records which number of fields 
+	differs from the number of columns. */
+	bool bStopped; /**< @b True if callback stopped parsing or an error 
+	occured. */
+} csv;
+
+const elcsv_kernels *elcsvGetKernels();
+const char *elcsvGetKernelsName();
+csv *elcsvCreate(char chDelimiter, char chQuote, 
+	bool (*recordForEach)(const strview *arrFields, size_t nCount, 
+	void *pData), void *pData);
+csv *elcsvCreateColumns(char chDelimiter, char chQuote, size_t nColumns);
+void elcsvDestroy(csv *pThis);
+void elcsvClear(csv *pThis);
+bool elcsvFeedView(csv *pThis, strview view);
+bool elcsvFeedELStr(csv *pThis, str *pStr);
+bool elcsvFinish(csv *pThis);
+size_t elcsvGetCountRecords(csv *pThis);
+size_t elcsvGetCountMalformed(csv *pThis);
+size_t elcsvGetCountRows(csv *pThis);
+const strview *elcsvGetColumn(csv *pThis, size_t nColumn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
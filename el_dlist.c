@@ -20,6 +20,7 @@
 #include "el_memory.h"
 
 #include "el_dlist.h"
+#include "el_parallel.h"
 
 #define isInvalid(s) ((s) == NULL)
 #define isInvalidNode(s) ((s) == NULL)
@@ -501,3 +502,274 @@ void eldlistForEachEx(dlist *pThis,
 	}
 	eldlistIteratorDestroy(it);
 }
+
+/** 
+ * @brief Wraps simple foreach callback so it can be called as extended one.
+ */
+typedef struct eldlist_foreach_cb {
+	bool (*dataCallback)(void *pData); /**< Simple callback. */
+} eldlist_foreach_cb;
+
+/**
+ * Calls simple foreach callback stored in @e pEx.
+ * @param  pData Item data.
+ * @param  pEx   Pointer to eldlist_foreach_cb structure.
+ * @return       Value returned by the simple callback.
+ */
+static bool eldlistForEachCallbackAdapter(void *pData, void *pEx) {
+	return ((eldlist_foreach_cb *)pEx)->dataCallback(pData);
+}
+
+/**
+ * Iterates through the doubly linked list and calls specified function for each 
+ * item of the list using several threads. Pointers to the data of all nodes are 
+ * taken before iteration so the callback should not modify the list itself. 
+ * If function returns @b false - stops iteration (items which are being 
+ * processed by other threads at this moment are still completed).
+ * @param pThis        Doubly linked list.
+ * @param dataCallback Callback function to be called for each item of the list.
+ * Must be thread safe.
+ * @param nThreads     Maximal number of threads to use. If 0 - number of 
+ * processors is used.
+ */
+void eldlistForEachParallel(dlist *pThis, bool (*dataCallback)(void *pData), 
+	size_t nThreads) {
+
+	if(isInvalid(pThis))
+		return;
+
+	if(dataCallback == NULL)
+		return;
+
+	eldlist_foreach_cb cb = { dataCallback };
+	eldlistForEachExParallel(pThis, eldlistForEachCallbackAdapter, &cb, 
+		nThreads);
+}
+
+/**
+ * Iterates through the doubly linked list and calls specified function for each 
+ * item of the list using several threads. Passes the pointer to custom data to 
+ * the callback function. Pointers to the data of all nodes are taken before 
+ * iteration so the callback should not modify the list itself. 
+ * If function returns @b false - stops iteration (items which are being 
+ * processed by other threads at this moment are still completed).
+ * @param pThis          Doubly linked list.
+ * @param dataCallbackEx Callback function to be called for each item of the 
+ * list. Must be thread safe.
+ * @param pEx            Pointer to custom data to be sent to callback.
+ * @param nThreads       Maximal number of threads to use. If 0 - number of 
+ * processors is used.
+ */
+void eldlistForEachExParallel(dlist *pThis, 
+	bool (*dataCallbackEx)(void *pData, void *pEx), void *pEx, 
+	size_t nThreads) {
+
+	if(isInvalid(pThis))
+		return;
+
+	if(dataCallbackEx == NULL || pThis->nCount == 0)
+		return;
+
+	void **pItems = EL_ALLOC(sizeof(void *) * pThis->nCount);
+	if(pItems == NULL)
+		return;
+
+	size_t nCount = 0;
+	for(eldlist_node *pNode = pThis->pHead; pNode != NULL; pNode = pNode->pNext)
+		pItems[nCount++] = pNode->pData;
+
+	elparallelForEachEx(pItems, nCount, dataCallbackEx, pEx, nThreads);
+
+	EL_FREE(pItems);
+}
+
+/**
+ * Sorts the doubly linked list in ascending order. Sort is stable (items which 
+ * are equal keep their relative order) and is done in place: nodes are never 
+ * reallocated, only their @e pPrev and @e pNext links are changed.
+ * <br> Bottom-up merge sort is used so complexity of this function is 
+ * O(n log n) and no additional memory is required.
+ * @param pThis     Doubly linked list.
+ * @param dataOrder Pointer to callback function which compares item data. It 
+ * should return negative value if first item is less than second one, zero if 
+ * items are equal and positive value if first item is greater than second one.
+ */
+void eldlistSort(dlist *pThis, int (*dataOrder)(void *p1, void *p2)) {
+	if(isInvalid(pThis))
+		return;
+
+	if(dataOrder == NULL || pThis->nCount < 2)
+		return;
+
+	eldlist_node *pList = pThis->pHead;
+	size_t nWidth = 1;
+
+	while(true) {
+		eldlist_node *p = pList;
+		eldlist_node *pTail = NULL;
+		size_t nMerges = 0;
+
+		pList = NULL;
+
+		// Merge adjacent runs of nWidth nodes. Only pNext links are maintained 
+		//   here, pPrev links are restored after the last pass.
+		while(p != NULL) {
+			nMerges++;
+
+			eldlist_node *q = p;
+			size_t nSizeP = 0;
+			for(size_t i = 0; i < nWidth && q != NULL; i++) {
+				nSizeP++;
+				q = q->pNext;
+			}
+			size_t nSizeQ = nWidth;
+
+			while(nSizeP > 0 || (nSizeQ > 0 && q != NULL)) {
+				eldlist_node *pNode;
+
+				// Take from the left run when items are equal to keep the sort 
+				//   stable.
+				if(nSizeP == 0) {
+					pNode = q;
+					q = q->pNext;
+					nSizeQ--;
+				} else if(nSizeQ == 0 || q == NULL || 
+					dataOrder(p->pData, q->pData) <= 0) {
+
+					pNode = p;
+					p = p->pNext;
+					nSizeP--;
+				} else {
+					pNode = q;
+					q = q->pNext;
+					nSizeQ--;
+				}
+
+				if(pTail != NULL)
+					pTail->pNext = pNode;
+				else
+					pList = pNode;
+				pTail = pNode;
+			}
+
+			p = q;
+		}
+		pTail->pNext = NULL;
+
+		if(nMerges <= 1)
+			break;
+
+		nWidth *= 2;
+	}
+
+	eldlist_node *pPrev = NULL;
+	for(eldlist_node *pNode = pList; pNode != NULL; pNode = pNode->pNext) {
+		pNode->pPrev = pPrev;
+		pPrev = pNode;
+	}
+
+	pThis->pHead = pList;
+	pThis->pTail = pPrev;
+}
+
+/**
+ * Moves all nodes of another doubly linked list (@e pOther) into this list 
+ * before the specified node. Another list becomes empty but is not destroyed.
+ * Moved data will be destroyed by the data destructor of this list.
+ * <br> Complexity of this function is O(1).
+ * @param  pThis       Doubly linked list.
+ * @param  pNodeBefore The node of this list before which nodes should be 
+ * inserted. If NULL - nodes are added at the end of this list.
+ * @param  pOther      Doubly linked list whose nodes are moved. Must differ 
+ * from @e pThis.
+ * @return             True if operation was successful.
+ */
+bool eldlistSplice(dlist *pThis, eldlist_node *pNodeBefore, dlist *pOther) {
+	if(isInvalid(pThis) || isInvalid(pOther))
+		return false;
+
+	if(pThis == pOther)
+		return false;
+
+	if(pOther->nCount == 0)
+		return true;
+
+	eldlist_node *pFirst = pOther->pHead;
+	eldlist_node *pLast = pOther->pTail;
+
+	if(pThis->nCount == 0) {
+		pThis->pHead = pFirst;
+		pThis->pTail = pLast;
+	} else if(pNodeBefore == NULL) {
+		pFirst->pPrev = pThis->pTail;
+		pThis->pTail->pNext = pFirst;
+		pThis->pTail = pLast;
+	} else {
+		pFirst->pPrev = pNodeBefore->pPrev;
+		pLast->pNext = pNodeBefore;
+		if(pNodeBefore->pPrev != NULL)
+			pNodeBefore->pPrev->pNext = pFirst;
+		else
+			pThis->pHead = pFirst;
+		pNodeBefore->pPrev = pLast;
+	}
+	pThis->nCount += pOther->nCount;
+
+	pOther->pHead = NULL;
+	pOther->pTail = NULL;
+	pOther->nCount = 0;
+
+	return true;
+}
+
+/**
+ * Moves all nodes of another doubly linked list (@e pOther) to the end of this
+ * list. Another list becomes empty but is not destroyed.
+ * <br> Complexity of this function is O(1).
+ * @param  pThis  Doubly linked list.
+ * @param  pOther Doubly linked list whose nodes are moved.
+ * @return        True if operation was successful.
+ */
+bool eldlistConcat(dlist *pThis, dlist *pOther) {
+	return eldlistSplice(pThis, NULL, pOther);
+}
+
+/**
+ * Splits the doubly linked list at the specified node. The node and all nodes
+ * after it are moved to the new list, which gets the same data destructor and 
+ * comparer as this list.
+ * <br> Complexity of this function is O(n) (moved nodes need to be counted).
+ * @param  pThis Doubly linked list.
+ * @param  pNode The node of this list to split at.
+ * @return       Newly created doubly linked list (or NULL if an error occured).
+ */
+dlist *eldlistSplitAt(dlist *pThis, eldlist_node *pNode) {
+	if(isInvalid(pThis))
+		return NULL;
+
+	if(isInvalidNode(pNode))
+		return NULL;
+
+	dlist *pOther = eldlistCreate(pThis->dataDestructor, pThis->dataComparer);
+	if(pOther == NULL)
+		return NULL;
+
+	size_t nCount = 0;
+	for(eldlist_node *pCur = pNode; pCur != NULL; pCur = pCur->pNext)
+		nCount++;
+
+	pOther->pHead = pNode;
+	pOther->pTail = pThis->pTail;
+	pOther->nCount = nCount;
+
+	pThis->pTail = pNode->pPrev;
+	if(pThis->pTail != NULL)
+		pThis->pTail->pNext = NULL;
+	else
+		pThis->pHead = NULL;
+	pThis->nCount -= nCount;
+
+	pNode->pPrev = NULL;
+
+	return pOther;
+}
@@ -80,6 +80,11 @@ extern dlist_iterator el_dlist_iterator_rend;
  * enumerator.
  */
 #define EL_CB_FOREACH_EX(s) (bool (*)(void *, void *))(s)
+/** 
+ * @brief Pointer to callback function which compares item data and returns 
+ * negative value, zero or positive value (like strcmp() does).
+ */
+#define EL_CB_DATA_ORDER(s) (int (*)(void *, void *))(s)
 
 eldlist_node *eldlistNodeCreate(void *pData);
 void eldlistNodeDestroy(eldlist_node *pThis, dlist *pDList);
@@ -125,6 +130,15 @@ inline dlist_iterator *eldlistREnd(dlist *pThis)  {
 void eldlistForEach(dlist *pThis, bool (*dataCallback)(void *pData));
 void eldlistForEachEx(dlist *pThis, 
 	bool (*dataCallbackEx)(void *pData, void *pEx), void *pEx);
+void eldlistForEachParallel(dlist *pThis, bool (*dataCallback)(void *pData), 
+	size_t nThreads);
+void eldlistForEachExParallel(dlist *pThis, 
+	bool (*dataCallbackEx)(void *pData, void *pEx), void *pEx, 
+	size_t nThreads);
+void eldlistSort(dlist *pThis, int (*dataOrder)(void *p1, void *p2));
+bool eldlistSplice(dlist *pThis, eldlist_node *pNodeBefore, dlist *pOther);
+bool eldlistConcat(dlist *pThis, dlist *pOther);
+dlist *eldlistSplitAt(dlist *pThis, eldlist_node *pNode);
 
 #ifdef __cplusplus
 }
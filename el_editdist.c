@@ -0,0 +1,675 @@
+/* Extreme Library (EL). Edit distance. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include <string.h>
+#include <stdatomic.h>
+
+#include "el_memory.h"
+#include "el_threadpool.h"
+
+#include "el_editdist.h"
+
+#define isInvalid(s) ((s) == NULL)
+
+/**
+ * Number of blocks which state is kept on the stack (longer patterns 
+ * allocate it).
+ */
+#define EL_EDITDIST_STACK_BLOCKS	32
+
+/**
+ * Row of empty mask for UTF-8 patterns (code points not in the pattern).
+ */
+#define EL_EDITDIST_ROW_NONE	128
+
+/**
+ * First row of code points which are not ASCII.
+ */
+#define EL_EDITDIST_ROW_CODES	129
+
+/** 
+ * @brief Holds the state shared by all threads of one batch computation.
+ */
+typedef struct eleditdist_batch {
+	editdist *pPattern; /**< Pattern. */
+	const strview *arrTexts; /**< Texts. */
+	size_t nMax; /**< Maximal distance of interest. */
+	size_t *arrDistances; /**< Distances (may be NULL). */
+	atomic_size_t nFound; /**< Number of texts within maximal distance. */
+} eleditdist_batch;
+
+/**
+ * Decodes the next UTF-8 code point. Each byte which doesn't start a valid 
+ * sequence is a separate character (above the range of code points).
+ * @param  pp   Pointer to the current byte (moved after the character).
+ * @param  pEnd End of the text.
+ * @return      Code point.
+ */
+static inline uint32_t eleditdistDecode(const unsigned char **pp, 
+	const unsigned char *pEnd) {
+
+	const unsigned char *p = *pp;
+	uint32_t nByte = p[0];
+	if(nByte < 0x80) {
+		*pp = p + 1;
+		return nByte;
+	}
+
+	size_t nLength = nByte >= 0xF0 ? 4 : nByte >= 0xE0 ? 3 : 2;
+	if(nByte >= 0xC2 && nByte <= 0xF4 && (size_t)(pEnd - p) >= nLength) {
+		uint32_t nCode = nByte & (0x7F >> nLength);
+		size_t i = 1;
+		for(; i < nLength && (p[i] & 0xC0) == 0x80; i++)
+			nCode = (nCode << 6) | (p[i] & 0x3F);
+		// overlong sequences and code points above the range are invalid
+		if(i == nLength && (nLength != 3 || nCode >= 0x800) && 
+			(nLength != 4 || (nCode >= 0x10000 && nCode <= 0x10FFFF))) {
+
+			*pp = p + nLength;
+			return nCode;
+		}
+	}
+
+	*pp = p + 1;
+	return 0x110000 + nByte;
+}
+
+/**
+ * Counts characters of UTF-8 text (as eleditdistDecode() splits it).
+ */
+static size_t eleditdistCountUTF8(const unsigned char *p, 
+	const unsigned char *pEnd) {
+
+	size_t nCount = 0;
+	while(p < pEnd) {
+		eleditdistDecode(&p, pEnd);
+		nCount++;
+	}
+
+	return nCount;
+}
+
+/**
+ * Returns the row of masks of the next character of the text.
+ * @param  pThis Pattern.
+ * @param  pp    Pointer to the current byte (moved after the character).
+ * @param  pEnd  End of the text.
+ * @return       Masks of positions of the character in the pattern.
+ */
+static inline const uint64_t *eleditdistNextRow(const editdist *pThis, 
+	const unsigned char **pp, const unsigned char *pEnd) {
+
+	if(!pThis->bUTF8)
+		return pThis->arrPeq + (size_t)*(*pp)++ * pThis->nBlocks;
+
+	uint32_t nCode = eleditdistDecode(pp, pEnd);
+	size_t nRow = EL_EDITDIST_ROW_NONE;
+	if(nCode < 0x80)
+		nRow = nCode;
+	else {
+		size_t nLow = 0;
+		size_t nHigh = pThis->nCodes;
+		while(nLow < nHigh) {
+			size_t nMid = (nLow + nHigh) / 2;
+			if(pThis->arrCodes[nMid] < nCode)
+				nLow = nMid + 1;
+			else
+				nHigh = nMid;
+		}
+		if(nLow < pThis->nCodes && pThis->arrCodes[nLow] == nCode)
+			nRow = EL_EDITDIST_ROW_CODES + nLow;
+	}
+
+	return pThis->arrPeq + nRow * pThis->nBlocks;
+}
+
+/**
+ * Computes the next column of one block of Levenshtein matrix. Vertical 
+ * differences are kept as bit vectors (plus ones and minus ones).
+ * @param  pPv      Positive vertical differences.
+ * @param  pMv      Negative vertical differences.
+ * @param  nEq      Positions of the text character in the block of pattern.
+ * @param  nHin     Horizontal difference at the top of the block (-1, 0, 1).
+ * @param  nOutMask Bit of the row which horizontal difference is returned.
+ * @return          Horizontal difference at the row of @e nOutMask.
+ */
+static inline int eleditdistAdvance(uint64_t *pPv, uint64_t *pMv, 
+	uint64_t nEq, int nHin, uint64_t nOutMask) {
+
+	uint64_t nPv = *pPv;
+	uint64_t nMv = *pMv;
+	uint64_t nHinNegative = (uint64_t)(nHin < 0);
+
+	uint64_t nXv = nEq | nMv;
+	nEq |= nHinNegative;
+	uint64_t nXh = (((nEq & nPv) + nPv) ^ nPv) | nEq;
+	uint64_t nPh = nMv | ~(nXh | nPv);
+	uint64_t nMh = nPv & nXh;
+
+	int nHout = (nPh & nOutMask) != 0 ? 1 : (nMh & nOutMask) != 0 ? -1 : 0;
+
+	nPh = (nPh << 1) | (uint64_t)(nHin > 0);
+	nMh = (nMh << 1) | nHinNegative;
+	*pPv = nMh | ~(nXv | nPh);
+	*pMv = nPh & nXv;
+
+	return nHout;
+}
+
+/**
+ * Computes edit distance for pattern of one block (up to 64 characters).
+ * @param  pThis  Pattern (not empty).
+ * @param  p      Text.
+ * @param  pEnd   End of the text.
+ * @param  nCount Number of characters in the text.
+ * @param  nMax   Maximal distance of interest (SIZE_MAX if unbounded).
+ * @return        Distance (or @e nMax + 1 if it's larger than @e nMax).
+ */
+static size_t eleditdistSingle(const editdist *pThis, const unsigned char *p, 
+	const unsigned char *pEnd, size_t nCount, size_t nMax) {
+
+	uint64_t nPv = ~0ull;
+	uint64_t nMv = 0;
+	uint64_t nLast = 1ull << (pThis->nLength - 1);
+	size_t nScore = pThis->nLength;
+
+	while(p < pEnd) {
+		uint64_t nEq = *eleditdistNextRow(pThis, &p, pEnd);
+		nScore += eleditdistAdvance(&nPv, &nMv, nEq, 1, nLast);
+		nCount--;
+		// each of remaining characters decreases the distance at most by 1
+		if(nMax != SIZE_MAX && nScore > nMax + nCount)
+			return nMax + 1;
+	}
+
+	return nScore;
+}
+
+/**
+ * Computes edit distance for pattern of many blocks. If distance is bounded, 
+ * only blocks holding rows within the band of the diagonal are computed 
+ * (cells below it exceed the bound), and computation stops when all cells 
+ * of the column exceed the bound.
+ * @param  pThis  Pattern (not empty).
+ * @param  p      Text.
+ * @param  pEnd   End of the text.
+ * @param  nMax   Maximal distance of interest (SIZE_MAX if unbounded).
+ * @return        Distance (or @e nMax + 1 if it's larger than @e nMax, or 
+ * EL_EDITDIST_ERROR if an error occured).
+ */
+static size_t eleditdistBlocks(const editdist *pThis, const unsigned char *p, 
+	const unsigned char *pEnd, size_t nMax) {
+
+	size_t nBlocks = pThis->nBlocks;
+	size_t nLength = pThis->nLength;
+	uint64_t arrStack[EL_EDITDIST_STACK_BLOCKS * 3];
+	uint64_t *arrState = arrStack;
+	if(nBlocks > EL_EDITDIST_STACK_BLOCKS) {
+		arrState = EL_ALLOC(nBlocks * 3 * sizeof(uint64_t));
+		if(arrState == NULL)
+			return EL_EDITDIST_ERROR;
+	}
+	uint64_t *arrPv = arrState;
+	uint64_t *arrMv = arrState + nBlocks;
+	// distances at the last row of each block
+	uint64_t *arrScores = arrState + nBlocks * 2;
+
+	uint64_t nLastMask = 1ull << ((nLength - 1) % 64);
+	bool bBounded = nMax != SIZE_MAX;
+	size_t nActive = nBlocks;
+	if(bBounded && nMax < nLength)
+		nActive = nMax / 64 + 1;
+	for(size_t i = 0; i < nActive; i++) {
+		arrPv[i] = ~0ull;
+		arrMv[i] = 0;
+		arrScores[i] = i + 1 < nBlocks ? (i + 1) * 64 : nLength;
+	}
+
+	size_t nColumn = 0;
+	size_t nResult = 0;
+	while(p < pEnd) {
+		const uint64_t *arrEq = eleditdistNextRow(pThis, &p, pEnd);
+		nColumn++;
+
+		// rows up to nColumn + nMax may be within the bound now
+		if(nActive < nBlocks && nColumn + nMax >= nActive * 64) {
+			arrPv[nActive] = ~0ull;
+			arrMv[nActive] = 0;
+			arrScores[nActive] = arrScores[nActive - 1] + 
+				(nActive + 1 < nBlocks ? 64 : nLength - nActive * 64);
+			nActive++;
+		}
+
+		int nHout = 1;
+		bool bExceeded = bBounded;
+		for(size_t i = 0; i < nActive; i++) {
+			uint64_t nOutMask = i + 1 < nBlocks ? 1ull << 63 : nLastMask;
+			nHout = eleditdistAdvance(&arrPv[i], &arrMv[i], arrEq[i], nHout, 
+				nOutMask);
+			arrScores[i] += (uint64_t)(int64_t)nHout;
+			// cells of block differ from the last one at most by its height
+			bExceeded = bExceeded && arrScores[i] > nMax + 63;
+		}
+		if(bExceeded) {
+			nResult = nMax + 1;
+			break;
+		}
+	}
+
+	if(nResult == 0) {
+		// pattern is longer than text and the bound, so the last block may be 
+		// not reached yet
+		if(nActive < nBlocks)
+			nResult = nMax + 1;
+		else {
+			nResult = arrScores[nBlocks - 1];
+			if(bBounded && nResult > nMax)
+				nResult = nMax + 1;
+		}
+	}
+
+	if(arrState != arrStack)
+		EL_FREE(arrState);
+
+	return nResult;
+}
+
+/**
+ * Computes edit distance between the pattern and the text.
+ */
+static size_t eleditdistRun(const editdist *pThis, strview viewText, 
+	size_t nMax) {
+
+	if(viewText.szBuf == NULL && viewText.nLength > 0)
+		return EL_EDITDIST_ERROR;
+
+	const unsigned char *p = (const unsigned char *)viewText.szBuf;
+	const unsigned char *pEnd = p + viewText.nLength;
+	size_t nCount = pThis->bUTF8 ? eleditdistCountUTF8(p, pEnd) : 
+		viewText.nLength;
+
+	// distance never exceeds the length of the longer string
+	size_t nBound = nMax;
+	if(nBound >= pThis->nLength + nCount)
+		nBound = SIZE_MAX;
+
+	if(pThis->nLength == 0)
+		return nCount <= nMax ? nCount : nMax + 1;
+	// distance is at least the difference of lengths
+	if(nBound != SIZE_MAX && (nCount > pThis->nLength + nBound || 
+		pThis->nLength > nCount + nBound))
+		return nMax + 1;
+	if(pThis->nBlocks == 1)
+		return eleditdistSingle(pThis, p, pEnd, nCount, nBound);
+
+	return eleditdistBlocks(pThis, p, pEnd, nBound);
+}
+
+/**
+ * Allocates the pattern and its masks.
+ * @param  nLength Length of the pattern (in characters).
+ * @param  nRows   Number of rows of masks.
+ * @param  bUTF8   If @b true, pattern is compared by code points.
+ * @return         Newly created pattern (or NULL if an error occured).
+ */
+static editdist *eleditdistAlloc(size_t nLength, size_t nRows, bool bUTF8) {
+	editdist *pThis = EL_CALLOC(1, sizeof(editdist));
+	if(pThis == NULL)
+		return NULL;
+
+	pThis->nLength = nLength;
+	pThis->nBlocks = nLength > 0 ? (nLength + 63) / 64 : 1;
+	pThis->bUTF8 = bUTF8;
+	pThis->arrPeq = EL_CALLOC(nRows * pThis->nBlocks, sizeof(uint64_t));
+	if(pThis->arrPeq == NULL) {
+		EL_FREE(pThis);
+		return NULL;
+	}
+
+	return pThis;
+}
+
+/**
+ * Creates the pattern compared with texts byte by byte.
+ * @param  viewPattern Pattern.
+ * @return             Newly created pattern (or NULL if an error occured).
+ */
+editdist *eleditdistCreate(strview viewPattern) {
+	if(viewPattern.szBuf == NULL && viewPattern.nLength > 0)
+		return NULL;
+
+	editdist *pThis = eleditdistAlloc(viewPattern.nLength, 256, false);
+	if(pThis == NULL)
+		return NULL;
+
+	const unsigned char *p = (const unsigned char *)viewPattern.szBuf;
+	for(size_t i = 0; i < viewPattern.nLength; i++)
+		pThis->arrPeq[(size_t)p[i] * pThis->nBlocks + i / 64] |= 
+			1ull << (i % 64);
+
+	return pThis;
+}
+
+/**
+ * Compares code points (for qsort()).
+ */
+static int eleditdistCompareCodes(const void *p1, const void *p2) {
+	uint32_t n1 = *(const uint32_t *)p1;
+	uint32_t n2 = *(const uint32_t *)p2;
+
+	return (n1 > n2) - (n1 < n2);
+}
+
+/**
+ * Creates the pattern compared with texts by UTF-8 code points (each byte of 
+ * invalid sequence is a separate character).
+ * @param  viewPattern Pattern.
+ * @return             Newly created pattern (or NULL if an error occured).
+ */
+editdist *eleditdistCreateUTF8(strview viewPattern) {
+	if(viewPattern.szBuf == NULL && viewPattern.nLength > 0)
+		return NULL;
+
+	const unsigned char *pBegin = (const unsigned char *)viewPattern.szBuf;
+	const unsigned char *pEnd = pBegin + viewPattern.nLength;
+	size_t nLength = eleditdistCountUTF8(pBegin, pEnd);
+
+	// code points which are not ASCII are sorted and made unique
+	uint32_t *arrCodes = NULL;
+	size_t nCodes = 0;
+	if(nLength > 0) {
+		arrCodes = EL_ALLOC(nLength * sizeof(uint32_t));
+		if(arrCodes == NULL)
+			return NULL;
+	}
+	for(const unsigned char *p = pBegin; p < pEnd; ) {
+		uint32_t nCode = eleditdistDecode(&p, pEnd);
+		if(nCode >= 0x80)
+			arrCodes[nCodes++] = nCode;
+	}
+	if(nCodes > 1) {
+		qsort(arrCodes, nCodes, sizeof(uint32_t), eleditdistCompareCodes);
+		size_t nUnique = 1;
+		for(size_t i = 1; i < nCodes; i++)
+			if(arrCodes[i] != arrCodes[nUnique - 1])
+				arrCodes[nUnique++] = arrCodes[i];
+		nCodes = nUnique;
+	}
+
+	editdist *pThis = eleditdistAlloc(nLength, EL_EDITDIST_ROW_CODES + nCodes, 
+		true);
+	if(pThis == NULL) {
+		if(arrCodes != NULL)
+			EL_FREE(arrCodes);
+		return NULL;
+	}
+	pThis->arrCodes = arrCodes;
+	pThis->nCodes = nCodes;
+
+	size_t i = 0;
+	for(const unsigned char *p = pBegin; p < pEnd; i++) {
+		uint64_t *arrRow = (uint64_t *)eleditdistNextRow(pThis, &p, pEnd);
+		arrRow[i / 64] |= 1ull << (i % 64);
+	}
+
+	return pThis;
+}
+
+/**
+ * Destroys the pattern.
+ * @param pThis Pattern.
+ */
+void eleditdistDestroy(editdist *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	EL_FREE(pThis->arrPeq);
+	if(pThis->arrCodes != NULL)
+		EL_FREE(pThis->arrCodes);
+
+	EL_FREE(pThis);
+}
+
+/**
+ * Returns the length of the pattern.
+ * @param  pThis Pattern.
+ * @return       Length (in bytes or code points).
+ */
+size_t eleditdistGetLength(editdist *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	return pThis->nLength;
+}
+
+/**
+ * Computes Levenshtein distance (number of insertions, deletions and 
+ * substitutions) between the pattern and the text. Takes O(n * m / 64) time 
+ * for text of n and pattern of m characters. If distance is bounded, 
+ * computation stops as soon as the bound can't be met.
+ * @param  pThis    Pattern.
+ * @param  viewText Text.
+ * @param  nMax     Maximal distance of interest (SIZE_MAX if unbounded).
+ * @return          Distance (or @e nMax + 1 if it's larger than @e nMax, or 
+ * EL_EDITDIST_ERROR if an error occured).
+ */
+size_t eleditdistCompute(editdist *pThis, strview viewText, size_t nMax) {
+	if(isInvalid(pThis))
+		return EL_EDITDIST_ERROR;
+
+	return eleditdistRun(pThis, viewText, nMax);
+}
+
+/**
+ * Computes distances for a range of texts of the batch.
+ */
+static void eleditdistBatchRange(size_t nBegin, size_t nEnd, 
+	eleditdist_batch *pBatch) {
+
+	size_t nFound = 0;
+	for(size_t i = nBegin; i < nEnd; i++) {
+		size_t nDistance = eleditdistRun(pBatch->pPattern, pBatch->arrTexts[i], 
+			pBatch->nMax);
+		nFound += nDistance <= pBatch->nMax;
+		if(pBatch->arrDistances != NULL)
+			pBatch->arrDistances[i] = nDistance;
+	}
+
+	atomic_fetch_add_explicit(&pBatch->nFound, nFound, memory_order_relaxed);
+}
+
+/**
+ * Computes distances between the pattern and many texts in parallel (by the 
+ * default thread pool).
+ * @param  pThis        Pattern.
+ * @param  arrTexts     Texts.
+ * @param  nCountTexts  Number of texts.
+ * @param  nMax         Maximal distance of interest (SIZE_MAX if unbounded).
+ * @param  arrDistances An array receiving the distance for each text (see 
+ * eleditdistCompute(), may be NULL if only the number of texts is required).
+ * @return              Number of texts within the maximal distance.
+ */
+size_t eleditdistComputeBatch(editdist *pThis, const strview *arrTexts, 
+	size_t nCountTexts, size_t nMax, size_t *arrDistances) {
+
+	if(isInvalid(pThis) || arrTexts == NULL)
+		return 0;
+
+	eleditdist_batch batch;
+	batch.pPattern = pThis;
+	batch.arrTexts = arrTexts;
+	batch.nMax = nMax;
+	batch.arrDistances = arrDistances;
+	atomic_init(&batch.nFound, 0);
+
+	elthreadpoolParallelFor(NULL, 0, nCountTexts, 0, 
+		EL_CB_RANGE(eleditdistBatchRange), &batch);
+
+	return atomic_load(&batch.nFound);
+}
+
+/**
+ * Computes edit distance between two views (the shorter one is the pattern).
+ * @param  view1 The first view.
+ * @param  view2 The second view.
+ * @param  nMax  Maximal distance of interest (SIZE_MAX if unbounded).
+ * @param  bUTF8 If @b true, code points are compared instead of bytes.
+ * @return       Distance (or @e nMax + 1, or EL_EDITDIST_ERROR).
+ */
+static size_t eleditdistPair(strview view1, strview view2, size_t nMax, 
+	bool bUTF8) {
+
+	if((view1.szBuf == NULL && view1.nLength > 0) || 
+		(view2.szBuf == NULL && view2.nLength > 0))
+		return EL_EDITDIST_ERROR;
+
+	if(view1.nLength > view2.nLength) {
+		strview view = view1;
+		view1 = view2;
+		view2 = view;
+	}
+
+	// short byte patterns don't need allocation
+	if(!bUTF8 && view1.nLength <= 64) {
+		editdist pattern;
+		uint64_t arrPeq[256];
+		memset(arrPeq, 0, sizeof(arrPeq));
+		pattern.nLength = view1.nLength;
+		pattern.nBlocks = 1;
+		pattern.bUTF8 = false;
+		pattern.arrPeq = arrPeq;
+		pattern.arrCodes = NULL;
+		pattern.nCodes = 0;
+		const unsigned char *p = (const unsigned char *)view1.szBuf;
+		for(size_t i = 0; i < view1.nLength; i++)
+			arrPeq[p[i]] |= 1ull << i;
+		return eleditdistRun(&pattern, view2, nMax);
+	}
+
+	editdist *pPattern = bUTF8 ? eleditdistCreateUTF8(view1) : 
+		eleditdistCreate(view1);
+	if(pPattern == NULL)
+		return EL_EDITDIST_ERROR;
+	size_t nResult = eleditdistRun(pPattern, view2, nMax);
+	eleditdistDestroy(pPattern);
+
+	return nResult;
+}
+
+/**
+ * Computes Levenshtein distance between two views byte by byte.
+ * @param  view1 The first view.
+ * @param  view2 The second view.
+ * @return       Distance (or EL_EDITDIST_ERROR if an error occured).
+ */
+size_t eleditdistView(strview view1, strview view2) {
+	return eleditdistPair(view1, view2, SIZE_MAX, false);
+}
+
+/**
+ * Computes Levenshtein distance between two views byte by byte if it 
+ * doesn't exceed the maximal one.
+ * @param  view1 The first view.
+ * @param  view2 The second view.
+ * @param  nMax  Maximal distance of interest.
+ * @return       Distance (or @e nMax + 1 if it's larger than @e nMax, or 
+ * EL_EDITDIST_ERROR if an error occured).
+ */
+size_t eleditdistBoundedView(strview view1, strview view2, size_t nMax) {
+	return eleditdistPair(view1, view2, nMax, false);
+}
+
+/**
+ * Computes Levenshtein distance between two views by UTF-8 code points.
+ * @param  view1 The first view.
+ * @param  view2 The second view.
+ * @return       Distance (or EL_EDITDIST_ERROR if an error occured).
+ */
+size_t eleditdistUTF8View(strview view1, strview view2) {
+	return eleditdistPair(view1, view2, SIZE_MAX, true);
+}
+
+/**
+ * Computes Levenshtein distance between two views by UTF-8 code points if 
+ * it doesn't exceed the maximal one.
+ * @param  view1 The first view.
+ * @param  view2 The second view.
+ * @param  nMax  Maximal distance of interest.
+ * @return       Distance (or @e nMax + 1 if it's larger than @e nMax, or 
+ * EL_EDITDIST_ERROR if an error occured).
+ */
+size_t eleditdistUTF8BoundedView(strview view1, strview view2, size_t nMax) {
+	return eleditdistPair(view1, view2, nMax, true);
+}
+
+/**
+ * Computes Levenshtein distance between two dynamic strings byte by byte.
+ * @param  pStr1 The first dynamic string.
+ * @param  pStr2 The second dynamic string.
+ * @return       Distance (or EL_EDITDIST_ERROR if an error occured).
+ */
+size_t eleditdistELStr(str *pStr1, str *pStr2) {
+	return eleditdistBoundedELStr(pStr1, pStr2, SIZE_MAX);
+}
+
+/**
+ * Computes Levenshtein distance between two dynamic strings byte by byte if 
+ * it doesn't exceed the maximal one.
+ * @param  pStr1 The first dynamic string.
+ * @param  pStr2 The second dynamic string.
+ * @param  nMax  Maximal distance of interest.
+ * @return       Distance (or @e nMax + 1 if it's larger than @e nMax, or 
+ * EL_EDITDIST_ERROR if an error occured).
+ */
+size_t eleditdistBoundedELStr(str *pStr1, str *pStr2, size_t nMax) {
+	if(elstrGetRawBuf(pStr1) == NULL || elstrGetRawBuf(pStr2) == NULL)
+		return EL_EDITDIST_ERROR;
+
+	return eleditdistPair(elstrGetView(pStr1), elstrGetView(pStr2), nMax, 
+		false);
+}
+
+/**
+ * Computes Levenshtein distance between two dynamic strings by UTF-8 code 
+ * points.
+ * @param  pStr1 The first dynamic string.
+ * @param  pStr2 The second dynamic string.
+ * @return       Distance (or EL_EDITDIST_ERROR if an error occured).
+ */
+size_t eleditdistUTF8ELStr(str *pStr1, str *pStr2) {
+	return eleditdistUTF8BoundedELStr(pStr1, pStr2, SIZE_MAX);
+}
+
+/**
+ * Computes Levenshtein distance between two dynamic strings by UTF-8 code 
+ * points if it doesn't exceed the maximal one.
+ * @param  pStr1 The first dynamic string.
+ * @param  pStr2 The second dynamic string.
+ * @param  nMax  Maximal distance of interest.
+ * @return       Distance (or @e nMax + 1 if it's larger than @e nMax, or 
+ * EL_EDITDIST_ERROR if an error occured).
+ */
+size_t eleditdistUTF8BoundedELStr(str *pStr1, str *pStr2, size_t nMax) {
+	if(elstrGetRawBuf(pStr1) == NULL || elstrGetRawBuf(pStr2) == NULL)
+		return EL_EDITDIST_ERROR;
+
+	return eleditdistPair(elstrGetView(pStr1), elstrGetView(pStr2), nMax, 
+		true);
+}
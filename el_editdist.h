@@ -0,0 +1,81 @@
+/* Extreme Library (EL). Edit distance. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#ifndef _EL_EDITDIST_H_
+#define _EL_EDITDIST_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "el_str.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 
+ * @brief Distance returned when an error occured.
+ */
+#define EL_EDITDIST_ERROR SIZE_MAX
+
+/** 
+ * @brief Holds the pattern prepared for computing its edit distance to many 
+ * texts.
+ *
+ * Pattern is split into blocks of 64 characters. For each character the bit 
+ * mask of its positions in the pattern is kept, so the whole column of 
+ * Levenshtein matrix is computed by a few word operations per block (Myers' 
+ * bit-parallel algorithm).
+ */
+typedef struct editdist {
+	size_t nLength; /**< Length of the pattern (in bytes or code points). */
+	size_t nBlocks; /**< Number of 64-bit words in the mask of each 
+	character. */
+	bool bUTF8; /**< If @b true, UTF-8 code points are compared instead of 
+	bytes. */
+	uint64_t *arrPeq; /**< Masks of positions of characters: 256 rows for 
+	bytes; 128 ASCII rows, an empty row and rows of @e arrCodes for UTF-8. */
+	uint32_t *arrCodes; /**< Sorted code points (not ASCII) of the 
+	pattern. */
+	size_t nCodes; /**< Number of code points in @e arrCodes. */
+} editdist;
+
+editdist *eleditdistCreate(strview viewPattern);
+editdist *eleditdistCreateUTF8(strview viewPattern);
+void eleditdistDestroy(editdist *pThis);
+size_t eleditdistGetLength(editdist *pThis);
+size_t eleditdistCompute(editdist *pThis, strview viewText, size_t nMax);
+size_t eleditdistComputeBatch(editdist *pThis, const strview *arrTexts, 
+	size_t nCountTexts, size_t nMax, size_t *arrDistances);
+size_t eleditdistView(strview view1, strview view2);
+size_t eleditdistBoundedView(strview view1, strview view2, size_t nMax);
+size_t eleditdistUTF8View(strview view1, strview view2);
+size_t eleditdistUTF8BoundedView(strview view1, strview view2, size_t nMax);
+size_t eleditdistELStr(str *pStr1, str *pStr2);
+size_t eleditdistBoundedELStr(str *pStr1, str *pStr2, size_t nMax);
+size_t eleditdistUTF8ELStr(str *pStr1, str *pStr2);
+size_t eleditdistUTF8BoundedELStr(str *pStr1, str *pStr2, size_t nMax);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,587 @@
+/* Extreme Library (EL). N-Gram fingerprints. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include <string.h>
+#include <stdatomic.h>
+
+#include "el_memory.h"
+#include "el_cpu.h"
+
+#include "el_fingerprint.h"
+
+#define isInvalid(s) ((s) == NULL)
+
+#if EL_CPU_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * Number of fingerprints whose common bits are counted by one kernel call 
+ * during the filtering.
+ */
+#define EL_FINGERPRINTS_BATCH	256
+/**
+ * Initial number of fingerprints memory is allocated for.
+ */
+#define EL_FINGERPRINTS_CAPACITY_MIN	16
+
+/**
+ * Pointer to kernel counting bits set in both the query and each of 
+ * @a nCount fingerprints.
+ */
+typedef void (*elfingerprints_kernel)(const uint64_t *pWords, size_t nWords, 
+	size_t nCount, const uint64_t *pQuery, uint32_t *arrCounts);
+
+/**
+ * Counts bits which are set in a single word without special instructions.
+ * @param  nValue Word.
+ * @return        Number of bits set.
+ */
+static inline uint32_t elfingerprintPopCount(uint64_t nValue) {
+	nValue = nValue - ((nValue >> 1) & 0x5555555555555555ull);
+	nValue = (nValue & 0x3333333333333333ull) + 
+		((nValue >> 2) & 0x3333333333333333ull);
+	nValue = (nValue + (nValue >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+	return (uint32_t)((nValue * 0x0101010101010101ull) >> 56);
+}
+
+/**
+ * Counts common bits of the query and fingerprints (portable implementation).
+ */
+static void elfingerprintsCountAndScalar(const uint64_t *pWords, size_t nWords, 
+	size_t nCount, const uint64_t *pQuery, uint32_t *arrCounts) {
+
+	for(size_t i = 0; i < nCount; i++, pWords += nWords) {
+		uint32_t nResult = 0;
+		for(size_t j = 0; j < nWords; j++)
+			nResult += elfingerprintPopCount(pWords[j] & pQuery[j]);
+		arrCounts[i] = nResult;
+	}
+}
+
+#if EL_CPU_X86
+
+/**
+ * Counts common bits of the query and fingerprints (POPCNT implementation).
+ */
+__attribute__((target("popcnt")))
+static void elfingerprintsCountAndPopcnt(const uint64_t *pWords, size_t nWords, 
+	size_t nCount, const uint64_t *pQuery, uint32_t *arrCounts) {
+
+	for(size_t i = 0; i < nCount; i++, pWords += nWords) {
+		uint32_t nResult = 0;
+		for(size_t j = 0; j < nWords; j++)
+			nResult += (uint32_t)__builtin_popcountll(pWords[j] & pQuery[j]);
+		arrCounts[i] = nResult;
+	}
+}
+
+/**
+ * Counts common bits of the query and a 256-bit part of fingerprint as bytes 
+ * (using in-register lookup table of nibble counts).
+ * @param  pWords Part of fingerprint.
+ * @param  query  Part of query.
+ * @return        Counts of each byte.
+ */
+__attribute__((target("avx2")))
+static inline __m256i elfingerprintsCountAndBytes256(const uint64_t *pWords, 
+	__m256i query) {
+
+	const __m256i lookup = _mm256_setr_epi8(
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i maskLow = _mm256_set1_epi8(0x0F);
+
+	__m256i v = _mm256_and_si256(
+		_mm256_loadu_si256((const __m256i *)pWords), query);
+	__m256i lo = _mm256_and_si256(v, maskLow);
+	__m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), maskLow);
+
+	return _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), 
+		_mm256_shuffle_epi8(lookup, hi));
+}
+
+/**
+ * Counts common bits of the query and a fingerprint as four 64-bit partial 
+ * sums. Byte counts of 512-bit fingerprints are added before summing (they 
+ * don't exceed 16).
+ */
+__attribute__((target("avx2")))
+static inline __m256i elfingerprintsCountAnd256(const uint64_t *pWords, 
+	size_t nWords, __m256i query0, __m256i query1) {
+
+	__m256i cnt = elfingerprintsCountAndBytes256(pWords, query0);
+	if(nWords == 8)
+		cnt = _mm256_add_epi8(cnt, 
+			elfingerprintsCountAndBytes256(pWords + 4, query1));
+
+	return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+/**
+ * Adds up partial sums of two fingerprints.
+ * @param  sum0 Partial sums of the first fingerprint.
+ * @param  sum1 Partial sums of the second fingerprint.
+ * @return      Register with two 32-bit totals in its lowest lanes.
+ */
+__attribute__((target("avx2")))
+static inline __m128i elfingerprintsSumPair(__m256i sum0, __m256i sum1) {
+	__m256i v = _mm256_or_si256(sum0, _mm256_slli_epi64(sum1, 32));
+	__m128i h = _mm_add_epi32(_mm256_castsi256_si128(v), 
+		_mm256_extracti128_si256(v, 1));
+
+	return _mm_add_epi32(h, _mm_unpackhi_epi64(h, h));
+}
+
+/**
+ * Counts common bits of the query and fingerprints (AVX2 implementation). 
+ * Four fingerprints are processed at once, so their totals are stored by 
+ * one instruction.
+ */
+__attribute__((target("avx2")))
+static void elfingerprintsCountAndAVX2(const uint64_t *pWords, size_t nWords, 
+	size_t nCount, const uint64_t *pQuery, uint32_t *arrCounts) {
+
+	__m256i query0 = _mm256_loadu_si256((const __m256i *)pQuery);
+	__m256i query1 = nWords == 8 ? 
+		_mm256_loadu_si256((const __m256i *)(pQuery + 4)) : query0;
+
+	size_t i = 0;
+	for(; i + 4 <= nCount; i += 4, pWords += 4 * nWords) {
+		__m128i pair01 = elfingerprintsSumPair(
+			elfingerprintsCountAnd256(pWords, nWords, query0, query1),
+			elfingerprintsCountAnd256(pWords + nWords, nWords, query0, query1));
+		__m128i pair23 = elfingerprintsSumPair(
+			elfingerprintsCountAnd256(pWords + 2 * nWords, nWords, query0, 
+				query1),
+			elfingerprintsCountAnd256(pWords + 3 * nWords, nWords, query0, 
+				query1));
+		_mm_storeu_si128((__m128i *)(arrCounts + i), 
+			_mm_unpacklo_epi64(pair01, pair23));
+	}
+	for(; i < nCount; i++, pWords += nWords) {
+		__m128i pair = elfingerprintsSumPair(
+			elfingerprintsCountAnd256(pWords, nWords, query0, query1), 
+			_mm256_setzero_si256());
+		arrCounts[i] = (uint32_t)_mm_cvtsi128_si32(pair);
+	}
+}
+
+/**
+ * Counts common bits of the query and fingerprints (AVX-512 implementation). 
+ * Two 256-bit or one 512-bit fingerprint is processed by one instruction.
+ */
+__attribute__((target("avx512f,avx512vpopcntdq")))
+static void elfingerprintsCountAndAVX512(const uint64_t *pWords, size_t nWords, 
+	size_t nCount, const uint64_t *pQuery, uint32_t *arrCounts) {
+
+	size_t i = 0;
+	if(nWords == 8) {
+		__m512i query = _mm512_loadu_si512(pQuery);
+		for(; i < nCount; i++, pWords += 8)
+			arrCounts[i] = (uint32_t)_mm512_reduce_add_epi64(
+				_mm512_popcnt_epi64(_mm512_and_si512(
+					_mm512_loadu_si512(pWords), query)));
+	} else {
+		__m512i query = _mm512_broadcast_i64x4(
+			_mm256_loadu_si256((const __m256i *)pQuery));
+		for(; i + 2 <= nCount; i += 2, pWords += 8) {
+			__m512i cnt = _mm512_popcnt_epi64(_mm512_and_si512(
+				_mm512_loadu_si512(pWords), query));
+			arrCounts[i] = (uint32_t)_mm512_mask_reduce_add_epi64(0x0F, cnt);
+			arrCounts[i + 1] = (uint32_t)_mm512_mask_reduce_add_epi64(0xF0, 
+				cnt);
+		}
+		if(i < nCount)
+			arrCounts[i] = (uint32_t)_mm512_mask_reduce_add_epi64(0x0F, 
+				_mm512_popcnt_epi64(_mm512_and_si512(
+					_mm512_maskz_loadu_epi64(0x0F, pWords), query)));
+	}
+}
+
+#endif
+
+/**
+ * Kernel chosen for the CPU (NULL until the first use).
+ */
+static _Atomic elfingerprints_kernel g_kernel = NULL;
+/**
+ * Name of the kernel chosen.
+ */
+static const char *_Atomic g_szKernelName = NULL;
+
+/**
+ * Returns the kernel counting common bits which is the best for the CPU.
+ * @return Kernel.
+ */
+static elfingerprints_kernel elfingerprintsGetKernel() {
+	elfingerprints_kernel kernel = atomic_load_explicit(&g_kernel, 
+		memory_order_acquire);
+	if(kernel != NULL)
+		return kernel;
+
+	const char *szName = "scalar";
+	kernel = elfingerprintsCountAndScalar;
+#if EL_CPU_X86
+	if(elcpuHas(EL_CPU_AVX512F | EL_CPU_AVX512VPOPCNTDQ)) {
+		szName = "avx512";
+		kernel = elfingerprintsCountAndAVX512;
+	} else if(elcpuHas(EL_CPU_AVX2)) {
+		szName = "avx2";
+		kernel = elfingerprintsCountAndAVX2;
+	} else if(elcpuHas(EL_CPU_POPCNT)) {
+		szName = "popcnt";
+		kernel = elfingerprintsCountAndPopcnt;
+	}
+#endif
+
+	atomic_store_explicit(&g_szKernelName, szName, memory_order_relaxed);
+	atomic_store_explicit(&g_kernel, kernel, memory_order_release);
+
+	return kernel;
+}
+
+/**
+ * Returns the name of kernel chosen for the CPU ("scalar", "popcnt", "avx2" 
+ * or "avx512").
+ * @return Name of kernel.
+ */
+const char *elfingerprintsGetKernelName() {
+	elfingerprintsGetKernel();
+	return atomic_load_explicit(&g_szKernelName, memory_order_relaxed);
+}
+
+/**
+ * Converts the size of fingerprint in bits to the number of words.
+ * @param  nBits Size of fingerprint in bits (256 or 512).
+ * @return       Number of words (or 0 if the size isn't supported).
+ */
+static size_t elfingerprintGetWords(size_t nBits) {
+	if(nBits != 256 && nBits != 512)
+		return 0;
+
+	return nBits / 64;
+}
+
+/**
+ * Hashes each N-Gram into one bit of the fingerprint.
+ * @param pWords       Fingerprint (must be zeroed).
+ * @param nWords       Number of words of fingerprint.
+ * @param pNGrams      An array of N-Grams.
+ * @param nCountNGrams Number of N-Grams in the array.
+ * @return             Number of bits set.
+ */
+static size_t elfingerprintBuild(uint64_t *pWords, size_t nWords, 
+	str **pNGrams, size_t nCountNGrams) {
+
+	size_t nMask = nWords * 64 - 1;
+	for(size_t i = 0; i < nCountNGrams; i++) {
+		size_t nBit = (size_t)elstrGetHashCode64(pNGrams[i]) & nMask;
+		pWords[nBit / 64] |= (uint64_t)1 << (nBit % 64);
+	}
+
+	size_t nPopCount = 0;
+	for(size_t i = 0; i < nWords; i++)
+		nPopCount += elfingerprintPopCount(pWords[i]);
+
+	return nPopCount;
+}
+
+/**
+ * Computes the upper bound of elstrMBCompareNGrams() result. Each bit set 
+ * only in one fingerprint comes from at least one N-Gram which has no match, 
+ * so the bound is: <br>
+ * (Count1 + Count2 - PopCount1 - PopCount2 + 2 * PopCount(Fingerprint1 AND 
+ * Fingerprint2)) / (Count1 + Count2).
+ * @param  nCountNGrams1 Number of N-Grams of the first fingerprint.
+ * @param  nPopCount1    Number of bits set in the first fingerprint.
+ * @param  nCountNGrams2 Number of N-Grams of the second fingerprint.
+ * @param  nPopCount2    Number of bits set in the second fingerprint.
+ * @param  nPopCountAnd  Number of bits set in both fingerprints.
+ * @return               Upper bound of similarity coefficient.
+ */
+static inline float elfingerprintComputeUpperBound(size_t nCountNGrams1, 
+	size_t nPopCount1, size_t nCountNGrams2, size_t nPopCount2, 
+	size_t nPopCountAnd) {
+
+	if(nCountNGrams1 == 0 || nCountNGrams2 == 0)
+		return 0;
+
+	size_t nBound = nCountNGrams1 + nCountNGrams2 - nPopCount1 - nPopCount2 + 
+		2 * nPopCountAnd;
+
+	// computed the same way as the similarity, so the bound is never below it
+	return (nBound * 1.0f) / (nCountNGrams1 + nCountNGrams2);
+}
+
+/**
+ * Creates new fingerprint of an array of N-Grams (for example created by 
+ * elstrMBCreateNGrams()).
+ * @param  nBits        Size of fingerprint in bits (256 or 512).
+ * @param  pNGrams      An array of N-Grams.
+ * @param  nCountNGrams Number of N-Grams in the array.
+ * @return              Newly created fingerprint (or NULL if an error 
+ * occured).
+ */
+fingerprint *elfingerprintCreate(size_t nBits, str **pNGrams, 
+	size_t nCountNGrams) {
+
+	size_t nWords = elfingerprintGetWords(nBits);
+	if(nWords == 0 || (isInvalid(pNGrams) && nCountNGrams != 0))
+		return NULL;
+
+	fingerprint *pThis = (fingerprint *)EL_CALLOC(1, sizeof(fingerprint));
+	if(isInvalid(pThis))
+		return NULL;
+
+	pThis->nWords = nWords;
+	pThis->nCountNGrams = nCountNGrams;
+	pThis->nPopCount = elfingerprintBuild(pThis->arrWords, nWords, pNGrams, 
+		nCountNGrams);
+
+	return pThis;
+}
+
+/**
+ * Destroys the fingerprint.
+ * @param pThis Fingerprint to be destroyed.
+ */
+void elfingerprintDestroy(fingerprint *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	EL_FREE(pThis);
+}
+
+/**
+ * Returns the upper bound of similarity coefficient of N-Gram arrays which 
+ * fingerprints are compared. If the bound is below the threshold, 
+ * elstrMBCompareNGrams() doesn't need to be called.
+ * @param  pThis  First fingerprint.
+ * @param  pOther Second fingerprint (must have the same size).
+ * @return        Upper bound of similarity coefficient from interval [0,1].
+ */
+float elfingerprintGetUpperBound(fingerprint *pThis, fingerprint *pOther) {
+	if(isInvalid(pThis) || isInvalid(pOther) || pThis->nWords != pOther->nWords)
+		return 0;
+
+	size_t nPopCountAnd = 0;
+	for(size_t i = 0; i < pThis->nWords; i++)
+		nPopCountAnd += elfingerprintPopCount(pThis->arrWords[i] & 
+			pOther->arrWords[i]);
+
+	return elfingerprintComputeUpperBound(pThis->nCountNGrams, 
+		pThis->nPopCount, pOther->nCountNGrams, pOther->nPopCount, 
+		nPopCountAnd);
+}
+
+/**
+ * Creates new empty array of fingerprints.
+ * @param  nBits Size of fingerprints in bits (256 or 512).
+ * @return       Newly created array (or NULL if an error occured).
+ */
+fingerprints *elfingerprintsCreate(size_t nBits) {
+	size_t nWords = elfingerprintGetWords(nBits);
+	if(nWords == 0)
+		return NULL;
+
+	fingerprints *pThis = (fingerprints *)EL_CALLOC(1, sizeof(fingerprints));
+	if(isInvalid(pThis))
+		return NULL;
+
+	pThis->nWords = nWords;
+
+	return pThis;
+}
+
+/**
+ * Destroys the array of fingerprints.
+ * @param pThis Array of fingerprints to be destroyed.
+ */
+void elfingerprintsDestroy(fingerprints *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	EL_FREE(pThis->arrWords);
+	EL_FREE(pThis->arrCountNGrams);
+	EL_FREE(pThis->arrPopCounts);
+	EL_FREE(pThis);
+}
+
+/**
+ * Removes all fingerprints (memory allocated isn't freed).
+ * @param pThis Array of fingerprints.
+ */
+void elfingerprintsClear(fingerprints *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	pThis->nCount = 0;
+}
+
+/**
+ * Returns the number of fingerprints.
+ * @param  pThis Array of fingerprints.
+ * @return       Number of fingerprints.
+ */
+size_t elfingerprintsGetCount(fingerprints *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	return pThis->nCount;
+}
+
+/**
+ * Makes sure memory is allocated for one more fingerprint.
+ * @param  pThis Array of fingerprints.
+ * @return       @b True if memory is allocated, or @b false if an error 
+ * occured.
+ */
+static bool elfingerprintsGrow(fingerprints *pThis) {
+	if(pThis->nCount < pThis->nCapacity)
+		return true;
+
+	size_t nCapacity = pThis->nCapacity * 2;
+	if(nCapacity < EL_FINGERPRINTS_CAPACITY_MIN)
+		nCapacity = EL_FINGERPRINTS_CAPACITY_MIN;
+
+	uint64_t *arrWords = (uint64_t *)EL_REALLOC(pThis->arrWords, 
+		nCapacity * pThis->nWords * sizeof(uint64_t));
+	if(isInvalid(arrWords))
+		return false;
+	pThis->arrWords = arrWords;
+
+	uint32_t *arrCountNGrams = (uint32_t *)EL_REALLOC(pThis->arrCountNGrams, 
+		nCapacity * sizeof(uint32_t));
+	if(isInvalid(arrCountNGrams))
+		return false;
+	pThis->arrCountNGrams = arrCountNGrams;
+
+	uint16_t *arrPopCounts = (uint16_t *)EL_REALLOC(pThis->arrPopCounts, 
+		nCapacity * sizeof(uint16_t));
+	if(isInvalid(arrPopCounts))
+		return false;
+	pThis->arrPopCounts = arrPopCounts;
+
+	pThis->nCapacity = nCapacity;
+
+	return true;
+}
+
+/**
+ * Adds the fingerprint of an array of N-Grams (for example created by 
+ * elstrMBCreateNGrams()).
+ * @param  pThis        Array of fingerprints.
+ * @param  pNGrams      An array of N-Grams.
+ * @param  nCountNGrams Number of N-Grams in the array (less than 2^32).
+ * @return              Index of the fingerprint added (or 
+ * EL_FINGERPRINTS_NPOS if an error occured).
+ */
+size_t elfingerprintsAdd(fingerprints *pThis, str **pNGrams, 
+	size_t nCountNGrams) {
+
+	if(isInvalid(pThis) || (isInvalid(pNGrams) && nCountNGrams != 0) || 
+		nCountNGrams > UINT32_MAX)
+		return EL_FINGERPRINTS_NPOS;
+
+	if(!elfingerprintsGrow(pThis))
+		return EL_FINGERPRINTS_NPOS;
+
+	size_t nIndex = pThis->nCount;
+	uint64_t *pWords = pThis->arrWords + nIndex * pThis->nWords;
+	memset(pWords, 0, pThis->nWords * sizeof(uint64_t));
+	pThis->arrPopCounts[nIndex] = (uint16_t)elfingerprintBuild(pWords, 
+		pThis->nWords, pNGrams, nCountNGrams);
+	pThis->arrCountNGrams[nIndex] = (uint32_t)nCountNGrams;
+	pThis->nCount++;
+
+	return nIndex;
+}
+
+/**
+ * Returns the upper bound of similarity coefficient of the query and N-Grams 
+ * of the fingerprint.
+ * @param  pThis  Array of fingerprints.
+ * @param  nIndex Index of the fingerprint.
+ * @param  pQuery Fingerprint of the query (must have the same size).
+ * @return        Upper bound of similarity coefficient from interval [0,1].
+ */
+float elfingerprintsGetUpperBound(fingerprints *pThis, size_t nIndex, 
+	fingerprint *pQuery) {
+
+	if(isInvalid(pThis) || isInvalid(pQuery) || nIndex >= pThis->nCount || 
+		pQuery->nWords != pThis->nWords)
+		return 0;
+
+	uint32_t nPopCountAnd;
+	elfingerprintsGetKernel()(pThis->arrWords + nIndex * pThis->nWords, 
+		pThis->nWords, 1, pQuery->arrWords, &nPopCountAnd);
+
+	return elfingerprintComputeUpperBound(pThis->arrCountNGrams[nIndex], 
+		pThis->arrPopCounts[nIndex], pQuery->nCountNGrams, pQuery->nPopCount, 
+		nPopCountAnd);
+}
+
+/**
+ * Finds the fingerprints which similarity with the query may reach the 
+ * threshold. Other fingerprints are guaranteed to have similarity coefficient 
+ * (computed by elstrMBCompareNGrams()) below the threshold, so they can be 
+ * skipped. Common bits are counted with SIMD instructions if the CPU supports 
+ * them.
+ * @param  pThis      Array of fingerprints.
+ * @param  pQuery     Fingerprint of the query (must have the same size).
+ * @param  fThreshold Minimal similarity coefficient.
+ * @param  arrIndices An array receiving indices of the fingerprints found in 
+ * ascending order (must have room for all fingerprints).
+ * @return            Number of fingerprints found.
+ */
+size_t elfingerprintsFilter(fingerprints *pThis, fingerprint *pQuery, 
+	float fThreshold, size_t *arrIndices) {
+
+	if(isInvalid(pThis) || isInvalid(pQuery) || isInvalid(arrIndices) || 
+		pQuery->nWords != pThis->nWords)
+		return 0;
+
+	elfingerprints_kernel kernel = elfingerprintsGetKernel();
+	uint32_t arrCounts[EL_FINGERPRINTS_BATCH];
+	size_t nResult = 0;
+
+	for(size_t nStart = 0; nStart < pThis->nCount; 
+		nStart += EL_FINGERPRINTS_BATCH) {
+
+		size_t nCount = pThis->nCount - nStart;
+		if(nCount > EL_FINGERPRINTS_BATCH)
+			nCount = EL_FINGERPRINTS_BATCH;
+
+		kernel(pThis->arrWords + nStart * pThis->nWords, pThis->nWords, nCount, 
+			pQuery->arrWords, arrCounts);
+
+		for(size_t i = 0; i < nCount; i++) {
+			float fBound = elfingerprintComputeUpperBound(
+				pThis->arrCountNGrams[nStart + i], 
+				pThis->arrPopCounts[nStart + i], pQuery->nCountNGrams, 
+				pQuery->nPopCount, arrCounts[i]);
+			if(fBound >= fThreshold)
+				arrIndices[nResult++] = nStart + i;
+		}
+	}
+
+	return nResult;
+}
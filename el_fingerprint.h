@@ -0,0 +1,90 @@
+/* Extreme Library (EL). N-Gram fingerprints. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#ifndef _EL_FINGERPRINT_H_
+#define _EL_FINGERPRINT_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "el_str.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 
+ * @brief Maximal number of 64-bit words in a fingerprint.
+ */
+#define EL_FINGERPRINT_WORDS_MAX 8
+
+/** 
+ * @brief Position returned when the fingerprint can't be added.
+ */
+#define EL_FINGERPRINTS_NPOS ((size_t)-1)
+
+/** 
+ * @brief Holds the fingerprint of a single array of N-Grams (used as a query).
+ *
+ * Each N-Gram is hashed into one bit of the fingerprint.
+ */
+typedef struct fingerprint {
+	uint64_t arrWords[EL_FINGERPRINT_WORDS_MAX]; /**< Bits of fingerprint. */
+	size_t nWords; /**< Number of words used (4 or 8). */
+	size_t nCountNGrams; /**< Number of N-Grams hashed. */
+	size_t nPopCount; /**< Number of bits set. */
+} fingerprint;
+
+/** 
+ * @brief Holds fingerprints of many arrays of N-Grams in contiguous memory, so 
+ * they can be scanned fast.
+ */
+typedef struct fingerprints {
+	size_t nWords; /**< Number of words of each fingerprint (4 or 8). */
+	size_t nCount; /**< Number of fingerprints. */
+	size_t nCapacity; /**< Number of fingerprints memory is allocated for. */
+	uint64_t *arrWords; /**< Bits of all fingerprints, one after another. */
+	uint32_t *arrCountNGrams; /**< Number of N-Grams of each fingerprint. */
+	uint16_t *arrPopCounts; /**< Number of bits set in each fingerprint. */
+} fingerprints;
+
+fingerprint *elfingerprintCreate(size_t nBits, str **pNGrams, 
+	size_t nCountNGrams);
+void elfingerprintDestroy(fingerprint *pThis);
+float elfingerprintGetUpperBound(fingerprint *pThis, fingerprint *pOther);
+
+fingerprints *elfingerprintsCreate(size_t nBits);
+void elfingerprintsDestroy(fingerprints *pThis);
+void elfingerprintsClear(fingerprints *pThis);
+size_t elfingerprintsGetCount(fingerprints *pThis);
+size_t elfingerprintsAdd(fingerprints *pThis, str **pNGrams, 
+	size_t nCountNGrams);
+float elfingerprintsGetUpperBound(fingerprints *pThis, size_t nIndex, 
+	fingerprint *pQuery);
+size_t elfingerprintsFilter(fingerprints *pThis, fingerprint *pQuery, 
+	float fThreshold, size_t *arrIndices);
+const char *elfingerprintsGetKernelName();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1297 @@
+/* Extreme Library (EL). Number formatting. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include <string.h>
+#include <stdio.h>
+
+#include "el_numfmt.h"
+
+/**
+ * Number of decimal digits fitting into unsigned 128-bit integer products 
+ * used by fixed notation (2^53 * 10^22 < 2^128).
+ */
+#define EL_NUMFMT_FIXED_DECIMALS_MAX	22
+
+/**
+ * Pairs of decimal digits from "00" to "99".
+ */
+static const char g_arrDigitPairs[201] = 
+	"00010203040506070809101112131415161718192021222324252627282930313233"
+	"34353637383940414243444546474849505152535455565758596061626364656667"
+	"68697071727374757677787980818283848586878889909192939495969798"
+	"99";
+
+/**
+ * Inverted powers of 5 (2^(bits(5^i) - 1 + 125) / 5^i + 1), low word first.
+ */
+static const uint64_t g_arrPow5InvSplit[342][2] = {
+	{ 0x1ull, 0x2000000000000000ull },
+	{ 0x999999999999999Aull, 0x1999999999999999ull },
+	{ 0x47AE147AE147AE15ull, 0x147AE147AE147AE1ull },
+	{ 0x6C8B4395810624DEull, 0x10624DD2F1A9FBE7ull },
+	{ 0x7A786C226809D496ull, 0x1A36E2EB1C432CA5ull },
+	{ 0x61F9F01B866E43ABull, 0x14F8B588E368F084ull },
+	{ 0xB4C7F34938583622ull, 0x10C6F7A0B5ED8D36ull },
+	{ 0x87A6520EC08D236Aull, 0x1AD7F29ABCAF4857ull },
+	{ 0x9FB841A566D74F88ull, 0x15798EE2308C39DFull },
+	{ 0xE62D01511F12A607ull, 0x112E0BE826D694B2ull },
+	{ 0xD6AE6881CB5109A4ull, 0x1B7CDFD9D7BDBAB7ull },
+	{ 0xDEF1ED34A2A73AEAull, 0x15FD7FE17964955Full },
+	{ 0x7F27F0F6E885C8BBull, 0x119799812DEA1119ull },
+	{ 0x650CB4BE40D60DF8ull, 0x1C25C268497681C2ull },
+	{ 0xEA70909833DE7193ull, 0x16849B86A12B9B01ull },
+	{ 0x21F3A6E0297EC143ull, 0x1203AF9EE756159Bull },
+	{ 0x6985D7CD0F313537ull, 0x1CD2B297D889BC2Bull },
+	{ 0x2137DFD73F5A90F9ull, 0x170EF54646D49689ull },
+	{ 0xE75FE645CC4873FAull, 0x12725DD1D243ABA0ull },
+	{ 0xA5663D3C7A0D865Dull, 0x1D83C94FB6D2AC34ull },
+	{ 0x511E976394D79EB1ull, 0x179CA10C9242235Dull },
+	{ 0xDA7EDF82DD794BC1ull, 0x12E3B40A0E9B4F7Dull },
+	{ 0x2A6498D1625BAC68ull, 0x1E392010175EE596ull },
+	{ 0xEEB6E0A781E2F053ull, 0x182DB34012B25144ull },
+	{ 0x58924D52CE4F26A9ull, 0x1357C299A88EA76Aull },
+	{ 0x27507BB7B07EA441ull, 0x1EF2D0F5DA7DD8AAull },
+	{ 0x52A6C95FC0655034ull, 0x18C240C4AECB13BBull },
+	{ 0xEEBD44C99EAA690ull, 0x13CE9A36F23C0FC9ull },
+	{ 0xB17953ADC3110A80ull, 0x1FB0F6BE50601941ull },
+	{ 0xC12DDC8B02740867ull, 0x195A5EFEA6B34767ull },
+	{ 0x3424B06F3529A052ull, 0x14484BFEEBC29F86ull },
+	{ 0x901D59F290EE19DBull, 0x1039D66589687F9Eull },
+	{ 0x4CFBC31DB4B0295Full, 0x19F623D5A8A73297ull },
+	{ 0x3D9635B15D59BAB2ull, 0x14C4E977BA1F5BACull },
+	{ 0x97AB5E277DE16228ull, 0x109D8792FB4C4956ull },
+	{ 0xF2ABC9D8C9689D0Dull, 0x1A95A5B7F87A0EF0ull },
+	{ 0x5BBCA17A3ABA173Eull, 0x154484932D2E725Aull },
+	{ 0xAFCA1AC82EFB45CBull, 0x11039D428A8B8EAEull },
+	{ 0xB2DCF7A6B1920945ull, 0x1B38FB9DAA78E44Aull },
+	{ 0xF57D92EBC141A104ull, 0x15C72FB1552D836Eull },
+	{ 0xC46475896767B403ull, 0x116C262777579C58ull },
+	{ 0x6D6D88DBD8A5ECD2ull, 0x1BE03D0BF225C6F4ull },
+	{ 0x8ABE071646EB23DBull, 0x164CFDA3281E38C3ull },
+	{ 0x6EFE6C11D255B649ull, 0x11D7314F534B609Cull },
+	{ 0xB197134FB6EF8A0Eull, 0x1C8B821885456760ull },
+	{ 0x27AC0F72F8BFA1A5ull, 0x16D601AD376AB91Aull },
+	{ 0xB95672C260994E1Eull, 0x1244CE242C5560E1ull },
+	{ 0xF5571E03CDC21695ull, 0x1D3AE36D13BBCE35ull },
+	{ 0x2AAC18030B01ABABull, 0x17624F8A762FD82Bull },
+	{ 0xBBBCE0026F348956ull, 0x12B50C6EC4F31355ull },
+	{ 0x92C7CCD0B1EDA889ull, 0x1DEE7A4AD4B81EEFull },
+	{ 0xDBD30A408E57BA07ull, 0x17F1FB6F10934BF2ull },
+	{ 0x7CA8D50071DFC806ull, 0x1327FC58DA0F6FF5ull },
+	{ 0xFAA7BB33E9660CD6ull, 0x1EA6608E29B24CBBull },
+	{ 0x9552FC298784D711ull, 0x18851A0B548EA3C9ull },
+	{ 0xAAA8C9BAD2D0AC0Eull, 0x139DAE6F76D88307ull },
+	{ 0xDDDADC5E1E1AACE3ull, 0x1F62B0B257C0D1A5ull },
+	{ 0x7E48B04B4B488A4Full, 0x191BC08EAC9A4151ull },
+	{ 0xCB6D59D5D5D3A1D9ull, 0x141633A556E1CDDAull },
+	{ 0x3C577B1177DC817Bull, 0x1011C2EAABE7D7E2ull },
+	{ 0xC6F25E825960CF2Aull, 0x19B604AAACA62636ull },
+	{ 0x6BF518684780A5BBull, 0x14919D5556EB51C5ull },
+	{ 0x232A79ED06008496ull, 0x10747DDDDF22A7D1ull },
+	{ 0xD1DD8FE1A3340756ull, 0x1A53FC9631D10C81ull },
+	{ 0xA7E4731AE8F66C45ull, 0x150FFD44F4A73D34ull },
+	{ 0x531D28E253F8569Eull, 0x10D9976A5D52975Dull },
+	{ 0xEB61DB03B98D5762ull, 0x1AF5BF109550F22Eull },
+	{ 0xBC4E48CFC7A445E8ull, 0x159165A6DDDA5B58ull },
+	{ 0x6371D3D96C836B20ull, 0x11411E1F17E1E2ADull },
+	{ 0x9F1C8628AD9F11CDull, 0x1B9B6364F3030448ull },
+	{ 0xE5B06B53BE18DB0Bull, 0x1615E91D8F359D06ull },
+	{ 0xEAF3890FCB4715A2ull, 0x11AB20E472914A6Bull },
+	{ 0x44B8DB4C7871BC37ull, 0x1C45016D841BAA46ull },
+	{ 0x3C715D6C6C1635Full, 0x169D9ABE03495505ull },
+	{ 0x3638DE456BCDE919ull, 0x1217AEFE69077737ull },
+	{ 0x56C163A2461641C1ull, 0x1CF2B1970E725858ull },
+	{ 0xDF011C81D1AB67CEull, 0x17288E1271F51379ull },
+	{ 0x7F3416CE4155ECA5ull, 0x1286D80EC190DC61ull },
+	{ 0x6520247D3556476Eull, 0x1DA48CE468E7C702ull },
+	{ 0xEA801D30F7783925ull, 0x17B6D71D20B96C01ull },
+	{ 0xBB99B0F3F92CFA84ull, 0x12F8AC174D612334ull },
+	{ 0x5F5C4E532847F739ull, 0x1E5AACF215683854ull },
+	{ 0x7F7D0B75B9D32C2Eull, 0x18488A5B44536043ull },
+	{ 0x9930D5F7C7DC2358ull, 0x136D3B7C36A919CFull },
+	{ 0x8EB4898C72F9D226ull, 0x1F152BF9F10E8FB2ull },
+	{ 0x722A07A38F2E41B8ull, 0x18DDBCC7F40BA628ull },
+	{ 0xC1BB394FA5BE9AFAull, 0x13E497065CD61E86ull },
+	{ 0x9C5EC2190930F7F6ull, 0x1FD424D6FAF030D7ull },
+	{ 0x49E56814075A5FF8ull, 0x197683DF2F268D79ull },
+	{ 0x6E51201005E1E660ull, 0x145ECFE5BF520AC7ull },
+	{ 0xF1DA800CD181851Aull, 0x104BD984990E6F05ull },
+	{ 0x4FC400148268D4F5ull, 0x1A12F5A0F4E3E4D6ull },
+	{ 0xD96999AA01ED772Bull, 0x14DBF7B3F71CB711ull },
+	{ 0xADEE1488018AC5BCull, 0x10AFF95CC5B09274ull },
+	{ 0x497CEDA668DE092Cull, 0x1AB328946F80EA54ull },
+	{ 0x3ACA57B853E4D424ull, 0x155C2076BF9A5510ull },
+	{ 0x623B7960431D7683ull, 0x1116805EFFAEAA73ull },
+	{ 0x9D2BF566D1C8BD9Eull, 0x1B5733CB32B110B8ull },
+	{ 0x7DBCC452416D647Full, 0x15DF5CA28EF40D60ull },
+	{ 0xCAFD69DB678AB6CCull, 0x117F7D4ED8C33DE6ull },
+	{ 0xAB2F0FC572778ADFull, 0x1BFF2EE48E052FD7ull },
+	{ 0x88F273045B92D580ull, 0x1665BF1D3E6A8CACull },
+	{ 0xD3F528D049424466ull, 0x11EAFF4A98553D56ull },
+	{ 0xB988414D4203A0A3ull, 0x1CAB3210F3BB9557ull },
+	{ 0x6139CDD76802E6E9ull, 0x16EF5B40C2FC7779ull },
+	{ 0xE761717920025254ull, 0x125915CD68C9F92Dull },
+	{ 0xA568B58E999D5086ull, 0x1D5B561574765B7Cull },
+	{ 0x5120913EE14AA6D2ull, 0x177C44DDF6C515FDull },
+	{ 0xA74D40FF1AA21F0Eull, 0x12C9D0B1923744CAull },
+	{ 0xBAECE64F769CB4Aull, 0x1E0FB44F50586E11ull },
+	{ 0x3C8BD850C5EE3C3Bull, 0x180C903F7379F1A7ull },
+	{ 0xCA0979DA37F1C9C9ull, 0x133D4032C2C7F485ull },
+	{ 0xA9A8C2F6BFE942DBull, 0x1EC866B79E0CBA6Full },
+	{ 0x2153CF2BCCBA9BE3ull, 0x18A0522C7E709526ull },
+	{ 0x1AA9728970954982ull, 0x13B374F06526DDB8ull },
+	{ 0xF775840F1A88759Dull, 0x1F8587E7083E2F8Cull },
+	{ 0x5F9136727BA05E17ull, 0x19379FEC0698260Aull },
+	{ 0x1940F85B9619E4DFull, 0x142C7FF0054684D5ull },
+	{ 0xE100C6AFAB47EA4Cull, 0x1023998CD1053710ull },
+	{ 0xCE67A44C453FDD47ull, 0x19D28F47B4D524E7ull },
+	{ 0xD852E9D69DCCB106ull, 0x14A8729FC3DDB71Full },
+	{ 0x79DBEE454B0A2738ull, 0x1086C219697E2C19ull },
+	{ 0x295FE3A211A9D859ull, 0x1A71368F0F30468Full },
+	{ 0xBAB31C81A7BB137Aull, 0x15275ED8D8F36BA5ull },
+	{ 0x6228E39AEC95A92Full, 0x10EC4BE0AD8F8951ull },
+	{ 0x9D0E38F7E0EF7517ull, 0x1B13AC9AAF4C0EE8ull },
+	{ 0xB0D82D931A592A79ull, 0x15A956E225D67253ull },
+	{ 0x8D79BE0F4847552Eull, 0x11544581B7DEC1DCull },
+	{ 0x158F967EDA0BBB7Cull, 0x1BBA08CF8C979C94ull },
+	{ 0x77A611FF14D62F97ull, 0x162E6D72D6DFB076ull },
+	{ 0xF951A7FF43DE8C79ull, 0x11BEBDF578B2F391ull },
+	{ 0xC21C3FFED2FDAD8Eull, 0x1C6463225AB7EC1Cull },
+	{ 0x1B0333242648AD8ull, 0x16B6B5B5155FF017ull },
+	{ 0x159C28E9B83A246ull, 0x122BC490DDE659ACull },
+	{ 0xCEF604175F3903A3ull, 0x1D12D41AFCA3C2ACull },
+	{ 0x725E69AC4C2D9C83ull, 0x17424348CA1C9BBDull },
+	{ 0xF5185489D68AE39Cull, 0x129B69070816E2FDull },
+	{ 0xEE8D540FBDAB05C6ull, 0x1DC574D80CF16B2Full },
+	{ 0xBED77672FE226B05ull, 0x17D12A4670C1228Cull },
+	{ 0xFF12C528CB4EBC04ull, 0x130DBB6B8D674ED6ull },
+	{ 0xCB513B74787DF9A0ull, 0x1E7C5F127BD87E24ull },
+	{ 0x90DC929F9FE614Dull, 0x18637F41FCAD31B7ull },
+	{ 0xA0D7D42194CB810Aull, 0x1382CC34CA2427C5ull },
+	{ 0x67BFB9CF5478CE77ull, 0x1F37AD21436D0C6Full },
+	{ 0x1FCC94A5DD2D71F9ull, 0x18F9574DCF8A7059ull },
+	{ 0x7FD6DD517DBDF4C7ull, 0x13FAAC3E3FA1F37Aull },
+	{ 0xFFBE2EE8C92FEE0Bull, 0x1FF779FD329CB8C3ull },
+	{ 0x6631BF20A0F324D6ull, 0x1992C7FDC216FA36ull },
+	{ 0xB827CC1A1A5C1D78ull, 0x14756CCB01ABFB5Eull },
+	{ 0x935309AE7B7CE460ull, 0x105DF0A267BCC918ull },
+	{ 0x1EEB42B0C594A099ull, 0x1A2FE76A3F9474F4ull },
+	{ 0xE58902270476E6E1ull, 0x14F31F8832DD2A5Cull },
+	{ 0xB7A0CE859D2BEBE7ull, 0x10C27FA028B0EEB0ull },
+	{ 0x59014A6F61DFDFD8ull, 0x1AD0CC33744E4AB4ull },
+	{ 0xE0CDD525E7E64CADull, 0x1573D68F903EA229ull },
+	{ 0x4D7177518651D6F1ull, 0x11297872D9CBB4EEull },
+	{ 0x7BE8BEE8D6E957E8ull, 0x1B758D848FAC54B0ull },
+	{ 0xFCBA3253DF211320ull, 0x15F7A46A0C89DD59ull },
+	{ 0x63C8284318E74280ull, 0x1192E9EE706E4AAEull },
+	{ 0x60D0D3827D86A66ull, 0x1C1E43171A4A1117ull },
+	{ 0x6B3DA42CECAD21EBull, 0x167E9C127B6E7412ull },
+	{ 0x88FE1CF0BD574E56ull, 0x11FEE341FC585CDBull },
+	{ 0x419694B462254A23ull, 0x1CCB0536608D615Full },
+	{ 0x67ABAA29E81DD4E9ull, 0x1708D0F84D3DE77Full },
+	{ 0xB95621BB2017DD87ull, 0x126D73F9D764B932ull },
+	{ 0xC223692B668C95A5ull, 0x1D7BECC2F23AC1EAull },
+	{ 0xCE82BA891ED6DE1Dull, 0x179657025B6234BBull },
+	{ 0xA53562074BDF1818ull, 0x12DEAC01E2B4F6FCull },
+	{ 0x3B889CD87964F359ull, 0x1E3113363787F194ull },
+	{ 0xFC6D4A46C783F5E1ull, 0x18274291C6065ADCull },
+	{ 0x30576E9F06032B1Aull, 0x13529BA7D19EAF17ull },
+	{ 0x1A257DCB3CD1DE90ull, 0x1EEA92A61C311825ull },
+	{ 0x481DFE3C30A7E540ull, 0x18BBA884E35A79B7ull },
+	{ 0xD34B31C9C0865100ull, 0x13C9539D82AEC7C5ull },
+	{ 0x5211E942CDA3B4CDull, 0x1FA885C8D117A609ull },
+	{ 0x74DB21023E1C90A4ull, 0x19539E3A40DFB807ull },
+	{ 0xF715B401CB4A0D50ull, 0x1442E4FB67196005ull },
+	{ 0xF8DE299B09080AA7ull, 0x103583FC527AB337ull },
+	{ 0x8E304291A80CDDD7ull, 0x19EF3993B72AB859ull },
+	{ 0x3E8D020E200A4B13ull, 0x14BF6142F8EEF9E1ull },
+	{ 0x653D9B3E80083C0Full, 0x10991A9BFA58C7E7ull },
+	{ 0x6EC8F864000D2CE4ull, 0x1A8E90F9908E0CA5ull },
+	{ 0x8BD3F9E999A423EAull, 0x153EDA614071A3B7ull },
+	{ 0x3CA994BAE1501CBBull, 0x10FF151A99F482F9ull },
+	{ 0xC775BAC49BB3612Bull, 0x1B31BB5DC320D18Eull },
+	{ 0xD2C4956A16291A89ull, 0x15C162B168E70E0Bull },
+	{ 0xDBD0778811BA7BA1ull, 0x11678227871F3E6Full },
+	{ 0x2C80BF401C5D929Bull, 0x1BD8D03F3E9863E6ull },
+	{ 0xBD33CC3349E47549ull, 0x16470CFF6546B651ull },
+	{ 0xCA8FD68F6E505DD4ull, 0x11D270CC51055EA7ull },
+	{ 0x4419574BE3B3C953ull, 0x1C83E7AD4E6EFDD9ull },
+	{ 0x347790982F63AA9ull, 0x16CFEC8AA52597E1ull },
+	{ 0xCF6C60D468C4FBBAull, 0x123FF06EEA847980ull },
+	{ 0xE57A34870E07F92Aull, 0x1D331A4B10D3F59Aull },
+	{ 0x512E906C0B399422ull, 0x175C1508DA432AE2ull },
+	{ 0xDA8BA6BCD5C7A9B5ull, 0x12B010D3E1CF5581ull },
+	{ 0x90DF712E22D90F87ull, 0x1DE6815302E5559Cull },
+	{ 0xDA4C5A8B4F140C6Cull, 0x17EB9AA8CF1DDE16ull },
+	{ 0xAEA37BA2A5A9A38Aull, 0x1322E220A5B17E78ull },
+	{ 0x7DD25F6AA2A905A9ull, 0x1E9E369AA2B59727ull },
+	{ 0x97DB7F888220D154ull, 0x187E92154EF7AC1Full },
+	{ 0x797C6606CE80A777ull, 0x139874DDD8C6234Cull },
+	{ 0x8F2D700AE4010BF1ull, 0x1F5A549627A36BADull },
+	{ 0xC2459A25000D65Aull, 0x191510781FB5EFBEull },
+	{ 0x701D1481D99A4515ull, 0x1410D9F9B2F7F2FEull },
+	{ 0xC017439B147B6A77ull, 0x100D7B2E28C65BFEull },
+	{ 0xCCF205C4ED9243F2ull, 0x19AF2B7D0E0A2CCAull },
+	{ 0xA5B37D0BE0E9CC2ull, 0x148C22CA71A1BD6Full },
+	{ 0x848F973CB3EE3CEull, 0x10701BD527B4978Cull },
+	{ 0xDA0E5BEC78649FB0ull, 0x1A4CF9550C5425ACull },
+	{ 0x7B3EAFF060507FC0ull, 0x150A6110D6A9B7BDull },
+	{ 0x95CBBFF380406633ull, 0x10D51A73DEEE2C97ull },
+	{ 0xEFAC665266CD7052ull, 0x1AEE90B964B04758ull },
+	{ 0x2623850EB8A459DBull, 0x158BA6FAB6F36C47ull },
+	{ 0x1E82D0D893B6AE49ull, 0x113C85955F29236Cull },
+	{ 0xFD9E1AF41F8AB075ull, 0x1B9408EEFEA838ACull },
+	{ 0x97B1AF29B2D559F7ull, 0x16100725988693BDull },
+	{ 0xAC8E25BAF5777B2Cull, 0x11A66C1E139EDC97ull },
+	{ 0x7A7D092B2258C513ull, 0x1C3D79C9B8FE2DBFull },
+	{ 0x61FDA0EF4EAD6A76ull, 0x169794A160CB57CCull },
+	{ 0xE7FE1A590BBDEEC5ull, 0x1212DD4DE7091309ull },
+	{ 0xA6635D5B45FCB13Aull, 0x1CEAFBAFD80E84DCull },
+	{ 0x851C4AAF6B308DC8ull, 0x172262F3133ED0B0ull },
+	{ 0xD0E36EF2BC26D7D4ull, 0x1281E8C275CBDA26ull },
+	{ 0xB49F17EAC6A48C86ull, 0x1D9CA79D894629D7ull },
+	{ 0x2A18DFEF0550706Bull, 0x17B08617A104EE46ull },
+	{ 0x54E0B3259DD9F389ull, 0x12F39E794D9D8B6Bull },
+	{ 0x87CDEB6F62F65274ull, 0x1E5297287C2F4578ull },
+	{ 0xD30B22BF825EA85Dull, 0x18421286C9BF6AC6ull },
+	{ 0xF3C1BCC684BB9E4ull, 0x13680ED23AFF889Full },
+	{ 0x18602C7A4079296Dull, 0x1F0CE4839198DA98ull },
+	{ 0x46B356C833942124ull, 0x18D71D360E13E213ull },
+	{ 0x388F78A029434DB6ull, 0x13DF4A91A4DCB4DCull },
+	{ 0x5A7F2766A86BAF8Aull, 0x1FCBAA82A1612160ull },
+	{ 0x153285EBB9EFBFA2ull, 0x196FBB9BB44DB44Dull },
+	{ 0xAA8ED189618C994Eull, 0x145962E2F6A4903Dull },
+	{ 0xEED8A7A11AD6E10Cull, 0x1047824F2BB6D9CAull },
+	{ 0x7E27729B5E249B45ull, 0x1A0C03B1DF8AF611ull },
+	{ 0xFE85F549181D4904ull, 0x14D6695B193BF80Dull },
+	{ 0xCB9E5DD4134AA0D0ull, 0x10AB877C142FF9A4ull },
+	{ 0xDF63C9535211014Dull, 0x1AAC0BF9B9E65C3Aull },
+	{ 0x191CA10F74DA6771ull, 0x15566FFAFB1EB02Full },
+	{ 0xADB080D92A4852C1ull, 0x1111F32F2F4BC025ull },
+	{ 0x15E7348EAA0D5134ull, 0x1B4FEB7EB212CD09ull },
+	{ 0xAB1F5D3EEE710DC4ull, 0x15D98932280F0A6Dull },
+	{ 0xBC1917658B8DA49Dull, 0x117AD428200C0857ull },
+	{ 0x2CF4F23C127C3A94ull, 0x1BF7B9D9CCE00D59ull },
+	{ 0xF0C3F4FCDB969543ull, 0x165FC7E170B33DE0ull },
+	{ 0x5A365D9716121103ull, 0x11E6398126F5CB1Aull },
+	{ 0x9056FC24F01CE804ull, 0x1CA38F350B22DE90ull },
+	{ 0xD9DF301D8CE3ECD0ull, 0x16E93F5DA2824BA6ull },
+	{ 0xE17F59B13D8323DAull, 0x125432B14ECEA2EBull },
+	{ 0x68CBC2B52F38395Cull, 0x1D53844EE47DD179ull },
+	{ 0x53D6355DBF602DE3ull, 0x177603725064A794ull },
+	{ 0xA9782AB165E68B1Cull, 0x12C4CF8EA6B6EC76ull },
+	{ 0xF26AAB56FD744FAull, 0x1E07B27DD78B13F1ull },
+	{ 0x3F52222ABFDF6A62ull, 0x18062864AC6F4327ull },
+	{ 0x65DB4E88997F884Eull, 0x1338205089F29C1Full },
+	{ 0x6FC54A7428CC0D4Aull, 0x1EC033B40FEA9365ull },
+	{ 0x596AA1F68709A43Bull, 0x1899C2F673220F84ull },
+	{ 0xADEEE7F86C07B696ull, 0x13AE3591F5B4D936ull },
+	{ 0x497E3FF3E00C5756ull, 0x1F7D228322BAF524ull },
+	{ 0xD464FFF64CD6AC45ull, 0x1930E868E89590E9ull },
+	{ 0x4383FFF83D7889D1ull, 0x14272053ED4473EEull },
+	{ 0xCF9CCCC69793A174ull, 0x101F4D0FF1038FF1ull },
+	{ 0x7F6147A425B90252ull, 0x19CBAE7FE805B31Cull },
+	{ 0xCC4DD2E9B7C7350Full, 0x14A2F1FFECD15C16ull },
+	{ 0x3D0B0F215FD290D9ull, 0x10825B3323DAB012ull },
+	{ 0x61AB4B689950E7C1ull, 0x1A6A2B85062AB350ull },
+	{ 0x4E22A2BA1440B967ull, 0x1521BC6A6B555C40ull },
+	{ 0xB4EE894DD009453ull, 0x10E7C9EEBC4449CDull },
+	{ 0x1217DA87C800ED51ull, 0x1B0C764AC6D3A948ull },
+	{ 0xDB46486CA000BDDAull, 0x15A391D56BDC876Cull },
+	{ 0x490506BD4CCD64AFull, 0x114FA7DDEFE39F8Aull },
+	{ 0xA8080AC87AE23AB1ull, 0x1BB2A62FE638FF43ull },
+	{ 0x5339A239FBE82EF4ull, 0x162884F31E93FF69ull },
+	{ 0x75C7B4FB2FECF25Dull, 0x11BA03F5B20FFF87ull },
+	{ 0x22D92191E647EA2Eull, 0x1C5CD322B67FFF3Full },
+	{ 0xB57A8141850654F2ull, 0x16B0A8E891FFFF65ull },
+	{ 0xC4620101373843F5ull, 0x1226ED86DB3332B7ull },
+	{ 0x3A366801F1F39FEEull, 0x1D0B15A491EB8459ull },
+	{ 0xFB5EB99B27F6198Bull, 0x173C115074BC69E0ull },
+	{ 0x2F7EFAE2865E7AD6ull, 0x129674405D6387E7ull },
+	{ 0xE597F7D0D6FD9156ull, 0x1DBD86CD6238D971ull },
+	{ 0x8479930D78CADAABull, 0x17CAD23DE82D7AC1ull },
+	{ 0xD06142712D6F1556ull, 0x1308A831868AC89Aull },
+	{ 0x4D686A4EAF182222ull, 0x1E74404F3DAADA91ull },
+	{ 0xA453883EF279B4E8ull, 0x185D003F6488AEDAull },
+	{ 0xE9DC6CFF28615D87ull, 0x137D99CC506D58AEull },
+	{ 0xA960AE650D6895A4ull, 0x1F2F5C7A1A488DE4ull },
+	{ 0xBAB3BEB73DED4483ull, 0x18F2B061AEA07183ull },
+	{ 0x2EF6322C318A9D36ull, 0x13F559E7BEE6C136ull },
+	{ 0xE4BD1D13827761F0ull, 0x1FEEF63F97D79B89ull },
+	{ 0x83CA7DA9352C4E5Aull, 0x198BF832DFDFAFA1ull },
+	{ 0x9CA1FE20F756A515ull, 0x146FF9C24CB2F2E7ull },
+	{ 0x4A1B31B3F9121DAAull, 0x1059949B708F28B9ull },
+	{ 0x435EB5ECC1B695DDull, 0x1A28EDC580E50DF5ull },
+	{ 0x35E55E57015EDE4Aull, 0x14ED8B04671DA4C4ull },
+	{ 0xC4B77EAC0118B1D5ull, 0x10BE08D0527E1D69ull },
+	{ 0xA12597799B5AB622ull, 0x1AC9A7B3B7302F0Full },
+	{ 0x4DB7AC6149155E81ull, 0x156E1FC2F8F358D9ull },
+	{ 0xD7C6238107444B9Bull, 0x1124E63593F5E0ADull },
+	{ 0x593D059B3ED3AC2Bull, 0x1B6E3D2286563449ull },
+	{ 0xE0FD9E15CBDC89BCull, 0x15F1CA820511C36Dull },
+	{ 0xB3FE18116FE3A163ull, 0x118E3B9B37416924ull },
+	{ 0x866359B57FD29BD1ull, 0x1C16C5C525357507ull },
+	{ 0xD1E91491330EE30Eull, 0x16789E3750F790D2ull },
+	{ 0x74BA76DA8F3F1C0Bull, 0x11FA182C40C60D75ull },
+	{ 0xEDF72490E531C678ull, 0x1CC359E067A348BBull },
+	{ 0x8B2C1D40B75B052Dull, 0x1702AE4D1FB5D3C9ull },
+	{ 0x6F567DCD5F7C0424ull, 0x12688B70E62B0FD4ull },
+	{ 0x7EF0C94898C66D06ull, 0x1D74124E3D11B2EDull },
+	{ 0x98C0A106E09EBD9Full, 0x17900EA4FDA7C257ull },
+	{ 0x470080D24D4BCAE6ull, 0x12D9A550CAEC9B79ull },
+	{ 0xD800CE1D487944A2ull, 0x1E29088144ADC58Eull },
+	{ 0x1333D8176D2DD082ull, 0x1820D39A9D57D13Full },
+	{ 0xA8F646792424A6CEull, 0x134D76154AACA765ull },
+	{ 0x74BD3D8EA03AA47Dull, 0x1EE25688777AA56Full },
+	{ 0x5D64313EE6955064ull, 0x18B51206C5FBB78Cull },
+	{ 0x4AB68DCBEBAAA6B7ull, 0x13C40E6BD1962C70ull },
+	{ 0x1124161312AAA457ull, 0x1FA01712E8F0471Aull },
+	{ 0xDA8344DC0EEEE9DFull, 0x194CDF4253F36C14ull },
+	{ 0xE2029D7CD8BF2180ull, 0x143D7F6843292343ull },
+	{ 0x4E687DFD7A328133ull, 0x103132B9CF541C36ull },
+	{ 0x4A40C9959050CEB8ull, 0x19E851294BB9C6BDull },
+	{ 0x833D477A6A70BC6ull, 0x14B9DA876FC7D231ull },
+	{ 0xA02976C61EEC096Bull, 0x1094AED2BFD30E8Dull },
+	{ 0x4257A364ACDBDFull, 0x1A877E1DFFB81749ull },
+	{ 0xCD01DFB5EA23E319ull, 0x153931B1996012A0ull },
+	{ 0x70CE4C91881CB5AEull, 0x10FA8E27ADE6754Dull },
+	{ 0x1AE3ADB5A69455E2ull, 0x1B2A7D0C4970BBAFull },
+	{ 0x7BE957C4854377E8ull, 0x15BB973D078D62F2ull },
+	{ 0xC987796A0435F987ull, 0x1162DF64060AB58Eull },
+	{ 0x75A58F1006BCC271ull, 0x1BD1656CD67788E4ull },
+	{ 0xF7B7A5A66BCA3527ull, 0x16411DF0AB92D3E9ull },
+	{ 0x5FC61E1EBCA1C41Full, 0x11CDB18D560F0FEEull },
+	{ 0xFFA363646102D365ull, 0x1C7C4F4889B1B316ull },
+	{ 0x32E91C504D9BDC51ull, 0x16C9D906D48E28DFull },
+	{ 0x8F20E37371497D0Eull, 0x123B140576D820B2ull },
+	{ 0x7E9B0585820F2E7Cull, 0x1D2B533BF159CDEAull },
+	{ 0xCBAF379E01A5BECAull, 0x1755DC2FF447D7EEull },
+	{ 0x958F94B348498A1ull, 0x12AB168CC36CACBFull }
+};
+
+/**
+ * Powers of 5 normalized to 125 bits (5^i >> (bits(5^i) - 125)), low word first.
+ */
+static const uint64_t g_arrPow5Split[326][2] = {
+	{ 0x0ull, 0x1000000000000000ull },
+	{ 0x0ull, 0x1400000000000000ull },
+	{ 0x0ull, 0x1900000000000000ull },
+	{ 0x0ull, 0x1F40000000000000ull },
+	{ 0x0ull, 0x1388000000000000ull },
+	{ 0x0ull, 0x186A000000000000ull },
+	{ 0x0ull, 0x1E84800000000000ull },
+	{ 0x0ull, 0x1312D00000000000ull },
+	{ 0x0ull, 0x17D7840000000000ull },
+	{ 0x0ull, 0x1DCD650000000000ull },
+	{ 0x0ull, 0x12A05F2000000000ull },
+	{ 0x0ull, 0x174876E800000000ull },
+	{ 0x0ull, 0x1D1A94A200000000ull },
+	{ 0x0ull, 0x12309CE540000000ull },
+	{ 0x0ull, 0x16BCC41E90000000ull },
+	{ 0x0ull, 0x1C6BF52634000000ull },
+	{ 0x0ull, 0x11C37937E0800000ull },
+	{ 0x0ull, 0x16345785D8A00000ull },
+	{ 0x0ull, 0x1BC16D674EC80000ull },
+	{ 0x0ull, 0x1158E460913D0000ull },
+	{ 0x0ull, 0x15AF1D78B58C4000ull },
+	{ 0x0ull, 0x1B1AE4D6E2EF5000ull },
+	{ 0x0ull, 0x10F0CF064DD59200ull },
+	{ 0x0ull, 0x152D02C7E14AF680ull },
+	{ 0x0ull, 0x1A784379D99DB420ull },
+	{ 0x0ull, 0x108B2A2C28029094ull },
+	{ 0x0ull, 0x14ADF4B7320334B9ull },
+	{ 0x4000000000000000ull, 0x19D971E4FE8401E7ull },
+	{ 0x8800000000000000ull, 0x1027E72F1F128130ull },
+	{ 0xAA00000000000000ull, 0x1431E0FAE6D7217Cull },
+	{ 0xD480000000000000ull, 0x193E5939A08CE9DBull },
+	{ 0xC9A0000000000000ull, 0x1F8DEF8808B02452ull },
+	{ 0xBE04000000000000ull, 0x13B8B5B5056E16B3ull },
+	{ 0xAD85000000000000ull, 0x18A6E32246C99C60ull },
+	{ 0xD8E6400000000000ull, 0x1ED09BEAD87C0378ull },
+	{ 0x878FE80000000000ull, 0x13426172C74D822Bull },
+	{ 0x6973E20000000000ull, 0x1812F9CF7920E2B6ull },
+	{ 0x3D0DA8000000000ull, 0x1E17B84357691B64ull },
+	{ 0x8262889000000000ull, 0x12CED32A16A1B11Eull },
+	{ 0x22FB2AB400000000ull, 0x178287F49C4A1D66ull },
+	{ 0xABB9F56100000000ull, 0x1D6329F1C35CA4BFull },
+	{ 0xCB54395CA0000000ull, 0x125DFA371A19E6F7ull },
+	{ 0xBE2947B3C8000000ull, 0x16F578C4E0A060B5ull },
+	{ 0x2DB399A0BA000000ull, 0x1CB2D6F618C878E3ull },
+	{ 0xFC90400474400000ull, 0x11EFC659CF7D4B8Dull },
+	{ 0x7BB4500591500000ull, 0x166BB7F0435C9E71ull },
+	{ 0xDAA16406F5A40000ull, 0x1C06A5EC5433C60Dull },
+	{ 0xA8A4DE8459868000ull, 0x118427B3B4A05BC8ull },
+	{ 0xD2CE16256FE82000ull, 0x15E531A0A1C872BAull },
+	{ 0x87819BAECBE22800ull, 0x1B5E7E08CA3A8F69ull },
+	{ 0xF4B1014D3F6D5900ull, 0x111B0EC57E6499A1ull },
+	{ 0x71DD41A08F48AF40ull, 0x1561D276DDFDC00Aull },
+	{ 0xE549208B31ADB10ull, 0x1ABA4714957D300Dull },
+	{ 0x28F4DB456FF0C8EAull, 0x10B46C6CDD6E3E08ull },
+	{ 0x33321216CBECFB24ull, 0x14E1878814C9CD8Aull },
+	{ 0xBFFE969C7EE839EDull, 0x1A19E96A19FC40ECull },
+	{ 0xF7FF1E21CF512434ull, 0x105031E2503DA893ull },
+	{ 0xF5FEE5AA43256D41ull, 0x14643E5AE44D12B8ull },
+	{ 0x337E9F14D3EEC892ull, 0x197D4DF19D605767ull },
+	{ 0x5E46DA08EA7AB6ull, 0x1FDCA16E04B86D41ull },
+	{ 0xA03AEC4845928CB2ull, 0x13E9E4E4C2F34448ull },
+	{ 0xC849A75A56F72FDEull, 0x18E45E1DF3B0155Aull },
+	{ 0x7A5C1130ECB4FBD6ull, 0x1F1D75A5709C1AB1ull },
+	{ 0xEC798ABE93F11D65ull, 0x13726987666190AEull },
+	{ 0xA797ED6E38ED64BFull, 0x184F03E93FF9F4DAull },
+	{ 0x517DE8C9C728BDEFull, 0x1E62C4E38FF87211ull },
+	{ 0xD2EEB17E1C7976B5ull, 0x12FDBB0E39FB474Aull },
+	{ 0x87AA5DDDA397D462ull, 0x17BD29D1C87A191Dull },
+	{ 0xE994F5550C7DC97Bull, 0x1DAC74463A989F64ull },
+	{ 0x11FD195527CE9DEDull, 0x128BC8ABE49F639Full },
+	{ 0xD67C5FAA71C24568ull, 0x172EBAD6DDC73C86ull },
+	{ 0x8C1B77950E32D6C2ull, 0x1CFA698C95390BA8ull },
+	{ 0x57912ABD28DFC639ull, 0x121C81F7DD43A749ull },
+	{ 0xAD75756C7317B7C8ull, 0x16A3A275D494911Bull },
+	{ 0x98D2D2C78FDDA5BAull, 0x1C4C8B1349B9B562ull },
+	{ 0x9F83C3BCB9EA8794ull, 0x11AFD6EC0E14115Dull },
+	{ 0x764B4ABE8652979ull, 0x161BCCA7119915B5ull },
+	{ 0x493DE1D6E27E73D7ull, 0x1BA2BFD0D5FF5B22ull },
+	{ 0x6DC6AD264D8F0866ull, 0x1145B7E285BF98F5ull },
+	{ 0xC938586FE0F2CA80ull, 0x159725DB272F7F32ull },
+	{ 0x7B866E8BD92F7D20ull, 0x1AFCEF51F0FB5EFFull },
+	{ 0xAD34051767BDAE34ull, 0x10DE1593369D1B5Full },
+	{ 0x9881065D41AD19C1ull, 0x15159AF804446237ull },
+	{ 0x7EA147F492186032ull, 0x1A5B01B605557AC5ull },
+	{ 0x6F24CCF8DB4F3C1Full, 0x1078E111C3556CBBull },
+	{ 0x4AEE003712230B27ull, 0x14971956342AC7EAull },
+	{ 0xDDA98044D6ABCDF0ull, 0x19BCDFABC13579E4ull },
+	{ 0xA89F02B062B60B6ull, 0x10160BCB58C16C2Full },
+	{ 0xCD2C6C35C7B638E4ull, 0x141B8EBE2EF1C73Aull },
+	{ 0x8077874339A3C71Dull, 0x1922726DBAAE3909ull },
+	{ 0xE0956914080CB8E4ull, 0x1F6B0F092959C74Bull },
+	{ 0x6C5D61AC8507F38Eull, 0x13A2E965B9D81C8Full },
+	{ 0x4774BA17A649F072ull, 0x188BA3BF284E23B3ull },
+	{ 0x1951E89D8FDC6C8Full, 0x1EAE8CAEF261ACA0ull },
+	{ 0xFD3316279E9C3D9ull, 0x132D17ED577D0BE4ull },
+	{ 0x13C7FDBB186434CFull, 0x17F85DE8AD5C4EDDull },
+	{ 0x58B9FD29DE7D4203ull, 0x1DF67562D8B36294ull },
+	{ 0xB7743E3A2B0E4942ull, 0x12BA095DC7701D9Cull },
+	{ 0xE5514DC8B5D1DB92ull, 0x17688BB5394C2503ull },
+	{ 0xDEA5A13AE3465277ull, 0x1D42AEA2879F2E44ull },
+	{ 0xB2784C4CE0BF38Aull, 0x1249AD2594C37CEBull },
+	{ 0xCDF165F6018EF06Dull, 0x16DC186EF9F45C25ull },
+	{ 0x416DBF7381F2AC88ull, 0x1C931E8AB871732Full },
+	{ 0x88E497A83137ABD5ull, 0x11DBF316B346E7FDull },
+	{ 0xEB1DBD923D8596CAull, 0x1652EFDC6018A1FCull },
+	{ 0x25E52CF6CCE6FC7Dull, 0x1BE7ABD3781ECA7Cull },
+	{ 0x97AF3C1A40105DCEull, 0x1170CB642B133E8Dull },
+	{ 0xFD9B0B20D0147542ull, 0x15CCFE3D35D80E30ull },
+	{ 0x3D01CDE904199292ull, 0x1B403DCC834E11BDull },
+	{ 0x462120B1A28FFB9Bull, 0x1108269FD210CB16ull },
+	{ 0xD7A968DE0B33FA82ull, 0x154A3047C694FDDBull },
+	{ 0xCD93C3158E00F923ull, 0x1A9CBC59B83A3D52ull },
+	{ 0xC07C59ED78C09BB6ull, 0x10A1F5B813246653ull },
+	{ 0xB09B7068D6F0C2A3ull, 0x14CA732617ED7FE8ull },
+	{ 0xDCC24C830CACF34Cull, 0x19FD0FEF9DE8DFE2ull },
+	{ 0xC9F96FD1E7EC180Full, 0x103E29F5C2B18BEDull },
+	{ 0x3C77CBC661E71E13ull, 0x144DB473335DEEE9ull },
+	{ 0x8B95BEB7FA60E598ull, 0x1961219000356AA3ull },
+	{ 0x6E7B2E65F8F91EFEull, 0x1FB969F40042C54Cull },
+	{ 0xC50CFCFFBB9BB35Full, 0x13D3E2388029BB4Full },
+	{ 0xB6503C3FAA82A037ull, 0x18C8DAC6A0342A23ull },
+	{ 0xA3E44B4F95234844ull, 0x1EFB1178484134ACull },
+	{ 0xE66EAF11BD360D2Bull, 0x135CEAEB2D28C0EBull },
+	{ 0xE00A5AD62C839075ull, 0x183425A5F872F126ull },
+	{ 0x980CF18BB7A47493ull, 0x1E412F0F768FAD70ull },
+	{ 0x5F0816F752C6C8DCull, 0x12E8BD69AA19CC66ull },
+	{ 0xF6CA1CB527787B13ull, 0x17A2ECC414A03F7Full },
+	{ 0xF47CA3E2715699D7ull, 0x1D8BA7F519C84F5Full },
+	{ 0xF8CDE66D86D62026ull, 0x127748F9301D319Bull },
+	{ 0xF7016008E88BA830ull, 0x17151B377C247E02ull },
+	{ 0xB4C1B80B22AE923Cull, 0x1CDA62055B2D9D83ull },
+	{ 0x50F91306F5AD1B65ull, 0x12087D4358FC8272ull },
+	{ 0xE53757C8B318623Full, 0x168A9C942F3BA30Eull },
+	{ 0x9E852DBADFDE7ACFull, 0x1C2D43B93B0A8BD2ull },
+	{ 0xA3133C94CBEB0CC1ull, 0x119C4A53C4E69763ull },
+	{ 0x8BD80BB9FEE5CFF1ull, 0x16035CE8B6203D3Cull },
+	{ 0xAECE0EA87E9F43EEull, 0x1B843422E3A84C8Bull },
+	{ 0x4D40C9294F238A75ull, 0x1132A095CE492FD7ull },
+	{ 0x2090FB73A2EC6D12ull, 0x157F48BB41DB7BCDull },
+	{ 0x68B53A508BA78856ull, 0x1ADF1AEA12525AC0ull },
+	{ 0x417144725748B536ull, 0x10CB70D24B7378B8ull },
+	{ 0x51CD958EED1AE283ull, 0x14FE4D06DE5056E6ull },
+	{ 0xE640FAF2A8619B24ull, 0x1A3DE04895E46C9Full },
+	{ 0xEFE89CD7A93D00F7ull, 0x1066AC2D5DAEC3E3ull },
+	{ 0xEBE2C40D938C4134ull, 0x14805738B51A74DCull },
+	{ 0x26DB7510F86F5181ull, 0x19A06D06E2611214ull },
+	{ 0x9849292A9B4592F1ull, 0x100444244D7CAB4Cull },
+	{ 0xBE5B73754216F7ADull, 0x1405552D60DBD61Full },
+	{ 0xADF25052929CB598ull, 0x1906AA78B912CBA7ull },
+	{ 0x996EE4673743E2FFull, 0x1F485516E7577E91ull },
+	{ 0xFFE54EC0828A6DDFull, 0x138D352E5096AF1Aull },
+	{ 0xBFDEA270A32D0957ull, 0x18708279E4BC5AE1ull },
+	{ 0x2FD64B0CCBF84BADull, 0x1E8CA3185DEB719Aull },
+	{ 0x5DE5EEE7FF7B2F4Cull, 0x1317E5EF3AB32700ull },
+	{ 0x755F6AA1FF59FB1Full, 0x17DDDF6B095FF0C0ull },
+	{ 0x92B7454A7F3079E7ull, 0x1DD55745CBB7ECF0ull },
+	{ 0x5BB28B4E8F7E4C30ull, 0x12A5568B9F52F416ull },
+	{ 0xF29F2E22335DDF3Cull, 0x174EAC2E8727B11Bull },
+	{ 0xEF46F9AAC035570Bull, 0x1D22573A28F19D62ull },
+	{ 0xD58C5C0AB8215667ull, 0x123576845997025Dull },
+	{ 0x4AEF730D6629AC01ull, 0x16C2D4256FFCC2F5ull },
+	{ 0x9DAB4FD0BFB41701ull, 0x1C73892ECBFBF3B2ull },
+	{ 0xA28B11E277D08E60ull, 0x11C835BD3F7D784Full },
+	{ 0x8B2DD65B15C4B1F9ull, 0x163A432C8F5CD663ull },
+	{ 0x6DF94BF1DB35DE77ull, 0x1BC8D3F7B3340BFCull },
+	{ 0xC4BBCF772901AB0Aull, 0x115D847AD000877Dull },
+	{ 0x35EAC354F34215CDull, 0x15B4E5998400A95Dull },
+	{ 0x8365742A30129B40ull, 0x1B221EFFE500D3B4ull },
+	{ 0xD21F689A5E0BA108ull, 0x10F5535FEF208450ull },
+	{ 0x6A742C0F58E894Aull, 0x1532A837EAE8A565ull },
+	{ 0x4851137132F22B9Dull, 0x1A7F5245E5A2CEBEull },
+	{ 0xED32AC26BFD75B42ull, 0x108F936BAF85C136ull },
+	{ 0xA87F57306FCD3212ull, 0x14B378469B673184ull },
+	{ 0xD29F2CFC8BC07E97ull, 0x19E056584240FDE5ull },
+	{ 0xA3A37C1DD7584F1Eull, 0x102C35F729689EAFull },
+	{ 0x8C8C5B254D2E62E6ull, 0x14374374F3C2C65Bull },
+	{ 0x6FAF71EEA079FB9Full, 0x1945145230B377F2ull },
+	{ 0xB9B4E6A48987A87ull, 0x1F965966BCE055EFull },
+	{ 0x674111026D5F4C94ull, 0x13BDF7E0360C35B5ull },
+	{ 0xC111554308B71FBAull, 0x18AD75D8438F4322ull },
+	{ 0x7155AA93CAE4E7A8ull, 0x1ED8D34E547313EBull },
+	{ 0x26D58A9C5ECF10C9ull, 0x13478410F4C7EC73ull },
+	{ 0xF08AED437682D4FBull, 0x1819651531F9E78Full },
+	{ 0xECADA89454238A3Aull, 0x1E1FBE5A7E786173ull },
+	{ 0x73EC895CB4963664ull, 0x12D3D6F88F0B3CE8ull },
+	{ 0x90E7ABB3E1BBC3FDull, 0x1788CCB6B2CE0C22ull },
+	{ 0x352196A0DA2AB4FDull, 0x1D6AFFE45F818F2Bull },
+	{ 0x134FE24885AB11Eull, 0x1262DFEEBBB0F97Bull },
+	{ 0xC1823DADAA715D65ull, 0x16FB97EA6A9D37D9ull },
+	{ 0x31E2CD19150DB4BFull, 0x1CBA7DE5054485D0ull },
+	{ 0x1F2DC02FAD2890F7ull, 0x11F48EAF234AD3A2ull },
+	{ 0xA6F9303B9872B535ull, 0x1671B25AEC1D888Aull },
+	{ 0x50B77C4A7E8F6282ull, 0x1C0E1EF1A724EAADull },
+	{ 0x5272ADAE8F199D91ull, 0x1188D357087712ACull },
+	{ 0x670F591A32E004F6ull, 0x15EB082CCA94D757ull },
+	{ 0x40D32F60BF980633ull, 0x1B65CA37FD3A0D2Dull },
+	{ 0x4883FD9C77BF03E0ull, 0x111F9E62FE44483Cull },
+	{ 0x5AA4FD0395AEC4D8ull, 0x156785FBBDD55A4Bull },
+	{ 0x314E3C447B1A760Eull, 0x1AC1677AAD4AB0DEull },
+	{ 0xDED0E5AACCF089C9ull, 0x10B8E0ACAC4EAE8Aull },
+	{ 0x96851F15802CAC3Bull, 0x14E718D7D7625A2Dull },
+	{ 0xFC2666DAE037D74Aull, 0x1A20DF0DCD3AF0B8ull },
+	{ 0x9D980048CC22E68Eull, 0x10548B68A044D673ull },
+	{ 0x84FE005AFF2BA032ull, 0x1469AE42C8560C10ull },
+	{ 0xA63D8071BEF6883Eull, 0x198419D37A6B8F14ull },
+	{ 0xCFCCE08E2EB42A4Eull, 0x1FE52048590672D9ull },
+	{ 0x21E00C58DD309A70ull, 0x13EF342D37A407C8ull },
+	{ 0x2A580F6F147CC10Dull, 0x18EB0138858D09BAull },
+	{ 0xB4EE134AD99BF150ull, 0x1F25C186A6F04C28ull },
+	{ 0x7114CC0EC80176D2ull, 0x137798F428562F99ull },
+	{ 0xCD59FF127A01D486ull, 0x18557F31326BBB7Full },
+	{ 0xC0B07ED7188249A8ull, 0x1E6ADEFD7F06AA5Full },
+	{ 0xD86E4F466F516E09ull, 0x1302CB5E6F642A7Bull },
+	{ 0xCE89E3180B25C98Bull, 0x17C37E360B3D351Aull },
+	{ 0x822C5BDE0DEF3BEEull, 0x1DB45DC38E0C8261ull },
+	{ 0xF15BB96AC8B58575ull, 0x1290BA9A38C7D17Cull },
+	{ 0x2DB2A7C57AE2E6D2ull, 0x1734E940C6F9C5DCull },
+	{ 0x391F51B6D99BA086ull, 0x1D022390F8B83753ull },
+	{ 0x3B3931248014454ull, 0x1221563A9B732294ull },
+	{ 0x4A077D6DA019569ull, 0x16A9ABC9424FEB39ull },
+	{ 0x45C895CC9081FAC3ull, 0x1C5416BB92E3E607ull },
+	{ 0x8B9D5D9FDA513CBAull, 0x11B48E353BCE6FC4ull },
+	{ 0xAE84B507D0E58BE8ull, 0x1621B1C28AC20BB5ull },
+	{ 0x1A25E249C51EEEE3ull, 0x1BAA1E332D728EA3ull },
+	{ 0xF057AD6E1B33554Dull, 0x114A52DFFC679925ull },
+	{ 0x6C6D98C9A2002AA1ull, 0x159CE797FB817F6Full },
+	{ 0x4788FEFC0A803549ull, 0x1B04217DFA61DF4Bull },
+	{ 0xCB59F5D8690214Eull, 0x10E294EEBC7D2B8Full },
+	{ 0xCFE30734E83429A1ull, 0x151B3A2A6B9C7672ull },
+	{ 0x83DBC9022241340Aull, 0x1A6208B50683940Full },
+	{ 0xB2695DA15568C086ull, 0x107D457124123C89ull },
+	{ 0x1F03B509AAC2F0A7ull, 0x149C96CD6D16CBACull },
+	{ 0x26C4A24C1573ACD1ull, 0x19C3BC80C85C7E97ull },
+	{ 0x783AE56F8D684C03ull, 0x101A55D07D39CF1Eull },
+	{ 0x16499ECB70C25F03ull, 0x1420EB449C8842E6ull },
+	{ 0x9BDC067E4CF2F6C4ull, 0x19292615C3AA539Full },
+	{ 0x82D3081DE02FB476ull, 0x1F736F9B3494E887ull },
+	{ 0xB1C3E512AC1DD0C9ull, 0x13A825C100DD1154ull },
+	{ 0xDE34DE57572544FCull, 0x18922F31411455A9ull },
+	{ 0x55C215ED2CEE963Bull, 0x1EB6BAFD91596B14ull },
+	{ 0xB5994DB43C151DE5ull, 0x133234DE7AD7E2ECull },
+	{ 0xE2FFA1214B1A655Eull, 0x17FEC216198DDBA7ull },
+	{ 0xDBBF89699DE0FEB6ull, 0x1DFE729B9FF15291ull },
+	{ 0x2957B5E202AC9F31ull, 0x12BF07A143F6D39Bull },
+	{ 0xF3ADA35A8357C6FEull, 0x176EC98994F48881ull },
+	{ 0x70990C31242DB8BDull, 0x1D4A7BEBFA31AAA2ull },
+	{ 0x865FA79EB69C9376ull, 0x124E8D737C5F0AA5ull },
+	{ 0xE7F791866443B854ull, 0x16E230D05B76CD4Eull },
+	{ 0xA1F575E7FD54A669ull, 0x1C9ABD04725480A2ull },
+	{ 0xA53969B0FE54E801ull, 0x11E0B622C774D065ull },
+	{ 0xE87C41D3DEA2202ull, 0x1658E3AB7952047Full },
+	{ 0xD229B5248D64AA82ull, 0x1BEF1C9657A6859Eull },
+	{ 0x435A1136D85EEA91ull, 0x117571DDF6C81383ull },
+	{ 0x143095848E76A536ull, 0x15D2CE55747A1864ull },
+	{ 0x193CBAE5B2144E83ull, 0x1B4781EAD1989E7Dull },
+	{ 0x2FC5F4CF8F4CB112ull, 0x110CB132C2FF630Eull },
+	{ 0xBBB77203731FDD56ull, 0x154FDD7F73BF3BD1ull },
+	{ 0x2AA54E844FE7D4ACull, 0x1AA3D4DF50AF0AC6ull },
+	{ 0xDAA75112B1F0E4EBull, 0x10A6650B926D66BBull },
+	{ 0xD15125575E6D1E26ull, 0x14CFFE4E7708C06Aull },
+	{ 0x85A56EAD360865B0ull, 0x1A03FDE214CAF085ull },
+	{ 0x7387652C41C53F8Eull, 0x10427EAD4CFED653ull },
+	{ 0x50693E7752368F71ull, 0x14531E58A03E8BE8ull },
+	{ 0x64838E1526C4334Eull, 0x1967E5EEC84E2EE2ull },
+	{ 0xFDA4719A70754022ull, 0x1FC1DF6A7A61BA9Aull },
+	{ 0xDE86C70086494815ull, 0x13D92BA28C7D14A0ull },
+	{ 0x162878C0A7DB9A1Aull, 0x18CF768B2F9C59C9ull },
+	{ 0x5BB296F0D1D280A1ull, 0x1F03542DFB83703Bull },
+	{ 0x194F9E5683239064ull, 0x1362149CBD322625ull },
+	{ 0x5FA385EC23EC747Eull, 0x183A99C3EC7EAFAEull },
+	{ 0xF78C67672CE7919Dull, 0x1E494034E79E5B99ull },
+	{ 0x3AB7C0A07C10BB02ull, 0x12EDC82110C2F940ull },
+	{ 0x4965B0C89B14E9C3ull, 0x17A93A2954F3B790ull },
+	{ 0x5BBF1CFAC1DA2433ull, 0x1D9388B3AA30A574ull },
+	{ 0xB957721CB92856A0ull, 0x127C35704A5E6768ull },
+	{ 0xE7AD4EA3E7726C48ull, 0x171B42CC5CF60142ull },
+	{ 0xA198A24CE14F075Aull, 0x1CE2137F74338193ull },
+	{ 0x44FF65700CD16498ull, 0x120D4C2FA8A030FCull },
+	{ 0x563F3ECC1005BDBEull, 0x16909F3B92C83D3Bull },
+	{ 0x2BCF0E7F14072D2Eull, 0x1C34C70A777A4C8Aull },
+	{ 0x5B61690F6C847C3Dull, 0x11A0FC668AAC6FD6ull },
+	{ 0xF239C35347A59B4Cull, 0x16093B802D578BCBull },
+	{ 0xEEC83428198F021Full, 0x1B8B8A6038AD6EBEull },
+	{ 0x553D20990FF96153ull, 0x1137367C236C6537ull },
+	{ 0x2A8C68BF53F7B9A8ull, 0x1585041B2C477E85ull },
+	{ 0x752F82EF28F5A812ull, 0x1AE64521F7595E26ull },
+	{ 0x93DB1D57999890Bull, 0x10CFEB353A97DAD8ull },
+	{ 0xB8D1E4AD7FFEB4Eull, 0x1503E602893DD18Eull },
+	{ 0x8E7065DD8DFFE622ull, 0x1A44DF832B8D45F1ull },
+	{ 0xF9063FAA78BFEFD5ull, 0x106B0BB1FB384BB6ull },
+	{ 0xB747CF9516EFEBCAull, 0x1485CE9E7A065EA4ull },
+	{ 0xE519C37A5CABE6BDull, 0x19A742461887F64Dull },
+	{ 0xAF301A2C79EB7036ull, 0x1008896BCF54F9F0ull },
+	{ 0xDAFC20B798664C43ull, 0x140AABC6C32A386Cull },
+	{ 0x11BB28E57E7FDF54ull, 0x190D56B873F4C688ull },
+	{ 0x1629F31EDE1FD72Aull, 0x1F50AC6690F1F82Aull },
+	{ 0x4DDA37F34AD3E67Aull, 0x13926BC01A973B1Aull },
+	{ 0xE150C5F01D88E019ull, 0x187706B0213D09E0ull },
+	{ 0x19A4F76C24EB181Full, 0x1E94C85C298C4C59ull },
+	{ 0xB0071AA39712EF13ull, 0x131CFD3999F7AFB7ull },
+	{ 0x9C08E14C7CD7AAD8ull, 0x17E43C8800759BA5ull },
+	{ 0x30B199F9C0D958Eull, 0x1DDD4BAA0093028Full },
+	{ 0x61E6F003C1887D79ull, 0x12AA4F4A405BE199ull },
+	{ 0xBA60AC04B1EA9CD7ull, 0x1754E31CD072D9FFull },
+	{ 0xA8F8D705DE65440Dull, 0x1D2A1BE4048F907Full },
+	{ 0xC99B8663AAFF4A88ull, 0x123A516E82D9BA4Full },
+	{ 0xBC0267FC95BF1D2Aull, 0x16C8E5CA239028E3ull },
+	{ 0xAB0301FBBB2EE474ull, 0x1C7B1F3CAC74331Cull },
+	{ 0xEAE1E13D54FD4EC9ull, 0x11CCF385EBC89FF1ull },
+	{ 0x659A598CAA3CA27Bull, 0x1640306766BAC7EEull },
+	{ 0xFF00EFEFD4CBCB1Aull, 0x1BD03C81406979E9ull },
+	{ 0x3F6095F5E4FF5EF0ull, 0x116225D0C841EC32ull },
+	{ 0xCF38BB735E3F36ACull, 0x15BAAF44FA52673Eull },
+	{ 0x8306EA5035CF0457ull, 0x1B295B1638E7010Eull },
+	{ 0x11E4527221A162B6ull, 0x10F9D8EDE39060A9ull },
+	{ 0x565D670EAA09BB64ull, 0x15384F295C7478D3ull },
+	{ 0x2BF4C0D2548C2A3Dull, 0x1A8662F3B3919708ull },
+	{ 0x1B78F88374D79A66ull, 0x1093FDD8503AFE65ull },
+	{ 0x625736A4520D8100ull, 0x14B8FD4E6449BDFEull },
+	{ 0xFAED044D6690E140ull, 0x19E73CA1FD5C2D7Dull },
+	{ 0xBCD422B0601A8CC8ull, 0x103085E53E599C6Eull },
+	{ 0x6C092B5C78212FFAull, 0x143CA75E8DF0038Aull },
+	{ 0x70B763396297BF8ull, 0x194BD136316C046Dull },
+	{ 0x48CE53C07BB3DAF6ull, 0x1F9EC583BDC70588ull },
+	{ 0x2D80F4584D5068DAull, 0x13C33B72569C6375ull },
+	{ 0x78E1316E60A48310ull, 0x18B40A4EEC437C52ull }
+};
+
+/**
+ * Counts decimal digits of the value.
+ * @param  nValue Value.
+ * @return        Number of digits (1 for 0).
+ */
+static inline size_t elnumfmtCountDigits(uint64_t nValue) {
+	size_t nDigits = 1;
+	for(;;) {
+		if(nValue < 10)
+			return nDigits;
+		if(nValue < 100)
+			return nDigits + 1;
+		if(nValue < 1000)
+			return nDigits + 2;
+		if(nValue < 10000)
+			return nDigits + 3;
+		nValue /= 10000;
+		nDigits += 4;
+	}
+}
+
+/**
+ * Writes the digits of the value ending right before @e pEnd (two digits at 
+ * once).
+ * @param pEnd   Position after the last digit.
+ * @param nValue Value.
+ */
+static inline void elnumfmtWriteDigitsBack(char *pEnd, uint64_t nValue) {
+	while(nValue >= 100) {
+		size_t nPair = (size_t)(nValue % 100) * 2;
+		nValue /= 100;
+		pEnd -= 2;
+		memcpy(pEnd, g_arrDigitPairs + nPair, 2);
+	}
+	if(nValue >= 10) {
+		pEnd -= 2;
+		memcpy(pEnd, g_arrDigitPairs + nValue * 2, 2);
+	} else
+		*--pEnd = (char)('0' + nValue);
+}
+
+/**
+ * Writes unsigned integer in decimal (null character is not added).
+ * @param  pDest  Buffer (at least EL_NUMFMT_INT64_MAX characters).
+ * @param  nValue Value.
+ * @return        Number of characters written.
+ */
+size_t elnumfmtUInt64(char *pDest, uint64_t nValue) {
+	size_t nDigits = elnumfmtCountDigits(nValue);
+	elnumfmtWriteDigitsBack(pDest + nDigits, nValue);
+
+	return nDigits;
+}
+
+/**
+ * Writes signed integer in decimal (null character is not added).
+ * @param  pDest  Buffer (at least EL_NUMFMT_INT64_MAX characters).
+ * @param  nValue Value.
+ * @return        Number of characters written.
+ */
+size_t elnumfmtInt64(char *pDest, int64_t nValue) {
+	if(nValue >= 0)
+		return elnumfmtUInt64(pDest, (uint64_t)nValue);
+
+	*pDest = '-';
+	return 1 + elnumfmtUInt64(pDest + 1, 0 - (uint64_t)nValue);
+}
+
+/**
+ * Writes unsigned integer in hex without prefix (null character is not 
+ * added).
+ * @param  pDest      Buffer (at least EL_NUMFMT_HEX_MAX characters).
+ * @param  nValue     Value.
+ * @param  nMinDigits Minimal number of digits (value is padded with zeros, 
+ * no more than 16).
+ * @param  bUpper     If @b true, upper case letters are used.
+ * @return            Number of characters written.
+ */
+size_t elnumfmtHex(char *pDest, uint64_t nValue, size_t nMinDigits, 
+	bool bUpper) {
+
+	const char *szDigits = bUpper ? "0123456789ABCDEF" : "0123456789abcdef";
+
+	size_t nDigits = nValue == 0 ? 1 : 
+		(size_t)(64 - __builtin_clzll(nValue) + 3) / 4;
+	if(nMinDigits > EL_NUMFMT_HEX_MAX)
+		nMinDigits = EL_NUMFMT_HEX_MAX;
+	if(nDigits < nMinDigits)
+		nDigits = nMinDigits;
+
+	for(size_t i = nDigits; i > 0; i--) {
+		pDest[i - 1] = szDigits[nValue & 0xF];
+		nValue >>= 4;
+	}
+
+	return nDigits;
+}
+
+/**
+ * Returns floor(log10(2^e)) for 0 <= e <= 1650.
+ */
+static inline uint32_t elnumfmtLog10Pow2(int32_t e) {
+	return ((uint32_t)e * 78913) >> 18;
+}
+
+/**
+ * Returns floor(log10(5^e)) for 0 <= e <= 2620.
+ */
+static inline uint32_t elnumfmtLog10Pow5(int32_t e) {
+	return ((uint32_t)e * 732923) >> 20;
+}
+
+/**
+ * Returns the number of bits of 5^e (ceil(log2(5^e)), 1 for 0) for 
+ * 0 <= e <= 3528.
+ */
+static inline int32_t elnumfmtPow5Bits(int32_t e) {
+	return (int32_t)((((uint32_t)e) * 1217359) >> 19) + 1;
+}
+
+/**
+ * Checks if the value is divisible by 5^p.
+ */
+static inline bool elnumfmtIsMultipleOfPow5(uint64_t nValue, uint32_t p) {
+	uint32_t nCount = 0;
+	while(nValue % 5 == 0) {
+		nValue /= 5;
+		nCount++;
+	}
+
+	return nCount >= p;
+}
+
+/**
+ * Checks if the value is divisible by 2^p.
+ */
+static inline bool elnumfmtIsMultipleOfPow2(uint64_t nValue, uint32_t p) {
+	return (nValue & ((1ull << p) - 1)) == 0;
+}
+
+/**
+ * Multiplies two 64-bit values.
+ * @param  nValue1 First value.
+ * @param  nValue2 Second value.
+ * @param  pHigh   Receives high word of the product.
+ * @return         Low word of the product.
+ */
+static inline uint64_t elnumfmtMul64(uint64_t nValue1, uint64_t nValue2, 
+	uint64_t *pHigh) {
+
+#ifdef __SIZEOF_INT128__
+	unsigned __int128 nProduct = (unsigned __int128)nValue1 * nValue2;
+	*pHigh = (uint64_t)(nProduct >> 64);
+
+	return (uint64_t)nProduct;
+#else
+	// products of 32-bit halves
+	uint64_t nLowLow = (nValue1 & 0xFFFFFFFF) * (nValue2 & 0xFFFFFFFF);
+	uint64_t nLowHigh = (nValue1 & 0xFFFFFFFF) * (nValue2 >> 32);
+	uint64_t nHighLow = (nValue1 >> 32) * (nValue2 & 0xFFFFFFFF);
+	uint64_t nHighHigh = (nValue1 >> 32) * (nValue2 >> 32);
+	uint64_t nMiddle = (nLowLow >> 32) + (nLowHigh & 0xFFFFFFFF) + 
+		(nHighLow & 0xFFFFFFFF);
+	*pHigh = nHighHigh + (nLowHigh >> 32) + (nHighLow >> 32) + (nMiddle >> 32);
+
+	return (nMiddle << 32) | (nLowLow & 0xFFFFFFFF);
+#endif
+}
+
+/**
+ * Multiplies the value by 128-bit factor and shifts the product right.
+ * @param  m      Value.
+ * @param  arrMul Factor (low word first).
+ * @param  j      Shift (greater than 64 and less than 128).
+ * @return        Shifted product.
+ */
+static inline uint64_t elnumfmtMulShift64(uint64_t m, const uint64_t *arrMul, 
+	int32_t j) {
+
+	uint64_t nHigh0;
+	uint64_t nHigh1;
+	elnumfmtMul64(m, arrMul[0], &nHigh0);
+	uint64_t nSum = elnumfmtMul64(m, arrMul[1], &nHigh1) + nHigh0;
+	if(nSum < nHigh0)
+		nHigh1++;
+
+	return (nSum >> (j - 64)) | (nHigh1 << (128 - j));
+}
+
+/**
+ * Converts finite non-zero double into the shortest decimal mantissa and 
+ * exponent which reads back into the same double (Ryu algorithm by Ulf 
+ * Adams).
+ * @param nIeeeMantissa Mantissa bits of double.
+ * @param nIeeeExponent Exponent bits of double.
+ * @param pExponent     Receives decimal exponent.
+ * @return              Decimal mantissa.
+ */
+static uint64_t elnumfmtShortest(uint64_t nIeeeMantissa, 
+	uint32_t nIeeeExponent, int32_t *pExponent) {
+
+	int32_t e2;
+	uint64_t m2;
+	if(nIeeeExponent == 0) {
+		e2 = 1 - 1023 - 52 - 2;
+		m2 = nIeeeMantissa;
+	} else {
+		e2 = (int32_t)nIeeeExponent - 1023 - 52 - 2;
+		m2 = (1ull << 52) | nIeeeMantissa;
+	}
+
+	// integers below 2^53 are written as is (without trailing zeros)
+	if(nIeeeExponent != 0 && e2 + 2 <= 0 && e2 + 2 >= -52) {
+		uint64_t nMask = (1ull << -(e2 + 2)) - 1;
+		if((m2 & nMask) == 0) {
+			uint64_t nOutput = m2 >> -(e2 + 2);
+			int32_t e10 = 0;
+			while(nOutput % 10 == 0) {
+				nOutput /= 10;
+				e10++;
+			}
+			*pExponent = e10;
+			return nOutput;
+		}
+	}
+
+	bool bAcceptBounds = (m2 & 1) == 0;
+
+	// interval of valid representations is [mm, mp] around mv (scaled by 4)
+	uint64_t mv = 4 * m2;
+	uint32_t nMmShift = nIeeeMantissa != 0 || nIeeeExponent <= 1;
+
+	uint64_t vr, vp, vm;
+	int32_t e10;
+	bool bVmIsTrailingZeros = false;
+	bool bVrIsTrailingZeros = false;
+	if(e2 >= 0) {
+		uint32_t q = elnumfmtLog10Pow2(e2) - (e2 > 3);
+		e10 = (int32_t)q;
+		int32_t k = 125 + elnumfmtPow5Bits((int32_t)q) - 1;
+		int32_t i = -e2 + (int32_t)q + k;
+		vr = elnumfmtMulShift64(4 * m2, g_arrPow5InvSplit[q], i);
+		vp = elnumfmtMulShift64(4 * m2 + 2, g_arrPow5InvSplit[q], i);
+		vm = elnumfmtMulShift64(4 * m2 - 1 - nMmShift, g_arrPow5InvSplit[q], 
+			i);
+		if(q <= 21) {
+			// only one of mp, mv and mm can be a multiple of 5
+			if(mv % 5 == 0)
+				bVrIsTrailingZeros = elnumfmtIsMultipleOfPow5(mv, q);
+			else if(bAcceptBounds)
+				bVmIsTrailingZeros = elnumfmtIsMultipleOfPow5(
+					mv - 1 - nMmShift, q);
+			else
+				vp -= elnumfmtIsMultipleOfPow5(mv + 2, q);
+		}
+	} else {
+		uint32_t q = elnumfmtLog10Pow5(-e2) - (-e2 > 1);
+		e10 = (int32_t)q + e2;
+		int32_t i = -e2 - (int32_t)q;
+		int32_t k = elnumfmtPow5Bits(i) - 125;
+		int32_t j = (int32_t)q - k;
+		vr = elnumfmtMulShift64(4 * m2, g_arrPow5Split[i], j);
+		vp = elnumfmtMulShift64(4 * m2 + 2, g_arrPow5Split[i], j);
+		vm = elnumfmtMulShift64(4 * m2 - 1 - nMmShift, g_arrPow5Split[i], j);
+		if(q <= 1) {
+			// mv = 4 * m2 always has at least two trailing zero bits
+			bVrIsTrailingZeros = true;
+			if(bAcceptBounds)
+				bVmIsTrailingZeros = nMmShift == 1;
+			else
+				vp--;
+		} else if(q < 63)
+			bVrIsTrailingZeros = elnumfmtIsMultipleOfPow2(mv, q);
+	}
+
+	// remove digits while the interval still holds different values
+	int32_t nRemoved = 0;
+	uint8_t nLastRemovedDigit = 0;
+	uint64_t nOutput;
+	if(bVmIsTrailingZeros || bVrIsTrailingZeros) {
+		// rare general case
+		while(vp / 10 > vm / 10) {
+			bVmIsTrailingZeros &= vm % 10 == 0;
+			bVrIsTrailingZeros &= nLastRemovedDigit == 0;
+			nLastRemovedDigit = (uint8_t)(vr % 10);
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			nRemoved++;
+		}
+		if(bVmIsTrailingZeros) {
+			while(vm % 10 == 0) {
+				bVrIsTrailingZeros &= nLastRemovedDigit == 0;
+				nLastRemovedDigit = (uint8_t)(vr % 10);
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+				nRemoved++;
+			}
+		}
+		// exact number .....50..0 is rounded to even
+		if(bVrIsTrailingZeros && nLastRemovedDigit == 5 && vr % 2 == 0)
+			nLastRemovedDigit = 4;
+		nOutput = vr + ((vr == vm && (!bAcceptBounds || !bVmIsTrailingZeros)) || 
+			nLastRemovedDigit >= 5);
+	} else {
+		bool bRoundUp = false;
+		if(vp / 100 > vm / 100) {
+			bRoundUp = vr % 100 >= 50;
+			vr /= 100;
+			vp /= 100;
+			vm /= 100;
+			nRemoved += 2;
+		}
+		while(vp / 10 > vm / 10) {
+			bRoundUp = vr % 10 >= 5;
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			nRemoved++;
+		}
+		nOutput = vr + (vr == vm || bRoundUp);
+	}
+
+	*pExponent = e10 + nRemoved;
+
+	return nOutput;
+}
+
+/**
+ * Writes the shortest decimal form of double which reads back into the same 
+ * value (null character is not added). Numbers with decimal exponent from -7 
+ * to 20 are written in positional notation ("0.001", "123.5", "1000"), 
+ * others in scientific one ("1e+21", "1.5e-08"). Infinities and NaN are 
+ * written as "inf", "-inf" and "nan".
+ * @param  pDest  Buffer (at least EL_NUMFMT_DOUBLE_MAX characters).
+ * @param  fValue Value.
+ * @return        Number of characters written.
+ */
+size_t elnumfmtDouble(char *pDest, double fValue) {
+	uint64_t nBits;
+	memcpy(&nBits, &fValue, sizeof(nBits));
+	bool bSign = (nBits >> 63) != 0;
+	uint64_t nIeeeMantissa = nBits & ((1ull << 52) - 1);
+	uint32_t nIeeeExponent = (uint32_t)((nBits >> 52) & 0x7FF);
+
+	char *p = pDest;
+	if(nIeeeExponent == 0x7FF && nIeeeMantissa != 0) {
+		memcpy(p, "nan", 3);
+		return 3;
+	}
+	if(bSign)
+		*p++ = '-';
+	if(nIeeeExponent == 0x7FF) {
+		memcpy(p, "inf", 3);
+		return (size_t)(p - pDest) + 3;
+	}
+	if(nIeeeExponent == 0 && nIeeeMantissa == 0) {
+		*p++ = '0';
+		return (size_t)(p - pDest);
+	}
+
+	int32_t nExponent;
+	uint64_t nOutput = elnumfmtShortest(nIeeeMantissa, nIeeeExponent, 
+		&nExponent);
+	int32_t nDigits = (int32_t)elnumfmtCountDigits(nOutput);
+	// position of decimal point relative to the first digit
+	int32_t nPoint = nDigits + nExponent;
+
+	if(nPoint > 21 || nPoint < -6) {
+		// d[.ddd]e(+|-)xx
+		elnumfmtWriteDigitsBack(p + 1 + nDigits, nOutput);
+		p[0] = p[1];
+		if(nDigits > 1) {
+			p[1] = '.';
+			p += nDigits + 1;
+		} else
+			p++;
+		int32_t nExp10 = nPoint - 1;
+		*p++ = 'e';
+		*p++ = nExp10 < 0 ? '-' : '+';
+		if(nExp10 < 0)
+			nExp10 = -nExp10;
+		if(nExp10 >= 100) {
+			*p++ = (char)('0' + nExp10 / 100);
+			nExp10 %= 100;
+		}
+		memcpy(p, g_arrDigitPairs + nExp10 * 2, 2);
+		p += 2;
+	} else if(nPoint <= 0) {
+		// 0.000ddd
+		*p++ = '0';
+		*p++ = '.';
+		memset(p, '0', (size_t)-nPoint);
+		p += -nPoint;
+		elnumfmtWriteDigitsBack(p + nDigits, nOutput);
+		p += nDigits;
+	} else if(nPoint >= nDigits) {
+		// ddd000
+		elnumfmtWriteDigitsBack(p + nDigits, nOutput);
+		p += nDigits;
+		memset(p, '0', (size_t)(nPoint - nDigits));
+		p += nPoint - nDigits;
+	} else {
+		// ddd.ddd
+		elnumfmtWriteDigitsBack(p + nDigits + 1, nOutput);
+		memmove(p, p + 1, (size_t)nPoint);
+		p[nPoint] = '.';
+		p += nDigits + 1;
+	}
+
+	return (size_t)(p - pDest);
+}
+
+/**
+ * Divides unsigned 128-bit integer by 32-bit divisor.
+ * @param  pHigh    High word of the value (receives high word of quotient).
+ * @param  pLow     Low word of the value (receives low word of quotient).
+ * @param  nDivisor Divisor.
+ * @return          Remainder.
+ */
+static inline uint32_t elnumfmtDivUInt128(uint64_t *pHigh, uint64_t *pLow, 
+	uint32_t nDivisor) {
+
+	// long division by 32-bit digits
+	uint64_t nRest = *pHigh % nDivisor;
+	*pHigh /= nDivisor;
+	uint64_t nPart = (nRest << 32) | (*pLow >> 32);
+	uint64_t nQuotient = nPart / nDivisor;
+	nPart = ((nPart % nDivisor) << 32) | (*pLow & 0xFFFFFFFF);
+	*pLow = (nQuotient << 32) | (nPart / nDivisor);
+
+	return (uint32_t)(nPart % nDivisor);
+}
+
+/**
+ * Writes unsigned 128-bit integer in decimal.
+ * @param  pDest Buffer (at least 39 characters).
+ * @param  nHigh High word of the value.
+ * @param  nLow  Low word of the value.
+ * @return       Number of characters written.
+ */
+static size_t elnumfmtUInt128(char *pDest, uint64_t nHigh, uint64_t nLow) {
+	if(nHigh == 0)
+		return elnumfmtUInt64(pDest, nLow);
+
+	// split into parts of 9 digits until the rest fits into 64 bits
+	uint32_t arrParts[3];
+	size_t nParts = 0;
+	while(nHigh != 0)
+		arrParts[nParts++] = elnumfmtDivUInt128(&nHigh, &nLow, 1000000000);
+
+	size_t nCount = elnumfmtUInt64(pDest, nLow);
+	while(nParts > 0) {
+		memset(pDest + nCount, '0', 9);
+		elnumfmtWriteDigitsBack(pDest + nCount + 9, arrParts[--nParts]);
+		nCount += 9;
+	}
+
+	return nCount;
+}
+
+/**
+ * Writes double in positional notation with fixed number of decimals, 
+ * rounded the same way as printf("%.*f") does (the exact binary value is 
+ * rounded half to even). Values which are not integers below 2^64 and have 
+ * up to 22 decimals are formatted by exact integer arithmetic, others by 
+ * snprintf().
+ * @param  pDest     Buffer.
+ * @param  nSize     Size of the buffer (null character is added if there is 
+ * room for it).
+ * @param  fValue    Value.
+ * @param  nDecimals Number of digits after decimal point.
+ * @return           Number of characters in the result (if it's not less 
+ * than @e nSize, the result is truncated).
+ */
+size_t elnumfmtDoubleFixed(char *pDest, size_t nSize, double fValue, 
+	size_t nDecimals) {
+
+	uint64_t nBits;
+	memcpy(&nBits, &fValue, sizeof(nBits));
+	bool bSign = (nBits >> 63) != 0;
+	uint64_t m2 = nBits & ((1ull << 52) - 1);
+	int32_t nIeeeExponent = (int32_t)((nBits >> 52) & 0x7FF);
+	int32_t e2 = (nIeeeExponent == 0 ? 1 : nIeeeExponent) - 1023 - 52;
+	if(nIeeeExponent != 0)
+		m2 |= 1ull << 52;
+
+	if(nIeeeExponent == 0x7FF || nDecimals > EL_NUMFMT_FIXED_DECIMALS_MAX || 
+		e2 > 11) {
+
+		int nLength = snprintf(pDest, nSize, "%.*f", (int)nDecimals, fValue);
+		return nLength > 0 ? (size_t)nLength : 0;
+	}
+
+	// value * 10^nDecimals = m2 * 10^nDecimals * 2^e2, rounded half to even 
+	// (integers are written as is, followed by zero decimals); scaled value 
+	// is kept in two words (it's less than 2^53 * 10^22 < 2^127)
+	uint64_t nHigh = 0;
+	uint64_t nLow = m2;
+	size_t nScale = e2 >= 0 ? 0 : nDecimals;
+	for(size_t i = 0; i < nScale; i++) {
+		uint64_t nCarry;
+		nLow = elnumfmtMul64(nLow, 10, &nCarry);
+		nHigh = nHigh * 10 + nCarry;
+	}
+	if(e2 >= 0)
+		nLow <<= e2;
+	else if(-e2 >= 128) {
+		nHigh = 0;
+		nLow = 0;
+	} else {
+		// bits shifted out are compared with the half of the last unit
+		int32_t nShift = -e2;
+		uint64_t nRestHigh = 0;
+		uint64_t nRestLow;
+		uint64_t nHalfHigh = 0;
+		uint64_t nHalfLow = 0;
+		if(nShift < 64) {
+			nRestLow = nLow & ((1ull << nShift) - 1);
+			nHalfLow = 1ull << (nShift - 1);
+			nLow = (nLow >> nShift) | (nHigh << (64 - nShift));
+			nHigh >>= nShift;
+		} else {
+			nRestHigh = nHigh & ((1ull << (nShift - 64)) - 1);
+			nRestLow = nLow;
+			if(nShift > 64)
+				nHalfHigh = 1ull << (nShift - 65);
+			else
+				nHalfLow = 1ull << 63;
+			nLow = nHigh >> (nShift - 64);
+			nHigh = 0;
+		}
+
+		bool bEqual = nRestHigh == nHalfHigh && nRestLow == nHalfLow;
+		if(nRestHigh > nHalfHigh || (nRestHigh == nHalfHigh && 
+			nRestLow > nHalfLow) || (bEqual && (nLow & 1) != 0)) {
+			nLow++;
+			if(nLow == 0)
+				nHigh++;
+		}
+	}
+
+	char arrBuf[64];
+	char *p = arrBuf;
+	if(bSign)
+		*p++ = '-';
+
+	char arrDigits[48];
+	size_t nDigits = elnumfmtUInt128(arrDigits, nHigh, nLow);
+	if(nDigits <= nScale) {
+		// leading zeros up to one digit before decimal point
+		size_t nZeros = nScale + 1 - nDigits;
+		memmove(arrDigits + nZeros, arrDigits, nDigits);
+		memset(arrDigits, '0', nZeros);
+		nDigits += nZeros;
+	}
+
+	size_t nInteger = nDigits - nScale;
+	memcpy(p, arrDigits, nInteger);
+	p += nInteger;
+	if(nDecimals > 0) {
+		*p++ = '.';
+		memcpy(p, arrDigits + nInteger, nScale);
+		memset(p + nScale, '0', nDecimals - nScale);
+		p += nDecimals;
+	}
+
+	size_t nLength = (size_t)(p - arrBuf);
+	if(nSize > 0) {
+		size_t nCopy = nLength < nSize ? nLength : nSize - 1;
+		memcpy(pDest, arrBuf, nCopy);
+		pDest[nCopy] = '\0';
+	}
+
+	return nLength;
+}
@@ -0,0 +1,59 @@
+/* Extreme Library (EL). Number formatting. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#ifndef _EL_NUMFMT_H_
+#define _EL_NUMFMT_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Maximal number of characters written for 64-bit integer (with sign).
+ */
+#define EL_NUMFMT_INT64_MAX		20
+
+/**
+ * Maximal number of characters written for 64-bit integer in hex.
+ */
+#define EL_NUMFMT_HEX_MAX		16
+
+/**
+ * Maximal number of characters written for the shortest form of double.
+ */
+#define EL_NUMFMT_DOUBLE_MAX	32
+
+size_t elnumfmtUInt64(char *pDest, uint64_t nValue);
+size_t elnumfmtInt64(char *pDest, int64_t nValue);
+size_t elnumfmtHex(char *pDest, uint64_t nValue, size_t nMinDigits, 
+	bool bUpper);
+size_t elnumfmtDouble(char *pDest, double fValue);
+size_t elnumfmtDoubleFixed(char *pDest, size_t nSize, double fValue, 
+	size_t nDecimals);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,55 @@
+/* Extreme Library (EL). Number parsing. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#ifndef _EL_NUMPARSE_H_
+#define _EL_NUMPARSE_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "el_str.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EL_NUMPARSE_OK				0
+#define EL_NUMPARSE_ERR_SYNTAX		1
+#define EL_NUMPARSE_ERR_RANGE		2
+
+int elnumparseInt64View(strview view, int64_t *pValue);
+int elnumparseInt64ELStr(str *pStr, int64_t *pValue);
+int elnumparseUInt64View(strview view, uint64_t *pValue);
+int elnumparseUInt64ELStr(str *pStr, uint64_t *pValue);
+int elnumparseDoubleView(strview view, double *pValue);
+int elnumparseDoubleELStr(str *pStr, double *pValue);
+size_t elnumparseInt64Column(const strview *arrViews, size_t nCount, 
+	int64_t *arrValues, int *arrErrors);
+size_t elnumparseUInt64Column(const strview *arrViews, size_t nCount, 
+	uint64_t *arrValues, int *arrErrors);
+size_t elnumparseDoubleColumn(const strview *arrViews, size_t nCount, 
+	double *arrValues, int *arrErrors);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
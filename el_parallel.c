@@ -0,0 +1,146 @@
+/* Extreme Library (EL). Parallel algorithms. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdatomic.h>
+#include <unistd.h>
+
+#include "el_memory.h"
+
+#include "el_parallel.h"
+#include "el_threadpool.h"
+
+/**
+ * Number of chunks each thread gets on average. More chunks give better load 
+ * balancing when callbacks have different cost, fewer chunks give less 
+ * contention on the shared chunk counter.
+ */
+#define EL_PARALLEL_CHUNKS_PER_THREAD	8
+
+/** 
+ * @brief Holds the state shared by all threads of one parallel foreach call.
+ */
+typedef struct elparallel_foreach {
+	void **pItems; /**< Items to iterate. */
+	size_t nCountItems; /**< Number of items. */
+	size_t nChunkSize; /**< Number of items in one chunk. */
+	bool (*dataCallbackEx)(void *pData, void *pEx); /**< Callback. */
+	void *pEx; /**< Custom data sent to callback. */
+	atomic_size_t nNextChunk; /**< Index of the next chunk to process. */
+	atomic_bool bStop; /**< Set when any callback returned @b false. */
+} elparallel_foreach;
+
+/**
+ * Returns the number of threads used by parallel algorithms when caller 
+ * doesn't specify it (number of online processors).
+ * @return Default number of threads (always 1 or more).
+ */
+size_t elparallelGetDefaultThreadCount() {
+	long nCount = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return nCount > 0 ? (size_t)nCount : 1;
+}
+
+/**
+ * Processes chunks of items until all chunks are taken or iteration is 
+ * stopped. Is executed by each thread participating in parallel foreach.
+ * @param nTask    Not used.
+ * @param nTaskEnd Not used.
+ * @param p        Parallel foreach state.
+ */
+static void elparallelForEachWorker(size_t nTask, size_t nTaskEnd, void *p) {
+	elparallel_foreach *pState = p;
+
+	(void)nTask;
+	(void)nTaskEnd;
+
+	while(!atomic_load_explicit(&pState->bStop, memory_order_relaxed)) {
+		size_t nChunk = atomic_fetch_add_explicit(&pState->nNextChunk, 1, 
+			memory_order_relaxed);
+		size_t nStart = nChunk * pState->nChunkSize;
+		if(nStart >= pState->nCountItems)
+			break;
+
+		size_t nEnd = nStart + pState->nChunkSize;
+		if(nEnd > pState->nCountItems)
+			nEnd = pState->nCountItems;
+
+		for(size_t i = nStart; i < nEnd; i++)
+			if(!pState->dataCallbackEx(pState->pItems[i], pState->pEx)) {
+				atomic_store_explicit(&pState->bStop, true, 
+					memory_order_relaxed);
+				break;
+			}
+	}
+}
+
+/**
+ * Calls specified function for each item of an array using several threads of
+ * the default thread pool. Items are split into chunks which are taken by 
+ * threads one by one, calling thread also processes chunks. Passes the pointer
+ * to custom data to the callback function. If function returns @b false - 
+ * stops iteration: chunks not yet started are skipped, items of chunks being 
+ * processed by other threads are not. So the set of processed items is 
+ * unspecified in this case.
+ * @param  pItems         An array of items.
+ * @param  nCountItems    Number of items in the @e pItems array.
+ * @param  dataCallbackEx Callback function to be called for each item. Must be
+ * thread safe.
+ * @param  pEx            Pointer to custom data to be sent to callback.
+ * @param  nThreads       Maximal number of threads to use (including calling 
+ * thread). If 0 - elparallelGetDefaultThreadCount() is used.
+ * @return                @b True if all items were processed, @b false if 
+ * iteration was stopped by callback or an error occured.
+ */
+bool elparallelForEachEx(void **pItems, size_t nCountItems, 
+	bool (*dataCallbackEx)(void *pData, void *pEx), void *pEx, 
+	size_t nThreads) {
+
+	if(dataCallbackEx == NULL)
+		return false;
+
+	if(nCountItems == 0)
+		return true;
+
+	if(pItems == NULL)
+		return false;
+
+	if(nThreads == 0)
+		nThreads = elparallelGetDefaultThreadCount();
+	if(nThreads > nCountItems)
+		nThreads = nCountItems;
+
+	elparallel_foreach state;
+	state.pItems = pItems;
+	state.nCountItems = nCountItems;
+	state.nChunkSize = nCountItems / (nThreads * EL_PARALLEL_CHUNKS_PER_THREAD);
+	if(state.nChunkSize == 0)
+		state.nChunkSize = 1;
+	state.dataCallbackEx = dataCallbackEx;
+	state.pEx = pEx;
+	atomic_init(&state.nNextChunk, 0);
+	atomic_init(&state.bStop, false);
+
+	// Each of nThreads tasks takes chunks until they are over
+	if(nThreads > 1)
+		elthreadpoolParallelFor(NULL, 0, nThreads, 1, elparallelForEachWorker, 
+			&state);
+	else
+		elparallelForEachWorker(0, 1, &state);
+
+	return !atomic_load(&state.bStop);
+}
@@ -0,0 +1,38 @@
+/* Extreme Library (EL). Parallel algorithms. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _EL_PARALLEL_H_
+#define _EL_PARALLEL_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+size_t elparallelGetDefaultThreadCount();
+bool elparallelForEachEx(void **pItems, size_t nCountItems, 
+	bool (*dataCallbackEx)(void *pData, void *pEx), void *pEx, 
+	size_t nThreads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
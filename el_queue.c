@@ -0,0 +1,714 @@
+/* Extreme Library (EL). Concurrent queues. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
+#include <errno.h>
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+#include "el_memory.h"
+
+#include "el_queue.h"
+
+#define isInvalid(s) ((s) == NULL)
+
+#ifdef __linux__
+#define EL_QUEUE_CLOCK CLOCK_MONOTONIC
+#else
+#define EL_QUEUE_CLOCK CLOCK_REALTIME
+#endif
+
+/**
+ * Computes smallest power of 2 which is not less than the value specified 
+ * (and not less than 2).
+ * @param  nValue Value.
+ * @return        Power of 2 or 0 if it can't be represented by size_t.
+ */
+static size_t elqueueRoundUpPow2(size_t nValue) {
+	size_t nResult = 2;
+
+	while(nResult < nValue && nResult != 0)
+		nResult <<= 1;
+
+	return nResult;
+}
+
+/**
+ * Converts timeout to the absolute deadline.
+ * @param nTimeoutMs Timeout in milliseconds.
+ * @param pDeadline  Deadline is returned here.
+ */
+static void elqueueDeadline(long nTimeoutMs, struct timespec *pDeadline) {
+	clock_gettime(EL_QUEUE_CLOCK, pDeadline);
+
+	pDeadline->tv_sec += nTimeoutMs / 1000;
+	pDeadline->tv_nsec += (nTimeoutMs % 1000) * 1000000L;
+	if(pDeadline->tv_nsec >= 1000000000L) {
+		pDeadline->tv_sec++;
+		pDeadline->tv_nsec -= 1000000000L;
+	}
+}
+
+/**
+ * Initializes the event count.
+ * @param pThis Event count.
+ */
+static void eleventcountInit(eleventcount *pThis) {
+	atomic_init(&pThis->nEpoch, 0);
+	atomic_init(&pThis->nWaiters, 0);
+#ifndef __linux__
+	pthread_mutex_init(&pThis->mutex, NULL);
+	pthread_cond_init(&pThis->cond, NULL);
+#endif
+}
+
+/**
+ * Frees resources used by the event count.
+ * @param pThis Event count.
+ */
+static void eleventcountFree(eleventcount *pThis) {
+#ifndef __linux__
+	pthread_cond_destroy(&pThis->cond);
+	pthread_mutex_destroy(&pThis->mutex);
+#else
+	(void)pThis;
+#endif
+}
+
+/**
+ * Registers the calling thread as a waiter. Condition must be checked once 
+ * more after this call and then either eleventcountCancel() or 
+ * eleventcountWait() must be called.
+ * @param  pThis Event count.
+ * @return       Key to be passed to eleventcountWait().
+ */
+static unsigned eleventcountPrepare(eleventcount *pThis) {
+	atomic_fetch_add(&pThis->nWaiters, 1);
+
+	return atomic_load(&pThis->nEpoch);
+}
+
+/**
+ * Unregisters the calling thread as a waiter.
+ * @param pThis Event count.
+ */
+static void eleventcountCancel(eleventcount *pThis) {
+	atomic_fetch_sub(&pThis->nWaiters, 1);
+}
+
+/**
+ * Sleeps until the event count is notified after eleventcountPrepare() call 
+ * or deadline is reached.
+ * @param  pThis     Event count.
+ * @param  nKey      Key returned by eleventcountPrepare().
+ * @param  pDeadline Deadline or NULL to wait forever.
+ * @return           False if deadline was reached.
+ */
+static bool eleventcountWait(eleventcount *pThis, unsigned nKey, 
+	const struct timespec *pDeadline) {
+
+	bool bResult = true;
+
+#ifdef __linux__
+	while(atomic_load(&pThis->nEpoch) == nKey) {
+		struct timespec timeout;
+		struct timespec *pTimeout = NULL;
+		if(pDeadline != NULL) {
+			struct timespec now;
+			clock_gettime(EL_QUEUE_CLOCK, &now);
+			timeout.tv_sec = pDeadline->tv_sec - now.tv_sec;
+			timeout.tv_nsec = pDeadline->tv_nsec - now.tv_nsec;
+			if(timeout.tv_nsec < 0) {
+				timeout.tv_sec--;
+				timeout.tv_nsec += 1000000000L;
+			}
+			if(timeout.tv_sec < 0) {
+				bResult = false;
+				break;
+			}
+			pTimeout = &timeout;
+		}
+		if(syscall(SYS_futex, &pThis->nEpoch, FUTEX_WAIT_PRIVATE, nKey, 
+			pTimeout, NULL, 0) != 0 && errno == ETIMEDOUT) {
+			bResult = false;
+			break;
+		}
+	}
+#else
+	pthread_mutex_lock(&pThis->mutex);
+	while(atomic_load(&pThis->nEpoch) == nKey) {
+		if(pDeadline != NULL) {
+			if(pthread_cond_timedwait(&pThis->cond, &pThis->mutex, 
+				pDeadline) == ETIMEDOUT) {
+				bResult = false;
+				break;
+			}
+		} else
+			pthread_cond_wait(&pThis->cond, &pThis->mutex);
+	}
+	pthread_mutex_unlock(&pThis->mutex);
+#endif
+
+	atomic_fetch_sub(&pThis->nWaiters, 1);
+
+	return bResult;
+}
+
+/**
+ * Wakes up all threads waiting on the event count. Costs only a memory fence 
+ * when there are no waiters.
+ * @param pThis Event count.
+ */
+static void eleventcountNotify(eleventcount *pThis) {
+	atomic_thread_fence(memory_order_seq_cst);
+	if(atomic_load_explicit(&pThis->nWaiters, memory_order_relaxed) == 0)
+		return;
+
+#ifdef __linux__
+	atomic_fetch_add(&pThis->nEpoch, 1);
+	syscall(SYS_futex, &pThis->nEpoch, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, 
+		NULL, 0);
+#else
+	pthread_mutex_lock(&pThis->mutex);
+	atomic_fetch_add(&pThis->nEpoch, 1);
+	pthread_cond_broadcast(&pThis->cond);
+	pthread_mutex_unlock(&pThis->mutex);
+#endif
+}
+
+/**
+ * Waits until operation succeeds or timeout expires. Expands into the body of
+ * blocking push and pop functions.
+ * @param  pEC        Event count to wait on.
+ * @param  tryOp      Expression trying the non-blocking operation.
+ * @param  nTimeoutMs Timeout in milliseconds.
+ */
+#define waitFor(pEC, tryOp, nTimeoutMs) { \
+	if(tryOp) \
+		return true; \
+	if((nTimeoutMs) == 0) \
+		return false; \
+	struct timespec deadline; \
+	if((nTimeoutMs) > 0) \
+		elqueueDeadline((nTimeoutMs), &deadline); \
+	while(true) { \
+		unsigned nKey = eleventcountPrepare(pEC); \
+		if(tryOp) { \
+			eleventcountCancel(pEC); \
+			return true; \
+		} \
+		if(!eleventcountWait((pEC), nKey, \
+			(nTimeoutMs) > 0 ? &deadline : NULL)) \
+			return (tryOp); \
+	} \
+}
+
+/**
+ * Creates new MPMC queue.
+ * @param  nCapacityMin   Minimal capacity required. Actual capacity is rounded 
+ * up to a power of 2.
+ * @param  dataDestructor Pointer to callback function which will be called for
+ * each item left in the queue when it's destroyed (may be NULL).
+ * @return                Newly created queue (or NULL if an error occured).
+ */
+mpmcqueue *elmpmcqueueCreate(size_t nCapacityMin, 
+	void (*dataDestructor)(void *pData)) {
+
+	size_t nCapacity = elqueueRoundUpPow2(nCapacityMin);
+	if(nCapacity == 0)
+		return NULL;
+
+	mpmcqueue *pThis = EL_CALLOC(1, sizeof(mpmcqueue));
+	if(pThis == NULL)
+		return NULL;
+
+	pThis->pCells = EL_ALLOC(sizeof(elmpmcqueue_cell) * nCapacity);
+	if(pThis->pCells == NULL) {
+		EL_FREE(pThis);
+		return NULL;
+	}
+
+	for(size_t i = 0; i < nCapacity; i++) {
+		atomic_init(&pThis->pCells[i].nSequence, i);
+		pThis->pCells[i].pData = NULL;
+	}
+
+	pThis->nMask = nCapacity - 1;
+	pThis->dataDestructor = dataDestructor;
+	atomic_init(&pThis->nPushPos, 0);
+	atomic_init(&pThis->nPopPos, 0);
+	eleventcountInit(&pThis->ecNotEmpty);
+	eleventcountInit(&pThis->ecNotFull);
+
+	return pThis;
+}
+
+/**
+ * Pushes the item without notifying waiting consumers.
+ * @param  pThis MPMC queue.
+ * @param  pData Item data.
+ * @return       True if item was pushed, false if the queue is full.
+ */
+static bool elmpmcqueueTryPush(mpmcqueue *pThis, void *pData) {
+	size_t nPos = atomic_load_explicit(&pThis->nPushPos, memory_order_relaxed);
+
+	elmpmcqueue_cell *pCell;
+	while(true) {
+		pCell = &pThis->pCells[nPos & pThis->nMask];
+		size_t nSeq = atomic_load_explicit(&pCell->nSequence, 
+			memory_order_acquire);
+		intptr_t nDiff = (intptr_t)nSeq - (intptr_t)nPos;
+
+		if(nDiff == 0) {
+			if(atomic_compare_exchange_weak_explicit(&pThis->nPushPos, &nPos, 
+				nPos + 1, memory_order_relaxed, memory_order_relaxed))
+				break;
+		} else if(nDiff < 0)
+			return false;
+		else
+			nPos = atomic_load_explicit(&pThis->nPushPos, memory_order_relaxed);
+	}
+
+	pCell->pData = pData;
+	atomic_store_explicit(&pCell->nSequence, nPos + 1, memory_order_release);
+
+	return true;
+}
+
+/**
+ * Pops the item without notifying waiting producers.
+ * @param  pThis  MPMC queue.
+ * @param  ppData Item data is returned here.
+ * @return        True if item was popped, false if the queue is empty.
+ */
+static bool elmpmcqueueTryPop(mpmcqueue *pThis, void **ppData) {
+	size_t nPos = atomic_load_explicit(&pThis->nPopPos, memory_order_relaxed);
+
+	elmpmcqueue_cell *pCell;
+	while(true) {
+		pCell = &pThis->pCells[nPos & pThis->nMask];
+		size_t nSeq = atomic_load_explicit(&pCell->nSequence, 
+			memory_order_acquire);
+		intptr_t nDiff = (intptr_t)nSeq - (intptr_t)(nPos + 1);
+
+		if(nDiff == 0) {
+			if(atomic_compare_exchange_weak_explicit(&pThis->nPopPos, &nPos, 
+				nPos + 1, memory_order_relaxed, memory_order_relaxed))
+				break;
+		} else if(nDiff < 0)
+			return false;
+		else
+			nPos = atomic_load_explicit(&pThis->nPopPos, memory_order_relaxed);
+	}
+
+	*ppData = pCell->pData;
+	atomic_store_explicit(&pCell->nSequence, nPos + pThis->nMask + 1, 
+		memory_order_release);
+
+	return true;
+}
+
+/**
+ * Destroys the MPMC queue and all items left in it (using data destructor).
+ * Must not be called while other threads use the queue.
+ * @param pThis MPMC queue to be destroyed.
+ */
+void elmpmcqueueDestroy(mpmcqueue *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	void *pData;
+	while(elmpmcqueueTryPop(pThis, &pData))
+		if(pData != NULL && pThis->dataDestructor != NULL)
+			pThis->dataDestructor(pData);
+
+	eleventcountFree(&pThis->ecNotEmpty);
+	eleventcountFree(&pThis->ecNotFull);
+
+	EL_FREE(pThis->pCells);
+	EL_FREE(pThis);
+}
+
+/**
+ * Returns the capacity of the MPMC queue.
+ * @param  pThis MPMC queue.
+ * @return       Maximal number of items the queue may hold.
+ */
+size_t elmpmcqueueGetCapacity(mpmcqueue *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	return pThis->nMask + 1;
+}
+
+/**
+ * Returns the number of items in the MPMC queue. When other threads use the 
+ * queue the value is approximate.
+ * @param  pThis MPMC queue.
+ * @return       Number of items in the queue.
+ */
+size_t elmpmcqueueGetCount(mpmcqueue *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	size_t nPop = atomic_load(&pThis->nPopPos);
+	size_t nPush = atomic_load(&pThis->nPushPos);
+
+	return nPush > nPop ? nPush - nPop : 0;
+}
+
+/**
+ * Pushes the item to the MPMC queue. Never blocks.
+ * @param  pThis MPMC queue.
+ * @param  pData Item data. Queue takes ownership of the data.
+ * @return       True if item was pushed, false if the queue is full.
+ */
+bool elmpmcqueuePush(mpmcqueue *pThis, void *pData) {
+	if(isInvalid(pThis))
+		return false;
+
+	if(!elmpmcqueueTryPush(pThis, pData))
+		return false;
+
+	eleventcountNotify(&pThis->ecNotEmpty);
+
+	return true;
+}
+
+/**
+ * Pops the item from the MPMC queue. Never blocks.
+ * @param  pThis  MPMC queue.
+ * @param  ppData Item data is returned here. Caller takes ownership of the 
+ * data.
+ * @return        True if item was popped, false if the queue is empty.
+ */
+bool elmpmcqueuePop(mpmcqueue *pThis, void **ppData) {
+	if(isInvalid(pThis) || ppData == NULL)
+		return false;
+
+	if(!elmpmcqueueTryPop(pThis, ppData))
+		return false;
+
+	eleventcountNotify(&pThis->ecNotFull);
+
+	return true;
+}
+
+/**
+ * Pushes several items to the MPMC queue. Never blocks. Items are pushed in 
+ * order until the queue becomes full.
+ * @param  pThis       MPMC queue.
+ * @param  pItems      An array of items.
+ * @param  nCountItems Number of items in the @e pItems array.
+ * @return             Number of pushed items.
+ */
+size_t elmpmcqueuePushBatch(mpmcqueue *pThis, void **pItems, 
+	size_t nCountItems) {
+
+	if(isInvalid(pThis) || pItems == NULL)
+		return 0;
+
+	size_t nPushed = 0;
+	while(nPushed < nCountItems && elmpmcqueueTryPush(pThis, pItems[nPushed]))
+		nPushed++;
+
+	if(nPushed > 0)
+		eleventcountNotify(&pThis->ecNotEmpty);
+
+	return nPushed;
+}
+
+/**
+ * Pops several items from the MPMC queue. Never blocks.
+ * @param  pThis     MPMC queue.
+ * @param  pItems    An array where popped items are returned.
+ * @param  nCountMax Maximal number of items to pop (size of @e pItems).
+ * @return           Number of popped items.
+ */
+size_t elmpmcqueuePopBatch(mpmcqueue *pThis, void **pItems, 
+	size_t nCountMax) {
+
+	if(isInvalid(pThis) || pItems == NULL)
+		return 0;
+
+	size_t nPopped = 0;
+	while(nPopped < nCountMax && elmpmcqueueTryPop(pThis, &pItems[nPopped]))
+		nPopped++;
+
+	if(nPopped > 0)
+		eleventcountNotify(&pThis->ecNotFull);
+
+	return nPopped;
+}
+
+/**
+ * Pushes the item to the MPMC queue. If the queue is full - waits until some 
+ * item is popped.
+ * @param  pThis      MPMC queue.
+ * @param  pData      Item data.
+ * @param  nTimeoutMs Timeout in milliseconds (EL_WAIT_INFINITE to wait 
+ * forever).
+ * @return            True if item was pushed, false if timeout expired.
+ */
+bool elmpmcqueuePushWait(mpmcqueue *pThis, void *pData, long nTimeoutMs) {
+	if(isInvalid(pThis))
+		return false;
+
+	waitFor(&pThis->ecNotFull, elmpmcqueuePush(pThis, pData), nTimeoutMs);
+}
+
+/**
+ * Pops the item from the MPMC queue. If the queue is empty - waits until some 
+ * item is pushed.
+ * @param  pThis      MPMC queue.
+ * @param  ppData     Item data is returned here.
+ * @param  nTimeoutMs Timeout in milliseconds (EL_WAIT_INFINITE to wait 
+ * forever).
+ * @return            True if item was popped, false if timeout expired.
+ */
+bool elmpmcqueuePopWait(mpmcqueue *pThis, void **ppData, long nTimeoutMs) {
+	if(isInvalid(pThis) || ppData == NULL)
+		return false;
+
+	waitFor(&pThis->ecNotEmpty, elmpmcqueuePop(pThis, ppData), nTimeoutMs);
+}
+
+/**
+ * Creates new SPSC ring buffer.
+ * @param  nCapacityMin   Minimal capacity required. Actual capacity is rounded 
+ * up to a power of 2.
+ * @param  dataDestructor Pointer to callback function which will be called for
+ * each item left in the ring buffer when it's destroyed (may be NULL).
+ * @return                Newly created ring buffer (or NULL if an error 
+ * occured).
+ */
+spscring *elspscringCreate(size_t nCapacityMin, 
+	void (*dataDestructor)(void *pData)) {
+
+	size_t nCapacity = elqueueRoundUpPow2(nCapacityMin);
+	if(nCapacity == 0)
+		return NULL;
+
+	spscring *pThis = EL_CALLOC(1, sizeof(spscring));
+	if(pThis == NULL)
+		return NULL;
+
+	pThis->pItems = EL_ALLOC(sizeof(void *) * nCapacity);
+	if(pThis->pItems == NULL) {
+		EL_FREE(pThis);
+		return NULL;
+	}
+
+	pThis->nMask = nCapacity - 1;
+	pThis->dataDestructor = dataDestructor;
+	atomic_init(&pThis->nHead, 0);
+	atomic_init(&pThis->nTail, 0);
+	eleventcountInit(&pThis->ecNotEmpty);
+	eleventcountInit(&pThis->ecNotFull);
+
+	return pThis;
+}
+
+/**
+ * Destroys the SPSC ring buffer and all items left in it (using data 
+ * destructor). Must not be called while other threads use the ring buffer.
+ * @param pThis SPSC ring buffer to be destroyed.
+ */
+void elspscringDestroy(spscring *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	size_t nHead = atomic_load(&pThis->nHead);
+	size_t nTail = atomic_load(&pThis->nTail);
+	if(pThis->dataDestructor != NULL)
+		for(; nHead != nTail; nHead++) {
+			void *pData = pThis->pItems[nHead & pThis->nMask];
+			if(pData != NULL)
+				pThis->dataDestructor(pData);
+		}
+
+	eleventcountFree(&pThis->ecNotEmpty);
+	eleventcountFree(&pThis->ecNotFull);
+
+	EL_FREE(pThis->pItems);
+	EL_FREE(pThis);
+}
+
+/**
+ * Returns the capacity of the SPSC ring buffer.
+ * @param  pThis SPSC ring buffer.
+ * @return       Maximal number of items the ring buffer may hold.
+ */
+size_t elspscringGetCapacity(spscring *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	return pThis->nMask + 1;
+}
+
+/**
+ * Returns the number of items in the SPSC ring buffer. When other threads use 
+ * the ring buffer the value is approximate.
+ * @param  pThis SPSC ring buffer.
+ * @return       Number of items in the ring buffer.
+ */
+size_t elspscringGetCount(spscring *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	size_t nHead = atomic_load(&pThis->nHead);
+	size_t nTail = atomic_load(&pThis->nTail);
+
+	return nTail > nHead ? nTail - nHead : 0;
+}
+
+/**
+ * Pushes several items to the SPSC ring buffer. Never blocks. Items are pushed 
+ * in order until the ring buffer becomes full. Must be called by producer only.
+ * @param  pThis       SPSC ring buffer.
+ * @param  pItems      An array of items.
+ * @param  nCountItems Number of items in the @e pItems array.
+ * @return             Number of pushed items.
+ */
+size_t elspscringPushBatch(spscring *pThis, void **pItems, 
+	size_t nCountItems) {
+
+	if(isInvalid(pThis) || pItems == NULL || nCountItems == 0)
+		return 0;
+
+	size_t nTail = atomic_load_explicit(&pThis->nTail, memory_order_relaxed);
+	size_t nCapacity = pThis->nMask + 1;
+
+	size_t nFree = nCapacity - (nTail - pThis->nHeadCached);
+	if(nFree < nCountItems) {
+		pThis->nHeadCached = atomic_load_explicit(&pThis->nHead, 
+			memory_order_acquire);
+		nFree = nCapacity - (nTail - pThis->nHeadCached);
+	}
+	if(nCountItems > nFree)
+		nCountItems = nFree;
+	if(nCountItems == 0)
+		return 0;
+
+	for(size_t i = 0; i < nCountItems; i++)
+		pThis->pItems[(nTail + i) & pThis->nMask] = pItems[i];
+
+	atomic_store_explicit(&pThis->nTail, nTail + nCountItems, 
+		memory_order_release);
+	eleventcountNotify(&pThis->ecNotEmpty);
+
+	return nCountItems;
+}
+
+/**
+ * Pops several items from the SPSC ring buffer. Never blocks. Must be called 
+ * by consumer only.
+ * @param  pThis     SPSC ring buffer.
+ * @param  pItems    An array where popped items are returned.
+ * @param  nCountMax Maximal number of items to pop (size of @e pItems).
+ * @return           Number of popped items.
+ */
+size_t elspscringPopBatch(spscring *pThis, void **pItems, size_t nCountMax) {
+	if(isInvalid(pThis) || pItems == NULL || nCountMax == 0)
+		return 0;
+
+	size_t nHead = atomic_load_explicit(&pThis->nHead, memory_order_relaxed);
+
+	size_t nAvailable = pThis->nTailCached - nHead;
+	if(nAvailable < nCountMax) {
+		pThis->nTailCached = atomic_load_explicit(&pThis->nTail, 
+			memory_order_acquire);
+		nAvailable = pThis->nTailCached - nHead;
+	}
+	if(nCountMax > nAvailable)
+		nCountMax = nAvailable;
+	if(nCountMax == 0)
+		return 0;
+
+	for(size_t i = 0; i < nCountMax; i++)
+		pItems[i] = pThis->pItems[(nHead + i) & pThis->nMask];
+
+	atomic_store_explicit(&pThis->nHead, nHead + nCountMax, 
+		memory_order_release);
+	eleventcountNotify(&pThis->ecNotFull);
+
+	return nCountMax;
+}
+
+/**
+ * Pushes the item to the SPSC ring buffer. Never blocks. Must be called by 
+ * producer only.
+ * @param  pThis SPSC ring buffer.
+ * @param  pData Item data. Ring buffer takes ownership of the data.
+ * @return       True if item was pushed, false if the ring buffer is full.
+ */
+bool elspscringPush(spscring *pThis, void *pData) {
+	return elspscringPushBatch(pThis, &pData, 1) == 1;
+}
+
+/**
+ * Pops the item from the SPSC ring buffer. Never blocks. Must be called by 
+ * consumer only.
+ * @param  pThis  SPSC ring buffer.
+ * @param  ppData Item data is returned here. Caller takes ownership of the 
+ * data.
+ * @return        True if item was popped, false if the ring buffer is empty.
+ */
+bool elspscringPop(spscring *pThis, void **ppData) {
+	if(ppData == NULL)
+		return false;
+
+	return elspscringPopBatch(pThis, ppData, 1) == 1;
+}
+
+/**
+ * Pushes the item to the SPSC ring buffer. If the ring buffer is full - waits 
+ * until some item is popped. Must be called by producer only.
+ * @param  pThis      SPSC ring buffer.
+ * @param  pData      Item data.
+ * @param  nTimeoutMs Timeout in milliseconds (EL_WAIT_INFINITE to wait 
+ * forever).
+ * @return            True if item was pushed, false if timeout expired.
+ */
+bool elspscringPushWait(spscring *pThis, void *pData, long nTimeoutMs) {
+	if(isInvalid(pThis))
+		return false;
+
+	waitFor(&pThis->ecNotFull, elspscringPush(pThis, pData), nTimeoutMs);
+}
+
+/**
+ * Pops the item from the SPSC ring buffer. If the ring buffer is empty - waits
+ * until some item is pushed. Must be called by consumer only.
+ * @param  pThis      SPSC ring buffer.
+ * @param  ppData     Item data is returned here.
+ * @param  nTimeoutMs Timeout in milliseconds (EL_WAIT_INFINITE to wait 
+ * forever).
+ * @return            True if item was popped, false if timeout expired.
+ */
+bool elspscringPopWait(spscring *pThis, void **ppData, long nTimeoutMs) {
+	if(isInvalid(pThis) || ppData == NULL)
+		return false;
+
+	waitFor(&pThis->ecNotEmpty, elspscringPop(pThis, ppData), nTimeoutMs);
+}
@@ -0,0 +1,146 @@
+/* Extreme Library (EL). Concurrent queues. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _EL_QUEUE_H_
+#define _EL_QUEUE_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#ifndef __linux__
+#include <pthread.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Size of the cache line. Indexes modified by different threads are separated 
+ * by padding of this size so they don't share cache lines.
+ */
+#define EL_CACHE_LINE_SIZE	64
+
+/** 
+ * @brief Lets threads sleep until some condition changes. Futex is used on 
+ * Linux, mutex and condition variable elsewhere.
+ */
+typedef struct eleventcount {
+	atomic_uint nEpoch; /**< Incremented on each notification. */
+	atomic_uint nWaiters; /**< Number of threads preparing to wait or 
+	waiting. */
+#ifndef __linux__
+	pthread_mutex_t mutex; /**< Protects waiting. */
+	pthread_cond_t cond; /**< Signalled on each notification. */
+#endif
+} eleventcount;
+
+/** 
+ * @brief Cell of the MPMC queue.
+ */
+typedef struct elmpmcqueue_cell {
+	atomic_size_t nSequence; /**< Tells if the cell is ready for push or pop. */
+	void *pData; /**< Data of the item. */
+} elmpmcqueue_cell;
+
+/** 
+ * @brief Bounded lock-free multi-producer multi-consumer queue of pointers.
+ *
+ * Any number of threads may push and pop items concurrently. Non-blocking 
+ * operations never take locks. Blocking operations sleep only when the queue 
+ * is full (push) or empty (pop).
+ */
+typedef struct mpmcqueue {
+	elmpmcqueue_cell *pCells; /**< Ring buffer of cells. */
+	size_t nMask; /**< Capacity minus one (capacity is a power of 2). */
+	void (*dataDestructor)(void *pData); /**< Pointer to callback which 
+	destroys data. */
+	char padding1[EL_CACHE_LINE_SIZE]; /**< Padding. */
+	atomic_size_t nPushPos; /**< Position of the next push. */
+	char padding2[EL_CACHE_LINE_SIZE]; /**< Padding. */
+	atomic_size_t nPopPos; /**< Position of the next pop. */
+	char padding3[EL_CACHE_LINE_SIZE]; /**< Padding. */
+	eleventcount ecNotEmpty; /**< Waited by 
+	consumers. */
+	eleventcount ecNotFull; /**< Waited by producers. */
+} mpmcqueue;
+
+/** 
+ * @brief Bounded wait-free single-producer single-consumer ring buffer of 
+ * pointers.
+ *
+ * Only one thread may push items and only one thread may pop items at the 
+ * same time.
+ */
+typedef struct spscring {
+	void **pItems; /**< Ring buffer of items. */
+	size_t nMask; /**< Capacity minus one (capacity is a power of 2). */
+	void (*dataDestructor)(void *pData); /**< Pointer to callback which 
+	destroys data. */
+	char padding1[EL_CACHE_LINE_SIZE]; /**< Padding. */
+	atomic_size_t nHead; /**< Position of the next pop (written by 
+	consumer). */
+	size_t nTailCached; /**< Consumer's copy of @e nTail. */
+	char padding2[EL_CACHE_LINE_SIZE]; /**< Padding. */
+	atomic_size_t nTail; /**< Position of the next push (written by 
+	producer). */
+	size_t nHeadCached; /**< Producer's copy of @e nHead. */
+	char padding3[EL_CACHE_LINE_SIZE]; /**< Padding. */
+	eleventcount ecNotEmpty; /**< Waited by 
+	consumer. */
+	eleventcount ecNotFull; /**< Waited by producer. */
+} spscring;
+
+/**
+ * Timeout value which means "wait forever".
+ */
+#define EL_WAIT_INFINITE	(-1L)
+
+mpmcqueue *elmpmcqueueCreate(size_t nCapacityMin, 
+	void (*dataDestructor)(void *pData));
+void elmpmcqueueDestroy(mpmcqueue *pThis);
+size_t elmpmcqueueGetCapacity(mpmcqueue *pThis);
+size_t elmpmcqueueGetCount(mpmcqueue *pThis);
+bool elmpmcqueuePush(mpmcqueue *pThis, void *pData);
+bool elmpmcqueuePop(mpmcqueue *pThis, void **ppData);
+size_t elmpmcqueuePushBatch(mpmcqueue *pThis, void **pItems, 
+	size_t nCountItems);
+size_t elmpmcqueuePopBatch(mpmcqueue *pThis, void **pItems, 
+	size_t nCountMax);
+bool elmpmcqueuePushWait(mpmcqueue *pThis, void *pData, long nTimeoutMs);
+bool elmpmcqueuePopWait(mpmcqueue *pThis, void **ppData, long nTimeoutMs);
+
+spscring *elspscringCreate(size_t nCapacityMin, 
+	void (*dataDestructor)(void *pData));
+void elspscringDestroy(spscring *pThis);
+size_t elspscringGetCapacity(spscring *pThis);
+size_t elspscringGetCount(spscring *pThis);
+bool elspscringPush(spscring *pThis, void *pData);
+bool elspscringPop(spscring *pThis, void **ppData);
+size_t elspscringPushBatch(spscring *pThis, void **pItems, 
+	size_t nCountItems);
+size_t elspscringPopBatch(spscring *pThis, void **pItems, size_t nCountMax);
+bool elspscringPushWait(spscring *pThis, void *pData, long nTimeoutMs);
+bool elspscringPopWait(spscring *pThis, void **ppData, long nTimeoutMs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,439 @@
+/* Extreme Library (EL). Rank/select index. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include <string.h>
+
+#include "el_memory.h"
+
+#include "el_rankselect.h"
+#include "el_bitops.h"
+
+#define isInvalid(s) ((s) == NULL)
+
+/**
+ * Number of bits in a word of the bit set.
+ */
+#define EL_RANKSELECT_WORD_BITS	(sizeof(uintmax_t) << 3)
+/**
+ * Number of words in a block.
+ */
+#define EL_RANKSELECT_BLOCK_WORDS	(512 / EL_RANKSELECT_WORD_BITS)
+/**
+ * Number of blocks in a superblock (superblock is 2^16 bits, so counts 
+ * relative to it fit into 16 bits).
+ */
+#define EL_RANKSELECT_SUPER_BLOCKS	128
+/**
+ * Every EL_RANKSELECT_SAMPLE-th bit set is sampled for select.
+ */
+#define EL_RANKSELECT_SAMPLE	8192
+
+/**
+ * Counts bits which are set in a single word.
+ * @param  nValue Word.
+ * @return        Number of bits set.
+ */
+static inline size_t elrankselectPopCount(uintmax_t nValue) {
+#if defined(__GNUC__) && UINTMAX_MAX == UINT64_MAX
+	return (size_t)__builtin_popcountll(nValue);
+#else
+	size_t nCount = 0;
+	for (; nValue; nCount++)
+		nValue &= nValue - 1; // clear the least significant bit set
+	return nCount;
+#endif
+}
+
+/**
+ * Returns the index of the lowest bit set. The word must not be zero.
+ * @param  nValue Word.
+ * @return        Index of the lowest bit set.
+ */
+static inline unsigned elrankselectLowestBit(uintmax_t nValue) {
+#if defined(__GNUC__) && UINTMAX_MAX == UINT64_MAX
+	return (unsigned)__builtin_ctzll(nValue);
+#else
+	unsigned nIndex = 0;
+	for(; (nValue & 1) == 0; nValue >>= 1)
+		nIndex++;
+	return nIndex;
+#endif
+}
+
+/**
+ * Returns the index of the bit set with the given rank in a single word. 
+ * Skips whole bytes first, so no more than 15 steps are made.
+ * @param  nValue Word.
+ * @param  nRank  Rank of the bit (zero based, less than the number of bits 
+ * set in the word).
+ * @return        Index of the bit.
+ */
+static inline unsigned elrankselectSelectInWord(uintmax_t nValue, 
+	size_t nRank) {
+
+	unsigned nShift = 0;
+	for(;; nShift += 8) {
+		size_t nBits = elrankselectPopCount((nValue >> nShift) & 0xFF);
+		if(nRank < nBits)
+			break;
+		nRank -= nBits;
+	}
+
+	uintmax_t nByte = (nValue >> nShift) & 0xFF;
+	for(; nRank > 0; nRank--)
+		nByte &= nByte - 1; // clear the least significant bit set
+
+	return nShift + elrankselectLowestBit(nByte);
+}
+
+/**
+ * Returns the number of bits set before the block.
+ * @param  pThis  Rank/select index.
+ * @param  nBlock Index of the block.
+ * @return        Number of bits set.
+ */
+static inline size_t elrankselectGetBlockRank(rankselect *pThis, 
+	size_t nBlock) {
+
+	return (size_t)pThis->arrSupers[nBlock / EL_RANKSELECT_SUPER_BLOCKS] + 
+		pThis->arrBlocks[nBlock];
+}
+
+/**
+ * Frees the directory of the index.
+ * @param pThis Rank/select index.
+ */
+static void elrankselectFreeDirectory(rankselect *pThis) {
+	EL_FREE(pThis->arrSupers);
+	EL_FREE(pThis->arrBlocks);
+	EL_FREE(pThis->arrSamples);
+	pThis->arrSupers = NULL;
+	pThis->arrBlocks = NULL;
+	pThis->arrSamples = NULL;
+	pThis->nSamples = 0;
+	pThis->bSamplesValid = false;
+}
+
+/**
+ * Samples every EL_RANKSELECT_SAMPLE-th bit set. Array of samples must be 
+ * large enough.
+ * @param pThis Rank/select index.
+ */
+static void elrankselectBuildSamples(rankselect *pThis) {
+	size_t nSample = 0;
+	size_t nRankNext = 0;
+
+	for(size_t nSuper = 0; nSuper < pThis->nSupers; nSuper++) {
+		size_t nRankEnd = (size_t)pThis->arrSupers[nSuper + 1];
+		for(; nRankNext < nRankEnd; nRankNext += EL_RANKSELECT_SAMPLE)
+			pThis->arrSamples[nSample++] = nSuper;
+	}
+
+	pThis->nSamples = nSample;
+	pThis->bSamplesValid = true;
+}
+
+/**
+ * Creates new rank/select index over the bit set. Bit set isn't copied, so it 
+ * must outlive the index. After the bit set is changed directly the index 
+ * must be rebuilt, or the changes must be made through elrankselectSet() and 
+ * elrankselectReset().
+ *
+ * Rank of a position is the number of bits set before it, so ranks of the 
+ * bits set form dense indices (from 0 to the number of bits set) and select 
+ * maps the dense index back to the position.
+ * @param  pBitset Bit set to be indexed.
+ * @return         Newly created index (or NULL if an error occured).
+ */
+rankselect *elrankselectCreate(bitset *pBitset) {
+	if(isInvalid(pBitset))
+		return NULL;
+
+	rankselect *pThis = (rankselect *)EL_CALLOC(1, sizeof(rankselect));
+	if(isInvalid(pThis))
+		return NULL;
+
+	pThis->pBitset = pBitset;
+	if(!elrankselectRebuild(pThis)) {
+		EL_FREE(pThis);
+		return NULL;
+	}
+
+	return pThis;
+}
+
+/**
+ * Destroys the rank/select index. Bit set indexed isn't destroyed.
+ * @param pThis Rank/select index to be destroyed.
+ */
+void elrankselectDestroy(rankselect *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	elrankselectFreeDirectory(pThis);
+	EL_FREE(pThis);
+}
+
+/**
+ * Rebuilds the index after the bit set was changed (including changes of its 
+ * capacity). Takes time proportional to the size of the bit set.
+ * @param  pThis Rank/select index.
+ * @return       @b True if the index was rebuilt, or @b false if an error 
+ * occured (the index becomes empty then).
+ */
+bool elrankselectRebuild(rankselect *pThis) {
+	if(isInvalid(pThis))
+		return false;
+
+	elrankselectFreeDirectory(pThis);
+
+	const uintmax_t *pWords = pThis->pBitset->pBuf;
+	size_t nCapacity = pThis->pBitset->nCapacity;
+	size_t nBlocks = nCapacity / EL_RANKSELECT_BLOCK_WORDS + 
+		(nCapacity % EL_RANKSELECT_BLOCK_WORDS != 0);
+	size_t nSupers = nBlocks / EL_RANKSELECT_SUPER_BLOCKS + 
+		(nBlocks % EL_RANKSELECT_SUPER_BLOCKS != 0);
+
+	pThis->nCapacity = 0;
+	pThis->nCount = 0;
+	pThis->nBlocks = 0;
+	pThis->nSupers = 0;
+
+	pThis->arrSupers = (uint64_t *)EL_ALLOC((nSupers + 1) * sizeof(uint64_t));
+	pThis->arrBlocks = (uint16_t *)EL_ALLOC((nBlocks + 1) * sizeof(uint16_t));
+	if(isInvalid(pThis->arrSupers) || isInvalid(pThis->arrBlocks)) {
+		elrankselectFreeDirectory(pThis);
+		return false;
+	}
+
+	size_t nCount = 0;
+	for(size_t nBlock = 0; nBlock < nBlocks; nBlock++) {
+		size_t nSuper = nBlock / EL_RANKSELECT_SUPER_BLOCKS;
+		if(nBlock % EL_RANKSELECT_SUPER_BLOCKS == 0)
+			pThis->arrSupers[nSuper] = nCount;
+		pThis->arrBlocks[nBlock] = (uint16_t)(nCount - pThis->arrSupers[nSuper]);
+
+		size_t nWord = nBlock * EL_RANKSELECT_BLOCK_WORDS;
+		size_t nWords = nCapacity - nWord;
+		if(nWords > EL_RANKSELECT_BLOCK_WORDS)
+			nWords = EL_RANKSELECT_BLOCK_WORDS;
+		nCount += elbitopsCount(pWords + nWord, nWords);
+	}
+	pThis->arrSupers[nSupers] = nCount;
+
+	pThis->nCapacity = nCapacity;
+	pThis->nCount = nCount;
+	pThis->nBlocks = nBlocks;
+	pThis->nSupers = nSupers;
+
+	// select samples are optional, so the index still works without them
+	size_t nSamples = nCount / EL_RANKSELECT_SAMPLE + 1;
+	pThis->arrSamples = (size_t *)EL_ALLOC(nSamples * sizeof(size_t));
+	if(!isInvalid(pThis->arrSamples))
+		elrankselectBuildSamples(pThis);
+
+	return true;
+}
+
+/**
+ * Returns the total number of bits set.
+ * @param  pThis Rank/select index.
+ * @return       Number of bits set.
+ */
+size_t elrankselectGetCount(rankselect *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	return pThis->nCount;
+}
+
+/**
+ * Returns the number of bits set before the position (rank). Takes constant 
+ * time: two lookups in the directory and up to 8 words counted.
+ * @param  pThis Rank/select index.
+ * @param  nPos  Position (positions beyond the bit set are allowed).
+ * @return       Number of bits set in the range [0, nPos).
+ */
+size_t elrankselectRank(rankselect *pThis, size_t nPos) {
+	if(isInvalid(pThis))
+		return 0;
+
+	size_t nWord = nPos / EL_RANKSELECT_WORD_BITS;
+	if(nWord >= pThis->nCapacity)
+		return pThis->nCount;
+
+	const uintmax_t *pWords = pThis->pBitset->pBuf;
+	size_t nBlock = nWord / EL_RANKSELECT_BLOCK_WORDS;
+	size_t nResult = elrankselectGetBlockRank(pThis, nBlock);
+
+	for(size_t i = nBlock * EL_RANKSELECT_BLOCK_WORDS; i < nWord; i++)
+		nResult += elrankselectPopCount(pWords[i]);
+
+	uintmax_t nMask = ((uintmax_t)1 << (nPos % EL_RANKSELECT_WORD_BITS)) - 1;
+	return nResult + elrankselectPopCount(pWords[nWord] & nMask);
+}
+
+/**
+ * Returns the position of the bit set with the given rank (select), so that 
+ * elrankselectRank() of the result equals to @a nRank. Samples narrow the 
+ * range of superblocks searched, then superblocks and blocks are searched 
+ * binary.
+ * @param  pThis Rank/select index.
+ * @param  nRank Rank of the bit set (zero based).
+ * @return       Position of the bit (or EL_BITSET_NPOS if less than 
+ * nRank + 1 bits are set).
+ */
+size_t elrankselectSelect(rankselect *pThis, size_t nRank) {
+	if(isInvalid(pThis) || nRank >= pThis->nCount)
+		return EL_BITSET_NPOS;
+
+	// find the last superblock which starts at or before the rank
+	size_t nLow = 0;
+	size_t nHigh = pThis->nSupers - 1;
+	if(pThis->bSamplesValid) {
+		size_t nSample = nRank / EL_RANKSELECT_SAMPLE;
+		nLow = pThis->arrSamples[nSample];
+		if(nSample + 1 < pThis->nSamples)
+			nHigh = pThis->arrSamples[nSample + 1];
+	}
+	while(nLow < nHigh) {
+		size_t nMiddle = nLow + (nHigh - nLow + 1) / 2;
+		if(pThis->arrSupers[nMiddle] <= nRank)
+			nLow = nMiddle;
+		else
+			nHigh = nMiddle - 1;
+	}
+	size_t nSuper = nLow;
+	nRank -= (size_t)pThis->arrSupers[nSuper];
+
+	// find the last block in it which starts at or before the rank
+	nLow = nSuper * EL_RANKSELECT_SUPER_BLOCKS;
+	nHigh = nLow + EL_RANKSELECT_SUPER_BLOCKS - 1;
+	if(nHigh >= pThis->nBlocks)
+		nHigh = pThis->nBlocks - 1;
+	while(nLow < nHigh) {
+		size_t nMiddle = nLow + (nHigh - nLow + 1) / 2;
+		if(pThis->arrBlocks[nMiddle] <= nRank)
+			nLow = nMiddle;
+		else
+			nHigh = nMiddle - 1;
+	}
+	size_t nBlock = nLow;
+	nRank -= pThis->arrBlocks[nBlock];
+
+	// find the word in the block
+	const uintmax_t *pWords = pThis->pBitset->pBuf;
+	size_t nWord = nBlock * EL_RANKSELECT_BLOCK_WORDS;
+	for(;; nWord++) {
+		size_t nBits = elrankselectPopCount(pWords[nWord]);
+		if(nRank < nBits)
+			break;
+		nRank -= nBits;
+	}
+
+	return nWord * EL_RANKSELECT_WORD_BITS + 
+		elrankselectSelectInWord(pWords[nWord], nRank);
+}
+
+/**
+ * Adjusts the counts of all blocks and superblocks after the word changed by 
+ * one. Samples become outdated.
+ * @param pThis Rank/select index.
+ * @param nWord Index of the word changed.
+ * @param bSet  @b True if the bit was set, @b false if it was reset.
+ */
+static void elrankselectUpdate(rankselect *pThis, size_t nWord, bool bSet) {
+	size_t nBlock = nWord / EL_RANKSELECT_BLOCK_WORDS;
+	size_t nSuper = nBlock / EL_RANKSELECT_SUPER_BLOCKS;
+	size_t nBlockEnd = (nSuper + 1) * EL_RANKSELECT_SUPER_BLOCKS;
+	if(nBlockEnd > pThis->nBlocks)
+		nBlockEnd = pThis->nBlocks;
+
+	if(bSet) {
+		for(size_t i = nBlock + 1; i < nBlockEnd; i++)
+			pThis->arrBlocks[i]++;
+		for(size_t i = nSuper + 1; i <= pThis->nSupers; i++)
+			pThis->arrSupers[i]++;
+		pThis->nCount++;
+	} else {
+		for(size_t i = nBlock + 1; i < nBlockEnd; i++)
+			pThis->arrBlocks[i]--;
+		for(size_t i = nSuper + 1; i <= pThis->nSupers; i++)
+			pThis->arrSupers[i]--;
+		pThis->nCount--;
+	}
+
+	pThis->bSamplesValid = false;
+}
+
+/**
+ * Sets the bit of the indexed bit set and updates the index. Takes time 
+ * proportional to the number of superblocks after the position, and makes 
+ * select slower until the index is rebuilt.
+ * @param  pThis Rank/select index.
+ * @param  nPos  Position of the bit (must be within the indexed capacity, bit 
+ * sets don't grow).
+ * @return       @b True if the bit is set, or @b false if the position is out 
+ * of range.
+ */
+bool elrankselectSet(rankselect *pThis, size_t nPos) {
+	if(isInvalid(pThis))
+		return false;
+
+	size_t nWord = nPos / EL_RANKSELECT_WORD_BITS;
+	if(nWord >= pThis->nCapacity)
+		return false;
+
+	uintmax_t nMask = (uintmax_t)1 << (nPos % EL_RANKSELECT_WORD_BITS);
+	uintmax_t *pWords = pThis->pBitset->pBuf;
+	if((pWords[nWord] & nMask) == 0) {
+		pWords[nWord] |= nMask;
+		elrankselectUpdate(pThis, nWord, true);
+	}
+
+	return true;
+}
+
+/**
+ * Resets the bit of the indexed bit set and updates the index. Takes time 
+ * proportional to the number of superblocks after the position, and makes 
+ * select slower until the index is rebuilt.
+ * @param  pThis Rank/select index.
+ * @param  nPos  Position of the bit.
+ * @return       @b True if the bit is reset, or @b false if the position is 
+ * out of range.
+ */
+bool elrankselectReset(rankselect *pThis, size_t nPos) {
+	if(isInvalid(pThis))
+		return false;
+
+	size_t nWord = nPos / EL_RANKSELECT_WORD_BITS;
+	if(nWord >= pThis->nCapacity)
+		return false;
+
+	uintmax_t nMask = (uintmax_t)1 << (nPos % EL_RANKSELECT_WORD_BITS);
+	uintmax_t *pWords = pThis->pBitset->pBuf;
+	if((pWords[nWord] & nMask) != 0) {
+		pWords[nWord] &= ~nMask;
+		elrankselectUpdate(pThis, nWord, false);
+	}
+
+	return true;
+}
@@ -0,0 +1,71 @@
+/* Extreme Library (EL). Rank/select index. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef _EL_RANKSELECT_H_
+#define _EL_RANKSELECT_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "el_bitset.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 
+ * @brief Holds the directory answering rank and select queries over a bit 
+ * set.
+ *
+ * Bit set is split into superblocks of 2^16 bits holding absolute counts of 
+ * bits set before them, and blocks of 512 bits holding 16-bit counts relative 
+ * to their superblock (about 3.2% of the bit set size). Every 8192-th bit set 
+ * is sampled to narrow the search for select.
+ */
+typedef struct rankselect {
+	bitset *pBitset; /**< Bit set indexed (isn't owned by the index). */
+	size_t nCapacity; /**< Number of words of bit set indexed. */
+	size_t nCount; /**< Total number of bits set. */
+	size_t nBlocks; /**< Number of blocks. */
+	size_t nSupers; /**< Number of superblocks. */
+	uint64_t *arrSupers; /**< Number of bits set before each superblock 
+	(and total number after the last one). */
+	uint16_t *arrBlocks; /**< Number of bits set before each block in its 
+	superblock. */
+	size_t nSamples; /**< Number of select samples. */
+	size_t *arrSamples; /**< Superblock holding every sampled bit set. */
+	bool bSamplesValid; /**< @b False if samples are outdated by incremental 
+	updates. */
+} rankselect;
+
+rankselect *elrankselectCreate(bitset *pBitset);
+void elrankselectDestroy(rankselect *pThis);
+bool elrankselectRebuild(rankselect *pThis);
+size_t elrankselectGetCount(rankselect *pThis);
+size_t elrankselectRank(rankselect *pThis, size_t nPos);
+size_t elrankselectSelect(rankselect *pThis, size_t nRank);
+bool elrankselectSet(rankselect *pThis, size_t nPos);
+bool elrankselectReset(rankselect *pThis, size_t nPos);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
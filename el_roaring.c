@@ -0,0 +1,1458 @@
+/* Extreme Library (EL). Compressed bitmaps. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include <string.h>
+
+#include "el_memory.h"
+
+#include "el_roaring.h"
+#include "el_bitops.h"
+
+#define isInvalid(s) ((s) == NULL)
+
+/**
+ * Number of values in a chunk (and bits in bitmap container).
+ */
+#define EL_ROARING_CHUNK_BITS	65536
+/**
+ * Number of bits in a word of bitmap container.
+ */
+#define EL_ROARING_WORD_BITS	(sizeof(uintmax_t) << 3)
+/**
+ * Number of words in bitmap container.
+ */
+#define EL_ROARING_BITMAP_WORDS	(EL_ROARING_CHUNK_BITS / EL_ROARING_WORD_BITS)
+/**
+ * Initial capacity of array container.
+ */
+#define EL_ROARING_ARRAY_CAPACITY_MIN	4
+/**
+ * Number of values extracted at once from bitmap container by enumerators.
+ */
+#define EL_ROARING_FOREACH_BATCH	256
+
+#define wordIndex(nValue) ((nValue) / EL_ROARING_WORD_BITS)
+#define bitMask(nValue) ((uintmax_t)1 << ((nValue) % EL_ROARING_WORD_BITS))
+
+/**
+ * Set-algebra operation.
+ */
+typedef enum elroaring_op {
+	EL_ROARING_OP_AND = 0,
+	EL_ROARING_OP_OR,
+	EL_ROARING_OP_XOR,
+	EL_ROARING_OP_ANDNOT
+} elroaring_op;
+
+/**
+ * Sets the bits of the range [nFrom, nTo) in bitmap words.
+ * @param pWords Bitmap words.
+ * @param nFrom  First value of the range.
+ * @param nTo    Value after the last one.
+ */
+static void elroaringWordsSetRange(uintmax_t *pWords, uint32_t nFrom, 
+	uint32_t nTo) {
+
+	for(; nFrom < nTo && nFrom % EL_ROARING_WORD_BITS != 0; nFrom++)
+		pWords[wordIndex(nFrom)] |= bitMask(nFrom);
+	for(; nFrom + EL_ROARING_WORD_BITS <= nTo; nFrom += EL_ROARING_WORD_BITS)
+		pWords[wordIndex(nFrom)] = UINTMAX_MAX;
+	for(; nFrom < nTo; nFrom++)
+		pWords[wordIndex(nFrom)] |= bitMask(nFrom);
+}
+
+/**
+ * Counts runs of consecutive bits set in bitmap words.
+ * @param  pWords Bitmap words.
+ * @return        Number of runs.
+ */
+static uint32_t elroaringWordsCountRuns(const uintmax_t *pWords) {
+	uintmax_t arrStarts[EL_ROARING_BITMAP_WORDS];
+	uintmax_t nCarry = 0;
+
+	for(size_t i = 0; i < EL_ROARING_BITMAP_WORDS; i++) {
+		// Bit starts a run if it's set and the previous one isn't.
+		arrStarts[i] = pWords[i] & ~((pWords[i] << 1) | nCarry);
+		nCarry = pWords[i] >> (EL_ROARING_WORD_BITS - 1);
+	}
+
+	return (uint32_t)elbitopsCount(arrStarts, EL_ROARING_BITMAP_WORDS);
+}
+
+/**
+ * Returns the index of the first element of sorted array which is not less 
+ * than the value.
+ * @param  arrValues Sorted array.
+ * @param  nSize     Number of elements.
+ * @param  nValue    Value.
+ * @return           Index of the element (or nSize if there's no such one).
+ */
+static uint32_t elroaringLowerBound(const uint16_t *arrValues, uint32_t nSize, 
+	uint16_t nValue) {
+
+	uint32_t nLow = 0, nHigh = nSize;
+	while(nLow < nHigh) {
+		uint32_t nMiddle = (nLow + nHigh) / 2;
+		if(arrValues[nMiddle] < nValue)
+			nLow = nMiddle + 1;
+		else
+			nHigh = nMiddle;
+	}
+
+	return nLow;
+}
+
+/**
+ * Returns the number of bytes allocated for the data of container.
+ * @param  pThis Container.
+ * @return       Number of bytes.
+ */
+static size_t elroaringContainerGetDataSize(const elroaring_container *pThis) {
+	switch(pThis->nType) {
+		case EL_ROARING_BITMAP:
+			return EL_ROARING_BITMAP_WORDS * sizeof(uintmax_t);
+		case EL_ROARING_RUN:
+			return pThis->nCapacity * sizeof(elroaring_run);
+		default:
+			return pThis->nCapacity * sizeof(uint16_t);
+	}
+}
+
+/**
+ * Frees the data of container.
+ * @param pThis Container.
+ */
+static void elroaringContainerFree(elroaring_container *pThis) {
+	EL_FREE(pThis->arrValues);
+	pThis->arrValues = NULL;
+}
+
+/**
+ * Initializes empty array container.
+ * @param  pThis Container.
+ * @param  nKey  Key of the container.
+ * @return       @b True if succeeded, otherwise @b false.
+ */
+static bool elroaringContainerInit(elroaring_container *pThis, uint16_t nKey) {
+	pThis->arrValues = EL_ALLOC(EL_ROARING_ARRAY_CAPACITY_MIN * 
+		sizeof(uint16_t));
+	if(pThis->arrValues == NULL)
+		return false;
+
+	pThis->nKey = nKey;
+	pThis->nType = EL_ROARING_ARRAY;
+	pThis->nCardinality = 0;
+	pThis->nSize = 0;
+	pThis->nCapacity = EL_ROARING_ARRAY_CAPACITY_MIN;
+
+	return true;
+}
+
+/**
+ * Initializes the container as a copy of another one. Extra capacity isn't 
+ * copied.
+ * @param  pThis  Container.
+ * @param  pOther Container to be copied.
+ * @return        @b True if succeeded, otherwise @b false.
+ */
+static bool elroaringContainerInitCopy(elroaring_container *pThis, 
+	const elroaring_container *pOther) {
+
+	*pThis = *pOther;
+	if(pThis->nType != EL_ROARING_BITMAP)
+		pThis->nCapacity = pThis->nSize > 0 ? pThis->nSize : 1;
+
+	size_t nDataSize = elroaringContainerGetDataSize(pThis);
+	pThis->arrValues = EL_ALLOC(nDataSize);
+	if(pThis->arrValues == NULL)
+		return false;
+
+	memcpy(pThis->arrValues, pOther->arrValues, nDataSize);
+
+	return true;
+}
+
+/**
+ * Writes the values of container into bitmap words.
+ * @param pThis  Container.
+ * @param pWords Bitmap words (EL_ROARING_BITMAP_WORDS).
+ */
+static void elroaringContainerToWords(const elroaring_container *pThis, 
+	uintmax_t *pWords) {
+
+	switch(pThis->nType) {
+		case EL_ROARING_BITMAP:
+			memcpy(pWords, pThis->pWords, 
+				EL_ROARING_BITMAP_WORDS * sizeof(uintmax_t));
+			break;
+		case EL_ROARING_RUN:
+			memset(pWords, 0, EL_ROARING_BITMAP_WORDS * sizeof(uintmax_t));
+			for(uint32_t i = 0; i < pThis->nSize; i++) {
+				uint32_t nStart = pThis->arrRuns[i].nStart;
+				elroaringWordsSetRange(pWords, nStart, 
+					nStart + pThis->arrRuns[i].nLength + 1);
+			}
+			break;
+		default:
+			memset(pWords, 0, EL_ROARING_BITMAP_WORDS * sizeof(uintmax_t));
+			for(uint32_t i = 0; i < pThis->nSize; i++)
+				pWords[wordIndex(pThis->arrValues[i])] |= 
+					bitMask(pThis->arrValues[i]);
+			break;
+	}
+}
+
+/**
+ * Initializes the container with the values of bitmap words. Array or bitmap 
+ * representation is chosen by the number of values.
+ * @param  pThis        Container.
+ * @param  nKey         Key of the container.
+ * @param  pWords       Bitmap words.
+ * @param  nCardinality Number of bits set in the words.
+ * @return              @b True if succeeded, otherwise @b false.
+ */
+static bool elroaringContainerInitFromWords(elroaring_container *pThis, 
+	uint16_t nKey, const uintmax_t *pWords, uint32_t nCardinality) {
+
+	pThis->nKey = nKey;
+	pThis->nCardinality = nCardinality;
+
+	if(nCardinality > EL_ROARING_ARRAY_MAX) {
+		pThis->pWords = EL_ALLOC(EL_ROARING_BITMAP_WORDS * sizeof(uintmax_t));
+		if(pThis->pWords == NULL)
+			return false;
+
+		memcpy(pThis->pWords, pWords, 
+			EL_ROARING_BITMAP_WORDS * sizeof(uintmax_t));
+		pThis->nType = EL_ROARING_BITMAP;
+		pThis->nSize = 0;
+		pThis->nCapacity = 0;
+
+		return true;
+	}
+
+	pThis->nCapacity = nCardinality > 0 ? nCardinality : 1;
+	pThis->arrValues = EL_ALLOC(pThis->nCapacity * sizeof(uint16_t));
+	if(pThis->arrValues == NULL)
+		return false;
+
+	pThis->nType = EL_ROARING_ARRAY;
+	pThis->nSize = 0;
+
+	uint32_t arrBatch[EL_ROARING_FOREACH_BATCH];
+	size_t nWordsPerBatch = EL_ROARING_FOREACH_BATCH / EL_ROARING_WORD_BITS;
+	for(size_t i = 0; i < EL_ROARING_BITMAP_WORDS; i += nWordsPerBatch) {
+		size_t nCount = elbitopsExtract32(pWords + i, nWordsPerBatch, 
+			i * EL_ROARING_WORD_BITS, arrBatch, EL_ROARING_FOREACH_BATCH);
+		for(size_t j = 0; j < nCount; j++)
+			pThis->arrValues[pThis->nSize++] = (uint16_t)arrBatch[j];
+	}
+
+	return true;
+}
+
+/**
+ * Initializes run container with the values of bitmap words.
+ * @param  pThis        Container.
+ * @param  nKey         Key of the container.
+ * @param  pWords       Bitmap words.
+ * @param  nCardinality Number of bits set in the words.
+ * @param  nRuns        Number of runs in the words.
+ * @return              @b True if succeeded, otherwise @b false.
+ */
+static bool elroaringContainerInitRunFromWords(elroaring_container *pThis, 
+	uint16_t nKey, const uintmax_t *pWords, uint32_t nCardinality, 
+	uint32_t nRuns) {
+
+	pThis->nCapacity = nRuns > 0 ? nRuns : 1;
+	pThis->arrRuns = EL_ALLOC(pThis->nCapacity * sizeof(elroaring_run));
+	if(pThis->arrRuns == NULL)
+		return false;
+
+	pThis->nKey = nKey;
+	pThis->nType = EL_ROARING_RUN;
+	pThis->nCardinality = nCardinality;
+	pThis->nSize = 0;
+
+	size_t nStart = elbitopsFindNext(pWords, EL_ROARING_BITMAP_WORDS, 0, true);
+	while(nStart != EL_BITOPS_NPOS) {
+		size_t nEnd = elbitopsFindNext(pWords, EL_ROARING_BITMAP_WORDS, nStart, 
+			false);
+		if(nEnd == EL_BITOPS_NPOS)
+			nEnd = EL_ROARING_CHUNK_BITS;
+
+		pThis->arrRuns[pThis->nSize].nStart = (uint16_t)nStart;
+		pThis->arrRuns[pThis->nSize].nLength = (uint16_t)(nEnd - nStart - 1);
+		pThis->nSize++;
+
+		nStart = elbitopsFindNext(pWords, EL_ROARING_BITMAP_WORDS, nEnd, true);
+	}
+
+	return true;
+}
+
+/**
+ * Initializes the container with the values of bitmap words choosing the 
+ * smallest of array, bitmap and run representations.
+ * @param  pThis        Container.
+ * @param  nKey         Key of the container.
+ * @param  pWords       Bitmap words.
+ * @param  nCardinality Number of bits set in the words.
+ * @return              @b True if succeeded, otherwise @b false.
+ */
+static bool elroaringContainerInitBest(elroaring_container *pThis, 
+	uint16_t nKey, const uintmax_t *pWords, uint32_t nCardinality) {
+
+	uint32_t nRuns = elroaringWordsCountRuns(pWords);
+	size_t nSizeRun = nRuns * sizeof(elroaring_run);
+	size_t nSizeOther = nCardinality > EL_ROARING_ARRAY_MAX ? 
+		EL_ROARING_BITMAP_WORDS * sizeof(uintmax_t) : 
+		nCardinality * sizeof(uint16_t);
+
+	if(nSizeRun < nSizeOther)
+		return elroaringContainerInitRunFromWords(pThis, nKey, pWords, 
+			nCardinality, nRuns);
+
+	return elroaringContainerInitFromWords(pThis, nKey, pWords, nCardinality);
+}
+
+/**
+ * Replaces the contents of container with the values of bitmap words.
+ * @param  pThis        Container.
+ * @param  pWords       Bitmap words (may be the words of the container 
+ * itself).
+ * @param  nCardinality Number of bits set in the words.
+ * @param  bBest        If @b true, run representation is considered as well.
+ * @return              @b True if succeeded, otherwise @b false (container 
+ * isn't changed in this case).
+ */
+static bool elroaringContainerReplace(elroaring_container *pThis, 
+	const uintmax_t *pWords, uint32_t nCardinality, bool bBest) {
+
+	elroaring_container container;
+	bool bResult = bBest ? 
+		elroaringContainerInitBest(&container, pThis->nKey, pWords, 
+			nCardinality) : 
+		elroaringContainerInitFromWords(&container, pThis->nKey, pWords, 
+			nCardinality);
+	if(!bResult)
+		return false;
+
+	elroaringContainerFree(pThis);
+	*pThis = container;
+
+	return true;
+}
+
+/**
+ * Checks if the container holds the value.
+ * @param  pThis  Container.
+ * @param  nValue Low 16 bits of the value.
+ * @return        @b True if the value is in container, otherwise @b false.
+ */
+static bool elroaringContainerContains(const elroaring_container *pThis, 
+	uint16_t nValue) {
+
+	switch(pThis->nType) {
+		case EL_ROARING_BITMAP:
+			return (pThis->pWords[wordIndex(nValue)] & bitMask(nValue)) != 0;
+		case EL_ROARING_RUN: {
+			// Find the last run starting not after the value.
+			uint32_t nLow = 0, nHigh = pThis->nSize;
+			while(nLow < nHigh) {
+				uint32_t nMiddle = (nLow + nHigh) / 2;
+				if(pThis->arrRuns[nMiddle].nStart <= nValue)
+					nLow = nMiddle + 1;
+				else
+					nHigh = nMiddle;
+			}
+			if(nLow == 0)
+				return false;
+
+			const elroaring_run *pRun = pThis->arrRuns + nLow - 1;
+			return (uint32_t)(nValue - pRun->nStart) <= pRun->nLength;
+		}
+		default: {
+			uint32_t nIndex = elroaringLowerBound(pThis->arrValues, 
+				pThis->nSize, nValue);
+			return nIndex < pThis->nSize && pThis->arrValues[nIndex] == nValue;
+		}
+	}
+}
+
+/**
+ * Adds the value to container. Run container is converted to array or bitmap 
+ * first, full array container is converted to bitmap.
+ * @param  pThis  Container.
+ * @param  nValue Low 16 bits of the value.
+ * @return        @b True if succeeded, otherwise @b false.
+ */
+static bool elroaringContainerAdd(elroaring_container *pThis, uint16_t nValue) {
+	if(pThis->nType == EL_ROARING_RUN) {
+		if(elroaringContainerContains(pThis, nValue))
+			return true;
+
+		uintmax_t arrWords[EL_ROARING_BITMAP_WORDS];
+		elroaringContainerToWords(pThis, arrWords);
+		arrWords[wordIndex(nValue)] |= bitMask(nValue);
+
+		return elroaringContainerReplace(pThis, arrWords, 
+			pThis->nCardinality + 1, false);
+	}
+
+	if(pThis->nType == EL_ROARING_BITMAP) {
+		uintmax_t *pWord = pThis->pWords + wordIndex(nValue);
+		if((*pWord & bitMask(nValue)) == 0) {
+			*pWord |= bitMask(nValue);
+			pThis->nCardinality++;
+		}
+		return true;
+	}
+
+	uint32_t nIndex = elroaringLowerBound(pThis->arrValues, pThis->nSize, 
+		nValue);
+	if(nIndex < pThis->nSize && pThis->arrValues[nIndex] == nValue)
+		return true;
+
+	if(pThis->nSize == EL_ROARING_ARRAY_MAX) {
+		uintmax_t arrWords[EL_ROARING_BITMAP_WORDS];
+		elroaringContainerToWords(pThis, arrWords);
+		arrWords[wordIndex(nValue)] |= bitMask(nValue);
+
+		return elroaringContainerReplace(pThis, arrWords, 
+			pThis->nCardinality + 1, false);
+	}
+
+	if(pThis->nSize == pThis->nCapacity) {
+		uint32_t nCapacity = pThis->nCapacity * 2;
+		if(nCapacity > EL_ROARING_ARRAY_MAX)
+			nCapacity = EL_ROARING_ARRAY_MAX;
+
+		uint16_t *arrValues = EL_REALLOC(pThis->arrValues, 
+			nCapacity * sizeof(uint16_t));
+		if(arrValues == NULL)
+			return false;
+
+		pThis->arrValues = arrValues;
+		pThis->nCapacity = nCapacity;
+	}
+
+	memmove(pThis->arrValues + nIndex + 1, pThis->arrValues + nIndex, 
+		(pThis->nSize - nIndex) * sizeof(uint16_t));
+	pThis->arrValues[nIndex] = nValue;
+	pThis->nSize++;
+	pThis->nCardinality++;
+
+	return true;
+}
+
+/**
+ * Removes the value from container. Bitmap container which becomes small 
+ * enough is converted to array.
+ * @param  pThis  Container.
+ * @param  nValue Low 16 bits of the value.
+ * @return        @b True if succeeded, otherwise @b false.
+ */
+static bool elroaringContainerRemove(elroaring_container *pThis, 
+	uint16_t nValue) {
+
+	if(!elroaringContainerContains(pThis, nValue))
+		return true;
+
+	if(pThis->nType == EL_ROARING_RUN) {
+		uintmax_t arrWords[EL_ROARING_BITMAP_WORDS];
+		elroaringContainerToWords(pThis, arrWords);
+		arrWords[wordIndex(nValue)] &= ~bitMask(nValue);
+
+		return elroaringContainerReplace(pThis, arrWords, 
+			pThis->nCardinality - 1, true);
+	}
+
+	if(pThis->nType == EL_ROARING_BITMAP) {
+		pThis->pWords[wordIndex(nValue)] &= ~bitMask(nValue);
+		pThis->nCardinality--;
+		if(pThis->nCardinality <= EL_ROARING_ARRAY_MAX)
+			elroaringContainerReplace(pThis, pThis->pWords, 
+				pThis->nCardinality, false);
+		return true;
+	}
+
+	uint32_t nIndex = elroaringLowerBound(pThis->arrValues, pThis->nSize, 
+		nValue);
+	memmove(pThis->arrValues + nIndex, pThis->arrValues + nIndex + 1, 
+		(pThis->nSize - nIndex - 1) * sizeof(uint16_t));
+	pThis->nSize--;
+	pThis->nCardinality--;
+
+	return true;
+}
+
+/**
+ * Merges two array containers.
+ * @param  pFirst  First array container.
+ * @param  pSecond Second array container.
+ * @param  nOp     Operation.
+ * @param  pResult Container to be initialized with the result.
+ * @return         @b True if succeeded, otherwise @b false.
+ */
+static bool elroaringArrayOp(const elroaring_container *pFirst, 
+	const elroaring_container *pSecond, elroaring_op nOp, 
+	elroaring_container *pResult) {
+
+	const uint16_t *arr1 = pFirst->arrValues, *arr2 = pSecond->arrValues;
+	uint32_t n1 = pFirst->nSize, n2 = pSecond->nSize;
+	bool bKeepFirst = nOp != EL_ROARING_OP_AND;
+	bool bKeepSecond = nOp == EL_ROARING_OP_OR || nOp == EL_ROARING_OP_XOR;
+	bool bKeepCommon = nOp == EL_ROARING_OP_AND || nOp == EL_ROARING_OP_OR;
+
+	uint32_t nCapacity = n1 + n2;
+	if(nOp == EL_ROARING_OP_AND)
+		nCapacity = n1 < n2 ? n1 : n2;
+	else if(nOp == EL_ROARING_OP_ANDNOT)
+		nCapacity = n1;
+	if(nCapacity == 0)
+		nCapacity = 1;
+
+	uint16_t *arrValues = EL_ALLOC(nCapacity * sizeof(uint16_t));
+	if(arrValues == NULL)
+		return false;
+
+	uint32_t i = 0, j = 0, nSize = 0;
+	while(i < n1 && j < n2) {
+		if(arr1[i] < arr2[j]) {
+			if(bKeepFirst)
+				arrValues[nSize++] = arr1[i];
+			i++;
+		} else if(arr2[j] < arr1[i]) {
+			if(bKeepSecond)
+				arrValues[nSize++] = arr2[j];
+			j++;
+		} else {
+			if(bKeepCommon)
+				arrValues[nSize++] = arr1[i];
+			i++;
+			j++;
+		}
+	}
+	if(bKeepFirst)
+		for(; i < n1; i++)
+			arrValues[nSize++] = arr1[i];
+	if(bKeepSecond)
+		for(; j < n2; j++)
+			arrValues[nSize++] = arr2[j];
+
+	pResult->nKey = pFirst->nKey;
+	pResult->nType = EL_ROARING_ARRAY;
+	pResult->nCardinality = nSize;
+	pResult->nSize = nSize;
+	pResult->nCapacity = nCapacity;
+	pResult->arrValues = arrValues;
+
+	if(nSize > EL_ROARING_ARRAY_MAX) {
+		uintmax_t arrWords[EL_ROARING_BITMAP_WORDS];
+		elroaringContainerToWords(pResult, arrWords);
+		if(!elroaringContainerReplace(pResult, arrWords, nSize, false)) {
+			elroaringContainerFree(pResult);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Selects the values of array container which are (or aren't) in another 
+ * container.
+ * @param  pArray  Array container.
+ * @param  pOther  Another container.
+ * @param  bInside If @b true, values which are in another container are 
+ * selected, otherwise values which aren't.
+ * @param  pResult Container to be initialized with the result.
+ * @return         @b True if succeeded, otherwise @b false.
+ */
+static bool elroaringArrayFilter(const elroaring_container *pArray, 
+	const elroaring_container *pOther, bool bInside, 
+	elroaring_container *pResult) {
+
+	uint32_t nCapacity = pArray->nSize > 0 ? pArray->nSize : 1;
+	uint16_t *arrValues = EL_ALLOC(nCapacity * sizeof(uint16_t));
+	if(arrValues == NULL)
+		return false;
+
+	uint32_t nSize = 0;
+	for(uint32_t i = 0; i < pArray->nSize; i++) {
+		if(elroaringContainerContains(pOther, pArray->arrValues[i]) == bInside)
+			arrValues[nSize++] = pArray->arrValues[i];
+	}
+
+	pResult->nKey = pArray->nKey;
+	pResult->nType = EL_ROARING_ARRAY;
+	pResult->nCardinality = nSize;
+	pResult->nSize = nSize;
+	pResult->nCapacity = nCapacity;
+	pResult->arrValues = arrValues;
+
+	return true;
+}
+
+/**
+ * Applies set-algebra operation to two containers with the same key. Arrays 
+ * are merged, arrays intersected with other containers are filtered, all 
+ * other combinations are processed as bitmaps by bitops kernels.
+ * @param  pFirst  First container.
+ * @param  pSecond Second container.
+ * @param  nOp     Operation.
+ * @param  pResult Container to be initialized with the result (may be empty).
+ * @return         @b True if succeeded, otherwise @b false.
+ */
+static bool elroaringContainerOp(const elroaring_container *pFirst, 
+	const elroaring_container *pSecond, elroaring_op nOp, 
+	elroaring_container *pResult) {
+
+	if(pFirst->nType == EL_ROARING_ARRAY && pSecond->nType == EL_ROARING_ARRAY)
+		return elroaringArrayOp(pFirst, pSecond, nOp, pResult);
+
+	if(pFirst->nType == EL_ROARING_ARRAY && (nOp == EL_ROARING_OP_AND || 
+		nOp == EL_ROARING_OP_ANDNOT))
+		return elroaringArrayFilter(pFirst, pSecond, nOp == EL_ROARING_OP_AND, 
+			pResult);
+
+	if(pSecond->nType == EL_ROARING_ARRAY && nOp == EL_ROARING_OP_AND)
+		return elroaringArrayFilter(pSecond, pFirst, true, pResult);
+
+	uintmax_t arrWords1[EL_ROARING_BITMAP_WORDS];
+	uintmax_t arrWords2[EL_ROARING_BITMAP_WORDS];
+	const uintmax_t *pWords2 = pSecond->pWords;
+
+	elroaringContainerToWords(pFirst, arrWords1);
+	if(pSecond->nType != EL_ROARING_BITMAP) {
+		elroaringContainerToWords(pSecond, arrWords2);
+		pWords2 = arrWords2;
+	}
+
+	switch(nOp) {
+		case EL_ROARING_OP_AND:
+			elbitopsAnd(arrWords1, arrWords1, pWords2, EL_ROARING_BITMAP_WORDS);
+			break;
+		case EL_ROARING_OP_OR:
+			elbitopsOr(arrWords1, arrWords1, pWords2, EL_ROARING_BITMAP_WORDS);
+			break;
+		case EL_ROARING_OP_XOR:
+			elbitopsXor(arrWords1, arrWords1, pWords2, EL_ROARING_BITMAP_WORDS);
+			break;
+		case EL_ROARING_OP_ANDNOT:
+			elbitopsAndNot(arrWords1, arrWords1, pWords2, 
+				EL_ROARING_BITMAP_WORDS);
+			break;
+	}
+
+	uint32_t nCardinality = (uint32_t)elbitopsCount(arrWords1, 
+		EL_ROARING_BITMAP_WORDS);
+
+	return elroaringContainerInitFromWords(pResult, pFirst->nKey, arrWords1, 
+		nCardinality);
+}
+
+/**
+ * Returns the greatest value of non-empty container.
+ * @param  pThis Container.
+ * @return       Low 16 bits of the greatest value.
+ */
+static uint16_t elroaringContainerGetMax(const elroaring_container *pThis) {
+	switch(pThis->nType) {
+		case EL_ROARING_BITMAP:
+			return (uint16_t)elbitopsFindPrev(pThis->pWords, 
+				EL_ROARING_BITMAP_WORDS, EL_BITOPS_NPOS, true);
+		case EL_ROARING_RUN: {
+			const elroaring_run *pRun = pThis->arrRuns + pThis->nSize - 1;
+			return (uint16_t)(pRun->nStart + pRun->nLength);
+		}
+		default:
+			return pThis->arrValues[pThis->nSize - 1];
+	}
+}
+
+/**
+ * Finds the index of the first container with the key not less than the 
+ * specified one.
+ * @param  pThis Compressed bitmap.
+ * @param  nKey  Key.
+ * @return       Index of the container (or number of containers).
+ */
+static size_t elroaringFindContainer(roaring *pThis, uint16_t nKey) {
+	size_t nLow = 0, nHigh = pThis->nCount;
+	while(nLow < nHigh) {
+		size_t nMiddle = (nLow + nHigh) / 2;
+		if(pThis->arrContainers[nMiddle].nKey < nKey)
+			nLow = nMiddle + 1;
+		else
+			nHigh = nMiddle;
+	}
+
+	return nLow;
+}
+
+/**
+ * Inserts the container at specified index. On failure the container is 
+ * freed.
+ * @param  pThis      Compressed bitmap.
+ * @param  nIndex     Index.
+ * @param  pContainer Container to be inserted.
+ * @return            @b True if succeeded, otherwise @b false.
+ */
+static bool elroaringInsertContainer(roaring *pThis, size_t nIndex, 
+	elroaring_container *pContainer) {
+
+	if(pThis->nCount == pThis->nCapacity) {
+		size_t nCapacity = pThis->nCapacity > 0 ? pThis->nCapacity * 2 : 4;
+		elroaring_container *arrContainers = EL_REALLOC(pThis->arrContainers, 
+			nCapacity * sizeof(elroaring_container));
+		if(arrContainers == NULL) {
+			elroaringContainerFree(pContainer);
+			return false;
+		}
+
+		pThis->arrContainers = arrContainers;
+		pThis->nCapacity = nCapacity;
+	}
+
+	memmove(pThis->arrContainers + nIndex + 1, pThis->arrContainers + nIndex, 
+		(pThis->nCount - nIndex) * sizeof(elroaring_container));
+	pThis->arrContainers[nIndex] = *pContainer;
+	pThis->nCount++;
+
+	return true;
+}
+
+/**
+ * Appends the container after all others (its key must be the greatest). 
+ * Empty container is freed instead.
+ * @param  pThis      Compressed bitmap.
+ * @param  pContainer Container to be appended.
+ * @return            @b True if succeeded, otherwise @b false.
+ */
+static bool elroaringAppendContainer(roaring *pThis, 
+	elroaring_container *pContainer) {
+
+	if(pContainer->nCardinality == 0) {
+		elroaringContainerFree(pContainer);
+		return true;
+	}
+
+	return elroaringInsertContainer(pThis, pThis->nCount, pContainer);
+}
+
+/**
+ * Removes and frees the container at specified index.
+ * @param pThis  Compressed bitmap.
+ * @param nIndex Index.
+ */
+static void elroaringRemoveContainer(roaring *pThis, size_t nIndex) {
+	elroaringContainerFree(pThis->arrContainers + nIndex);
+	memmove(pThis->arrContainers + nIndex, pThis->arrContainers + nIndex + 1, 
+		(pThis->nCount - nIndex - 1) * sizeof(elroaring_container));
+	pThis->nCount--;
+}
+
+/**
+ * Creates new empty compressed bitmap of 32-bit values.
+ * @return Newly created compressed bitmap (or NULL if an error occured).
+ */
+roaring *elroaringCreate() {
+	return EL_CALLOC(1, sizeof(roaring));
+}
+
+/**
+ * Creates new compressed bitmap holding the same values as another one.
+ * @param  pOther Compressed bitmap to be copied.
+ * @return        Newly created compressed bitmap (or NULL if an error 
+ * occured).
+ */
+roaring *elroaringCreateCopy(roaring *pOther) {
+	if(isInvalid(pOther))
+		return NULL;
+
+	roaring *pThis = elroaringCreate();
+	if(pThis == NULL)
+		return NULL;
+
+	for(size_t i = 0; i < pOther->nCount; i++) {
+		elroaring_container container;
+		if(!elroaringContainerInitCopy(&container, pOther->arrContainers + i) || 
+			!elroaringAppendContainer(pThis, &container)) {
+
+			elroaringDestroy(pThis);
+			return NULL;
+		}
+	}
+
+	return pThis;
+}
+
+/**
+ * Creates new compressed bitmap holding positions of the bits which are set 
+ * in the bit set. Positions which don't fit into 32 bits are ignored.
+ * @param  pBitset Bit set.
+ * @return         Newly created compressed bitmap (or NULL if an error 
+ * occured).
+ */
+roaring *elroaringCreateFromBitset(bitset *pBitset) {
+	if(isInvalid(pBitset))
+		return NULL;
+
+	roaring *pThis = elroaringCreate();
+	if(pThis == NULL)
+		return NULL;
+
+	uint64_t nWordsMax = ((uint64_t)UINT32_MAX + 1) / EL_ROARING_WORD_BITS;
+	size_t nWordsTotal = (uint64_t)pBitset->nCapacity < nWordsMax ? 
+		pBitset->nCapacity : (size_t)nWordsMax;
+	uintmax_t arrWords[EL_ROARING_BITMAP_WORDS];
+
+	for(size_t i = 0; i < nWordsTotal; i += EL_ROARING_BITMAP_WORDS) {
+		size_t nWords = nWordsTotal - i < EL_ROARING_BITMAP_WORDS ? 
+			nWordsTotal - i : EL_ROARING_BITMAP_WORDS;
+		if(!elbitopsAny(pBitset->pBuf + i, nWords))
+			continue;
+
+		memcpy(arrWords, pBitset->pBuf + i, nWords * sizeof(uintmax_t));
+		memset(arrWords + nWords, 0, 
+			(EL_ROARING_BITMAP_WORDS - nWords) * sizeof(uintmax_t));
+
+		elroaring_container container;
+		uint16_t nKey = (uint16_t)(i / EL_ROARING_BITMAP_WORDS);
+		uint32_t nCardinality = (uint32_t)elbitopsCount(arrWords, 
+			EL_ROARING_BITMAP_WORDS);
+		if(!elroaringContainerInitBest(&container, nKey, arrWords, 
+			nCardinality) || !elroaringAppendContainer(pThis, &container)) {
+
+			elroaringDestroy(pThis);
+			return NULL;
+		}
+	}
+
+	return pThis;
+}
+
+/**
+ * Destroys the compressed bitmap.
+ * @param pThis Compressed bitmap to be destroyed.
+ */
+void elroaringDestroy(roaring *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	elroaringClear(pThis);
+	EL_FREE(pThis->arrContainers);
+	EL_FREE(pThis);
+}
+
+/**
+ * Removes all values from the compressed bitmap.
+ * @param pThis Compressed bitmap.
+ */
+void elroaringClear(roaring *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	for(size_t i = 0; i < pThis->nCount; i++)
+		elroaringContainerFree(pThis->arrContainers + i);
+	pThis->nCount = 0;
+}
+
+/**
+ * Returns the number of values in the compressed bitmap (its cardinality).
+ * @param  pThis Compressed bitmap.
+ * @return       Number of values.
+ */
+uint64_t elroaringGetCount(roaring *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	uint64_t nCount = 0;
+	for(size_t i = 0; i < pThis->nCount; i++)
+		nCount += pThis->arrContainers[i].nCardinality;
+
+	return nCount;
+}
+
+/**
+ * Returns the number of bytes of memory used by the compressed bitmap.
+ * @param  pThis Compressed bitmap.
+ * @return       Number of bytes.
+ */
+size_t elroaringGetSizeInBytes(roaring *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	size_t nSize = sizeof(roaring) + 
+		pThis->nCapacity * sizeof(elroaring_container);
+	for(size_t i = 0; i < pThis->nCount; i++)
+		nSize += elroaringContainerGetDataSize(pThis->arrContainers + i);
+
+	return nSize;
+}
+
+/**
+ * Adds the value to the compressed bitmap.
+ * @param  pThis  Compressed bitmap.
+ * @param  nValue Value.
+ * @return        @b True if succeeded, otherwise @b false.
+ */
+bool elroaringAdd(roaring *pThis, uint32_t nValue) {
+	if(isInvalid(pThis))
+		return false;
+
+	uint16_t nKey = (uint16_t)(nValue >> 16);
+	size_t nIndex = elroaringFindContainer(pThis, nKey);
+	if(nIndex == pThis->nCount || pThis->arrContainers[nIndex].nKey != nKey) {
+		elroaring_container container;
+		if(!elroaringContainerInit(&container, nKey) || 
+			!elroaringInsertContainer(pThis, nIndex, &container))
+			return false;
+	}
+
+	return elroaringContainerAdd(pThis->arrContainers + nIndex, 
+		(uint16_t)nValue);
+}
+
+/**
+ * Adds all values of the range [nFrom, nTo) to the compressed bitmap. Chunks 
+ * covered by the range completely become single runs, partially covered ones 
+ * get the smallest representation.
+ * @param  pThis Compressed bitmap.
+ * @param  nFrom First value of the range.
+ * @param  nTo   Value after the last one (up to 2^32).
+ * @return       @b True if succeeded, otherwise @b false.
+ */
+bool elroaringAddRange(roaring *pThis, uint32_t nFrom, uint64_t nTo) {
+	if(isInvalid(pThis))
+		return false;
+
+	if(nTo > (uint64_t)UINT32_MAX + 1)
+		nTo = (uint64_t)UINT32_MAX + 1;
+	if(nFrom >= nTo)
+		return true;
+
+	uint32_t nKeyFirst = nFrom >> 16;
+	uint32_t nKeyLast = (uint32_t)((nTo - 1) >> 16);
+	uintmax_t arrWords[EL_ROARING_BITMAP_WORDS];
+
+	for(uint32_t nKey = nKeyFirst; nKey <= nKeyLast; nKey++) {
+		uint32_t nLow = nKey == nKeyFirst ? (nFrom & 0xFFFF) : 0;
+		uint32_t nHigh = nKey == nKeyLast ? 
+			(uint32_t)((nTo - 1) & 0xFFFF) + 1 : EL_ROARING_CHUNK_BITS;
+
+		size_t nIndex = elroaringFindContainer(pThis, (uint16_t)nKey);
+		bool bExists = nIndex < pThis->nCount && 
+			pThis->arrContainers[nIndex].nKey == nKey;
+
+		elroaring_container container;
+		if(nLow == 0 && nHigh == EL_ROARING_CHUNK_BITS) {
+			container.arrRuns = EL_ALLOC(sizeof(elroaring_run));
+			if(container.arrRuns == NULL)
+				return false;
+
+			container.nKey = (uint16_t)nKey;
+			container.nType = EL_ROARING_RUN;
+			container.nCardinality = EL_ROARING_CHUNK_BITS;
+			container.nSize = 1;
+			container.nCapacity = 1;
+			container.arrRuns[0].nStart = 0;
+			container.arrRuns[0].nLength = EL_ROARING_CHUNK_BITS - 1;
+		} else {
+			if(bExists)
+				elroaringContainerToWords(pThis->arrContainers + nIndex, 
+					arrWords);
+			else
+				memset(arrWords, 0, sizeof(arrWords));
+			elroaringWordsSetRange(arrWords, nLow, nHigh);
+
+			uint32_t nCardinality = (uint32_t)elbitopsCount(arrWords, 
+				EL_ROARING_BITMAP_WORDS);
+			if(!elroaringContainerInitBest(&container, (uint16_t)nKey, 
+				arrWords, nCardinality))
+				return false;
+		}
+
+		if(bExists) {
+			elroaringContainerFree(pThis->arrContainers + nIndex);
+			pThis->arrContainers[nIndex] = container;
+		} else if(!elroaringInsertContainer(pThis, nIndex, &container))
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * Removes the value from the compressed bitmap.
+ * @param  pThis  Compressed bitmap.
+ * @param  nValue Value.
+ * @return        @b True if succeeded, otherwise @b false.
+ */
+bool elroaringRemove(roaring *pThis, uint32_t nValue) {
+	if(isInvalid(pThis))
+		return false;
+
+	uint16_t nKey = (uint16_t)(nValue >> 16);
+	size_t nIndex = elroaringFindContainer(pThis, nKey);
+	if(nIndex == pThis->nCount || pThis->arrContainers[nIndex].nKey != nKey)
+		return true;
+
+	if(!elroaringContainerRemove(pThis->arrContainers + nIndex, 
+		(uint16_t)nValue))
+		return false;
+
+	if(pThis->arrContainers[nIndex].nCardinality == 0)
+		elroaringRemoveContainer(pThis, nIndex);
+
+	return true;
+}
+
+/**
+ * Checks if the compressed bitmap holds the value.
+ * @param  pThis  Compressed bitmap.
+ * @param  nValue Value.
+ * @return        @b True if the value is in the compressed bitmap, otherwise 
+ * @b false.
+ */
+bool elroaringContains(roaring *pThis, uint32_t nValue) {
+	if(isInvalid(pThis))
+		return false;
+
+	uint16_t nKey = (uint16_t)(nValue >> 16);
+	size_t nIndex = elroaringFindContainer(pThis, nKey);
+	if(nIndex == pThis->nCount || pThis->arrContainers[nIndex].nKey != nKey)
+		return false;
+
+	return elroaringContainerContains(pThis->arrContainers + nIndex, 
+		(uint16_t)nValue);
+}
+
+/**
+ * Converts each container to the smallest of array, bitmap and run 
+ * representations and removes extra capacity. Useful after the compressed 
+ * bitmap is built.
+ * @param  pThis Compressed bitmap.
+ * @return       @b True if succeeded, otherwise @b false.
+ */
+bool elroaringOptimize(roaring *pThis) {
+	if(isInvalid(pThis))
+		return false;
+
+	uintmax_t arrWords[EL_ROARING_BITMAP_WORDS];
+	for(size_t i = 0; i < pThis->nCount; i++) {
+		elroaring_container *pContainer = pThis->arrContainers + i;
+		elroaringContainerToWords(pContainer, arrWords);
+		if(!elroaringContainerReplace(pContainer, arrWords, 
+			pContainer->nCardinality, true))
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * Checks if the compressed bitmap holds the same values as another one 
+ * (representation of containers doesn't matter).
+ * @param  pThis  Compressed bitmap.
+ * @param  pOther Compressed bitmap to check equality with.
+ * @return        @b True if the compressed bitmaps are equal, otherwise 
+ * @b false.
+ */
+bool elroaringIsEqualTo(roaring *pThis, roaring *pOther) {
+	if(isInvalid(pThis) || isInvalid(pOther))
+		return false;
+
+	if(pThis->nCount != pOther->nCount)
+		return false;
+
+	uintmax_t arrWords1[EL_ROARING_BITMAP_WORDS];
+	uintmax_t arrWords2[EL_ROARING_BITMAP_WORDS];
+	for(size_t i = 0; i < pThis->nCount; i++) {
+		elroaring_container *p1 = pThis->arrContainers + i;
+		elroaring_container *p2 = pOther->arrContainers + i;
+		if(p1->nKey != p2->nKey || p1->nCardinality != p2->nCardinality)
+			return false;
+
+		if(p1->nType == EL_ROARING_ARRAY && p2->nType == EL_ROARING_ARRAY) {
+			if(memcmp(p1->arrValues, p2->arrValues, 
+				p1->nSize * sizeof(uint16_t)) != 0)
+				return false;
+		} else {
+			elroaringContainerToWords(p1, arrWords1);
+			elroaringContainerToWords(p2, arrWords2);
+			if(!elbitopsEqual(arrWords1, arrWords2, EL_ROARING_BITMAP_WORDS))
+				return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Creates new compressed bitmap which is the result of set-algebra operation 
+ * over two compressed bitmaps. Containers are merged by their keys.
+ * @param  pFirst  First compressed bitmap.
+ * @param  pSecond Second compressed bitmap.
+ * @param  nOp     Operation.
+ * @return         Newly created compressed bitmap (or NULL if an error 
+ * occured).
+ */
+static roaring *elroaringCreateOp(roaring *pFirst, roaring *pSecond, 
+	elroaring_op nOp) {
+
+	if(isInvalid(pFirst) || isInvalid(pSecond))
+		return NULL;
+
+	roaring *pResult = elroaringCreate();
+	if(pResult == NULL)
+		return NULL;
+
+	bool bKeepFirst = nOp != EL_ROARING_OP_AND;
+	bool bKeepSecond = nOp == EL_ROARING_OP_OR || nOp == EL_ROARING_OP_XOR;
+	size_t i = 0, j = 0;
+
+	while(i < pFirst->nCount || j < pSecond->nCount) {
+		elroaring_container *p1 = i < pFirst->nCount ? 
+			pFirst->arrContainers + i : NULL;
+		elroaring_container *p2 = j < pSecond->nCount ? 
+			pSecond->arrContainers + j : NULL;
+		elroaring_container container;
+		bool bSucceeded = true;
+
+		if(p2 == NULL || (p1 != NULL && p1->nKey < p2->nKey)) {
+			if(bKeepFirst)
+				bSucceeded = elroaringContainerInitCopy(&container, p1) && 
+					elroaringAppendContainer(pResult, &container);
+			else if(p2 == NULL)
+				break;
+			i++;
+		} else if(p1 == NULL || p2->nKey < p1->nKey) {
+			if(bKeepSecond)
+				bSucceeded = elroaringContainerInitCopy(&container, p2) && 
+					elroaringAppendContainer(pResult, &container);
+			else if(p1 == NULL)
+				break;
+			j++;
+		} else {
+			bSucceeded = elroaringContainerOp(p1, p2, nOp, &container) && 
+				elroaringAppendContainer(pResult, &container);
+			i++;
+			j++;
+		}
+
+		if(!bSucceeded) {
+			elroaringDestroy(pResult);
+			return NULL;
+		}
+	}
+
+	return pResult;
+}
+
+/**
+ * Replaces the contents of compressed bitmap with the contents of another one 
+ * which is destroyed then.
+ * @param  pThis Compressed bitmap.
+ * @param  pNew  Compressed bitmap holding new contents (may be NULL).
+ * @return       @b True if @e pNew isn't NULL, otherwise @b false.
+ */
+static bool elroaringReplace(roaring *pThis, roaring *pNew) {
+	if(pNew == NULL)
+		return false;
+
+	elroaringClear(pThis);
+	EL_FREE(pThis->arrContainers);
+	*pThis = *pNew;
+	EL_FREE(pNew);
+
+	return true;
+}
+
+/**
+ * Creates new compressed bitmap which is an intersection of two ones.
+ * @param  pFirst  First compressed bitmap.
+ * @param  pSecond Second compressed bitmap.
+ * @return         Newly created compressed bitmap (or NULL if an error 
+ * occured).
+ */
+roaring *elroaringCreateAnd(roaring *pFirst, roaring *pSecond) {
+	return elroaringCreateOp(pFirst, pSecond, EL_ROARING_OP_AND);
+}
+
+/**
+ * Creates new compressed bitmap which is an union of two ones.
+ * @param  pFirst  First compressed bitmap.
+ * @param  pSecond Second compressed bitmap.
+ * @return         Newly created compressed bitmap (or NULL if an error 
+ * occured).
+ */
+roaring *elroaringCreateOr(roaring *pFirst, roaring *pSecond) {
+	return elroaringCreateOp(pFirst, pSecond, EL_ROARING_OP_OR);
+}
+
+/**
+ * Creates new compressed bitmap which is a symmetric difference of two ones.
+ * @param  pFirst  First compressed bitmap.
+ * @param  pSecond Second compressed bitmap.
+ * @return         Newly created compressed bitmap (or NULL if an error 
+ * occured).
+ */
+roaring *elroaringCreateXor(roaring *pFirst, roaring *pSecond) {
+	return elroaringCreateOp(pFirst, pSecond, EL_ROARING_OP_XOR);
+}
+
+/**
+ * Creates new compressed bitmap holding values of the first compressed bitmap 
+ * which aren't in the second one.
+ * @param  pFirst  First compressed bitmap.
+ * @param  pSecond Second compressed bitmap.
+ * @return         Newly created compressed bitmap (or NULL if an error 
+ * occured).
+ */
+roaring *elroaringCreateAndNot(roaring *pFirst, roaring *pSecond) {
+	return elroaringCreateOp(pFirst, pSecond, EL_ROARING_OP_ANDNOT);
+}
+
+/**
+ * Replaces the compressed bitmap with its intersection with another one.
+ * @param  pThis  Compressed bitmap.
+ * @param  pOther Another compressed bitmap.
+ * @return        @b True if succeeded, otherwise @b false (compressed bitmap 
+ * isn't changed in this case).
+ */
+bool elroaringAnd(roaring *pThis, roaring *pOther) {
+	return elroaringReplace(pThis, 
+		elroaringCreateOp(pThis, pOther, EL_ROARING_OP_AND));
+}
+
+/**
+ * Replaces the compressed bitmap with its union with another one.
+ * @param  pThis  Compressed bitmap.
+ * @param  pOther Another compressed bitmap.
+ * @return        @b True if succeeded, otherwise @b false (compressed bitmap 
+ * isn't changed in this case).
+ */
+bool elroaringOr(roaring *pThis, roaring *pOther) {
+	return elroaringReplace(pThis, 
+		elroaringCreateOp(pThis, pOther, EL_ROARING_OP_OR));
+}
+
+/**
+ * Replaces the compressed bitmap with its symmetric difference with another 
+ * one.
+ * @param  pThis  Compressed bitmap.
+ * @param  pOther Another compressed bitmap.
+ * @return        @b True if succeeded, otherwise @b false (compressed bitmap 
+ * isn't changed in this case).
+ */
+bool elroaringXor(roaring *pThis, roaring *pOther) {
+	return elroaringReplace(pThis, 
+		elroaringCreateOp(pThis, pOther, EL_ROARING_OP_XOR));
+}
+
+/**
+ * Removes from the compressed bitmap all values of another one.
+ * @param  pThis  Compressed bitmap.
+ * @param  pOther Another compressed bitmap.
+ * @return        @b True if succeeded, otherwise @b false (compressed bitmap 
+ * isn't changed in this case).
+ */
+bool elroaringAndNot(roaring *pThis, roaring *pOther) {
+	return elroaringReplace(pThis, 
+		elroaringCreateOp(pThis, pOther, EL_ROARING_OP_ANDNOT));
+}
+
+/** 
+ * @brief Wraps simple foreach callback so it can be called as extended one.
+ */
+typedef struct elroaring_foreach_cb {
+	bool (*valueCallback)(uint32_t nValue); /**< Simple callback. */
+} elroaring_foreach_cb;
+
+/**
+ * Calls simple foreach callback stored in @e pEx.
+ * @param  nValue Value.
+ * @param  pEx    Pointer to elroaring_foreach_cb.
+ * @return        Result of the callback.
+ */
+static bool elroaringForEachCallbackAdapter(uint32_t nValue, void *pEx) {
+	return ((elroaring_foreach_cb *)pEx)->valueCallback(nValue);
+}
+
+/**
+ * Iterates through the values of the compressed bitmap in ascending order and 
+ * calls specified function for each of them. If function returns @b false - 
+ * stops iteration.
+ * @param pThis         Compressed bitmap.
+ * @param valueCallback Callback function to be called for each value.
+ */
+void elroaringForEach(roaring *pThis, bool (*valueCallback)(uint32_t nValue)) {
+	if(valueCallback == NULL)
+		return;
+
+	elroaring_foreach_cb cb = { valueCallback };
+	elroaringForEachEx(pThis, elroaringForEachCallbackAdapter, &cb);
+}
+
+/**
+ * Iterates through the values of the compressed bitmap in ascending order and 
+ * calls specified function for each of them. Passes the pointer to custom 
+ * data to the callback function. If function returns @b false - stops 
+ * iteration.
+ * @param pThis           Compressed bitmap.
+ * @param valueCallbackEx Callback function to be called for each value.
+ * @param pEx             Pointer to custom data to be sent to callback.
+ */
+void elroaringForEachEx(roaring *pThis, 
+	bool (*valueCallbackEx)(uint32_t nValue, void *pEx), void *pEx) {
+
+	if(isInvalid(pThis))
+		return;
+
+	if(valueCallbackEx == NULL)
+		return;
+
+	uint32_t arrBatch[EL_ROARING_FOREACH_BATCH];
+	size_t nWordsPerBatch = EL_ROARING_FOREACH_BATCH / EL_ROARING_WORD_BITS;
+
+	for(size_t i = 0; i < pThis->nCount; i++) {
+		elroaring_container *pContainer = pThis->arrContainers + i;
+		uint32_t nBase = (uint32_t)pContainer->nKey << 16;
+
+		switch(pContainer->nType) {
+			case EL_ROARING_BITMAP:
+				for(size_t j = 0; j < EL_ROARING_BITMAP_WORDS; 
+					j += nWordsPerBatch) {
+
+					size_t nCount = elbitopsExtract32(pContainer->pWords + j, 
+						nWordsPerBatch, nBase + j * EL_ROARING_WORD_BITS, 
+						arrBatch, EL_ROARING_FOREACH_BATCH);
+					for(size_t k = 0; k < nCount; k++) {
+						if(!valueCallbackEx(arrBatch[k], pEx))
+							return;
+					}
+				}
+				break;
+			case EL_ROARING_RUN:
+				for(uint32_t j = 0; j < pContainer->nSize; j++) {
+					uint32_t nValue = nBase + pContainer->arrRuns[j].nStart;
+					uint32_t nLast = nValue + pContainer->arrRuns[j].nLength;
+					for(; nValue <= nLast; nValue++) {
+						if(!valueCallbackEx(nValue, pEx))
+							return;
+						if(nValue == UINT32_MAX)
+							break;
+					}
+				}
+				break;
+			default:
+				for(uint32_t j = 0; j < pContainer->nSize; j++) {
+					if(!valueCallbackEx(nBase + pContainer->arrValues[j], pEx))
+						return;
+				}
+				break;
+		}
+	}
+}
+
+/**
+ * Writes the values of the compressed bitmap into an array in ascending 
+ * order. Stops when @e nCountMax values are written.
+ * @param  pThis     Compressed bitmap.
+ * @param  arrValues Destination array.
+ * @param  nCountMax Capacity of the destination array (use 
+ * elroaringGetCount() to find out the capacity required).
+ * @return           Number of values written.
+ */
+size_t elroaringToArray(roaring *pThis, uint32_t *arrValues, size_t nCountMax) {
+	if(isInvalid(pThis) || arrValues == NULL)
+		return 0;
+
+	size_t nResult = 0;
+	for(size_t i = 0; i < pThis->nCount && nResult < nCountMax; i++) {
+		elroaring_container *pContainer = pThis->arrContainers + i;
+		uint32_t nBase = (uint32_t)pContainer->nKey << 16;
+
+		switch(pContainer->nType) {
+			case EL_ROARING_BITMAP:
+				nResult += elbitopsExtract32(pContainer->pWords, 
+					EL_ROARING_BITMAP_WORDS, nBase, arrValues + nResult, 
+					nCountMax - nResult);
+				break;
+			case EL_ROARING_RUN:
+				for(uint32_t j = 0; j < pContainer->nSize; j++) {
+					uint32_t nValue = nBase + pContainer->arrRuns[j].nStart;
+					uint32_t nLength = pContainer->arrRuns[j].nLength + 1u;
+					for(uint32_t k = 0; k < nLength && nResult < nCountMax; k++)
+						arrValues[nResult++] = nValue + k;
+				}
+				break;
+			default:
+				for(uint32_t j = 0; j < pContainer->nSize && 
+					nResult < nCountMax; j++)
+					arrValues[nResult++] = nBase + pContainer->arrValues[j];
+				break;
+		}
+	}
+
+	return nResult;
+}
+
+/**
+ * Creates new bit set holding the values of the compressed bitmap as 
+ * positions of the bits which are set. The size of bit set is enough to hold 
+ * the greatest value.
+ * @param  pThis Compressed bitmap.
+ * @return       Newly created bit set (or NULL if an error occured).
+ */
+bitset *elroaringToBitset(roaring *pThis) {
+	if(isInvalid(pThis))
+		return NULL;
+
+	if(pThis->nCount == 0)
+		return elbitsetCreate(1);
+
+	elroaring_container *pLast = pThis->arrContainers + pThis->nCount - 1;
+	size_t nMax = ((size_t)pLast->nKey << 16) + 
+		elroaringContainerGetMax(pLast);
+
+	bitset *pBitset = elbitsetCreate(nMax + 1);
+	if(pBitset == NULL)
+		return NULL;
+
+	uintmax_t arrWords[EL_ROARING_BITMAP_WORDS];
+	for(size_t i = 0; i < pThis->nCount; i++) {
+		elroaring_container *pContainer = pThis->arrContainers + i;
+		size_t nOffset = (size_t)pContainer->nKey * EL_ROARING_BITMAP_WORDS;
+		size_t nWords = pBitset->nCapacity - nOffset < EL_ROARING_BITMAP_WORDS ? 
+			pBitset->nCapacity - nOffset : EL_ROARING_BITMAP_WORDS;
+
+		const uintmax_t *pWords = pContainer->pWords;
+		if(pContainer->nType != EL_ROARING_BITMAP) {
+			elroaringContainerToWords(pContainer, arrWords);
+			pWords = arrWords;
+		}
+		memcpy(pBitset->pBuf + nOffset, pWords, nWords * sizeof(uintmax_t));
+	}
+
+	return pBitset;
+}
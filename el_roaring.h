@@ -0,0 +1,126 @@
+/* Extreme Library (EL). Compressed bitmaps. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef _EL_ROARING_H_
+#define _EL_ROARING_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "el_bitset.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Maximal number of values in array container. Larger containers are stored 
+ * as bitmaps (both take 8 KB at this size).
+ */
+#define EL_ROARING_ARRAY_MAX	4096
+
+/**
+ * Type of container holding the values of one 2^16 chunk.
+ */
+typedef enum elroaring_type {
+	EL_ROARING_ARRAY = 0, /**< Sorted array of 16-bit values. */
+	EL_ROARING_BITMAP, /**< Bitmap of 2^16 bits. */
+	EL_ROARING_RUN /**< Sorted array of runs of consecutive values. */
+} elroaring_type;
+
+/** 
+ * @brief Run of consecutive values in run container.
+ */
+typedef struct elroaring_run {
+	uint16_t nStart; /**< First value of the run. */
+	uint16_t nLength; /**< Number of values in the run minus one. */
+} elroaring_run;
+
+/** 
+ * @brief Holds the values of one 2^16 chunk of compressed bitmap.
+ */
+typedef struct elroaring_container {
+	uint16_t nKey; /**< High 16 bits of values stored. */
+	uint8_t nType; /**< Type of the container (elroaring_type). */
+	uint32_t nCardinality; /**< Number of values stored. */
+	uint32_t nSize; /**< Number of elements in array (values or runs). */
+	uint32_t nCapacity; /**< Number of elements allocated. */
+	union {
+		uint16_t *arrValues; /**< Values of array container. */
+		uintmax_t *pWords; /**< Words of bitmap container. */
+		elroaring_run *arrRuns; /**< Runs of run container. */
+	};
+} elroaring_container;
+
+/** 
+ * @brief Holds the data of compressed bitmap of 32-bit values.
+ *
+ * The universe is split into 2^16 chunks by high 16 bits of the values. Each 
+ * non-empty chunk is stored as a sorted array, a bitmap or a run-length 
+ * container whichever fits its contents best.
+ */
+typedef struct roaring {
+	size_t nCount; /**< Number of containers. */
+	size_t nCapacity; /**< Number of containers allocated. */
+	elroaring_container *arrContainers; /**< Containers sorted by key. */
+} roaring;
+
+/** 
+ * @brief Pointer to callback function which's called by foreach() enumerator.
+ */
+#define EL_CB_VALUE_FOREACH(s) (bool (*)(uint32_t))(s)
+/** 
+ * @brief Pointer to extended callback function which's called by foreachex() 
+ * enumerator.
+ */
+#define EL_CB_VALUE_FOREACH_EX(s) (bool (*)(uint32_t, void *))(s)
+
+roaring *elroaringCreate();
+roaring *elroaringCreateCopy(roaring *pOther);
+roaring *elroaringCreateFromBitset(bitset *pBitset);
+void elroaringDestroy(roaring *pThis);
+void elroaringClear(roaring *pThis);
+uint64_t elroaringGetCount(roaring *pThis);
+size_t elroaringGetSizeInBytes(roaring *pThis);
+bool elroaringAdd(roaring *pThis, uint32_t nValue);
+bool elroaringAddRange(roaring *pThis, uint32_t nFrom, uint64_t nTo);
+bool elroaringRemove(roaring *pThis, uint32_t nValue);
+bool elroaringContains(roaring *pThis, uint32_t nValue);
+bool elroaringOptimize(roaring *pThis);
+bool elroaringIsEqualTo(roaring *pThis, roaring *pOther);
+roaring *elroaringCreateAnd(roaring *pFirst, roaring *pSecond);
+roaring *elroaringCreateOr(roaring *pFirst, roaring *pSecond);
+roaring *elroaringCreateXor(roaring *pFirst, roaring *pSecond);
+roaring *elroaringCreateAndNot(roaring *pFirst, roaring *pSecond);
+bool elroaringAnd(roaring *pThis, roaring *pOther);
+bool elroaringOr(roaring *pThis, roaring *pOther);
+bool elroaringXor(roaring *pThis, roaring *pOther);
+bool elroaringAndNot(roaring *pThis, roaring *pOther);
+void elroaringForEach(roaring *pThis, bool (*valueCallback)(uint32_t nValue));
+void elroaringForEachEx(roaring *pThis, 
+	bool (*valueCallbackEx)(uint32_t nValue, void *pEx), void *pEx);
+size_t elroaringToArray(roaring *pThis, uint32_t *arrValues, size_t nCountMax);
+bitset *elroaringToBitset(roaring *pThis);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
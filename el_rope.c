@@ -0,0 +1,1051 @@
+/* Extreme Library (EL). Ropes. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include <string.h>
+
+#include "el_memory.h"
+
+#include "el_rope.h"
+
+#define isInvalid(s) ((s) == NULL)
+#define getTotal(pNode) ((pNode) != NULL ? (pNode)->nTotal : 0)
+#define updateTotal(pNode) (pNode)->nTotal = getTotal((pNode)->pLeft) + \
+	(pNode)->nLength + getTotal((pNode)->pRight)
+
+/**
+ * Returns the next random priority for a node.
+ * @param  pThis Rope.
+ * @return       Priority.
+ */
+static uint32_t elropeRandomPriority(rope *pThis) {
+	// xorshift32
+	uint32_t nRandom = pThis->nRandom;
+	nRandom ^= nRandom << 13;
+	nRandom ^= nRandom >> 17;
+	nRandom ^= nRandom << 5;
+	pThis->nRandom = nRandom;
+
+	return nRandom;
+}
+
+/**
+ * Creates new rope node holding the chunk.
+ * @param  pThis   Rope.
+ * @param  p       Bytes of the chunk.
+ * @param  nLength Number of bytes (not greater than EL_ROPE_CHUNK_MAX).
+ * @return         Newly created node (or NULL if an error occured).
+ */
+static elrope_node *elropeNodeCreate(rope *pThis, const char *p, 
+	size_t nLength) {
+
+	elrope_node *pNode = EL_ALLOC(sizeof(elrope_node));
+	if(pNode == NULL)
+		return NULL;
+
+	pNode->pLeft = NULL;
+	pNode->pRight = NULL;
+	pNode->nPriority = elropeRandomPriority(pThis);
+	pNode->nLength = (uint32_t)nLength;
+	pNode->nTotal = nLength;
+	memcpy(pNode->arrChunk, p, nLength);
+
+	return pNode;
+}
+
+/**
+ * Destroys all nodes of the subtree.
+ * @param pNode Root of the subtree.
+ */
+static void elropeNodeDestroyTree(elrope_node *pNode) {
+	while(pNode != NULL) {
+		elropeNodeDestroyTree(pNode->pLeft);
+		elrope_node *pRight = pNode->pRight;
+		EL_FREE(pNode);
+		pNode = pRight;
+	}
+}
+
+/**
+ * Joins two subtrees (all chunks of the first one precede chunks of the 
+ * second one).
+ * @param  pNode1 First subtree.
+ * @param  pNode2 Second subtree.
+ * @return        Root of the joined tree.
+ */
+static elrope_node *elropeNodeMerge(elrope_node *pNode1, elrope_node *pNode2) {
+	if(pNode1 == NULL)
+		return pNode2;
+	if(pNode2 == NULL)
+		return pNode1;
+
+	if(pNode1->nPriority > pNode2->nPriority) {
+		pNode1->pRight = elropeNodeMerge(pNode1->pRight, pNode2);
+		updateTotal(pNode1);
+		return pNode1;
+	}
+
+	pNode2->pLeft = elropeNodeMerge(pNode1, pNode2->pLeft);
+	updateTotal(pNode2);
+	return pNode2;
+}
+
+/**
+ * Splits the subtree into two: with first @e nPos bytes and with the rest. 
+ * Chunk containing the position is split in two, its second part is moved to 
+ * the spare node provided (which is left out of both subtrees).
+ * @param pNode   Root of the subtree.
+ * @param nPos    Position of the split.
+ * @param ppLeft  Receives subtree with first @e nPos bytes.
+ * @param ppRight Receives subtree with the rest of bytes (except the spare 
+ * node).
+ * @param ppSpare Spare node (set to NULL if it's used).
+ */
+static void elropeNodeSplitTree(elrope_node *pNode, size_t nPos, 
+	elrope_node **ppLeft, elrope_node **ppRight, elrope_node **ppSpare) {
+
+	if(pNode == NULL) {
+		*ppLeft = NULL;
+		*ppRight = NULL;
+		return;
+	}
+
+	size_t nLeft = getTotal(pNode->pLeft);
+	if(nPos <= nLeft) {
+		elropeNodeSplitTree(pNode->pLeft, nPos, ppLeft, &pNode->pLeft, ppSpare);
+		updateTotal(pNode);
+		*ppRight = pNode;
+	} else if(nPos >= nLeft + pNode->nLength) {
+		elropeNodeSplitTree(pNode->pRight, nPos - nLeft - pNode->nLength, 
+			&pNode->pRight, ppRight, ppSpare);
+		updateTotal(pNode);
+		*ppLeft = pNode;
+	} else {
+		size_t nOffset = nPos - nLeft;
+		elrope_node *pSpare = *ppSpare;
+		*ppSpare = NULL;
+
+		pSpare->nLength = pNode->nLength - (uint32_t)nOffset;
+		memcpy(pSpare->arrChunk, pNode->arrChunk + nOffset, pSpare->nLength);
+		pSpare->pLeft = NULL;
+		pSpare->pRight = NULL;
+		pSpare->nTotal = pSpare->nLength;
+
+		*ppRight = pNode->pRight;
+		pNode->nLength = (uint32_t)nOffset;
+		pNode->pRight = NULL;
+		updateTotal(pNode);
+
+		*ppLeft = pNode;
+	}
+}
+
+/**
+ * Splits the subtree into two: with first @e nPos bytes and with the rest. 
+ * Chunk containing the position is split in two, its second part is moved to 
+ * the spare node provided.
+ * @param pThis   Rope.
+ * @param pNode   Root of the subtree.
+ * @param nPos    Position of the split.
+ * @param ppLeft  Receives subtree with first @e nPos bytes.
+ * @param ppRight Receives subtree with the rest of bytes.
+ * @param ppSpare Spare node (set to NULL if it's used).
+ */
+static void elropeNodeSplit(rope *pThis, elrope_node *pNode, size_t nPos, 
+	elrope_node **ppLeft, elrope_node **ppRight, elrope_node **ppSpare) {
+
+	elrope_node *pSpare = *ppSpare;
+	elropeNodeSplitTree(pNode, nPos, ppLeft, ppRight, ppSpare);
+
+	// second part of the chunk gets its own priority and is merged into the 
+	// right tree (taking the priority of the chunk split makes the tree 
+	// degenerate after many splits)
+	if(pSpare != NULL && *ppSpare == NULL) {
+		pSpare->nPriority = elropeRandomPriority(pThis);
+		*ppRight = elropeNodeMerge(pSpare, *ppRight);
+	}
+}
+
+/**
+ * Removes the first node of the subtree.
+ * @param  pNode   Root of the subtree (not NULL).
+ * @param  ppFirst Receives the node removed.
+ * @return         Root of the remaining subtree.
+ */
+static elrope_node *elropeNodeRemoveFirst(elrope_node *pNode, 
+	elrope_node **ppFirst) {
+
+	if(pNode->pLeft == NULL) {
+		*ppFirst = pNode;
+		return pNode->pRight;
+	}
+
+	pNode->pLeft = elropeNodeRemoveFirst(pNode->pLeft, ppFirst);
+	updateTotal(pNode);
+	return pNode;
+}
+
+/**
+ * Returns the last node of the subtree.
+ * @param  pNode Root of the subtree.
+ * @return       Last node (or NULL if the subtree is empty).
+ */
+static elrope_node *elropeNodeGetLast(elrope_node *pNode) {
+	if(pNode != NULL)
+		while(pNode->pRight != NULL)
+			pNode = pNode->pRight;
+
+	return pNode;
+}
+
+/**
+ * Appends bytes to the last chunk of the subtree.
+ * @param pNode   Root of the subtree (not NULL).
+ * @param p       Bytes to append.
+ * @param nLength Number of bytes (the last chunk must have room for them).
+ */
+static void elropeNodeAppendToLast(elrope_node *pNode, const char *p, 
+	size_t nLength) {
+
+	elrope_node *pLast = elropeNodeGetLast(pNode);
+	memcpy(pLast->arrChunk + pLast->nLength, p, nLength);
+	pLast->nLength += (uint32_t)nLength;
+
+	for(; pNode != NULL; pNode = pNode->pRight)
+		pNode->nTotal += nLength;
+}
+
+/**
+ * Joins two subtrees. If the last chunk of the first subtree and the first 
+ * chunk of the second one fit into one chunk, they are combined (so edits 
+ * don't leave a lot of small chunks).
+ * @param  pNode1 First subtree.
+ * @param  pNode2 Second subtree.
+ * @return        Root of the joined tree.
+ */
+static elrope_node *elropeNodeJoin(elrope_node *pNode1, elrope_node *pNode2) {
+	if(pNode1 == NULL || pNode2 == NULL)
+		return elropeNodeMerge(pNode1, pNode2);
+
+	elrope_node *pFirst = pNode2;
+	while(pFirst->pLeft != NULL)
+		pFirst = pFirst->pLeft;
+
+	if(elropeNodeGetLast(pNode1)->nLength + pFirst->nLength <= 
+		EL_ROPE_CHUNK_MAX) {
+
+		pNode2 = elropeNodeRemoveFirst(pNode2, &pFirst);
+		elropeNodeAppendToLast(pNode1, pFirst->arrChunk, pFirst->nLength);
+		EL_FREE(pFirst);
+	}
+
+	return elropeNodeMerge(pNode1, pNode2);
+}
+
+/**
+ * Joins the chunk containing the position with the previous or the next 
+ * chunk if it's shorter than EL_ROPE_CHUNK_MIN and they fit into one chunk.
+ * @param  pNode Root of the tree.
+ * @param  nPos  Position (the last chunk is taken if it's past the end).
+ * @return       Root of the tree.
+ */
+static elrope_node *elropeNodeCoalesce(elrope_node *pNode, size_t nPos) {
+	size_t nTotal = getTotal(pNode);
+	if(nTotal == 0)
+		return pNode;
+	if(nPos >= nTotal)
+		nPos = nTotal - 1;
+
+	size_t nStart = 0;
+	elrope_node *pChunk = pNode;
+	for(;;) {
+		size_t nLeft = getTotal(pChunk->pLeft);
+		if(nPos < nLeft)
+			pChunk = pChunk->pLeft;
+		else if(nPos < nLeft + pChunk->nLength) {
+			nStart += nLeft;
+			break;
+		} else {
+			nStart += nLeft + pChunk->nLength;
+			nPos -= nLeft + pChunk->nLength;
+			pChunk = pChunk->pRight;
+		}
+	}
+
+	if(pChunk->nLength >= EL_ROPE_CHUNK_MIN)
+		return pNode;
+
+	// splits at the borders of chunks don't need spare nodes, joining the 
+	// parts back combines the chunks next to the border if they fit
+	size_t nEnd = nStart + pChunk->nLength;
+	elrope_node *pLeft;
+	elrope_node *pRight;
+	elrope_node *pSpare = NULL;
+	if(nStart > 0) {
+		elropeNodeSplitTree(pNode, nStart, &pLeft, &pRight, &pSpare);
+		bool bFits = elropeNodeGetLast(pLeft)->nLength + pChunk->nLength <= 
+			EL_ROPE_CHUNK_MAX;
+		pNode = elropeNodeJoin(pLeft, pRight);
+		if(bFits)
+			return pNode;
+	}
+
+	if(nEnd < nTotal) {
+		elropeNodeSplitTree(pNode, nEnd, &pLeft, &pRight, &pSpare);
+		pNode = elropeNodeJoin(pLeft, pRight);
+	}
+
+	return pNode;
+}
+
+/**
+ * Creates the subtree holding the bytes in chunks.
+ * @param  pThis   Rope.
+ * @param  p       Bytes.
+ * @param  nLength Number of bytes.
+ * @param  ppNode  Receives root of the subtree (NULL if there are no bytes).
+ * @return         @b True if successful, @b false if an error occured.
+ */
+static bool elropeNodeBuild(rope *pThis, const char *p, size_t nLength, 
+	elrope_node **ppNode) {
+
+	elrope_node *pRoot = NULL;
+	while(nLength > 0) {
+		size_t nChunk = nLength < EL_ROPE_CHUNK_MAX ? nLength : 
+			EL_ROPE_CHUNK_MAX;
+		elrope_node *pNode = elropeNodeCreate(pThis, p, nChunk);
+		if(pNode == NULL) {
+			elropeNodeDestroyTree(pRoot);
+			return false;
+		}
+		pRoot = elropeNodeMerge(pRoot, pNode);
+		p += nChunk;
+		nLength -= nChunk;
+	}
+
+	*ppNode = pRoot;
+
+	return true;
+}
+
+/**
+ * Appends bytes to the subtree. Room left in its last chunk is filled first.
+ * @param  pThis   Rope.
+ * @param  ppNode  Root of the subtree (updated).
+ * @param  p       Bytes to append.
+ * @param  nLength Number of bytes.
+ * @return         @b True if successful, @b false if an error occured (the 
+ * subtree is not changed then).
+ */
+static bool elropeNodeAppend(rope *pThis, elrope_node **ppNode, const char *p, 
+	size_t nLength) {
+
+	size_t nRoom = 0;
+	elrope_node *pLast = elropeNodeGetLast(*ppNode);
+	if(pLast != NULL)
+		nRoom = EL_ROPE_CHUNK_MAX - pLast->nLength;
+	if(nRoom > nLength)
+		nRoom = nLength;
+
+	elrope_node *pRest;
+	if(!elropeNodeBuild(pThis, p + nRoom, nLength - nRoom, &pRest))
+		return false;
+
+	if(nRoom > 0)
+		elropeNodeAppendToLast(*ppNode, p, nRoom);
+	*ppNode = elropeNodeMerge(*ppNode, pRest);
+
+	return true;
+}
+
+/**
+ * Inserts bytes into the chunk containing the position if it has room.
+ * @param  pNode   Root of the subtree.
+ * @param  nPos    Position in the subtree.
+ * @param  p       Bytes to insert.
+ * @param  nLength Number of bytes.
+ * @return         @b True if bytes are inserted, @b false if the chunk has no 
+ * room for them.
+ */
+static bool elropeNodeInsertInPlace(elrope_node *pNode, size_t nPos, 
+	const char *p, size_t nLength) {
+
+	if(pNode == NULL)
+		return false;
+
+	bool bInserted;
+	size_t nLeft = getTotal(pNode->pLeft);
+	if(nPos <= nLeft && pNode->pLeft != NULL)
+		bInserted = elropeNodeInsertInPlace(pNode->pLeft, nPos, p, nLength);
+	else if(nPos <= nLeft + pNode->nLength) {
+		if(pNode->nLength + nLength > EL_ROPE_CHUNK_MAX)
+			return false;
+		size_t nOffset = nPos - nLeft;
+		memmove(pNode->arrChunk + nOffset + nLength, pNode->arrChunk + nOffset, 
+			pNode->nLength - nOffset);
+		memcpy(pNode->arrChunk + nOffset, p, nLength);
+		pNode->nLength += (uint32_t)nLength;
+		bInserted = true;
+	} else
+		bInserted = elropeNodeInsertInPlace(pNode->pRight, 
+			nPos - nLeft - pNode->nLength, p, nLength);
+
+	if(bInserted)
+		pNode->nTotal += nLength;
+
+	return bInserted;
+}
+
+/**
+ * Removes bytes from the chunk if all of them are in one chunk and it doesn't 
+ * become empty.
+ * @param  pNode  Root of the subtree.
+ * @param  nPos   Position in the subtree.
+ * @param  nCount Number of bytes to remove.
+ * @return        @b True if bytes are removed, otherwise @b false.
+ */
+static bool elropeNodeDeleteInPlace(elrope_node *pNode, size_t nPos, 
+	size_t nCount) {
+
+	if(pNode == NULL)
+		return false;
+
+	bool bDeleted;
+	size_t nLeft = getTotal(pNode->pLeft);
+	if(nPos < nLeft)
+		bDeleted = elropeNodeDeleteInPlace(pNode->pLeft, nPos, nCount);
+	else if(nPos < nLeft + pNode->nLength) {
+		size_t nOffset = nPos - nLeft;
+		if(nCount >= pNode->nLength || nOffset + nCount > pNode->nLength)
+			return false;
+		memmove(pNode->arrChunk + nOffset, pNode->arrChunk + nOffset + nCount, 
+			pNode->nLength - nOffset - nCount);
+		pNode->nLength -= (uint32_t)nCount;
+		bDeleted = true;
+	} else
+		bDeleted = elropeNodeDeleteInPlace(pNode->pRight, 
+			nPos - nLeft - pNode->nLength, nCount);
+
+	if(bDeleted)
+		pNode->nTotal -= nCount;
+
+	return bDeleted;
+}
+
+/**
+ * Visits chunks of the subtree intersecting with the range in order.
+ * @param  pNode        Root of the subtree.
+ * @param  nStart       Start of the range (relative to the subtree).
+ * @param  nEnd         End of the range (relative to the subtree).
+ * @param  chunkForEach Callback receiving parts of chunks in the range.
+ * @param  pData        User data passed to callback.
+ * @return              @b False if callback stopped the visiting.
+ */
+static bool elropeNodeForEach(elrope_node *pNode, size_t nStart, size_t nEnd, 
+	bool (*chunkForEach)(const char *p, size_t nLength, void *pData), 
+	void *pData) {
+
+	while(pNode != NULL && nStart < nEnd) {
+		size_t nLeft = getTotal(pNode->pLeft);
+		if(nStart < nLeft && !elropeNodeForEach(pNode->pLeft, nStart, 
+			nEnd < nLeft ? nEnd : nLeft, chunkForEach, pData))
+			return false;
+
+		size_t nChunkEnd = nLeft + pNode->nLength;
+		if(nEnd <= nLeft)
+			return true;
+		if(nStart < nChunkEnd) {
+			size_t nFrom = nStart > nLeft ? nStart - nLeft : 0;
+			size_t nTo = (nEnd < nChunkEnd ? nEnd : nChunkEnd) - nLeft;
+			if(!chunkForEach(pNode->arrChunk + nFrom, nTo - nFrom, pData))
+				return false;
+		}
+		if(nEnd <= nChunkEnd)
+			return true;
+
+		// right subtree is visited without recursion
+		nStart = nStart > nChunkEnd ? nStart - nChunkEnd : 0;
+		nEnd -= nChunkEnd;
+		pNode = pNode->pRight;
+	}
+
+	return true;
+}
+
+/**
+ * Creates new empty rope.
+ * @return Newly created rope (or NULL if an error occured).
+ */
+rope *elropeCreate() {
+	rope *pThis = EL_CALLOC(1, sizeof(rope));
+	if(pThis == NULL)
+		return NULL;
+
+	pThis->nRandom = 2463534242u;
+
+	return pThis;
+}
+
+/**
+ * Creates new rope holding the text of C style string.
+ * @param  sz C style string.
+ * @return    Newly created rope (or NULL if an error occured).
+ */
+rope *elropeCreateFromCStr(const char *sz) {
+	if(sz == NULL)
+		return NULL;
+
+	return elropeCreateFromView(elstrviewFromCStr(sz));
+}
+
+/**
+ * Creates new rope holding the text of dynamic string.
+ * @param  pStr Dynamic string.
+ * @return      Newly created rope (or NULL if an error occured).
+ */
+rope *elropeCreateFromELStr(str *pStr) {
+	strview view = elstrGetView(pStr);
+	if(view.szBuf == NULL)
+		return NULL;
+
+	return elropeCreateFromView(view);
+}
+
+/**
+ * Creates new rope holding the bytes of the view.
+ * @param  view View.
+ * @return      Newly created rope (or NULL if an error occured).
+ */
+rope *elropeCreateFromView(strview view) {
+	rope *pThis = elropeCreate();
+	if(pThis == NULL)
+		return NULL;
+
+	if(!elropeAppendView(pThis, view)) {
+		elropeDestroy(pThis);
+		return NULL;
+	}
+
+	return pThis;
+}
+
+/**
+ * Destroys the rope.
+ * @param pThis Rope.
+ */
+void elropeDestroy(rope *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	elropeNodeDestroyTree(pThis->pRoot);
+
+	EL_FREE(pThis);
+}
+
+/**
+ * Removes all text from the rope.
+ * @param pThis Rope.
+ */
+void elropeClear(rope *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	elropeNodeDestroyTree(pThis->pRoot);
+	pThis->pRoot = NULL;
+}
+
+/**
+ * Returns the length of the text.
+ * @param  pThis Rope.
+ * @return       Number of bytes in the rope.
+ */
+size_t elropeGetLength(rope *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	return getTotal(pThis->pRoot);
+}
+
+/**
+ * Returns the character at the position.
+ * @param  pThis  Rope.
+ * @param  nIndex Position of the character.
+ * @return        Character (or null character if position is out of range).
+ */
+char elropeGetChar(rope *pThis, size_t nIndex) {
+	if(isInvalid(pThis))
+		return '\0';
+
+	elrope_node *pNode = pThis->pRoot;
+	while(pNode != NULL) {
+		size_t nLeft = getTotal(pNode->pLeft);
+		if(nIndex < nLeft)
+			pNode = pNode->pLeft;
+		else if(nIndex < nLeft + pNode->nLength)
+			return pNode->arrChunk[nIndex - nLeft];
+		else {
+			nIndex -= nLeft + pNode->nLength;
+			pNode = pNode->pRight;
+		}
+	}
+
+	return '\0';
+}
+
+/**
+ * Inserts C style string into the rope.
+ * @param  pThis  Rope.
+ * @param  nIndex Position where to insert.
+ * @param  sz     C style string.
+ * @return        @b True if successful, @b false if an error occured.
+ */
+bool elropeInsertCStr(rope *pThis, size_t nIndex, const char *sz) {
+	if(sz == NULL)
+		return false;
+
+	return elropeInsertView(pThis, nIndex, elstrviewFromCStr(sz));
+}
+
+/**
+ * Inserts dynamic string into the rope.
+ * @param  pThis  Rope.
+ * @param  nIndex Position where to insert.
+ * @param  pStr   Dynamic string.
+ * @return        @b True if successful, @b false if an error occured.
+ */
+bool elropeInsertELStr(rope *pThis, size_t nIndex, str *pStr) {
+	strview view = elstrGetView(pStr);
+	if(view.szBuf == NULL)
+		return false;
+
+	return elropeInsertView(pThis, nIndex, view);
+}
+
+/**
+ * Inserts bytes of the view into the rope. Bytes go into the chunk at the 
+ * position if it has room, otherwise the tree is split at the position.
+ * @param  pThis  Rope.
+ * @param  nIndex Position where to insert.
+ * @param  view   View (may not point into the rope itself).
+ * @return        @b True if successful, @b false if an error occured (the 
+ * rope is not changed then).
+ */
+bool elropeInsertView(rope *pThis, size_t nIndex, strview view) {
+	if(isInvalid(pThis) || view.szBuf == NULL)
+		return false;
+
+	if(nIndex > getTotal(pThis->pRoot))
+		return false;
+
+	if(view.nLength == 0)
+		return true;
+
+	if(elropeNodeInsertInPlace(pThis->pRoot, nIndex, view.szBuf, 
+		view.nLength))
+		return true;
+
+	elrope_node *pSpare = EL_ALLOC(sizeof(elrope_node));
+	if(pSpare == NULL)
+		return false;
+
+	elrope_node *pLeft;
+	elrope_node *pRight;
+	elropeNodeSplit(pThis, pThis->pRoot, nIndex, &pLeft, &pRight, &pSpare);
+	bool bResult = elropeNodeAppend(pThis, &pLeft, view.szBuf, view.nLength);
+	pThis->pRoot = elropeNodeJoin(pLeft, pRight);
+
+	if(pSpare != NULL)
+		EL_FREE(pSpare);
+
+	return bResult;
+}
+
+/**
+ * Appends bytes of the view to the end of the rope.
+ * @param  pThis Rope.
+ * @param  view  View (may not point into the rope itself).
+ * @return       @b True if successful, @b false if an error occured.
+ */
+bool elropeAppendView(rope *pThis, strview view) {
+	if(isInvalid(pThis) || view.szBuf == NULL)
+		return false;
+
+	return elropeNodeAppend(pThis, &pThis->pRoot, view.szBuf, view.nLength);
+}
+
+/**
+ * Appends C style string to the end of the rope.
+ * @param  pThis Rope.
+ * @param  sz    C style string.
+ * @return       @b True if successful, @b false if an error occured.
+ */
+bool elropeAppendCStr(rope *pThis, const char *sz) {
+	if(sz == NULL)
+		return false;
+
+	return elropeAppendView(pThis, elstrviewFromCStr(sz));
+}
+
+/**
+ * Inserts C style string at the beginning of the rope.
+ * @param  pThis Rope.
+ * @param  sz    C style string.
+ * @return       @b True if successful, @b false if an error occured.
+ */
+bool elropePrependCStr(rope *pThis, const char *sz) {
+	return elropeInsertCStr(pThis, 0, sz);
+}
+
+/**
+ * Joins short chunks around the position where bytes are removed with their 
+ * neighbours (so deletions don't leave a lot of small chunks).
+ * @param pThis  Rope.
+ * @param nIndex Position where bytes are removed.
+ */
+static void elropeDeleteCoalesce(rope *pThis, size_t nIndex) {
+	if(nIndex > 0)
+		pThis->pRoot = elropeNodeCoalesce(pThis->pRoot, nIndex - 1);
+	pThis->pRoot = elropeNodeCoalesce(pThis->pRoot, nIndex);
+}
+
+/**
+ * Removes bytes from the rope.
+ * @param  pThis  Rope.
+ * @param  nIndex Position of the first byte to remove.
+ * @param  nCount Number of bytes to remove (bytes after the end of the rope 
+ * are ignored).
+ * @return        @b True if successful, @b false if an error occured (the 
+ * rope is not changed then).
+ */
+bool elropeDelete(rope *pThis, size_t nIndex, size_t nCount) {
+	if(isInvalid(pThis))
+		return false;
+
+	size_t nLength = getTotal(pThis->pRoot);
+	if(nIndex > nLength)
+		return false;
+
+	if(nCount > nLength - nIndex)
+		nCount = nLength - nIndex;
+	if(nCount == 0)
+		return true;
+
+	if(elropeNodeDeleteInPlace(pThis->pRoot, nIndex, nCount)) {
+		elropeDeleteCoalesce(pThis, nIndex);
+		return true;
+	}
+
+	elrope_node *pSpare1 = EL_ALLOC(sizeof(elrope_node));
+	elrope_node *pSpare2 = EL_ALLOC(sizeof(elrope_node));
+	if(pSpare1 == NULL || pSpare2 == NULL) {
+		if(pSpare1 != NULL)
+			EL_FREE(pSpare1);
+		if(pSpare2 != NULL)
+			EL_FREE(pSpare2);
+		return false;
+	}
+
+	elrope_node *pLeft;
+	elrope_node *pMiddle;
+	elrope_node *pRight;
+	elropeNodeSplit(pThis, pThis->pRoot, nIndex, &pLeft, &pMiddle, &pSpare1);
+	elropeNodeSplit(pThis, pMiddle, nCount, &pMiddle, &pRight, &pSpare2);
+	elropeNodeDestroyTree(pMiddle);
+	pThis->pRoot = elropeNodeJoin(pLeft, pRight);
+	elropeDeleteCoalesce(pThis, nIndex);
+
+	if(pSpare1 != NULL)
+		EL_FREE(pSpare1);
+	if(pSpare2 != NULL)
+		EL_FREE(pSpare2);
+
+	return true;
+}
+
+/**
+ * Splits the rope in two. Text after the position is moved to a new rope.
+ * @param  pThis  Rope.
+ * @param  nIndex Position of the split.
+ * @return        Newly created rope holding the text after the position (or 
+ * NULL if an error occured).
+ */
+rope *elropeSplit(rope *pThis, size_t nIndex) {
+	if(isInvalid(pThis))
+		return NULL;
+
+	if(nIndex > getTotal(pThis->pRoot))
+		return NULL;
+
+	rope *pTail = elropeCreate();
+	if(pTail == NULL)
+		return NULL;
+
+	elrope_node *pSpare = EL_ALLOC(sizeof(elrope_node));
+	if(pSpare == NULL) {
+		elropeDestroy(pTail);
+		return NULL;
+	}
+
+	pTail->nRandom = elropeRandomPriority(pThis) | 1;
+	elropeNodeSplit(pThis, pThis->pRoot, nIndex, &pThis->pRoot, 
+		&pTail->pRoot, &pSpare);
+
+	if(pSpare != NULL)
+		EL_FREE(pSpare);
+
+	return pTail;
+}
+
+/**
+ * Moves all text of the other rope to the end of the rope. The other rope 
+ * becomes empty (but is not destroyed).
+ * @param pThis  Rope.
+ * @param pOther Rope which text is moved.
+ */
+void elropeConcat(rope *pThis, rope *pOther) {
+	if(isInvalid(pThis) || isInvalid(pOther) || pThis == pOther)
+		return;
+
+	pThis->pRoot = elropeNodeJoin(pThis->pRoot, pOther->pRoot);
+	pOther->pRoot = NULL;
+}
+
+/**
+ * Callback copying chunks into the buffer.
+ */
+static bool elropeCopyChunk(const char *p, size_t nLength, char **ppDest) {
+	memcpy(*ppDest, p, nLength);
+	*ppDest += nLength;
+
+	return true;
+}
+
+/**
+ * Copies part of the text into the buffer (null character is not added).
+ * @param  pThis  Rope.
+ * @param  nIndex Position of the first byte to copy.
+ * @param  nCount Number of bytes to copy.
+ * @param  pDest  Buffer (at least @e nCount bytes).
+ * @return        Number of bytes copied.
+ */
+size_t elropeCopyTo(rope *pThis, size_t nIndex, size_t nCount, char *pDest) {
+	if(isInvalid(pThis) || pDest == NULL)
+		return 0;
+
+	size_t nLength = getTotal(pThis->pRoot);
+	if(nIndex >= nLength)
+		return 0;
+	if(nCount > nLength - nIndex)
+		nCount = nLength - nIndex;
+
+	elropeNodeForEach(pThis->pRoot, nIndex, nIndex + nCount, 
+		EL_CB_CHUNK_FOREACH_EX(elropeCopyChunk), &pDest);
+
+	return nCount;
+}
+
+/**
+ * Creates new dynamic string from the part of the text.
+ * @param  pThis  Rope.
+ * @param  nIndex Position of the first byte.
+ * @param  nCount Number of bytes (bytes after the end of the rope are 
+ * ignored).
+ * @return        New dynamic string (or NULL if an error occured).
+ */
+str *elropeSubString(rope *pThis, size_t nIndex, size_t nCount) {
+	if(isInvalid(pThis))
+		return NULL;
+
+	size_t nLength = getTotal(pThis->pRoot);
+	if(nIndex > nLength)
+		return NULL;
+	if(nCount > nLength - nIndex)
+		nCount = nLength - nIndex;
+
+	str *pStr = elstrCreateEmptyWithCapacity(nCount + 1);
+	if(pStr == NULL)
+		return NULL;
+
+	elropeCopyTo(pThis, nIndex, nCount, pStr->szBuf);
+	elstrSetLength(pStr, nCount);
+
+	return pStr;
+}
+
+/**
+ * Creates new dynamic string holding all text of the rope.
+ * @param  pThis Rope.
+ * @return       New dynamic string (or NULL if an error occured).
+ */
+str *elropeToELStr(rope *pThis) {
+	return elropeSubString(pThis, 0, elropeGetLength(pThis));
+}
+
+/**
+ * Calls the callback for each chunk of the part of text in order. Chunks at 
+ * the ends of the part are passed partially.
+ * @param pThis        Rope.
+ * @param nIndex       Position of the first byte.
+ * @param nCount       Number of bytes (bytes after the end of the rope are 
+ * ignored).
+ * @param chunkForEach Callback receiving bytes of chunk, their number and 
+ * user data. Visiting stops when it returns @b false.
+ * @param pData        User data passed to callback.
+ */
+void elropeForEachChunkEx(rope *pThis, size_t nIndex, size_t nCount, 
+	bool (*chunkForEach)(const char *p, size_t nLength, void *pData), 
+	void *pData) {
+
+	if(isInvalid(pThis) || chunkForEach == NULL)
+		return;
+
+	size_t nLength = getTotal(pThis->pRoot);
+	if(nIndex >= nLength)
+		return;
+	if(nCount > nLength - nIndex)
+		nCount = nLength - nIndex;
+
+	elropeNodeForEach(pThis->pRoot, nIndex, nIndex + nCount, chunkForEach, 
+		pData);
+}
+
+/**
+ * Callback adding chunks to hash code computation.
+ */
+static bool elropeHashChunk(const char *p, size_t nLength, 
+	strhash64 *pState) {
+
+	elstrHash64Update(pState, p, nLength);
+
+	return true;
+}
+
+/**
+ * Computes 64-bit hash code of the text without flattening it. Result is the 
+ * same as elstrGetHashCode64() returns for the same text.
+ * @param  pThis Rope.
+ * @return       Hash code.
+ */
+uint64_t elropeGetHashCode64(rope *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	size_t nLength = getTotal(pThis->pRoot);
+	strhash64 state;
+	elstrHash64Begin(&state, nLength);
+	elropeNodeForEach(pThis->pRoot, 0, nLength, 
+		EL_CB_CHUNK_FOREACH_EX(elropeHashChunk), &state);
+
+	return elstrHash64End(&state);
+}
+
+/**
+ * @brief Holds the state of substring search across chunks.
+ */
+typedef struct elrope_search {
+	strview viewSubstr; /**< Substring searched. */
+	char *pWindow; /**< Last bytes of previous chunks followed by the current 
+	chunk. */
+	size_t nWindow; /**< Number of bytes in the window. */
+	size_t nWindowStart; /**< Position of the window in the rope. */
+	size_t nFound; /**< Position found (or EL_ROPE_NPOS). */
+} elrope_search;
+
+/**
+ * Callback searching substring in the window ending by the chunk. Substring 
+ * length minus one last bytes are kept, so occurences crossing the chunk 
+ * boundaries are found too.
+ */
+static bool elropeSearchChunk(const char *p, size_t nLength, 
+	elrope_search *pSearch) {
+
+	memcpy(pSearch->pWindow + pSearch->nWindow, p, nLength);
+	pSearch->nWindow += nLength;
+
+	size_t nPos = elstrviewIndexOfView(
+		elstrviewFromBuf(pSearch->pWindow, pSearch->nWindow), 
+		pSearch->viewSubstr);
+	if(nPos != EL_STRVIEW_NPOS) {
+		pSearch->nFound = pSearch->nWindowStart + nPos;
+		return false;
+	}
+
+	size_t nKeep = pSearch->viewSubstr.nLength - 1;
+	if(pSearch->nWindow > nKeep) {
+		size_t nDrop = pSearch->nWindow - nKeep;
+		memmove(pSearch->pWindow, pSearch->pWindow + nDrop, nKeep);
+		pSearch->nWindow = nKeep;
+		pSearch->nWindowStart += nDrop;
+	}
+
+	return true;
+}
+
+/**
+ * Returns the position of the first occurence of substring starting from 
+ * the @e nIndexFrom. Text is not flattened.
+ * @param  pThis      Rope.
+ * @param  view       Substring (may contain null characters).
+ * @param  nIndexFrom Position where the search starts.
+ * @return            Position of substring (or EL_ROPE_NPOS if it's not 
+ * found or an error occured).
+ */
+size_t elropeIndexOfView(rope *pThis, strview view, size_t nIndexFrom) {
+	if(isInvalid(pThis) || view.szBuf == NULL)
+		return EL_ROPE_NPOS;
+
+	size_t nLength = getTotal(pThis->pRoot);
+	if(nIndexFrom > nLength || view.nLength > nLength - nIndexFrom)
+		return EL_ROPE_NPOS;
+
+	if(view.nLength == 0)
+		return nIndexFrom;
+
+	elrope_search search;
+	search.viewSubstr = view;
+	search.pWindow = EL_ALLOC(view.nLength - 1 + EL_ROPE_CHUNK_MAX);
+	if(search.pWindow == NULL)
+		return EL_ROPE_NPOS;
+	search.nWindow = 0;
+	search.nWindowStart = nIndexFrom;
+	search.nFound = EL_ROPE_NPOS;
+
+	elropeNodeForEach(pThis->pRoot, nIndexFrom, nLength, 
+		EL_CB_CHUNK_FOREACH_EX(elropeSearchChunk), &search);
+
+	EL_FREE(search.pWindow);
+
+	return search.nFound;
+}
+
+/**
+ * Returns the position of the first occurence of C style string starting 
+ * from the @e nIndexFrom.
+ * @param  pThis      Rope.
+ * @param  sz         C style string.
+ * @param  nIndexFrom Position where the search starts.
+ * @return            Position of substring (or EL_ROPE_NPOS if it's not 
+ * found or an error occured).
+ */
+size_t elropeIndexOfCStr(rope *pThis, const char *sz, size_t nIndexFrom) {
+	if(sz == NULL)
+		return EL_ROPE_NPOS;
+
+	return elropeIndexOfView(pThis, elstrviewFromCStr(sz), nIndexFrom);
+}
@@ -0,0 +1,110 @@
+/* Extreme Library (EL). Ropes. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#ifndef _EL_ROPE_H_
+#define _EL_ROPE_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "el_str.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Maximal number of bytes in a chunk of rope.
+ */
+#define EL_ROPE_CHUNK_MAX	1024
+
+/**
+ * Chunks shorter than this are joined with a neighbouring chunk after bytes 
+ * are removed (if they fit into one chunk).
+ */
+#define EL_ROPE_CHUNK_MIN	(EL_ROPE_CHUNK_MAX / 4)
+
+/**
+ * Position returned by rope functions when nothing is found.
+ */
+#define EL_ROPE_NPOS	SIZE_MAX
+
+/**
+ * Callback receiving chunks of rope (bytes, their number and user data).
+ */
+#define EL_CB_CHUNK_FOREACH_EX(s) (bool (*)(const char *, size_t, void *))(s)
+
+/** 
+ * @brief Holds the data of rope node. Each node keeps one chunk of text.
+ */
+typedef struct elrope_node {
+	struct elrope_node *pLeft; /**< Subtree with preceding chunks. */
+	struct elrope_node *pRight; /**< Subtree with following chunks. */
+	size_t nTotal; /**< Number of bytes in the subtree. */
+	uint32_t nPriority; /**< Random priority keeping the tree balanced. */
+	uint32_t nLength; /**< Number of bytes in the chunk. */
+	char arrChunk[EL_ROPE_CHUNK_MAX]; /**< Bytes of the chunk. */
+} elrope_node;
+
+/** 
+ * @brief Text kept as a balanced tree of chunks (treap ordered by position).
+ *
+ * Insert, delete, split and concatenation take O(log n) on average instead 
+ * of moving the tail of the text, so large texts may be edited cheaply. 
+ * Chunks are visited in order without flattening the text.
+ */
+typedef struct rope {
+	elrope_node *pRoot; /**< Root of the tree (NULL if rope is empty). */
+	uint32_t nRandom; /**< State of random generator choosing priorities. */
+} rope;
+
+rope *elropeCreate();
+rope *elropeCreateFromCStr(const char *sz);
+rope *elropeCreateFromELStr(str *pStr);
+rope *elropeCreateFromView(strview view);
+void elropeDestroy(rope *pThis);
+void elropeClear(rope *pThis);
+size_t elropeGetLength(rope *pThis);
+char elropeGetChar(rope *pThis, size_t nIndex);
+bool elropeInsertCStr(rope *pThis, size_t nIndex, const char *sz);
+bool elropeInsertELStr(rope *pThis, size_t nIndex, str *pStr);
+bool elropeInsertView(rope *pThis, size_t nIndex, strview view);
+bool elropeAppendCStr(rope *pThis, const char *sz);
+bool elropeAppendView(rope *pThis, strview view);
+bool elropePrependCStr(rope *pThis, const char *sz);
+bool elropeDelete(rope *pThis, size_t nIndex, size_t nCount);
+rope *elropeSplit(rope *pThis, size_t nIndex);
+void elropeConcat(rope *pThis, rope *pOther);
+str *elropeSubString(rope *pThis, size_t nIndex, size_t nCount);
+str *elropeToELStr(rope *pThis);
+size_t elropeCopyTo(rope *pThis, size_t nIndex, size_t nCount, char *pDest);
+void elropeForEachChunkEx(rope *pThis, size_t nIndex, size_t nCount, 
+	bool (*chunkForEach)(const char *p, size_t nLength, void *pData), 
+	void *pData);
+uint64_t elropeGetHashCode64(rope *pThis);
+size_t elropeIndexOfView(rope *pThis, strview view, size_t nIndexFrom);
+size_t elropeIndexOfCStr(rope *pThis, const char *sz, size_t nIndexFrom);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
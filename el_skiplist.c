@@ -0,0 +1,444 @@
+/* Extreme Library (EL). Skip lists. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "el_memory.h"
+
+#include "el_skiplist.h"
+
+#define isInvalid(s) ((s) == NULL)
+#define isInvalidNode(s) ((s) == NULL)
+#define destroyNode(s, pNode) { \
+	if((pNode)->pData != NULL && (s)->dataDestructor != NULL) \
+		(s)->dataDestructor((pNode)->pData); \
+	EL_FREE(pNode); }
+
+/**
+ * Creates new skip list node.
+ * @param  pData   Node data.
+ * @param  nLevels Number of levels.
+ * @return         Newly created node (or NULL if an error occured).
+ */
+static elskiplist_node *elskiplistNodeCreate(void *pData, size_t nLevels) {
+	elskiplist_node *pNode = EL_CALLOC(1, sizeof(elskiplist_node) + 
+		nLevels * sizeof(elskiplist_node *));
+
+	if(pNode != NULL) {
+		pNode->pData = pData;
+		pNode->nLevels = nLevels;
+	}
+
+	return pNode;
+}
+
+/**
+ * Chooses the number of levels for a new node. Each next level is used with 
+ * probability 1/4.
+ * @param  pThis Skip list.
+ * @return       Number of levels.
+ */
+static size_t elskiplistRandomLevels(skiplist *pThis) {
+	// xorshift32
+	uint32_t nRandom = pThis->nRandom;
+	nRandom ^= nRandom << 13;
+	nRandom ^= nRandom >> 17;
+	nRandom ^= nRandom << 5;
+	pThis->nRandom = nRandom;
+
+	size_t nLevels = 1;
+	while((nRandom & 3) == 0 && nLevels < EL_SKIPLIST_LEVELS_MAX) {
+		nLevels++;
+		nRandom >>= 2;
+	}
+
+	return nLevels;
+}
+
+/**
+ * Creates new empty skip list.
+ * @param  dataDestructor Pointer to callback function which will be called for 
+ * each item to destroy it.
+ * @param  dataOrder      Pointer to callback function which will be called to 
+ * compare item data. It should return negative value, zero or positive value 
+ * (like strcmp() does).
+ * @return                Newly created skip list (or NULL if an error 
+ * occured).
+ */
+skiplist *elskiplistCreate(void (*dataDestructor)(void *pData), 
+	int (*dataOrder)(void *p1, void *p2)) {
+
+	if(dataOrder == NULL)
+		return NULL;
+
+	skiplist *pThis = EL_CALLOC(1, sizeof(skiplist));
+	if(pThis == NULL)
+		return NULL;
+
+	pThis->pHead = elskiplistNodeCreate(NULL, EL_SKIPLIST_LEVELS_MAX);
+	if(pThis->pHead == NULL) {
+		EL_FREE(pThis);
+		return NULL;
+	}
+
+	pThis->nLevels = 1;
+	pThis->nRandom = 2463534242u;
+	pThis->dataDestructor = dataDestructor;
+	pThis->dataOrder = dataOrder;
+
+	return pThis;
+}
+
+/**
+ * Destroys all nodes of skip list. Doesn't change the state of the list.
+ * @param  pThis Skip list.
+ */
+static void elskiplistAllNodesDestroy(skiplist *pThis) {
+	elskiplist_node *pNode = pThis->pHead->pNext[0];
+
+	while(pNode != NULL) {
+		elskiplist_node *pNext = pNode->pNext[0];
+
+		destroyNode(pThis, pNode);
+
+		pNode = pNext;
+	}
+}
+
+/**
+ * Destroys the skip list.
+ * @param pThis Skip list to be destroyed.
+ */
+void elskiplistDestroy(skiplist *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	elskiplistAllNodesDestroy(pThis);
+
+	EL_FREE(pThis->pHead);
+	EL_FREE(pThis);
+}
+
+/**
+ * Returns number of nodes in the list.
+ * @param  pThis Skip list.
+ * @return       Number of nodes in the list.
+ */
+size_t elskiplistGetCount(skiplist *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	return pThis->nCount;
+}
+
+/**
+ * Clears the skip list.
+ * @param  pThis Skip list.
+ * @return       True if operation was successful.
+ */
+bool elskiplistClear(skiplist *pThis) {
+	if(isInvalid(pThis))
+		return false;
+
+	elskiplistAllNodesDestroy(pThis);
+
+	for(size_t i = 0; i < EL_SKIPLIST_LEVELS_MAX; i++)
+		pThis->pHead->pNext[i] = NULL;
+	pThis->pTail = NULL;
+	pThis->nCount = 0;
+	pThis->nLevels = 1;
+
+	return true;
+}
+
+/**
+ * Finds for each level the last node which data is less than (or not greater 
+ * than if @e bInclusive is set) the data specified.
+ * @param  pThis      Skip list.
+ * @param  pData      Data to search.
+ * @param  bInclusive If set - nodes equal to @e pData are also passed.
+ * @param  pUpdate    An array of found nodes (one per level). May be NULL.
+ * @return            Found node of the lowest level.
+ */
+static elskiplist_node *elskiplistSearchPrev(skiplist *pThis, void *pData, 
+	bool bInclusive, elskiplist_node **pUpdate) {
+
+	elskiplist_node *pNode = pThis->pHead;
+
+	for(size_t i = pThis->nLevels; i-- > 0; ) {
+		elskiplist_node *pNext = pNode->pNext[i];
+		while(pNext != NULL) {
+			int nOrder = pThis->dataOrder(pNext->pData, pData);
+			if(nOrder > 0 || (nOrder == 0 && !bInclusive))
+				break;
+			pNode = pNext;
+			pNext = pNode->pNext[i];
+		}
+		if(pUpdate != NULL)
+			pUpdate[i] = pNode;
+	}
+
+	return pNode;
+}
+
+/**
+ * Inserts the data into the skip list keeping the list sorted. If the list 
+ * already contains equal items, new item is placed after them.
+ * <br> Complexity of this function is O(log n) on average.
+ * @param  pThis Skip list.
+ * @param  pData Data to be added to the list.
+ * @return       Newly created node (or NULL if an error occured).
+ */
+elskiplist_node *elskiplistInsert(skiplist *pThis, void *pData) {
+	if(isInvalid(pThis))
+		return NULL;
+
+	elskiplist_node *pUpdate[EL_SKIPLIST_LEVELS_MAX];
+	elskiplistSearchPrev(pThis, pData, true, pUpdate);
+
+	size_t nLevels = elskiplistRandomLevels(pThis);
+	elskiplist_node *pNode = elskiplistNodeCreate(pData, nLevels);
+	if(pNode == NULL)
+		return NULL;
+
+	for(; pThis->nLevels < nLevels; pThis->nLevels++)
+		pUpdate[pThis->nLevels] = pThis->pHead;
+
+	for(size_t i = 0; i < nLevels; i++) {
+		pNode->pNext[i] = pUpdate[i]->pNext[i];
+		pUpdate[i]->pNext[i] = pNode;
+	}
+
+	pNode->pPrev = pUpdate[0] == pThis->pHead ? NULL : pUpdate[0];
+	if(pNode->pNext[0] != NULL)
+		pNode->pNext[0]->pPrev = pNode;
+	else
+		pThis->pTail = pNode;
+
+	pThis->nCount++;
+
+	return pNode;
+}
+
+/**
+ * Returns the first node which data is not less than the data specified.
+ * <br> Complexity of this function is O(log n) on average.
+ * @param  pThis Skip list.
+ * @param  pData Data to search.
+ * @return       Found node or NULL if all items are less than @e pData or an 
+ * error occured.
+ */
+elskiplist_node *elskiplistLowerBound(skiplist *pThis, void *pData) {
+	if(isInvalid(pThis))
+		return NULL;
+
+	return elskiplistSearchPrev(pThis, pData, false, NULL)->pNext[0];
+}
+
+/**
+ * Returns the first node which data is greater than the data specified.
+ * <br> Complexity of this function is O(log n) on average.
+ * @param  pThis Skip list.
+ * @param  pData Data to search.
+ * @return       Found node or NULL if no items are greater than @e pData or an
+ * error occured.
+ */
+elskiplist_node *elskiplistUpperBound(skiplist *pThis, void *pData) {
+	if(isInvalid(pThis))
+		return NULL;
+
+	return elskiplistSearchPrev(pThis, pData, true, NULL)->pNext[0];
+}
+
+/**
+ * Searches for the first node containing the data equal to specified.
+ * <br> Complexity of this function is O(log n) on average.
+ * @param  pThis Skip list.
+ * @param  pData Data to search.
+ * @return       First node containing the data equal to specified. Returns 
+ * NULL if the node is not found or an error occured.
+ */
+elskiplist_node *elskiplistFind(skiplist *pThis, void *pData) {
+	elskiplist_node *pNode = elskiplistLowerBound(pThis, pData);
+
+	if(pNode != NULL && pThis->dataOrder(pNode->pData, pData) == 0)
+		return pNode;
+
+	return NULL;
+}
+
+/**
+ * Removes the node from all levels and destroys it.
+ * @param pThis   Skip list.
+ * @param pNode   Node to be removed.
+ * @param pUpdate Nodes preceding @e pNode at each of its levels.
+ */
+static void elskiplistUnlink(skiplist *pThis, elskiplist_node *pNode, 
+	elskiplist_node **pUpdate) {
+
+	for(size_t i = 0; i < pNode->nLevels; i++)
+		pUpdate[i]->pNext[i] = pNode->pNext[i];
+
+	if(pNode->pNext[0] != NULL)
+		pNode->pNext[0]->pPrev = pNode->pPrev;
+	else
+		pThis->pTail = pNode->pPrev;
+
+	while(pThis->nLevels > 1 && pThis->pHead->pNext[pThis->nLevels - 1] == NULL)
+		pThis->nLevels--;
+
+	pThis->nCount--;
+
+	destroyNode(pThis, pNode);
+}
+
+/**
+ * Searches for the first node containing the data equal to specified and 
+ * removes it from the list.
+ * <br> Complexity of this function is O(log n) on average.
+ * @param  pThis Skip list.
+ * @param  pData The data of node to be removed.
+ * @return       True if node was actually removed.
+ */
+bool elskiplistRemove(skiplist *pThis, void *pData) {
+	if(isInvalid(pThis))
+		return false;
+
+	elskiplist_node *pUpdate[EL_SKIPLIST_LEVELS_MAX];
+	elskiplist_node *pNode = elskiplistSearchPrev(pThis, pData, false, 
+		pUpdate)->pNext[0];
+
+	if(pNode == NULL || pThis->dataOrder(pNode->pData, pData) != 0)
+		return false;
+
+	elskiplistUnlink(pThis, pNode, pUpdate);
+
+	return true;
+}
+
+/**
+ * Removes the node specified from the list.
+ * <br> Complexity of this function is O(log n) on average (plus the number of 
+ * items equal to the node's data).
+ * @param  pThis Skip list.
+ * @param  pNode Node to be removed.
+ * @return       True if node was actually removed.
+ */
+bool elskiplistRemoveNode(skiplist *pThis, elskiplist_node *pNode) {
+	if(isInvalid(pThis))
+		return false;
+
+	if(isInvalidNode(pNode))
+		return false;
+
+	elskiplist_node *pUpdate[EL_SKIPLIST_LEVELS_MAX];
+	elskiplistSearchPrev(pThis, pNode->pData, false, pUpdate);
+
+	// Node may be preceded by equal items, skip them
+	for(size_t i = 0; i < pNode->nLevels; i++)
+		while(pUpdate[i]->pNext[i] != pNode) {
+			if(pUpdate[i]->pNext[i] == NULL)
+				return false;
+			pUpdate[i] = pUpdate[i]->pNext[i];
+		}
+
+	elskiplistUnlink(pThis, pNode, pUpdate);
+
+	return true;
+}
+
+/**
+ * Returns a first (smallest) node of skip list.
+ * @param  pThis Skip list.
+ * @return       First node. Returns NULL if the list is empty or an error 
+ * occured.
+ */
+elskiplist_node *elskiplistGetFirstNode(skiplist *pThis) {
+	if(isInvalid(pThis))
+		return NULL;
+
+	return pThis->pHead->pNext[0];
+}
+
+/**
+ * Returns a last (greatest) node of skip list.
+ * @param  pThis Skip list.
+ * @return       Last node. Returns NULL if the list is empty or an error 
+ * occured.
+ */
+elskiplist_node *elskiplistGetLastNode(skiplist *pThis) {
+	if(isInvalid(pThis))
+		return NULL;
+
+	return pThis->pTail;
+}
+
+/**
+ * Returns the node following the node specified.
+ * @param  pNode Skip list node.
+ * @return       Next node or NULL if @e pNode is the last one.
+ */
+elskiplist_node *elskiplistNodeNext(elskiplist_node *pNode) {
+	if(isInvalidNode(pNode))
+		return NULL;
+
+	return pNode->pNext[0];
+}
+
+/**
+ * Returns the node preceding the node specified.
+ * @param  pNode Skip list node.
+ * @return       Previous node or NULL if @e pNode is the first one.
+ */
+elskiplist_node *elskiplistNodePrev(elskiplist_node *pNode) {
+	if(isInvalidNode(pNode))
+		return NULL;
+
+	return pNode->pPrev;
+}
+
+/**
+ * Iterates in ascending order through items of the skip list which are not 
+ * less than @e pFrom and less than @e pTo, and calls specified function for 
+ * each of them. Passes the pointer to custom data to the callback function.
+ * If function returns @b false - stops iteration.
+ * @param pThis          Skip list.
+ * @param pFrom          Lower bound of the range (inclusive). If NULL - 
+ * iteration starts from the first item.
+ * @param pTo            Upper bound of the range (exclusive). If NULL - 
+ * iteration continues up to the last item.
+ * @param dataCallbackEx Callback function to be called for each item.
+ * @param pEx            Pointer to custom data to be sent to callback.
+ */
+void elskiplistForEachRange(skiplist *pThis, void *pFrom, void *pTo, 
+	bool (*dataCallbackEx)(void *pData, void *pEx), void *pEx) {
+
+	if(isInvalid(pThis))
+		return;
+
+	if(dataCallbackEx == NULL)
+		return;
+
+	elskiplist_node *pNode = pFrom != NULL ? 
+		elskiplistLowerBound(pThis, pFrom) : pThis->pHead->pNext[0];
+
+	for(; pNode != NULL; pNode = pNode->pNext[0]) {
+		if(pTo != NULL && pThis->dataOrder(pNode->pData, pTo) >= 0)
+			break;
+		if(!dataCallbackEx(pNode->pData, pEx))
+			break;
+	}
+}
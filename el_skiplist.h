@@ -0,0 +1,88 @@
+/* Extreme Library (EL). Skip lists. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _EL_SKIPLIST_H_
+#define _EL_SKIPLIST_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "el_dlist.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Maximal number of levels of skip list.
+ */
+#define EL_SKIPLIST_LEVELS_MAX	32
+
+/** 
+ * @brief Holds the data of skip list node.
+ */
+typedef struct elskiplist_node {
+	void *pData; /**< Pointer to the data of this node. */
+	struct elskiplist_node *pPrev; /**< Pointer to previous node. */
+	size_t nLevels; /**< Number of levels this node is linked at. */
+	struct elskiplist_node *pNext[]; /**< Pointers to next nodes (one per 
+	level). */
+} elskiplist_node;
+
+/** 
+ * @brief Ordered container based on skip list.
+ *
+ * Items are kept sorted by the three-way comparer. Items which are equal keep 
+ * the order of insertion. Insert, search and removal take O(log n) on average.
+ */
+typedef struct skiplist {
+	elskiplist_node *pHead; /**< Head node (holds no data). */
+	elskiplist_node *pTail; /**< Pointer to the last node. */
+	size_t nCount; /**< Number of elements in the list. */
+	size_t nLevels; /**< Number of levels currently used. */
+	uint32_t nRandom; /**< State of random generator choosing node levels. */
+	void (*dataDestructor)(void *pData); /**< Pointer to callback which 
+	destroys data. */
+	int (*dataOrder)(void *p1, void *p2); /**< Pointer to callback which 
+	compares 2 data items. */
+} skiplist;
+
+skiplist *elskiplistCreate(void (*dataDestructor)(void *pData), 
+	int (*dataOrder)(void *p1, void *p2));
+void elskiplistDestroy(skiplist *pThis);
+size_t elskiplistGetCount(skiplist *pThis);
+bool elskiplistClear(skiplist *pThis);
+elskiplist_node *elskiplistInsert(skiplist *pThis, void *pData);
+elskiplist_node *elskiplistFind(skiplist *pThis, void *pData);
+elskiplist_node *elskiplistLowerBound(skiplist *pThis, void *pData);
+elskiplist_node *elskiplistUpperBound(skiplist *pThis, void *pData);
+bool elskiplistRemove(skiplist *pThis, void *pData);
+bool elskiplistRemoveNode(skiplist *pThis, elskiplist_node *pNode);
+elskiplist_node *elskiplistGetFirstNode(skiplist *pThis);
+elskiplist_node *elskiplistGetLastNode(skiplist *pThis);
+elskiplist_node *elskiplistNodeNext(elskiplist_node *pNode);
+elskiplist_node *elskiplistNodePrev(elskiplist_node *pNode);
+void elskiplistForEachRange(skiplist *pThis, void *pFrom, void *pTo, 
+	bool (*dataCallbackEx)(void *pData, void *pEx), void *pEx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
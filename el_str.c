@@ -21,10 +21,19 @@
 #include <stdarg.h>
 #include <wchar.h>
 #include <stdint.h>
+#include <stdatomic.h>
 
 #include "el_memory.h"
+#include "el_cpu.h"
 
 #include "el_str.h"
+#include "el_strops.h"
+#include "el_numfmt.h"
+#include "el_parallel.h"
+
+#if EL_CPU_X86
+#include <immintrin.h>
+#endif
 
 /**
  * Number of bits in @e str.nExtra used by flags.
@@ -666,6 +675,147 @@ uint_fast32_t elstrGetHashCode(str *pThis) {
     return nHash;
 }
 
+/**
+ * Multiplies two 64-bit values and folds the 128-bit product into 64 bits.
+ * @param  nA First value.
+ * @param  nB Second value.
+ * @return    High half of the product XOR-ed with the low one.
+ */
+static inline uint64_t elstrHashMix64(uint64_t nA, uint64_t nB) {
+#ifdef __SIZEOF_INT128__
+	unsigned __int128 nProduct = (unsigned __int128)nA * nB;
+	return (uint64_t)nProduct ^ (uint64_t)(nProduct >> 64);
+#else
+	uint64_t nLow = nA * nB;
+	uint64_t nHigh = ((nA >> 32) * (nB >> 32)) + 
+		(((nA >> 32) * (nB & 0xFFFFFFFF)) >> 32) + 
+		(((nA & 0xFFFFFFFF) * (nB >> 32)) >> 32);
+	return nLow ^ nHigh;
+#endif
+}
+
+/**
+ * Reads 8 bytes (in any alignment) as a 64-bit value.
+ */
+static inline uint64_t elstrHashRead64(const char *p) {
+	uint64_t nValue;
+	memcpy(&nValue, p, sizeof(nValue));
+	return nValue;
+}
+
+/**
+ * Computes 64-bit hash code of the bytes. 16 bytes are mixed at once by 
+ * 64x64->128 bit multiplication.
+ * @param  p       Bytes.
+ * @param  nLength Number of bytes.
+ * @return         Hash code.
+ */
+static uint64_t elstrHashBytes64(const char *p, size_t nLength) {
+	const uint64_t nK0 = 0xA0761D6478BD642Full;
+	const uint64_t nK1 = 0xE7037ED1A0B428DBull;
+	const uint64_t nK2 = 0x8EBC6AF09C88C6E3ull;
+
+	uint64_t nHash = nK0 ^ elstrHashMix64((uint64_t)nLength ^ nK1, nK2);
+	for(; nLength >= 16; p += 16, nLength -= 16)
+		nHash = elstrHashMix64(elstrHashRead64(p) ^ nK1, 
+			elstrHashRead64(p + 8) ^ nHash);
+
+	char arrTail[16] = { 0 };
+	memcpy(arrTail, p, nLength);
+	nHash = elstrHashMix64(elstrHashRead64(arrTail) ^ nK1, 
+		elstrHashRead64(arrTail + 8) ^ nHash);
+
+	return elstrHashMix64(nHash ^ nK2, nHash ^ nK0);
+}
+
+/**
+ * Computes and returns 64-bit hash code of dynamic string. Unlike 
+ * elstrGetHashCode() it processes 16 bytes at once and all bits of the result 
+ * are well mixed, so it suits hash tables and Bloom filters.
+ * @param  pThis Dynamic string.
+ * @return       Hash code of the string.
+ */
+uint64_t elstrGetHashCode64(str *pThis) {
+	if(isNaS(pThis))
+		return 0;
+
+	return elstrHashBytes64(pThis->szBuf, pThis->nLength);
+}
+
+/**
+ * Starts computing 64-bit hash code of bytes which come in parts (the result 
+ * is the same as elstrGetHashCode64() returns for all parts joined).
+ * @param pState  State of hash computation.
+ * @param nLength Total number of bytes which will be hashed.
+ */
+void elstrHash64Begin(strhash64 *pState, size_t nLength) {
+	const uint64_t nK0 = 0xA0761D6478BD642Full;
+	const uint64_t nK1 = 0xE7037ED1A0B428DBull;
+	const uint64_t nK2 = 0x8EBC6AF09C88C6E3ull;
+
+	pState->nHash = nK0 ^ elstrHashMix64((uint64_t)nLength ^ nK1, nK2);
+	pState->nTail = 0;
+}
+
+/**
+ * Adds next part of bytes to 64-bit hash code computation.
+ * @param pState  State of hash computation.
+ * @param p       Bytes.
+ * @param nLength Number of bytes.
+ */
+void elstrHash64Update(strhash64 *pState, const char *p, size_t nLength) {
+	const uint64_t nK1 = 0xE7037ED1A0B428DBull;
+
+	if(pState->nTail > 0) {
+		size_t nCopy = 16 - pState->nTail;
+		if(nCopy > nLength)
+			nCopy = nLength;
+		memcpy(pState->arrTail + pState->nTail, p, nCopy);
+		pState->nTail += nCopy;
+		p += nCopy;
+		nLength -= nCopy;
+		// block is mixed only when more bytes follow, the last one is mixed 
+		// by elstrHash64End()
+		if(pState->nTail < 16 || nLength == 0)
+			return;
+		pState->nHash = elstrHashMix64(elstrHashRead64(pState->arrTail) ^ nK1, 
+			elstrHashRead64(pState->arrTail + 8) ^ pState->nHash);
+		pState->nTail = 0;
+	}
+
+	for(; nLength > 16; p += 16, nLength -= 16)
+		pState->nHash = elstrHashMix64(elstrHashRead64(p) ^ nK1, 
+			elstrHashRead64(p + 8) ^ pState->nHash);
+
+	memcpy(pState->arrTail, p, nLength);
+	pState->nTail = nLength;
+}
+
+/**
+ * Finishes 64-bit hash code computation.
+ * @param  pState State of hash computation.
+ * @return        Hash code of all bytes added.
+ */
+uint64_t elstrHash64End(strhash64 *pState) {
+	const uint64_t nK0 = 0xA0761D6478BD642Full;
+	const uint64_t nK1 = 0xE7037ED1A0B428DBull;
+	const uint64_t nK2 = 0x8EBC6AF09C88C6E3ull;
+
+	uint64_t nHash = pState->nHash;
+	// full last block is mixed as is and followed by an empty tail
+	if(pState->nTail == 16) {
+		nHash = elstrHashMix64(elstrHashRead64(pState->arrTail) ^ nK1, 
+			elstrHashRead64(pState->arrTail + 8) ^ nHash);
+		pState->nTail = 0;
+	}
+
+	memset(pState->arrTail + pState->nTail, 0, 16 - pState->nTail);
+	nHash = elstrHashMix64(elstrHashRead64(pState->arrTail) ^ nK1, 
+		elstrHashRead64(pState->arrTail + 8) ^ nHash);
+
+	return elstrHashMix64(nHash ^ nK2, nHash ^ nK0);
+}
+
 /**
  * Creates new string from the substring of dynamic string.
  * @note 
@@ -937,6 +1087,243 @@ void elstrAppendPrintfELStrFormat(str *pThis, str *pStrFormat, ...) {
 	}
 }
 
+/**
+ * Checks if the view points into the data buffer of dynamic string (so it may 
+ * be changed or moved when the string is changed).
+ * @param  pThis Dynamic string.
+ * @param  view  View.
+ * @return       @b True if the view overlaps the data buffer.
+ */
+static bool elstrViewOverlaps(str *pThis, strview view) {
+	uintptr_t nStart = (uintptr_t)pThis->szBuf;
+	uintptr_t nViewStart = (uintptr_t)view.szBuf;
+
+	return nViewStart < nStart + pThis->nCapacity && 
+		nViewStart + view.nLength > nStart;
+}
+
+/**
+ * Reserves room for bytes appended to the dynamic string. Buffer of variable 
+ * size string grows at least twice, so series of appends take linear time.
+ * @param  pThis  Dynamic string.
+ * @param  nCount Number of bytes to append.
+ * @return        Pointer to the end of string (or NULL if an error occured, 
+ * string becomes NaS then).
+ */
+static char *elstrReserveAppend(str *pThis, size_t nCount) {
+	if(isNaS(pThis))
+		return NULL;
+
+	size_t nCapacity = pThis->nLength + nCount + 1;
+	if(pThis->nCapacity < nCapacity && !isFixed(pThis) && 
+		nCapacity < pThis->nCapacity * 2)
+		nCapacity = pThis->nCapacity * 2;
+
+	elstrEnsureCapacity(pThis, nCapacity);
+	if(isNaS(pThis))
+		return NULL;
+
+	return pThis->szBuf + pThis->nLength;
+}
+
+/**
+ * Completes append started by elstrReserveAppend().
+ * @param pThis  Dynamic string.
+ * @param nCount Number of bytes appended.
+ */
+static inline void elstrCommitAppend(str *pThis, size_t nCount) {
+	pThis->nLength += nCount;
+	pThis->szBuf[pThis->nLength] = '\0';
+
+	clearMBLength(pThis);
+}
+
+/**
+ * Appends bytes formatted in the temporary buffer.
+ * @param pThis  Dynamic string.
+ * @param p      Bytes.
+ * @param nCount Number of bytes.
+ */
+static inline void elstrAppendBuf(str *pThis, const char *p, size_t nCount) {
+	char *pDest = elstrReserveAppend(pThis, nCount);
+	if(pDest == NULL)
+		return;
+
+	memcpy(pDest, p, nCount);
+	elstrCommitAppend(pThis, nCount);
+}
+
+/**
+ * Appends signed integer in decimal to the dynamic string (without 
+ * formatting by printf()).
+ * @param pThis  Dynamic string.
+ * @param nValue Value.
+ */
+void elstrAppendInt64(str *pThis, int64_t nValue) {
+	char arrBuf[EL_NUMFMT_INT64_MAX];
+	elstrAppendBuf(pThis, arrBuf, elnumfmtInt64(arrBuf, nValue));
+}
+
+/**
+ * Appends unsigned integer in decimal to the dynamic string.
+ * @param pThis  Dynamic string.
+ * @param nValue Value.
+ */
+void elstrAppendUInt64(str *pThis, uint64_t nValue) {
+	char arrBuf[EL_NUMFMT_INT64_MAX];
+	elstrAppendBuf(pThis, arrBuf, elnumfmtUInt64(arrBuf, nValue));
+}
+
+/**
+ * Appends unsigned integer in hex (without prefix) to the dynamic string.
+ * @param pThis      Dynamic string.
+ * @param nValue     Value.
+ * @param nMinDigits Minimal number of digits (value is padded with zeros, no 
+ * more than 16).
+ * @param bUpper     If @b true, upper case letters are used.
+ */
+void elstrAppendHex(str *pThis, uint64_t nValue, size_t nMinDigits, 
+	bool bUpper) {
+
+	char arrBuf[EL_NUMFMT_HEX_MAX];
+	elstrAppendBuf(pThis, arrBuf, 
+		elnumfmtHex(arrBuf, nValue, nMinDigits, bUpper));
+}
+
+/**
+ * Appends the shortest decimal form of double which reads back into the same 
+ * value to the dynamic string (see elnumfmtDouble()).
+ * @param pThis  Dynamic string.
+ * @param fValue Value.
+ */
+void elstrAppendDouble(str *pThis, double fValue) {
+	char arrBuf[EL_NUMFMT_DOUBLE_MAX];
+	elstrAppendBuf(pThis, arrBuf, elnumfmtDouble(arrBuf, fValue));
+}
+
+/**
+ * Appends double with fixed number of decimals to the dynamic string. 
+ * Result is the same as printf("%.*f") gives.
+ * @param pThis     Dynamic string.
+ * @param fValue    Value.
+ * @param nDecimals Number of digits after decimal point.
+ */
+void elstrAppendDoubleFixed(str *pThis, double fValue, size_t nDecimals) {
+	char arrBuf[80];
+	size_t nCount = elnumfmtDoubleFixed(arrBuf, sizeof(arrBuf), fValue, 
+		nDecimals);
+	if(nCount < sizeof(arrBuf)) {
+		elstrAppendBuf(pThis, arrBuf, nCount);
+		return;
+	}
+
+	// long results are formatted right into the string
+	char *p = elstrReserveAppend(pThis, nCount);
+	if(p == NULL)
+		return;
+
+	elnumfmtDoubleFixed(p, nCount + 1, fValue, nDecimals);
+	elstrCommitAppend(pThis, nCount);
+}
+
+/**
+ * Appends "true" or "false" to the dynamic string.
+ * @param pThis  Dynamic string.
+ * @param bValue Value.
+ */
+void elstrAppendBool(str *pThis, bool bValue) {
+	if(bValue)
+		elstrAppendBuf(pThis, "true", 4);
+	else
+		elstrAppendBuf(pThis, "false", 5);
+}
+
+/**
+ * Appends bytes of the view padded to the width of the field.
+ * @param pThis      Dynamic string.
+ * @param view       View.
+ * @param nWidth     Minimal width of the field (longer views are not cut).
+ * @param chPad      Character filling the rest of the field.
+ * @param bAlignLeft If @b true, padding follows the view, otherwise it 
+ * precedes the view.
+ */
+void elstrAppendPaddedView(str *pThis, strview view, size_t nWidth, 
+	char chPad, bool bAlignLeft) {
+
+	if(pThis == NULL || view.szBuf == NULL)
+		return;
+
+	// view of the string itself is moved together with its buffer
+	bool bOverlaps = elstrViewOverlaps(pThis, view);
+	size_t nOffset = bOverlaps ? (size_t)(view.szBuf - pThis->szBuf) : 0;
+
+	size_t nPad = nWidth > view.nLength ? nWidth - view.nLength : 0;
+	char *p = elstrReserveAppend(pThis, view.nLength + nPad);
+	if(p == NULL)
+		return;
+	if(bOverlaps)
+		view.szBuf = pThis->szBuf + nOffset;
+
+	if(bAlignLeft) {
+		memcpy(p, view.szBuf, view.nLength);
+		memset(p + view.nLength, chPad, nPad);
+	} else {
+		memset(p, chPad, nPad);
+		memcpy(p + nPad, view.szBuf, view.nLength);
+	}
+
+	elstrCommitAppend(pThis, view.nLength + nPad);
+}
+
+/**
+ * Appends C style string padded to the width of the field.
+ * @param pThis      Dynamic string.
+ * @param sz         C style string.
+ * @param nWidth     Minimal width of the field.
+ * @param chPad      Character filling the rest of the field.
+ * @param bAlignLeft If @b true, padding follows the string, otherwise it 
+ * precedes the string.
+ */
+void elstrAppendPaddedCStr(str *pThis, const char *sz, size_t nWidth, 
+	char chPad, bool bAlignLeft) {
+
+	if(sz == NULL)
+		return;
+
+	elstrAppendPaddedView(pThis, elstrviewFromCStr(sz), nWidth, chPad, 
+		bAlignLeft);
+}
+
+/**
+ * Appends signed integer right aligned in the field. If the field is padded 
+ * with zeros, minus sign precedes them (like printf("%05d") does).
+ * @param pThis  Dynamic string.
+ * @param nValue Value.
+ * @param nWidth Minimal width of the field.
+ * @param chPad  Character filling the rest of the field.
+ */
+void elstrAppendInt64Padded(str *pThis, int64_t nValue, size_t nWidth, 
+	char chPad) {
+
+	char arrBuf[EL_NUMFMT_INT64_MAX];
+	size_t nCount = elnumfmtInt64(arrBuf, nValue);
+	size_t nPad = nWidth > nCount ? nWidth - nCount : 0;
+
+	char *p = elstrReserveAppend(pThis, nCount + nPad);
+	if(p == NULL)
+		return;
+
+	size_t nSign = 0;
+	if(chPad == '0' && nValue < 0) {
+		*p = '-';
+		nSign = 1;
+	}
+	memset(p + nSign, chPad, nPad);
+	memcpy(p + nSign + nPad, arrBuf + nSign, nCount - nSign);
+
+	elstrCommitAppend(pThis, nCount + nPad);
+}
+
 /**
  * Inserts the specified C string at the specified index of this string.
  * @param pThis  Dynamic string.
@@ -1013,17 +1400,8 @@ size_t elstrDeleteChar(str *pThis, char ch) {
 	if(pThis->nLength == 0)
 		return 0;
 
-	size_t nRemoved = 0;
-	char *pDest = pThis->szBuf;
-	char *pSrc = pDest;
-	while(pSrc - pThis->szBuf < pThis->nLength) {
-		if(*pSrc != ch) {
-			*pDest = *pSrc;
-			pDest++;
-		} else
-			nRemoved++;
-		pSrc++;
-	}
+	size_t nRemoved = pThis->nLength - 
+		elstropsDeleteChar(pThis->szBuf, pThis->nLength, ch);
 
 	elstrSetLength(pThis, pThis->nLength - nRemoved);
 
@@ -1043,19 +1421,8 @@ void elstrLTrimChars(str *pThis, char arrChars[], size_t nCountChars) {
 	if(pThis->nLength == 0 || nCountChars == 0)
 		return;
 
-	int nCount = pThis->nLength;
-	for(size_t i = 0; i < pThis->nLength; i++) {
-		bool bFound = false;
-		for(size_t j = 0; j < nCountChars; j++)
-			if(pThis->szBuf[i] == arrChars[j]) {
-				bFound = true;
-				break;
-			}
-		if(!bFound) {
-			nCount = i;
-			break;
-		}
-	}
+	size_t nCount = elstropsSpan(pThis->szBuf, pThis->nLength, arrChars, 
+		nCountChars);
 
 	if(nCount > 0)
 		elstrDelete(pThis, 0, nCount);
@@ -1083,25 +1450,11 @@ void elstrRTrimChars(str *pThis, char arrChars[], size_t nCountChars) {
 	if(pThis->nLength == 0 || nCountChars == 0)
 		return;
 
-	int nStart = 0;
-	for(int i = pThis->nLength - 1; i >= 0; i--) {
-		bool bFound = false;
-		int j;
-		for(j = 0; j < nCountChars; j++)
-			if(pThis->szBuf[i] == arrChars[j]) {
-				bFound = true;
-				break;
-			}
-		if(!bFound) {
-			nStart = i + 1;
-			break;
-		}
-	}
-
-	int nCount = pThis->nLength - nStart;
+	size_t nCount = elstropsSpanBack(pThis->szBuf, pThis->nLength, arrChars, 
+		nCountChars);
 
 	if(nCount > 0)
-		elstrDelete(pThis, nStart, nCount);
+		elstrDelete(pThis, pThis->nLength - nCount, nCount);
 }
 
 /**
@@ -1147,15 +1500,7 @@ void elstrReverse(str *pThis) {
 	if(pThis->nLength == 0)
 		return;
 
-	char *p1 = pThis->szBuf;
-	char *p2 = pThis->szBuf + pThis->nLength - 1;
-	while(p1 < p2) {
-		char ch = *p1;
-		*p1 = *p2;
-		*p2 = ch;
-		p1++;
-		p2--;
-	}
+	elstropsReverse(pThis->szBuf, pThis->nLength);
 }
 
 /**
@@ -1172,9 +1517,57 @@ void elstrReplaceChar(str *pThis, char chOld, char chNew) {
 	if(pThis->nLength == 0)
 		return;
 
-	for(int i = 0; i < pThis->nLength; i++)
-		if(pThis->szBuf[i] == chOld)
-			pThis->szBuf[i] = chNew;
+	elstropsReplaceChar(pThis->szBuf, pThis->nLength, chOld, chNew);
+}
+
+/**
+ * Converts ASCII letters of the dynamic string to upper case. Other bytes 
+ * (including parts of multibyte characters) are kept as is.
+ * @param pThis Dynamic string.
+ */
+void elstrToUpperASCII(str *pThis) {
+	if(isNaS(pThis))
+		return;
+
+	elstropsToUpper(pThis->szBuf, pThis->nLength);
+}
+
+/**
+ * Converts ASCII letters of the dynamic string to lower case. Other bytes 
+ * (including parts of multibyte characters) are kept as is.
+ * @param pThis Dynamic string.
+ */
+void elstrToLowerASCII(str *pThis) {
+	if(isNaS(pThis))
+		return;
+
+	elstropsToLower(pThis->szBuf, pThis->nLength);
+}
+
+/**
+ * Folds the case of ASCII letters of the dynamic string, so strings differing 
+ * only in case of ASCII letters become equal.
+ * @param pThis Dynamic string.
+ */
+void elstrFoldCaseASCII(str *pThis) {
+	elstrToLowerASCII(pThis);
+}
+
+/**
+ * Replaces each byte of the dynamic string by its entry of the table.
+ * @param pThis    Dynamic string.
+ * @param arrTable Table of 256 bytes indexed by unsigned byte value. Should 
+ * not map any byte to null character.
+ */
+void elstrTranslate(str *pThis, const unsigned char arrTable[256]) {
+	if(isNaS(pThis))
+		return;
+
+	if(arrTable == NULL)
+		return;
+
+	elstropsTranslate(pThis->szBuf, pThis->nLength, arrTable);
+	clearMBLength(pThis);
 }
 
 /**
@@ -1205,6 +1598,36 @@ int elstrCompareCStr(str *pThis, const char *sz) {
 	return nRes;
 }
 
+/**
+ * Compares the dynamic string with another dynamic string. Can be used as a 
+ * three-way comparer (for example by eldlistSort()).
+ * @param  pThis Dynamic string.
+ * @param  pStr  Dynamic string to compare with.
+ * @return       -1 if dynamic string is less than another one, 0 if strings 
+ * are equal, 1 if dynamic string is greater than another one. If by some 
+ * reason it's not possible to compare strings due to errors, returns 
+ * EL_STR_ERR_WRONG_STRING or EL_STR_ERR_WRONG_PARAM.
+ */
+int elstrCompareELStr(str *pThis, str *pStr) {
+	if(isNaS(pThis))
+		return EL_STR_ERR_WRONG_STRING;
+
+	if(pStr == NULL || isNaS(pStr))
+		return EL_STR_ERR_WRONG_PARAM;
+
+	size_t nMin = pThis->nLength < pStr->nLength ? pThis->nLength : 
+		pStr->nLength;
+	int nRes = memcmp(pThis->szBuf, pStr->szBuf, nMin);
+	if(nRes == 0) {
+		if(pThis->nLength < pStr->nLength)
+			nRes = -1;
+		else
+			nRes = pThis->nLength == pStr->nLength ? 0 : 1;
+	} else
+		nRes = nRes < 0 ? -1 : 1;
+	return nRes;
+}
+
 /**
  * Checks if the dynamic string is equal to C style string.
  * @param  pThis Dynamic string.
@@ -1330,11 +1753,9 @@ int elstrIndexOfChar(str *pThis, char ch) {
 	if(isNaS(pThis))
 		return -1;
 
-	for(int i = 0; i < pThis->nLength; i++)
-		if(pThis->szBuf[i] == ch)
-			return i;
+	const char *p = memchr(pThis->szBuf, ch, pThis->nLength);
 
-	return -1;
+	return p == NULL ? -1 : (int)(p - pThis->szBuf);
 }
 
 /**
@@ -1352,11 +1773,826 @@ int elstrIndexOfCharFrom(str *pThis, char ch, int nIndexFrom) {
 	if(nIndexFrom < 0 || nIndexFrom > pThis->nLength)
 		return -1;
 
-	for(int i = nIndexFrom; i < pThis->nLength; i++)
-		if(pThis->szBuf[i] == ch)
-			return i;
+	const char *p = memchr(pThis->szBuf + nIndexFrom, ch, 
+		pThis->nLength - nIndexFrom);
 
-	return -1;
+	return p == NULL ? -1 : (int)(p - pThis->szBuf);
+}
+
+/**
+ * Position returned by search routines when the substring isn't found.
+ */
+#define EL_STR_SEARCH_NPOS		SIZE_MAX
+/**
+ * Maximal length of substring searched by SIMD filter. Longer ones are 
+ * searched by Two-Way algorithm, which time is linear in the worst case.
+ */
+#define EL_STR_SEARCH_SHORT_MAX	32
+
+/**
+ * Pointer to kernel searching the substring (the first or the last occurence).
+ */
+typedef size_t (*elstr_search_kernel)(const char *pHay, size_t nHay, 
+	const char *pNeedle, size_t nNeedle);
+
+/**
+ * Kernels searching short substrings.
+ */
+typedef struct elstr_search_kernels {
+	elstr_search_kernel forward; /**< Searches the first occurence. */
+	elstr_search_kernel backward; /**< Searches the last occurence. */
+} elstr_search_kernels;
+
+/**
+ * Checks if the substring is at the candidate position where its first and 
+ * last characters already match.
+ */
+#define elstrSearchIsMatch(pHay, nPos, pNeedle, nNeedle) \
+	((nNeedle) <= 2 || \
+	memcmp((pHay) + (nPos) + 1, (pNeedle) + 1, (nNeedle) - 2) == 0)
+
+/**
+ * Searches the first occurence of short substring (portable implementation). 
+ * Candidates are found by memchr() and checked by the last character first.
+ */
+static size_t elstrSearchForwardScalar(const char *pHay, size_t nHay, 
+	const char *pNeedle, size_t nNeedle) {
+
+	size_t nLast = nHay - nNeedle;
+	const char *p = pHay;
+
+	while((p = memchr(p, pNeedle[0], nLast - (size_t)(p - pHay) + 1)) != NULL) {
+		size_t nPos = (size_t)(p - pHay);
+		if(pHay[nPos + nNeedle - 1] == pNeedle[nNeedle - 1] && 
+			elstrSearchIsMatch(pHay, nPos, pNeedle, nNeedle))
+			return nPos;
+		if(nPos == nLast)
+			break;
+		p++;
+	}
+
+	return EL_STR_SEARCH_NPOS;
+}
+
+/**
+ * Searches the last occurence of short substring (portable implementation).
+ */
+static size_t elstrSearchBackwardScalar(const char *pHay, size_t nHay, 
+	const char *pNeedle, size_t nNeedle) {
+
+	for(size_t nPos = nHay - nNeedle + 1; nPos-- > 0; )
+		if(pHay[nPos] == pNeedle[0] && 
+			pHay[nPos + nNeedle - 1] == pNeedle[nNeedle - 1] && 
+			elstrSearchIsMatch(pHay, nPos, pNeedle, nNeedle))
+			return nPos;
+
+	return EL_STR_SEARCH_NPOS;
+}
+
+/**
+ * Portable kernels.
+ */
+static const elstr_search_kernels g_searchScalar = {
+	elstrSearchForwardScalar, 
+	elstrSearchBackwardScalar
+};
+
+#if EL_CPU_X86
+
+/**
+ * Returns the mask of positions among 16 ones starting from @a pHay, where the 
+ * first and the last characters of substring match.
+ */
+__attribute__((target("sse2")))
+static inline uint32_t elstrSearchCandidatesSSE2(const char *pHay, 
+	const char *pNeedle, size_t nNeedle) {
+
+	__m128i first = _mm_set1_epi8(pNeedle[0]);
+	__m128i last = _mm_set1_epi8(pNeedle[nNeedle - 1]);
+	__m128i blockFirst = _mm_loadu_si128((const __m128i *)pHay);
+	__m128i blockLast = _mm_loadu_si128(
+		(const __m128i *)(pHay + nNeedle - 1));
+
+	return (uint32_t)_mm_movemask_epi8(_mm_and_si128(
+		_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast)));
+}
+
+/**
+ * Returns the mask of positions among 32 ones starting from @a pHay, where the 
+ * first and the last characters of substring match.
+ */
+__attribute__((target("avx2")))
+static inline uint32_t elstrSearchCandidatesAVX2(const char *pHay, 
+	const char *pNeedle, size_t nNeedle) {
+
+	__m256i first = _mm256_set1_epi8(pNeedle[0]);
+	__m256i last = _mm256_set1_epi8(pNeedle[nNeedle - 1]);
+	__m256i blockFirst = _mm256_loadu_si256((const __m256i *)pHay);
+	__m256i blockLast = _mm256_loadu_si256(
+		(const __m256i *)(pHay + nNeedle - 1));
+
+	return (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(
+		_mm256_cmpeq_epi8(first, blockFirst), 
+		_mm256_cmpeq_epi8(last, blockLast)));
+}
+
+/**
+ * Defines SIMD kernels searching the first and the last occurence of short 
+ * substring. Positions where both the first and the last characters match are 
+ * found for @e width positions at once, then only they are compared. 
+ * Positions which don't fill the whole block are checked by portable kernels.
+ */
+#define defineSearchSIMD(name, isa, width, candidates) \
+__attribute__((target(isa))) \
+static size_t name##Forward(const char *pHay, size_t nHay, \
+	const char *pNeedle, size_t nNeedle) { \
+	size_t nPos = 0; \
+	for(; nPos + nNeedle - 1 + (width) <= nHay; nPos += (width)) { \
+		uint32_t mask = candidates(pHay + nPos, pNeedle, nNeedle); \
+		for(; mask != 0; mask &= mask - 1) { \
+			size_t nFound = nPos + (size_t)__builtin_ctz(mask); \
+			if(elstrSearchIsMatch(pHay, nFound, pNeedle, nNeedle)) \
+				return nFound; \
+		} \
+	} \
+	size_t nFound = elstrSearchForwardScalar(pHay + nPos, nHay - nPos, \
+		pNeedle, nNeedle); \
+	return nFound == EL_STR_SEARCH_NPOS ? nFound : nPos + nFound; \
+} \
+__attribute__((target(isa))) \
+static size_t name##Backward(const char *pHay, size_t nHay, \
+	const char *pNeedle, size_t nNeedle) { \
+	size_t nEnd = nHay - nNeedle + 1; /* number of positions left */ \
+	for(; nEnd >= (width); nEnd -= (width)) { \
+		size_t nPos = nEnd - (width); \
+		uint32_t mask = candidates(pHay + nPos, pNeedle, nNeedle); \
+		for(; mask != 0; mask &= ~((uint32_t)1 << (31 - __builtin_clz(mask)))) {\
+			size_t nFound = nPos + 31 - (size_t)__builtin_clz(mask); \
+			if(elstrSearchIsMatch(pHay, nFound, pNeedle, nNeedle)) \
+				return nFound; \
+		} \
+	} \
+	if(nEnd == 0) \
+		return EL_STR_SEARCH_NPOS; \
+	return elstrSearchBackwardScalar(pHay, nEnd + nNeedle - 1, pNeedle, \
+		nNeedle); \
+} \
+static const elstr_search_kernels g_search##name = { \
+	name##Forward, \
+	name##Backward \
+};
+
+defineSearchSIMD(SSE2, "sse2", 16, elstrSearchCandidatesSSE2)
+defineSearchSIMD(AVX2, "avx2", 32, elstrSearchCandidatesAVX2)
+
+#endif
+
+/**
+ * Kernels chosen for the CPU (NULL until the first use).
+ */
+static const elstr_search_kernels *_Atomic g_pSearchKernels = NULL;
+
+/**
+ * Returns the kernels searching short substrings which are the best for the 
+ * CPU.
+ * @return Kernels.
+ */
+static const elstr_search_kernels *elstrGetSearchKernels() {
+	const elstr_search_kernels *pKernels = atomic_load_explicit(
+		&g_pSearchKernels, memory_order_relaxed);
+	if(pKernels != NULL)
+		return pKernels;
+
+	pKernels = &g_searchScalar;
+#if EL_CPU_X86
+	if(elcpuHas(EL_CPU_AVX2))
+		pKernels = &g_searchAVX2;
+	else if(elcpuHas(EL_CPU_SSE2))
+		pKernels = &g_searchSSE2;
+#endif
+
+	atomic_store_explicit(&g_pSearchKernels, pKernels, memory_order_relaxed);
+
+	return pKernels;
+}
+
+/**
+ * Defines the search by Two-Way algorithm (Crochemore and Perrin). Characters 
+ * are read by @e at(p, n, i), so the same code searches both forward and (in 
+ * reversed strings) backward. When nothing is matched yet, @e skip(p, n, j, 
+ * ch) moves to the next position @e j where the character @e ch is read. 
+ * Defines @e name##Factorize, which finds the critical factorization of 
+ * substring, and @e name, which returns the position of the first occurence 
+ * counted from the start of string read.
+ */
+#define defineTwoWay(name, at, skip) \
+static size_t name##Factorize(const char *pNeedle, size_t nNeedle, \
+	size_t *pPeriod) { \
+	size_t nSuffix = SIZE_MAX, j = 0, k = 1, p = 1; \
+	while(j + k < nNeedle) { \
+		unsigned char a = at(pNeedle, nNeedle, j + k); \
+		unsigned char b = at(pNeedle, nNeedle, nSuffix + k); \
+		if(a < b) { \
+			j += k; k = 1; p = j - nSuffix; \
+		} else if(a == b) { \
+			if(k != p) k++; else { j += p; k = 1; } \
+		} else { \
+			nSuffix = j++; k = p = 1; \
+		} \
+	} \
+	*pPeriod = p; \
+	size_t nSuffixRev = SIZE_MAX; \
+	j = 0; k = p = 1; \
+	while(j + k < nNeedle) { \
+		unsigned char a = at(pNeedle, nNeedle, j + k); \
+		unsigned char b = at(pNeedle, nNeedle, nSuffixRev + k); \
+		if(b < a) { \
+			j += k; k = 1; p = j - nSuffixRev; \
+		} else if(a == b) { \
+			if(k != p) k++; else { j += p; k = 1; } \
+		} else { \
+			nSuffixRev = j++; k = p = 1; \
+		} \
+	} \
+	if(nSuffixRev + 1 < nSuffix + 1) \
+		return nSuffix + 1; \
+	*pPeriod = p; \
+	return nSuffixRev + 1; \
+} \
+static size_t name(const char *pHay, size_t nHay, const char *pNeedle, \
+	size_t nNeedle) { \
+	size_t nPeriod; \
+	size_t nSuffix = name##Factorize(pNeedle, nNeedle, &nPeriod); \
+	bool bPeriodic = true; \
+	for(size_t i = 0; i < nSuffix && bPeriodic; i++) \
+		bPeriodic = at(pNeedle, nNeedle, i) == \
+			at(pNeedle, nNeedle, i + nPeriod); \
+	unsigned char chSuffix = at(pNeedle, nNeedle, nSuffix); \
+	size_t j = 0; \
+	if(bPeriodic) { \
+		/* prefix already matched is remembered after the shift by period */ \
+		size_t nMemory = 0; \
+		while(j <= nHay - nNeedle) { \
+			if(nMemory == 0) { \
+				j = skip(pHay, nHay, j + nSuffix, chSuffix) - nSuffix; \
+				if(j > nHay - nNeedle) \
+					break; \
+			} \
+			size_t i = nSuffix > nMemory ? nSuffix : nMemory; \
+			while(i < nNeedle && \
+				at(pNeedle, nNeedle, i) == at(pHay, nHay, i + j)) \
+				i++; \
+			if(i >= nNeedle) { \
+				i = nSuffix - 1; \
+				while(nMemory < i + 1 && \
+					at(pNeedle, nNeedle, i) == at(pHay, nHay, i + j)) \
+					i--; \
+				if(i + 1 < nMemory + 1) \
+					return j; \
+				j += nPeriod; \
+				nMemory = nNeedle - nPeriod; \
+			} else { \
+				j += i - nSuffix + 1; \
+				nMemory = 0; \
+			} \
+		} \
+	} else { \
+		nPeriod = (nSuffix > nNeedle - nSuffix ? nSuffix : \
+			nNeedle - nSuffix) + 1; \
+		while(j <= nHay - nNeedle) { \
+			j = skip(pHay, nHay, j + nSuffix, chSuffix) - nSuffix; \
+			if(j > nHay - nNeedle) \
+				break; \
+			size_t i = nSuffix; \
+			while(i < nNeedle && \
+				at(pNeedle, nNeedle, i) == at(pHay, nHay, i + j)) \
+				i++; \
+			if(i >= nNeedle) { \
+				i = nSuffix - 1; \
+				while(i != SIZE_MAX && \
+					at(pNeedle, nNeedle, i) == at(pHay, nHay, i + j)) \
+					i--; \
+				if(i == SIZE_MAX) \
+					return j; \
+				j += nPeriod; \
+			} else \
+				j += i - nSuffix + 1; \
+		} \
+	} \
+	return EL_STR_SEARCH_NPOS; \
+}
+
+#define elstrAtForward(p, n, i) ((unsigned char)(p)[(i)])
+#define elstrAtBackward(p, n, i) ((unsigned char)(p)[(n) - 1 - (i)])
+
+/**
+ * Returns the position of the character at or after @a nPos (or @a nHay if 
+ * it's not found) using memchr().
+ */
+static inline size_t elstrSkipForward(const char *pHay, size_t nHay, 
+	size_t nPos, unsigned char ch) {
+
+	const char *p = memchr(pHay + nPos, ch, nHay - nPos);
+	return p == NULL ? nHay : (size_t)(p - pHay);
+}
+
+/**
+ * Returns the position unchanged (reversed strings have no fast skip).
+ */
+#define elstrSkipBackward(p, n, nPos, ch) ((void)(ch), (nPos))
+
+defineTwoWay(elstrSearchTwoWayForward, elstrAtForward, elstrSkipForward)
+defineTwoWay(elstrSearchTwoWayBackward, elstrAtBackward, elstrSkipBackward)
+
+/**
+ * Searches the first occurence of substring in the buffer. Single characters 
+ * are searched by memchr(), short substrings by SIMD filter of the first and 
+ * the last characters, long ones by Two-Way algorithm.
+ * @param  pHay    Buffer where to search.
+ * @param  nHay    Length of the buffer.
+ * @param  pNeedle Substring to search.
+ * @param  nNeedle Length of the substring.
+ * @return         Position of substring (or EL_STR_SEARCH_NPOS if it's not 
+ * found).
+ */
+static size_t elstrSearch(const char *pHay, size_t nHay, const char *pNeedle, 
+	size_t nNeedle) {
+
+	if(nNeedle == 0)
+		return 0;
+	if(nNeedle > nHay)
+		return EL_STR_SEARCH_NPOS;
+
+	if(nNeedle == 1) {
+		const char *p = memchr(pHay, pNeedle[0], nHay);
+		return p == NULL ? EL_STR_SEARCH_NPOS : (size_t)(p - pHay);
+	}
+	if(nNeedle <= EL_STR_SEARCH_SHORT_MAX)
+		return elstrGetSearchKernels()->forward(pHay, nHay, pNeedle, nNeedle);
+
+	return elstrSearchTwoWayForward(pHay, nHay, pNeedle, nNeedle);
+}
+
+/**
+ * Searches the last occurence of substring in the buffer.
+ * @param  pHay    Buffer where to search.
+ * @param  nHay    Length of the buffer.
+ * @param  pNeedle Substring to search.
+ * @param  nNeedle Length of the substring.
+ * @return         Position of substring (or EL_STR_SEARCH_NPOS if it's not 
+ * found).
+ */
+static size_t elstrSearchLast(const char *pHay, size_t nHay, 
+	const char *pNeedle, size_t nNeedle) {
+
+	if(nNeedle == 0)
+		return nHay;
+	if(nNeedle > nHay)
+		return EL_STR_SEARCH_NPOS;
+
+	if(nNeedle <= EL_STR_SEARCH_SHORT_MAX)
+		return elstrGetSearchKernels()->backward(pHay, nHay, pNeedle, nNeedle);
+
+	// position in reversed string is the position of the substring's end
+	size_t nFound = elstrSearchTwoWayBackward(pHay, nHay, pNeedle, nNeedle);
+	return nFound == EL_STR_SEARCH_NPOS ? nFound : nHay - nFound - nNeedle;
+}
+
+/**
+ * Converts the position found to the index returned by IndexOf functions.
+ */
+#define elstrSearchToIndex(nPos) \
+	((nPos) == EL_STR_SEARCH_NPOS ? -1 : (int)(nPos))
+
+/**
+ * Creates the view of C string.
+ * @param  sz C string.
+ * @return    View of the string (empty if @a sz is NULL).
+ */
+strview elstrviewFromCStr(const char *sz) {
+	strview view = { sz, sz == NULL ? 0 : strlen(sz) };
+	return view;
+}
+
+/**
+ * Creates the view of buffer which may contain null characters.
+ * @param  p       Buffer.
+ * @param  nLength Length of the buffer (in bytes).
+ * @return         View of the buffer.
+ */
+strview elstrviewFromBuf(const char *p, size_t nLength) {
+	strview view = { p, p == NULL ? 0 : nLength };
+	return view;
+}
+
+/**
+ * Creates the view of dynamic string. View becomes invalid when the string 
+ * is changed or destroyed.
+ * @param  pThis Dynamic string.
+ * @return       View of the string (with NULL buffer if the string is NaS).
+ */
+strview elstrGetView(str *pThis) {
+	strview view = { NULL, 0 };
+	if(pThis != NULL && !isNaS(pThis)) {
+		view.szBuf = pThis->szBuf;
+		view.nLength = pThis->nLength;
+	}
+	return view;
+}
+
+/**
+ * Returns the position of the first occurence of substring in the view.
+ * @param  view        View where to search.
+ * @param  viewSubstr  Substring to search.
+ * @return             Position of substring (or EL_STRVIEW_NPOS if it's not 
+ * found).
+ */
+size_t elstrviewIndexOfView(strview view, strview viewSubstr) {
+	if(view.szBuf == NULL || viewSubstr.szBuf == NULL)
+		return EL_STRVIEW_NPOS;
+
+	return elstrSearch(view.szBuf, view.nLength, viewSubstr.szBuf, 
+		viewSubstr.nLength);
+}
+
+/**
+ * Returns an index of the first occurence of substring starting from the 
+ * @e nIndexFrom. Substring may contain null characters.
+ * @param  pThis      Dynamic string.
+ * @param  view       Substring to search.
+ * @param  nIndexFrom Position where to start the search.
+ * @return            An index of the substring or -1 if substring is not found 
+ * or error occured.
+ */
+int elstrIndexOfViewFrom(str *pThis, strview view, int nIndexFrom) {
+	if(isNaS(pThis) || view.szBuf == NULL)
+		return -1;
+	if(nIndexFrom < 0 || nIndexFrom > pThis->nLength)
+		return -1;
+
+	size_t nPos = elstrSearch(pThis->szBuf + nIndexFrom, 
+		pThis->nLength - nIndexFrom, view.szBuf, view.nLength);
+	if(nPos == EL_STR_SEARCH_NPOS)
+		return -1;
+
+	return (int)(nPos + nIndexFrom);
+}
+
+/**
+ * Returns an index of the first occurence of substring. Substring may contain 
+ * null characters.
+ * @param  pThis Dynamic string.
+ * @param  view  Substring to search.
+ * @return       An index of the substring or -1 if substring is not found or 
+ * error occured.
+ */
+int elstrIndexOfView(str *pThis, strview view) {
+	return elstrIndexOfViewFrom(pThis, view, 0);
+}
+
+/**
+ * Returns an index of the first occurence of C string.
+ * @param  pThis Dynamic string.
+ * @param  sz    C string to search.
+ * @return       An index of the substring or -1 if substring is not found or 
+ * error occured.
+ */
+int elstrIndexOfCStr(str *pThis, const char *sz) {
+	return elstrIndexOfViewFrom(pThis, elstrviewFromCStr(sz), 0);
+}
+
+/**
+ * Returns an index of the first occurence of dynamic string.
+ * @param  pThis Dynamic string.
+ * @param  pStr  Dynamic string to search.
+ * @return       An index of the substring or -1 if substring is not found or 
+ * error occured.
+ */
+int elstrIndexOfELStr(str *pThis, str *pStr) {
+	return elstrIndexOfViewFrom(pThis, elstrGetView(pStr), 0);
+}
+
+/**
+ * Returns an index of the last occurence of substring. Substring may contain 
+ * null characters.
+ * @param  pThis Dynamic string.
+ * @param  view  Substring to search.
+ * @return       An index of the substring or -1 if substring is not found or 
+ * error occured.
+ */
+int elstrLastIndexOfView(str *pThis, strview view) {
+	if(isNaS(pThis) || view.szBuf == NULL)
+		return -1;
+
+	return elstrSearchToIndex(elstrSearchLast(pThis->szBuf, pThis->nLength, 
+		view.szBuf, view.nLength));
+}
+
+/**
+ * Returns an index of the last occurence of C string.
+ * @param  pThis Dynamic string.
+ * @param  sz    C string to search.
+ * @return       An index of the substring or -1 if substring is not found or 
+ * error occured.
+ */
+int elstrLastIndexOfCStr(str *pThis, const char *sz) {
+	return elstrLastIndexOfView(pThis, elstrviewFromCStr(sz));
+}
+
+/**
+ * Returns an index of the last occurence of dynamic string.
+ * @param  pThis Dynamic string.
+ * @param  pStr  Dynamic string to search.
+ * @return       An index of the substring or -1 if substring is not found or 
+ * error occured.
+ */
+int elstrLastIndexOfELStr(str *pThis, str *pStr) {
+	return elstrLastIndexOfView(pThis, elstrGetView(pStr));
+}
+
+/**
+ * Checks if the dynamic string contains the substring.
+ * @param  pThis Dynamic string.
+ * @param  view  Substring to search.
+ * @return       @b True if the substring is found.
+ */
+bool elstrContainsView(str *pThis, strview view) {
+	return elstrIndexOfViewFrom(pThis, view, 0) >= 0;
+}
+
+/**
+ * Checks if the dynamic string contains C string.
+ * @param  pThis Dynamic string.
+ * @param  sz    C string to search.
+ * @return       @b True if the substring is found.
+ */
+bool elstrContainsCStr(str *pThis, const char *sz) {
+	return elstrContainsView(pThis, elstrviewFromCStr(sz));
+}
+
+/**
+ * Checks if the dynamic string contains another dynamic string.
+ * @param  pThis Dynamic string.
+ * @param  pStr  Dynamic string to search.
+ * @return       @b True if the substring is found.
+ */
+bool elstrContainsELStr(str *pThis, str *pStr) {
+	return elstrContainsView(pThis, elstrGetView(pStr));
+}
+
+/**
+ * Counts non-overlapping occurences of substring.
+ * @param  pThis Dynamic string.
+ * @param  view  Substring to search (empty substring is never counted).
+ * @return       Number of occurences.
+ */
+size_t elstrCountView(str *pThis, strview view) {
+	if(isNaS(pThis) || view.szBuf == NULL || view.nLength == 0)
+		return 0;
+
+	size_t nCount = 0;
+	size_t nStart = 0;
+	size_t nPos;
+	while((nPos = elstrSearch(pThis->szBuf + nStart, pThis->nLength - nStart, 
+		view.szBuf, view.nLength)) != EL_STR_SEARCH_NPOS) {
+		nCount++;
+		nStart += nPos + view.nLength;
+	}
+
+	return nCount;
+}
+
+/**
+ * Counts non-overlapping occurences of C string.
+ * @param  pThis Dynamic string.
+ * @param  sz    C string to search.
+ * @return       Number of occurences.
+ */
+size_t elstrCountCStr(str *pThis, const char *sz) {
+	return elstrCountView(pThis, elstrviewFromCStr(sz));
+}
+
+/**
+ * Counts non-overlapping occurences of dynamic string.
+ * @param  pThis Dynamic string.
+ * @param  pStr  Dynamic string to search.
+ * @return       Number of occurences.
+ */
+size_t elstrCountELStr(str *pThis, str *pStr) {
+	return elstrCountView(pThis, elstrGetView(pStr));
+}
+
+/**
+ * Copies the buffer replacing all non-overlapping occurences of substring 
+ * (found from left to right).
+ * @param  pDest   Destination (may be the same as @a pSrc if the replacement 
+ * isn't longer than the substring).
+ * @param  pSrc    Source.
+ * @param  nLength Length of the source.
+ * @param  viewOld Substring to be replaced (not empty).
+ * @param  viewNew Replacement.
+ * @param  pCount  Number of replacements made is returned here.
+ * @return         Length of the result.
+ */
+static size_t elstrReplaceAllTo(char *pDest, const char *pSrc, size_t nLength, 
+	strview viewOld, strview viewNew, size_t *pCount) {
+
+	size_t nRead = 0;
+	size_t nWrite = 0;
+	size_t nCount = 0;
+	size_t nPos;
+
+	while((nPos = elstrSearch(pSrc + nRead, nLength - nRead, viewOld.szBuf, 
+		viewOld.nLength)) != EL_STR_SEARCH_NPOS) {
+
+		if(pDest + nWrite != pSrc + nRead)
+			memmove(pDest + nWrite, pSrc + nRead, nPos);
+		nWrite += nPos;
+		memcpy(pDest + nWrite, viewNew.szBuf, viewNew.nLength);
+		nWrite += viewNew.nLength;
+		nRead += nPos + viewOld.nLength;
+		nCount++;
+	}
+
+	if(pDest + nWrite != pSrc + nRead)
+		memmove(pDest + nWrite, pSrc + nRead, nLength - nRead);
+	nWrite += nLength - nRead;
+
+	*pCount = nCount;
+	return nWrite;
+}
+
+/**
+ * Replaces all non-overlapping occurences of substring (found from left to 
+ * right) with another one. Substrings may contain null characters. If the 
+ * replacement isn't longer than the substring, the string is changed in place 
+ * in one pass. Otherwise matches are counted first, and the result is built 
+ * in one allocation of the final length. If the string can't hold the result 
+ * (for example fixed string is too small) - it becomes NaS.
+ * @param  pThis   Dynamic string.
+ * @param  viewOld Substring to be replaced (empty substring is never 
+ * replaced).
+ * @param  viewNew Replacement.
+ * @return         Number of replacements made.
+ */
+size_t elstrReplaceAllView(str *pThis, strview viewOld, strview viewNew) {
+	if(isNaS(pThis))
+		return 0;
+	if(viewOld.szBuf == NULL || viewOld.nLength == 0 || viewNew.szBuf == NULL)
+		return 0;
+
+	size_t nCount;
+	bool bAliased = elstrViewOverlaps(pThis, viewOld) || 
+		elstrViewOverlaps(pThis, viewNew);
+
+	if(viewNew.nLength <= viewOld.nLength && !bAliased) {
+		size_t nLength = elstrReplaceAllTo(pThis->szBuf, pThis->szBuf, 
+			pThis->nLength, viewOld, viewNew, &nCount);
+		if(nCount > 0)
+			elstrSetLength(pThis, nLength);
+		return nCount;
+	}
+
+	nCount = elstrCountView(pThis, viewOld);
+	if(nCount == 0)
+		return 0;
+
+	size_t nLength = pThis->nLength - nCount * viewOld.nLength;
+	if(viewNew.nLength > 0 && 
+		nCount > (SIZE_MAX - 1 - nLength) / viewNew.nLength) {
+
+		makeNaS(pThis);
+		return 0;
+	}
+	nLength += nCount * viewNew.nLength;
+
+	if(isFixed(pThis) && nLength + 1 > pThis->nCapacity) {
+		makeNaS(pThis);
+		return 0;
+	}
+
+	char *szBufNew = EL_ALLOC(nLength + 1);
+	if(szBufNew == NULL) {
+		makeNaS(pThis);
+		return 0;
+	}
+	elstrReplaceAllTo(szBufNew, pThis->szBuf, pThis->nLength, viewOld, viewNew, 
+		&nCount);
+
+	if(isFixed(pThis)) {
+		memcpy(pThis->szBuf, szBufNew, nLength);
+		EL_FREE(szBufNew);
+	} else {
+		EL_FREE(pThis->szBuf);
+		pThis->szBuf = szBufNew;
+		pThis->nCapacity = nLength + 1;
+	}
+	elstrSetLength(pThis, nLength);
+
+	return nCount;
+}
+
+/**
+ * Replaces all non-overlapping occurences of C string with another one. See 
+ * elstrReplaceAllView().
+ * @param  pThis Dynamic string.
+ * @param  szOld C string to be replaced.
+ * @param  szNew Replacement C string.
+ * @return       Number of replacements made.
+ */
+size_t elstrReplaceAllCStr(str *pThis, const char *szOld, const char *szNew) {
+	return elstrReplaceAllView(pThis, elstrviewFromCStr(szOld), 
+		elstrviewFromCStr(szNew));
+}
+
+/**
+ * Replaces all non-overlapping occurences of dynamic string with another one. 
+ * See elstrReplaceAllView().
+ * @param  pThis Dynamic string.
+ * @param  pOld  Dynamic string to be replaced.
+ * @param  pNew  Replacement dynamic string.
+ * @return       Number of replacements made.
+ */
+size_t elstrReplaceAllELStr(str *pThis, str *pOld, str *pNew) {
+	return elstrReplaceAllView(pThis, elstrGetView(pOld), elstrGetView(pNew));
+}
+
+/**
+ * Replaces the first occurence of substring with another one. Substrings may 
+ * contain null characters. Only the tail after the substring is moved. If the 
+ * string can't hold the result (for example fixed string is too small) - it 
+ * becomes NaS.
+ * @param  pThis   Dynamic string.
+ * @param  viewOld Substring to be replaced (empty substring is never 
+ * replaced).
+ * @param  viewNew Replacement.
+ * @return         @b True if the substring was found and replaced.
+ */
+bool elstrReplaceFirstView(str *pThis, strview viewOld, strview viewNew) {
+	if(isNaS(pThis))
+		return false;
+	if(viewOld.szBuf == NULL || viewOld.nLength == 0 || viewNew.szBuf == NULL)
+		return false;
+
+	size_t nPos = elstrSearch(pThis->szBuf, pThis->nLength, viewOld.szBuf, 
+		viewOld.nLength);
+	if(nPos == EL_STR_SEARCH_NPOS)
+		return false;
+
+	// replacement taken from the string itself may move, so copy it first
+	char *pCopy = NULL;
+	if(elstrViewOverlaps(pThis, viewNew) && viewNew.nLength > 0) {
+		pCopy = EL_ALLOC(viewNew.nLength);
+		if(pCopy == NULL) {
+			makeNaS(pThis);
+			return false;
+		}
+		memcpy(pCopy, viewNew.szBuf, viewNew.nLength);
+		viewNew.szBuf = pCopy;
+	}
+
+	size_t nLength = pThis->nLength - viewOld.nLength + viewNew.nLength;
+	if(viewNew.nLength != viewOld.nLength) {
+		elstrEnsureCapacity(pThis, nLength + 1);
+		if(isNaS(pThis)) {
+			EL_FREE(pCopy);
+			return false;
+		}
+		memmove(pThis->szBuf + nPos + viewNew.nLength, 
+			pThis->szBuf + nPos + viewOld.nLength, 
+			pThis->nLength - nPos - viewOld.nLength);
+	}
+	memcpy(pThis->szBuf + nPos, viewNew.szBuf, viewNew.nLength);
+	elstrSetLength(pThis, nLength);
+
+	EL_FREE(pCopy);
+	return true;
+}
+
+/**
+ * Replaces the first occurence of C string with another one. See 
+ * elstrReplaceFirstView().
+ * @param  pThis Dynamic string.
+ * @param  szOld C string to be replaced.
+ * @param  szNew Replacement C string.
+ * @return       @b True if the substring was found and replaced.
+ */
+bool elstrReplaceFirstCStr(str *pThis, const char *szOld, const char *szNew) {
+	return elstrReplaceFirstView(pThis, elstrviewFromCStr(szOld), 
+		elstrviewFromCStr(szNew));
+}
+
+/**
+ * Replaces the first occurence of dynamic string with another one. See 
+ * elstrReplaceFirstView().
+ * @param  pThis Dynamic string.
+ * @param  pOld  Dynamic string to be replaced.
+ * @param  pNew  Replacement dynamic string.
+ * @return       @b True if the substring was found and replaced.
+ */
+bool elstrReplaceFirstELStr(str *pThis, str *pOld, str *pNew) {
+	return elstrReplaceFirstView(pThis, elstrGetView(pOld), 
+		elstrGetView(pNew));
 }
 
 /**
@@ -1787,6 +3023,30 @@ void elstrArrayELStrDestroy(str **pStrings, size_t nCountStrings) {
 	}
 }
 
+/**
+ * Calls specified function for each string of an array (for example created by
+ * elstrSplitByChars()) using several threads. Callback may change the string 
+ * it gets (but not replace it). Passes the pointer to custom data to the 
+ * callback function. If function returns @b false - stops iteration (strings 
+ * which are being processed by other threads at this moment are still 
+ * completed).
+ * @param  pStrings       An array of ELStrings.
+ * @param  nCountStrings  Number of ELStrings in array.
+ * @param  strCallbackEx  Callback function to be called for each string. Must 
+ * be thread safe.
+ * @param  pEx            Pointer to custom data to be sent to callback.
+ * @param  nThreads       Maximal number of threads to use. If 0 - number of 
+ * processors is used.
+ * @return                @b True if all strings were processed, @b false if 
+ * iteration was stopped by callback or an error occured.
+ */
+bool elstrArrayELStrMapParallel(str **pStrings, size_t nCountStrings, 
+	bool (*strCallbackEx)(str *pStr, void *pEx), void *pEx, size_t nThreads) {
+
+	return elparallelForEachEx((void **)pStrings, nCountStrings, 
+		EL_CB_FOREACH_EX(strCallbackEx), pEx, nThreads);
+}
+
 /**
  * Returns the maximal number of multibyte characters the dynamic string may 
  * hold.
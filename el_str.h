@@ -57,11 +57,40 @@ typedef struct str {
  	char *szBuf; /**< The data buffer itself. */
 } str;
 
+/** 
+ * @brief Holds the pointer to a part of memory and its length, so substrings 
+ * with null characters can be passed without copying.
+ *
+ * View doesn't own the memory, so it must not outlive the buffer.
+ */
+typedef struct strview {
+	const char *szBuf; /**< Start of the part (not necessarily terminated by 
+	null). */
+	size_t nLength; /**< Length of the part (in bytes). */
+} strview;
+
+/**
+ * Position returned by view functions when nothing is found.
+ */
+#define EL_STRVIEW_NPOS	SIZE_MAX
+
+/** 
+ * @brief Holds the state of 64-bit hash code computed over bytes which come 
+ * in parts.
+ */
+typedef struct strhash64 {
+	uint64_t nHash; /**< Hash code of the blocks mixed so far. */
+	size_t nTail; /**< Number of bytes in @e arrTail. */
+	char arrTail[16]; /**< Bytes not mixed yet. */
+} strhash64;
+
 #define EL_STR_ERR_WRONG_STRING	3
 #define EL_STR_ERR_WRONG_PARAM	4
 
 void elstrArrayELStrDestroy(str **pStrings, size_t nCountStrings);
 size_t elstrMBGetMaxLength();
+bool elstrArrayELStrMapParallel(str **pStrings, size_t nCountStrings, 
+	bool (*strCallbackEx)(str *pStr, void *pEx), void *pEx, size_t nThreads);
 
 str *elstrCreateEmpty();
 str *elstrCreateEmptyWithCapacity(size_t nCapacity);
@@ -89,6 +118,10 @@ size_t elstrGetCapacity(str *pThis);
 size_t elstrGetUnused(str *pThis);
 const char *elstrGetRawBuf(str *pThis);
 uint_fast32_t elstrGetHashCode(str *pThis);
+uint64_t elstrGetHashCode64(str *pThis);
+void elstrHash64Begin(strhash64 *pState, size_t nLength);
+void elstrHash64Update(strhash64 *pState, const char *p, size_t nLength);
+uint64_t elstrHash64End(strhash64 *pState);
 str *elstrSubString(str *pThis, int nIndex, size_t nCount);
 void elstrAssignFromCStr(str *pThis, const char *sz);
 void elstrAssignFromELStr(str *pThis, str *pStr);
@@ -100,6 +133,19 @@ void elstrAppendAllCStr(str *pThis, ...);
 void elstrAppendAllELStrPrealloc(str *pThis, ...);
 void elstrAppendPrintfCStrFormat(str *pThis, const char *cszFormat, ...);
 void elstrAppendPrintfELStrFormat(str *pThis, str *pStrFormat, ...);
+void elstrAppendInt64(str *pThis, int64_t nValue);
+void elstrAppendUInt64(str *pThis, uint64_t nValue);
+void elstrAppendHex(str *pThis, uint64_t nValue, size_t nMinDigits, 
+	bool bUpper);
+void elstrAppendDouble(str *pThis, double fValue);
+void elstrAppendDoubleFixed(str *pThis, double fValue, size_t nDecimals);
+void elstrAppendBool(str *pThis, bool bValue);
+void elstrAppendPaddedView(str *pThis, strview view, size_t nWidth, 
+	char chPad, bool bAlignLeft);
+void elstrAppendPaddedCStr(str *pThis, const char *sz, size_t nWidth, 
+	char chPad, bool bAlignLeft);
+void elstrAppendInt64Padded(str *pThis, int64_t nValue, size_t nWidth, 
+	char chPad);
 void elstrInsertCStr(str *pThis, int nIndex, char *sz);
 void elstrDelete(str *pThis, int nIndex, size_t nCount);
 size_t elstrDeleteChar(str *pThis, char ch);
@@ -111,7 +157,12 @@ void elstrTrim(str *pThis);
 void elstrTrimChars(str *pThis, char arrChars[], size_t nCountChars);
 void elstrReverse(str *pThis);
 void elstrReplaceChar(str *pThis, char chOld, char chNew);
+void elstrToUpperASCII(str *pThis);
+void elstrToLowerASCII(str *pThis);
+void elstrFoldCaseASCII(str *pThis);
+void elstrTranslate(str *pThis, const unsigned char arrTable[256]);
 int elstrCompareCStr(str *pThis, const char *sz);
+int elstrCompareELStr(str *pThis, str *pStr);
 bool elstrIsEqualToCStr(str *pThis, const char *sz);
 bool elstrIsEqualToELStr(str *pThis, str *pStr);
 bool elstrHasPrefixCStr(str *pThis, char *sz);
@@ -120,6 +171,29 @@ bool elstrHasSuffixCStr(str *pThis, char *sz);
 bool elstrHasSuffixELStr(str *pThis, str *pStr);
 int elstrIndexOfChar(str *pThis, char ch);
 int elstrIndexOfCharFrom(str *pThis, char ch, int nIndexFrom);
+strview elstrviewFromCStr(const char *sz);
+strview elstrviewFromBuf(const char *p, size_t nLength);
+strview elstrGetView(str *pThis);
+size_t elstrviewIndexOfView(strview view, strview viewSubstr);
+int elstrIndexOfCStr(str *pThis, const char *sz);
+int elstrIndexOfELStr(str *pThis, str *pStr);
+int elstrIndexOfView(str *pThis, strview view);
+int elstrIndexOfViewFrom(str *pThis, strview view, int nIndexFrom);
+int elstrLastIndexOfCStr(str *pThis, const char *sz);
+int elstrLastIndexOfELStr(str *pThis, str *pStr);
+int elstrLastIndexOfView(str *pThis, strview view);
+bool elstrContainsCStr(str *pThis, const char *sz);
+bool elstrContainsELStr(str *pThis, str *pStr);
+bool elstrContainsView(str *pThis, strview view);
+size_t elstrCountCStr(str *pThis, const char *sz);
+size_t elstrCountELStr(str *pThis, str *pStr);
+size_t elstrCountView(str *pThis, strview view);
+size_t elstrReplaceAllCStr(str *pThis, const char *szOld, const char *szNew);
+size_t elstrReplaceAllELStr(str *pThis, str *pOld, str *pNew);
+size_t elstrReplaceAllView(str *pThis, strview viewOld, strview viewNew);
+bool elstrReplaceFirstCStr(str *pThis, const char *szOld, const char *szNew);
+bool elstrReplaceFirstELStr(str *pThis, str *pOld, str *pNew);
+bool elstrReplaceFirstView(str *pThis, strview viewOld, strview viewNew);
 str **elstrSplitByChars(str *pThis, char arrChars[], size_t nCountChars, 
 	bool bRemoveEmpty, size_t *pCountSubstrings);
 str **elstrSplitByCharsNoEmpty(str *pThis, char arrChars[], size_t nCountChars, 
@@ -0,0 +1,454 @@
+/* Extreme Library (EL). Scatter/gather string builder. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+
+#include "el_memory.h"
+
+#include "el_strbuilder.h"
+
+#define isInvalid(s) ((s) == NULL)
+
+/**
+ * Maximal number of fragments passed to one writev() call.
+ */
+#if defined(IOV_MAX) && IOV_MAX < 1024
+#define EL_STRBUILDER_WRITE_BATCH	IOV_MAX
+#elif defined(IOV_MAX) || defined(UIO_MAXIOV)
+#define EL_STRBUILDER_WRITE_BATCH	1024
+#else
+#define EL_STRBUILDER_WRITE_BATCH	16
+#endif
+
+/**
+ * Adds the fragment. Fragment which continues the last one in memory extends 
+ * it instead.
+ * @param  pThis   Builder.
+ * @param  p       Bytes of the fragment.
+ * @param  nLength Number of bytes (not 0).
+ * @return         @b True if successful, @b false if an error occured.
+ */
+static bool elstrbuilderAddIov(strbuilder *pThis, const char *p, 
+	size_t nLength) {
+
+	// fragments written already are never extended
+	if(pThis->nCountIov > pThis->nFirst) {
+		struct iovec *pLast = &pThis->arrIov[pThis->nCountIov - 1];
+		if((const char *)pLast->iov_base + pLast->iov_len == p) {
+			pLast->iov_len += nLength;
+			pThis->nLength += nLength;
+			return true;
+		}
+	}
+
+	if(pThis->nCountIov == pThis->nCapacityIov) {
+		size_t nCapacity = pThis->nCapacityIov > 0 ? 
+			pThis->nCapacityIov * 2 : 16;
+		struct iovec *arrIov = EL_REALLOC(pThis->arrIov, 
+			nCapacity * sizeof(struct iovec));
+		if(arrIov == NULL)
+			return false;
+		pThis->arrIov = arrIov;
+		pThis->nCapacityIov = nCapacity;
+	}
+
+	pThis->arrIov[pThis->nCountIov].iov_base = (void *)p;
+	pThis->arrIov[pThis->nCountIov].iov_len = nLength;
+	pThis->nCountIov++;
+	pThis->nLength += nLength;
+
+	return true;
+}
+
+/**
+ * Reserves bytes in the arena. New block is allocated if the current one has 
+ * no room.
+ * @param  pThis   Builder.
+ * @param  nLength Number of bytes.
+ * @return         Pointer to reserved bytes (or NULL if an error occured).
+ */
+static char *elstrbuilderReserve(strbuilder *pThis, size_t nLength) {
+	elstrbuilder_block *pBlock = pThis->pBlocks;
+	if(pBlock == NULL || pBlock->nCapacity - pBlock->nUsed < nLength) {
+		size_t nCapacity = nLength > EL_STRBUILDER_BLOCK_SIZE ? nLength : 
+			EL_STRBUILDER_BLOCK_SIZE;
+		pBlock = EL_ALLOC(sizeof(elstrbuilder_block) + nCapacity);
+		if(pBlock == NULL)
+			return NULL;
+		pBlock->pNext = pThis->pBlocks;
+		pBlock->nUsed = 0;
+		pBlock->nCapacity = nCapacity;
+		pThis->pBlocks = pBlock;
+	}
+
+	return pBlock->arrData + pBlock->nUsed;
+}
+
+/**
+ * Copies bytes into the arena and adds them as a fragment.
+ * @param  pThis   Builder.
+ * @param  p       Bytes.
+ * @param  nLength Number of bytes (not 0).
+ * @return         @b True if successful, @b false if an error occured.
+ */
+static bool elstrbuilderAddCopy(strbuilder *pThis, const char *p, 
+	size_t nLength) {
+
+	char *pDest = elstrbuilderReserve(pThis, nLength);
+	if(pDest == NULL)
+		return false;
+
+	memcpy(pDest, p, nLength);
+	if(!elstrbuilderAddIov(pThis, pDest, nLength))
+		return false;
+	pThis->pBlocks->nUsed += nLength;
+
+	return true;
+}
+
+/**
+ * Creates new empty builder.
+ * @return Newly created builder (or NULL if an error occured).
+ */
+strbuilder *elstrbuilderCreate() {
+	return EL_CALLOC(1, sizeof(strbuilder));
+}
+
+/**
+ * Destroys the builder with owned dynamic strings and copied fragments.
+ * @param pThis Builder.
+ */
+void elstrbuilderDestroy(strbuilder *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	elstrbuilderClear(pThis);
+
+	if(pThis->arrIov != NULL)
+		EL_FREE(pThis->arrIov);
+	if(pThis->arrOwned != NULL)
+		EL_FREE(pThis->arrOwned);
+
+	EL_FREE(pThis);
+}
+
+/**
+ * Removes all fragments. Owned dynamic strings are destroyed, memory of 
+ * fragments list is kept for reuse.
+ * @param pThis Builder.
+ */
+void elstrbuilderClear(strbuilder *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	for(size_t i = 0; i < pThis->nCountOwned; i++)
+		elstrDestroy(pThis->arrOwned[i]);
+
+	while(pThis->pBlocks != NULL) {
+		elstrbuilder_block *pNext = pThis->pBlocks->pNext;
+		EL_FREE(pThis->pBlocks);
+		pThis->pBlocks = pNext;
+	}
+
+	pThis->nCountIov = 0;
+	pThis->nCountOwned = 0;
+	pThis->nLength = 0;
+	pThis->nFirst = 0;
+	pThis->nFirstOffset = 0;
+	pThis->nWritten = 0;
+}
+
+/**
+ * Returns the total length of the text built.
+ * @param  pThis Builder.
+ * @return       Number of bytes.
+ */
+size_t elstrbuilderGetLength(strbuilder *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	return pThis->nLength;
+}
+
+/**
+ * Returns the number of fragments (neighbouring fragments in memory are 
+ * counted as one).
+ * @param  pThis Builder.
+ * @return       Number of fragments.
+ */
+size_t elstrbuilderGetCountFragments(strbuilder *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	return pThis->nCountIov;
+}
+
+/**
+ * Returns the number of bytes not written by elstrbuilderWrite() yet.
+ * @param  pThis Builder.
+ * @return       Number of bytes.
+ */
+size_t elstrbuilderGetPending(strbuilder *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	return pThis->nLength - pThis->nWritten;
+}
+
+/**
+ * Appends bytes of the view. Memory is referenced, not copied (except short 
+ * views), so it must stay unchanged until the builder is cleared.
+ * @param  pThis Builder.
+ * @param  view  View.
+ * @return       @b True if successful, @b false if an error occured.
+ */
+bool elstrbuilderAppendView(strbuilder *pThis, strview view) {
+	if(isInvalid(pThis) || view.szBuf == NULL)
+		return false;
+
+	if(view.nLength == 0)
+		return true;
+
+	if(view.nLength < EL_STRBUILDER_COPY_MAX)
+		return elstrbuilderAddCopy(pThis, view.szBuf, view.nLength);
+
+	return elstrbuilderAddIov(pThis, view.szBuf, view.nLength);
+}
+
+/**
+ * Appends C style string. Memory is referenced, not copied (except short 
+ * strings).
+ * @param  pThis Builder.
+ * @param  sz    C style string.
+ * @return       @b True if successful, @b false if an error occured.
+ */
+bool elstrbuilderAppendCStr(strbuilder *pThis, const char *sz) {
+	if(sz == NULL)
+		return false;
+
+	return elstrbuilderAppendView(pThis, elstrviewFromCStr(sz));
+}
+
+/**
+ * Appends dynamic string. Its buffer is referenced, not copied (except short 
+ * strings), so the string must stay unchanged until the builder is cleared.
+ * @param  pThis Builder.
+ * @param  pStr  Dynamic string.
+ * @return       @b True if successful, @b false if an error occured.
+ */
+bool elstrbuilderAppendELStr(strbuilder *pThis, str *pStr) {
+	strview view = elstrGetView(pStr);
+	if(view.szBuf == NULL)
+		return false;
+
+	return elstrbuilderAppendView(pThis, view);
+}
+
+/**
+ * Appends dynamic string and takes its ownership. The string is destroyed 
+ * when the builder is cleared or destroyed (even if an error occured).
+ * @param  pThis Builder.
+ * @param  pStr  Dynamic string.
+ * @return       @b True if successful, @b false if an error occured.
+ */
+bool elstrbuilderAppendELStrOwned(strbuilder *pThis, str *pStr) {
+	if(isInvalid(pThis) || pStr == NULL) {
+		elstrDestroy(pStr);
+		return false;
+	}
+
+	if(pThis->nCountOwned == pThis->nCapacityOwned) {
+		size_t nCapacity = pThis->nCapacityOwned > 0 ? 
+			pThis->nCapacityOwned * 2 : 8;
+		str **arrOwned = EL_REALLOC(pThis->arrOwned, 
+			nCapacity * sizeof(str *));
+		if(arrOwned == NULL) {
+			elstrDestroy(pStr);
+			return false;
+		}
+		pThis->arrOwned = arrOwned;
+		pThis->nCapacityOwned = nCapacity;
+	}
+	pThis->arrOwned[pThis->nCountOwned++] = pStr;
+
+	return elstrbuilderAppendELStr(pThis, pStr);
+}
+
+/**
+ * Appends a copy of bytes of the view (memory may be reused right after the 
+ * call).
+ * @param  pThis Builder.
+ * @param  view  View.
+ * @return       @b True if successful, @b false if an error occured.
+ */
+bool elstrbuilderAppendCopyView(strbuilder *pThis, strview view) {
+	if(isInvalid(pThis) || view.szBuf == NULL)
+		return false;
+
+	if(view.nLength == 0)
+		return true;
+
+	return elstrbuilderAddCopy(pThis, view.szBuf, view.nLength);
+}
+
+/**
+ * Appends a copy of C style string.
+ * @param  pThis Builder.
+ * @param  sz    C style string.
+ * @return       @b True if successful, @b false if an error occured.
+ */
+bool elstrbuilderAppendCopyCStr(strbuilder *pThis, const char *sz) {
+	if(sz == NULL)
+		return false;
+
+	return elstrbuilderAppendCopyView(pThis, elstrviewFromCStr(sz));
+}
+
+/**
+ * Appends formatted data (formatted in the arena).
+ * @param  pThis     Builder.
+ * @param  cszFormat Format (as for printf()).
+ * @return           @b True if successful, @b false if an error occured.
+ */
+bool elstrbuilderAppendPrintfCStrFormat(strbuilder *pThis, 
+	const char *cszFormat, ...) {
+
+	if(isInvalid(pThis) || cszFormat == NULL)
+		return false;
+
+	size_t nRoom = 0;
+	if(pThis->pBlocks != NULL)
+		nRoom = pThis->pBlocks->nCapacity - pThis->pBlocks->nUsed;
+
+	// formatted into the room left, and once more if it doesn't fit
+	va_list vl;
+	va_start(vl, cszFormat);
+	int nWritten = vsnprintf(nRoom > 0 ? 
+		pThis->pBlocks->arrData + pThis->pBlocks->nUsed : NULL, nRoom, 
+		cszFormat, vl);
+	va_end(vl);
+	if(nWritten < 0)
+		return false;
+
+	char *pDest = NULL;
+	if((size_t)nWritten < nRoom)
+		pDest = pThis->pBlocks->arrData + pThis->pBlocks->nUsed;
+	else {
+		pDest = elstrbuilderReserve(pThis, (size_t)nWritten + 1);
+		if(pDest == NULL)
+			return false;
+		va_start(vl, cszFormat);
+		vsnprintf(pDest, (size_t)nWritten + 1, cszFormat, vl);
+		va_end(vl);
+	}
+
+	if(nWritten == 0)
+		return true;
+
+	if(!elstrbuilderAddIov(pThis, pDest, (size_t)nWritten))
+		return false;
+	pThis->pBlocks->nUsed += (size_t)nWritten;
+
+	return true;
+}
+
+/**
+ * Creates new dynamic string holding all text built (buffer is allocated 
+ * once, of exact size).
+ * @param  pThis Builder.
+ * @return       New dynamic string (or NULL if an error occured).
+ */
+str *elstrbuilderToELStr(strbuilder *pThis) {
+	if(isInvalid(pThis))
+		return NULL;
+
+	str *pStr = elstrCreateEmptyWithCapacity(pThis->nLength + 1);
+	if(pStr == NULL)
+		return NULL;
+
+	char *pDest = pStr->szBuf;
+	for(size_t i = 0; i < pThis->nCountIov; i++) {
+		memcpy(pDest, pThis->arrIov[i].iov_base, pThis->arrIov[i].iov_len);
+		pDest += pThis->arrIov[i].iov_len;
+	}
+	elstrSetLength(pStr, pThis->nLength);
+
+	return pStr;
+}
+
+/**
+ * Writes the text not written yet to the file descriptor by writev(2). 
+ * Fragments are passed in batches (no more than IOV_MAX at once), partial 
+ * writes are continued. Interrupted calls are restarted. If the descriptor 
+ * is non-blocking and would block, returns what was written so far, so the 
+ * call may be repeated later (see elstrbuilderGetPending()).
+ * @param  pThis Builder.
+ * @param  nFd   File descriptor.
+ * @return       Number of bytes written by this call (or -1 if an error 
+ * occured, @e errno is set then).
+ */
+ssize_t elstrbuilderWrite(strbuilder *pThis, int nFd) {
+	if(isInvalid(pThis)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	size_t nWritten = 0;
+	struct iovec arrBatch[EL_STRBUILDER_WRITE_BATCH];
+	while(pThis->nFirst < pThis->nCountIov) {
+		size_t nBatch = pThis->nCountIov - pThis->nFirst;
+		if(nBatch > EL_STRBUILDER_WRITE_BATCH)
+			nBatch = EL_STRBUILDER_WRITE_BATCH;
+		memcpy(arrBatch, pThis->arrIov + pThis->nFirst, 
+			nBatch * sizeof(struct iovec));
+		arrBatch[0].iov_base = (char *)arrBatch[0].iov_base + 
+			pThis->nFirstOffset;
+		arrBatch[0].iov_len -= pThis->nFirstOffset;
+
+		ssize_t nResult = writev(nFd, arrBatch, (int)nBatch);
+		if(nResult < 0) {
+			if(errno == EINTR)
+				continue;
+			if(errno == EAGAIN || errno == EWOULDBLOCK)
+				break;
+			return -1;
+		}
+
+		nWritten += (size_t)nResult;
+		pThis->nWritten += (size_t)nResult;
+
+		// skip fragments written completely
+		size_t nLeft = (size_t)nResult + pThis->nFirstOffset;
+		while(pThis->nFirst < pThis->nCountIov && 
+			nLeft >= pThis->arrIov[pThis->nFirst].iov_len) {
+
+			nLeft -= pThis->arrIov[pThis->nFirst].iov_len;
+			pThis->nFirst++;
+		}
+		pThis->nFirstOffset = nLeft;
+	}
+
+	return (ssize_t)nWritten;
+}
@@ -0,0 +1,101 @@
+/* Extreme Library (EL). Scatter/gather string builder. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#ifndef _EL_STRBUILDER_H_
+#define _EL_STRBUILDER_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "el_str.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Fragments shorter than this are copied into the arena instead of being 
+ * referenced (so neighbouring small fragments share one iovec).
+ */
+#define EL_STRBUILDER_COPY_MAX	64
+
+/**
+ * Size of arena block (in bytes).
+ */
+#define EL_STRBUILDER_BLOCK_SIZE	4096
+
+/** 
+ * @brief Block of the arena holding copied fragments.
+ */
+typedef struct elstrbuilder_block {
+	struct elstrbuilder_block *pNext; /**< Previously allocated block. */
+	size_t nUsed; /**< Number of bytes used. */
+	size_t nCapacity; /**< Number of bytes in @e arrData. */
+	char arrData[]; /**< Bytes of the block. */
+} elstrbuilder_block;
+
+/** 
+ * @brief Builds the text from fragments without copying them into one buffer.
+ *
+ * Fragments are recorded as iovec references: borrowed views (memory must 
+ * stay valid and unchanged until builder is cleared or destroyed), owned 
+ * dynamic strings (destroyed with the builder) or copies kept in the arena. 
+ * Text may be flattened into one dynamic string or written by writev(2).
+ */
+typedef struct strbuilder {
+	struct iovec *arrIov; /**< Fragments. */
+	size_t nCountIov; /**< Number of fragments. */
+	size_t nCapacityIov; /**< Number of fragments allocated. */
+	str **arrOwned; /**< Dynamic strings owned by the builder. */
+	size_t nCountOwned; /**< Number of owned dynamic strings. */
+	size_t nCapacityOwned; /**< Number of owned dynamic strings allocated. */
+	elstrbuilder_block *pBlocks; /**< Arena blocks (the last allocated 
+	first). */
+	size_t nLength; /**< Total number of bytes in fragments. */
+	size_t nFirst; /**< First fragment not written completely. */
+	size_t nFirstOffset; /**< Number of bytes of the first fragment written. */
+	size_t nWritten; /**< Total number of bytes written. */
+} strbuilder;
+
+strbuilder *elstrbuilderCreate();
+void elstrbuilderDestroy(strbuilder *pThis);
+void elstrbuilderClear(strbuilder *pThis);
+size_t elstrbuilderGetLength(strbuilder *pThis);
+size_t elstrbuilderGetCountFragments(strbuilder *pThis);
+size_t elstrbuilderGetPending(strbuilder *pThis);
+bool elstrbuilderAppendView(strbuilder *pThis, strview view);
+bool elstrbuilderAppendCStr(strbuilder *pThis, const char *sz);
+bool elstrbuilderAppendELStr(strbuilder *pThis, str *pStr);
+bool elstrbuilderAppendELStrOwned(strbuilder *pThis, str *pStr);
+bool elstrbuilderAppendCopyView(strbuilder *pThis, strview view);
+bool elstrbuilderAppendCopyCStr(strbuilder *pThis, const char *sz);
+bool elstrbuilderAppendPrintfCStrFormat(strbuilder *pThis, 
+	const char *cszFormat, ...);
+str *elstrbuilderToELStr(strbuilder *pThis);
+ssize_t elstrbuilderWrite(strbuilder *pThis, int nFd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,693 @@
+/* Extreme Library (EL). Byte operations for strings. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#include <string.h>
+#include <stdatomic.h>
+
+#include "el_cpu.h"
+
+#include "el_strops.h"
+
+#if EL_CPU_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * Maximal number of characters in the set searched by SIMD span kernels. 
+ * Larger sets are looked up in the table.
+ */
+#define EL_STROPS_SPAN_SIMD_MAX	8
+
+/**
+ * Replaces all occurences of the character (portable implementation).
+ */
+static void elstropsReplaceCharScalar(char *p, size_t nLength, char chOld, 
+	char chNew) {
+
+	for(size_t i = 0; i < nLength; i++)
+		if(p[i] == chOld)
+			p[i] = chNew;
+}
+
+/**
+ * Removes all occurences of the character (portable implementation).
+ */
+static size_t elstropsDeleteCharScalar(char *p, size_t nLength, char ch) {
+	size_t nWrite = 0;
+
+	for(size_t i = 0; i < nLength; i++)
+		if(p[i] != ch)
+			p[nWrite++] = p[i];
+
+	return nWrite;
+}
+
+/**
+ * Reverses the order of bytes (portable implementation).
+ */
+static void elstropsReverseScalar(char *p, size_t nLength) {
+	if(nLength < 2)
+		return;
+
+	char *p1 = p;
+	char *p2 = p + nLength - 1;
+	while(p1 < p2) {
+		char ch = *p1;
+		*p1 = *p2;
+		*p2 = ch;
+		p1++;
+		p2--;
+	}
+}
+
+/**
+ * Fills the table marking the characters of the set.
+ * @param arrIsInSet  Table of 256 flags.
+ * @param arrChars    Characters of the set.
+ * @param nCountChars Number of characters in the set.
+ */
+static void elstropsFillSet(bool *arrIsInSet, const char *arrChars, 
+	size_t nCountChars) {
+
+	memset(arrIsInSet, 0, 256 * sizeof(bool));
+	for(size_t i = 0; i < nCountChars; i++)
+		arrIsInSet[(unsigned char)arrChars[i]] = true;
+}
+
+/**
+ * Counts leading bytes from the set (portable implementation).
+ */
+static size_t elstropsSpanScalar(const char *p, size_t nLength, 
+	const char *arrChars, size_t nCountChars) {
+
+	bool arrIsInSet[256];
+	elstropsFillSet(arrIsInSet, arrChars, nCountChars);
+
+	size_t i = 0;
+	while(i < nLength && arrIsInSet[(unsigned char)p[i]])
+		i++;
+
+	return i;
+}
+
+/**
+ * Counts trailing bytes from the set (portable implementation).
+ */
+static size_t elstropsSpanBackScalar(const char *p, size_t nLength, 
+	const char *arrChars, size_t nCountChars) {
+
+	bool arrIsInSet[256];
+	elstropsFillSet(arrIsInSet, arrChars, nCountChars);
+
+	size_t i = nLength;
+	while(i > 0 && arrIsInSet[(unsigned char)p[i - 1]])
+		i--;
+
+	return nLength - i;
+}
+
+/**
+ * Converts ASCII letters to upper case (portable implementation).
+ */
+static void elstropsToUpperScalar(char *p, size_t nLength) {
+	for(size_t i = 0; i < nLength; i++)
+		if((unsigned char)(p[i] - 'a') <= 'z' - 'a')
+			p[i] ^= 0x20;
+}
+
+/**
+ * Converts ASCII letters to lower case (portable implementation).
+ */
+static void elstropsToLowerScalar(char *p, size_t nLength) {
+	for(size_t i = 0; i < nLength; i++)
+		if((unsigned char)(p[i] - 'A') <= 'Z' - 'A')
+			p[i] ^= 0x20;
+}
+
+/**
+ * Replaces each byte by its entry of the table (portable implementation).
+ */
+static void elstropsTranslateScalar(char *p, size_t nLength, 
+	const unsigned char *arrTable) {
+
+	size_t i = 0;
+	// independent lookups let the CPU overlap them
+	for(; i + 4 <= nLength; i += 4) {
+		unsigned char ch0 = arrTable[(unsigned char)p[i]];
+		unsigned char ch1 = arrTable[(unsigned char)p[i + 1]];
+		unsigned char ch2 = arrTable[(unsigned char)p[i + 2]];
+		unsigned char ch3 = arrTable[(unsigned char)p[i + 3]];
+		p[i] = (char)ch0;
+		p[i + 1] = (char)ch1;
+		p[i + 2] = (char)ch2;
+		p[i + 3] = (char)ch3;
+	}
+	for(; i < nLength; i++)
+		p[i] = (char)arrTable[(unsigned char)p[i]];
+}
+
+/**
+ * Portable kernels.
+ */
+static const elstrops_kernels g_kernelsScalar = {
+	"scalar",
+	elstropsReplaceCharScalar,
+	elstropsDeleteCharScalar,
+	elstropsReverseScalar,
+	elstropsSpanScalar,
+	elstropsSpanBackScalar,
+	elstropsToUpperScalar,
+	elstropsToLowerScalar,
+	elstropsTranslateScalar
+};
+
+#if EL_CPU_X86
+
+/**
+ * Replaces all occurences of the character (SSE2 implementation).
+ */
+__attribute__((target("sse2")))
+static void elstropsReplaceCharSSE2(char *p, size_t nLength, char chOld, 
+	char chNew) {
+
+	__m128i vOld = _mm_set1_epi8(chOld);
+	__m128i vNew = _mm_set1_epi8(chNew);
+
+	size_t i = 0;
+	for(; i + 16 <= nLength; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+		__m128i mask = _mm_cmpeq_epi8(v, vOld);
+		v = _mm_or_si128(_mm_andnot_si128(mask, v), _mm_and_si128(mask, vNew));
+		_mm_storeu_si128((__m128i *)(p + i), v);
+	}
+	elstropsReplaceCharScalar(p + i, nLength - i, chOld, chNew);
+}
+
+/**
+ * Removes all occurences of the character (SSE2 implementation). Blocks 
+ * without the character are moved whole, other ones byte by byte. Writing 
+ * never overtakes reading, so stores don't damage bytes not read yet.
+ */
+__attribute__((target("sse2")))
+static size_t elstropsDeleteCharSSE2(char *p, size_t nLength, char ch) {
+	__m128i vCh = _mm_set1_epi8(ch);
+	size_t nWrite = 0;
+
+	size_t i = 0;
+	for(; i + 16 <= nLength; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+		if(_mm_movemask_epi8(_mm_cmpeq_epi8(v, vCh)) == 0) {
+			_mm_storeu_si128((__m128i *)(p + nWrite), v);
+			nWrite += 16;
+		} else {
+			for(size_t j = i; j < i + 16; j++)
+				if(p[j] != ch)
+					p[nWrite++] = p[j];
+		}
+	}
+	for(; i < nLength; i++)
+		if(p[i] != ch)
+			p[nWrite++] = p[i];
+
+	return nWrite;
+}
+
+/**
+ * Reverses the order of bytes in SSE2 register (SSE2 has no byte shuffle, so 
+ * bytes are swapped in words, then words and double words are shuffled).
+ * @param  v Register.
+ * @return   Register with bytes in reverse order.
+ */
+__attribute__((target("sse2")))
+static inline __m128i elstropsReverse128(__m128i v) {
+	v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+	v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+	v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+	return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+/**
+ * Reverses the order of bytes (SSE2 implementation). Blocks from both ends 
+ * are reversed and swapped, the middle is reversed by portable code.
+ */
+__attribute__((target("sse2")))
+static void elstropsReverseSSE2(char *p, size_t nLength) {
+	size_t nStart = 0;
+	size_t nEnd = nLength;
+
+	for(; nEnd - nStart >= 32; nStart += 16, nEnd -= 16) {
+		__m128i v1 = _mm_loadu_si128((const __m128i *)(p + nStart));
+		__m128i v2 = _mm_loadu_si128((const __m128i *)(p + nEnd - 16));
+		_mm_storeu_si128((__m128i *)(p + nStart), elstropsReverse128(v2));
+		_mm_storeu_si128((__m128i *)(p + nEnd - 16), elstropsReverse128(v1));
+	}
+	elstropsReverseScalar(p + nStart, nEnd - nStart);
+}
+
+/**
+ * Counts leading bytes from the set (SSE2 implementation). Each block is 
+ * compared with every character of the set.
+ */
+__attribute__((target("sse2")))
+static size_t elstropsSpanSSE2(const char *p, size_t nLength, 
+	const char *arrChars, size_t nCountChars) {
+
+	if(nCountChars == 0 || nCountChars > EL_STROPS_SPAN_SIMD_MAX)
+		return elstropsSpanScalar(p, nLength, arrChars, nCountChars);
+
+	__m128i arrSet[EL_STROPS_SPAN_SIMD_MAX];
+	for(size_t j = 0; j < nCountChars; j++)
+		arrSet[j] = _mm_set1_epi8(arrChars[j]);
+
+	size_t i = 0;
+	for(; i + 16 <= nLength; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+		__m128i mask = _mm_cmpeq_epi8(v, arrSet[0]);
+		for(size_t j = 1; j < nCountChars; j++)
+			mask = _mm_or_si128(mask, _mm_cmpeq_epi8(v, arrSet[j]));
+		uint32_t nOther = ~(uint32_t)_mm_movemask_epi8(mask) & 0xFFFF;
+		if(nOther != 0)
+			return i + (size_t)__builtin_ctz(nOther);
+	}
+
+	return i + elstropsSpanScalar(p + i, nLength - i, arrChars, nCountChars);
+}
+
+/**
+ * Counts trailing bytes from the set (SSE2 implementation).
+ */
+__attribute__((target("sse2")))
+static size_t elstropsSpanBackSSE2(const char *p, size_t nLength, 
+	const char *arrChars, size_t nCountChars) {
+
+	if(nCountChars == 0 || nCountChars > EL_STROPS_SPAN_SIMD_MAX)
+		return elstropsSpanBackScalar(p, nLength, arrChars, nCountChars);
+
+	__m128i arrSet[EL_STROPS_SPAN_SIMD_MAX];
+	for(size_t j = 0; j < nCountChars; j++)
+		arrSet[j] = _mm_set1_epi8(arrChars[j]);
+
+	size_t nEnd = nLength;
+	for(; nEnd >= 16; nEnd -= 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(p + nEnd - 16));
+		__m128i mask = _mm_cmpeq_epi8(v, arrSet[0]);
+		for(size_t j = 1; j < nCountChars; j++)
+			mask = _mm_or_si128(mask, _mm_cmpeq_epi8(v, arrSet[j]));
+		uint32_t nOther = ~(uint32_t)_mm_movemask_epi8(mask) & 0xFFFF;
+		if(nOther != 0)
+			return nLength - (nEnd - 16) - 
+				(size_t)(32 - __builtin_clz(nOther));
+	}
+
+	return nLength - nEnd + elstropsSpanBackScalar(p, nEnd, arrChars, 
+		nCountChars);
+}
+
+/**
+ * Converts ASCII letters to upper case (SSE2 implementation). Letters are 
+ * found by one unsigned comparison of the distance from 'a'.
+ */
+__attribute__((target("sse2")))
+static void elstropsToUpperSSE2(char *p, size_t nLength) {
+	__m128i vFirst = _mm_set1_epi8('a');
+	__m128i vRange = _mm_set1_epi8('z' - 'a');
+	__m128i vCase = _mm_set1_epi8(0x20);
+
+	size_t i = 0;
+	for(; i + 16 <= nLength; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+		__m128i vDist = _mm_sub_epi8(v, vFirst);
+		__m128i mask = _mm_cmpeq_epi8(_mm_min_epu8(vDist, vRange), vDist);
+		v = _mm_xor_si128(v, _mm_and_si128(mask, vCase));
+		_mm_storeu_si128((__m128i *)(p + i), v);
+	}
+	elstropsToUpperScalar(p + i, nLength - i);
+}
+
+/**
+ * Converts ASCII letters to lower case (SSE2 implementation).
+ */
+__attribute__((target("sse2")))
+static void elstropsToLowerSSE2(char *p, size_t nLength) {
+	__m128i vFirst = _mm_set1_epi8('A');
+	__m128i vRange = _mm_set1_epi8('Z' - 'A');
+	__m128i vCase = _mm_set1_epi8(0x20);
+
+	size_t i = 0;
+	for(; i + 16 <= nLength; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+		__m128i vDist = _mm_sub_epi8(v, vFirst);
+		__m128i mask = _mm_cmpeq_epi8(_mm_min_epu8(vDist, vRange), vDist);
+		v = _mm_xor_si128(v, _mm_and_si128(mask, vCase));
+		_mm_storeu_si128((__m128i *)(p + i), v);
+	}
+	elstropsToLowerScalar(p + i, nLength - i);
+}
+
+/**
+ * SSE2 kernels (SSE2 has no byte shuffle, so translation is portable).
+ */
+static const elstrops_kernels g_kernelsSSE2 = {
+	"sse2",
+	elstropsReplaceCharSSE2,
+	elstropsDeleteCharSSE2,
+	elstropsReverseSSE2,
+	elstropsSpanSSE2,
+	elstropsSpanBackSSE2,
+	elstropsToUpperSSE2,
+	elstropsToLowerSSE2,
+	elstropsTranslateScalar
+};
+
+/**
+ * Replaces all occurences of the character (AVX2 implementation).
+ */
+__attribute__((target("avx2")))
+static void elstropsReplaceCharAVX2(char *p, size_t nLength, char chOld, 
+	char chNew) {
+
+	__m256i vOld = _mm256_set1_epi8(chOld);
+	__m256i vNew = _mm256_set1_epi8(chNew);
+
+	size_t i = 0;
+	for(; i + 32 <= nLength; i += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+		__m256i mask = _mm256_cmpeq_epi8(v, vOld);
+		_mm256_storeu_si256((__m256i *)(p + i), 
+			_mm256_blendv_epi8(v, vNew, mask));
+	}
+	elstropsReplaceCharSSE2(p + i, nLength - i, chOld, chNew);
+}
+
+/**
+ * Removes all occurences of the character (AVX2 implementation).
+ */
+__attribute__((target("avx2")))
+static size_t elstropsDeleteCharAVX2(char *p, size_t nLength, char ch) {
+	__m256i vCh = _mm256_set1_epi8(ch);
+	size_t nWrite = 0;
+
+	size_t i = 0;
+	for(; i + 32 <= nLength; i += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+		uint32_t nFound = (uint32_t)_mm256_movemask_epi8(
+			_mm256_cmpeq_epi8(v, vCh));
+		if(nFound == 0) {
+			_mm256_storeu_si256((__m256i *)(p + nWrite), v);
+			nWrite += 32;
+		} else {
+			// bytes before the first occurence are moved at once
+			size_t nKeep = (size_t)__builtin_ctz(nFound);
+			memmove(p + nWrite, p + i, nKeep);
+			nWrite += nKeep;
+			for(size_t j = i + nKeep + 1; j < i + 32; j++)
+				if(p[j] != ch)
+					p[nWrite++] = p[j];
+		}
+	}
+
+	for(; i < nLength; i++)
+		if(p[i] != ch)
+			p[nWrite++] = p[i];
+
+	return nWrite;
+}
+
+/**
+ * Reverses the order of bytes (AVX2 implementation).
+ */
+__attribute__((target("avx2")))
+static void elstropsReverseAVX2(char *p, size_t nLength) {
+	__m256i vShuffle = _mm256_setr_epi8(
+		15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 
+		15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+	size_t nStart = 0;
+	size_t nEnd = nLength;
+
+	for(; nEnd - nStart >= 64; nStart += 32, nEnd -= 32) {
+		__m256i v1 = _mm256_loadu_si256((const __m256i *)(p + nStart));
+		__m256i v2 = _mm256_loadu_si256((const __m256i *)(p + nEnd - 32));
+		v1 = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v1, vShuffle), 0x4E);
+		v2 = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v2, vShuffle), 0x4E);
+		_mm256_storeu_si256((__m256i *)(p + nStart), v2);
+		_mm256_storeu_si256((__m256i *)(p + nEnd - 32), v1);
+	}
+	elstropsReverseSSE2(p + nStart, nEnd - nStart);
+}
+
+/**
+ * Counts leading bytes from the set (AVX2 implementation).
+ */
+__attribute__((target("avx2")))
+static size_t elstropsSpanAVX2(const char *p, size_t nLength, 
+	const char *arrChars, size_t nCountChars) {
+
+	if(nCountChars == 0 || nCountChars > EL_STROPS_SPAN_SIMD_MAX)
+		return elstropsSpanScalar(p, nLength, arrChars, nCountChars);
+
+	__m256i arrSet[EL_STROPS_SPAN_SIMD_MAX];
+	for(size_t j = 0; j < nCountChars; j++)
+		arrSet[j] = _mm256_set1_epi8(arrChars[j]);
+
+	size_t i = 0;
+	for(; i + 32 <= nLength; i += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+		__m256i mask = _mm256_cmpeq_epi8(v, arrSet[0]);
+		for(size_t j = 1; j < nCountChars; j++)
+			mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(v, arrSet[j]));
+		uint32_t nOther = ~(uint32_t)_mm256_movemask_epi8(mask);
+		if(nOther != 0)
+			return i + (size_t)__builtin_ctz(nOther);
+	}
+
+	return i + elstropsSpanSSE2(p + i, nLength - i, arrChars, nCountChars);
+}
+
+/**
+ * Counts trailing bytes from the set (AVX2 implementation).
+ */
+__attribute__((target("avx2")))
+static size_t elstropsSpanBackAVX2(const char *p, size_t nLength, 
+	const char *arrChars, size_t nCountChars) {
+
+	if(nCountChars == 0 || nCountChars > EL_STROPS_SPAN_SIMD_MAX)
+		return elstropsSpanBackScalar(p, nLength, arrChars, nCountChars);
+
+	__m256i arrSet[EL_STROPS_SPAN_SIMD_MAX];
+	for(size_t j = 0; j < nCountChars; j++)
+		arrSet[j] = _mm256_set1_epi8(arrChars[j]);
+
+	size_t nEnd = nLength;
+	for(; nEnd >= 32; nEnd -= 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(p + nEnd - 32));
+		__m256i mask = _mm256_cmpeq_epi8(v, arrSet[0]);
+		for(size_t j = 1; j < nCountChars; j++)
+			mask = _mm256_or_si256(mask, _mm256_cmpeq_epi8(v, arrSet[j]));
+		uint32_t nOther = ~(uint32_t)_mm256_movemask_epi8(mask);
+		if(nOther != 0)
+			return nLength - nEnd + (size_t)__builtin_clz(nOther);
+	}
+
+	return nLength - nEnd + elstropsSpanBackSSE2(p, nEnd, arrChars, 
+		nCountChars);
+}
+
+/**
+ * Converts ASCII letters to upper case (AVX2 implementation).
+ */
+__attribute__((target("avx2")))
+static void elstropsToUpperAVX2(char *p, size_t nLength) {
+	__m256i vFirst = _mm256_set1_epi8('a');
+	__m256i vRange = _mm256_set1_epi8('z' - 'a');
+	__m256i vCase = _mm256_set1_epi8(0x20);
+
+	size_t i = 0;
+	for(; i + 32 <= nLength; i += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+		__m256i vDist = _mm256_sub_epi8(v, vFirst);
+		__m256i mask = _mm256_cmpeq_epi8(_mm256_min_epu8(vDist, vRange), 
+			vDist);
+		v = _mm256_xor_si256(v, _mm256_and_si256(mask, vCase));
+		_mm256_storeu_si256((__m256i *)(p + i), v);
+	}
+	elstropsToUpperSSE2(p + i, nLength - i);
+}
+
+/**
+ * Converts ASCII letters to lower case (AVX2 implementation).
+ */
+__attribute__((target("avx2")))
+static void elstropsToLowerAVX2(char *p, size_t nLength) {
+	__m256i vFirst = _mm256_set1_epi8('A');
+	__m256i vRange = _mm256_set1_epi8('Z' - 'A');
+	__m256i vCase = _mm256_set1_epi8(0x20);
+
+	size_t i = 0;
+	for(; i + 32 <= nLength; i += 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+		__m256i vDist = _mm256_sub_epi8(v, vFirst);
+		__m256i mask = _mm256_cmpeq_epi8(_mm256_min_epu8(vDist, vRange), 
+			vDist);
+		v = _mm256_xor_si256(v, _mm256_and_si256(mask, vCase));
+		_mm256_storeu_si256((__m256i *)(p + i), v);
+	}
+	elstropsToLowerSSE2(p + i, nLength - i);
+}
+
+/**
+ * AVX2 kernels (translation by 16 byte shuffles isn't faster than portable 
+ * table lookups, so it's portable as well).
+ */
+static const elstrops_kernels g_kernelsAVX2 = {
+	"avx2",
+	elstropsReplaceCharAVX2,
+	elstropsDeleteCharAVX2,
+	elstropsReverseAVX2,
+	elstropsSpanAVX2,
+	elstropsSpanBackAVX2,
+	elstropsToUpperAVX2,
+	elstropsToLowerAVX2,
+	elstropsTranslateScalar
+};
+
+#endif
+
+static const elstrops_kernels *_Atomic g_pKernels = NULL;
+
+/**
+ * Returns the kernels best suited for the CPU. CPU is checked once, at first 
+ * call.
+ * @return Kernels.
+ */
+const elstrops_kernels *elstropsGetKernels() {
+	const elstrops_kernels *pKernels = atomic_load_explicit(&g_pKernels, 
+		memory_order_relaxed);
+	if(pKernels != NULL)
+		return pKernels;
+
+	pKernels = &g_kernelsScalar;
+#if EL_CPU_X86
+	if(elcpuHas(EL_CPU_AVX2))
+		pKernels = &g_kernelsAVX2;
+	else if(elcpuHas(EL_CPU_SSE2))
+		pKernels = &g_kernelsSSE2;
+#endif
+
+	atomic_store_explicit(&g_pKernels, pKernels, memory_order_relaxed);
+
+	return pKernels;
+}
+
+/**
+ * Returns the name of kernels chosen for the CPU ("scalar", "sse2" or 
+ * "avx2").
+ * @return Name of kernels.
+ */
+const char *elstropsGetKernelsName() {
+	return elstropsGetKernels()->szName;
+}
+
+/**
+ * Replaces all occurences of the character in the buffer.
+ * @param p       Buffer.
+ * @param nLength Length of the buffer.
+ * @param chOld   Character to replace.
+ * @param chNew   Replacement character.
+ */
+void elstropsReplaceChar(char *p, size_t nLength, char chOld, char chNew) {
+	elstropsGetKernels()->replaceChar(p, nLength, chOld, chNew);
+}
+
+/**
+ * Removes all occurences of the character from the buffer. Remaining bytes 
+ * are moved to the beginning of the buffer.
+ * @param  p       Buffer.
+ * @param  nLength Length of the buffer.
+ * @param  ch      Character to remove.
+ * @return         New length of the buffer.
+ */
+size_t elstropsDeleteChar(char *p, size_t nLength, char ch) {
+	return elstropsGetKernels()->deleteChar(p, nLength, ch);
+}
+
+/**
+ * Reverses the order of bytes in the buffer.
+ * @param p       Buffer.
+ * @param nLength Length of the buffer.
+ */
+void elstropsReverse(char *p, size_t nLength) {
+	elstropsGetKernels()->reverse(p, nLength);
+}
+
+/**
+ * Counts leading bytes of the buffer which belong to the set.
+ * @param  p           Buffer.
+ * @param  nLength     Length of the buffer.
+ * @param  arrChars    Characters of the set.
+ * @param  nCountChars Number of characters in the set.
+ * @return             Number of leading bytes from the set.
+ */
+size_t elstropsSpan(const char *p, size_t nLength, const char *arrChars, 
+	size_t nCountChars) {
+
+	return elstropsGetKernels()->span(p, nLength, arrChars, nCountChars);
+}
+
+/**
+ * Counts trailing bytes of the buffer which belong to the set.
+ * @param  p           Buffer.
+ * @param  nLength     Length of the buffer.
+ * @param  arrChars    Characters of the set.
+ * @param  nCountChars Number of characters in the set.
+ * @return             Number of trailing bytes from the set.
+ */
+size_t elstropsSpanBack(const char *p, size_t nLength, const char *arrChars, 
+	size_t nCountChars) {
+
+	return elstropsGetKernels()->spanBack(p, nLength, arrChars, nCountChars);
+}
+
+/**
+ * Converts ASCII letters of the buffer to upper case. Other bytes are kept.
+ * @param p       Buffer.
+ * @param nLength Length of the buffer.
+ */
+void elstropsToUpper(char *p, size_t nLength) {
+	elstropsGetKernels()->toUpper(p, nLength);
+}
+
+/**
+ * Converts ASCII letters of the buffer to lower case. Other bytes are kept.
+ * @param p       Buffer.
+ * @param nLength Length of the buffer.
+ */
+void elstropsToLower(char *p, size_t nLength) {
+	elstropsGetKernels()->toLower(p, nLength);
+}
+
+/**
+ * Replaces each byte of the buffer by its entry of the table.
+ * @param p        Buffer.
+ * @param nLength  Length of the buffer.
+ * @param arrTable Table of 256 bytes indexed by unsigned byte value.
+ */
+void elstropsTranslate(char *p, size_t nLength, const unsigned char *arrTable) {
+	elstropsGetKernels()->translate(p, nLength, arrTable);
+}
@@ -0,0 +1,73 @@
+/* Extreme Library (EL). Byte operations for strings. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+
+#ifndef _EL_STROPS_H_
+#define _EL_STROPS_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 
+ * @brief Kernels transforming buffers of bytes in place. The best 
+ * implementation for the CPU is chosen at first use (scalar, SSE2 or AVX2).
+ */
+typedef struct elstrops_kernels {
+	const char *szName; /**< Name of the implementation. */
+	void (*replaceChar)(char *p, size_t nLength, char chOld, char chNew); /**< 
+	Replaces all occurences of the character. */
+	size_t (*deleteChar)(char *p, size_t nLength, char ch); /**< Removes all 
+	occurences of the character, returns new length. */
+	void (*reverse)(char *p, size_t nLength); /**< Reverses the order of 
+	bytes. */
+	size_t (*span)(const char *p, size_t nLength, const char *arrChars, 
+		size_t nCountChars); /**< Counts leading bytes from the set. */
+	size_t (*spanBack)(const char *p, size_t nLength, const char *arrChars, 
+		size_t nCountChars); /**< Counts trailing bytes from the set. */
+	void (*toUpper)(char *p, size_t nLength); /**< Converts ASCII letters to 
+	upper case. */
+	void (*toLower)(char *p, size_t nLength); /**< Converts ASCII letters to 
+	lower case. */
+	void (*translate)(char *p, size_t nLength, const unsigned char *arrTable); 
+	/**< Replaces each byte by its entry of 256-byte table. */
+} elstrops_kernels;
+
+const elstrops_kernels *elstropsGetKernels();
+const char *elstropsGetKernelsName();
+void elstropsReplaceChar(char *p, size_t nLength, char chOld, char chNew);
+size_t elstropsDeleteChar(char *p, size_t nLength, char ch);
+void elstropsReverse(char *p, size_t nLength);
+size_t elstropsSpan(const char *p, size_t nLength, const char *arrChars, 
+	size_t nCountChars);
+size_t elstropsSpanBack(const char *p, size_t nLength, const char *arrChars, 
+	size_t nCountChars);
+void elstropsToUpper(char *p, size_t nLength);
+void elstropsToLower(char *p, size_t nLength);
+void elstropsTranslate(char *p, size_t nLength, const unsigned char *arrTable);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,763 @@
+/* Extreme Library (EL). Thread pool. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "el_memory.h"
+
+#include "el_threadpool.h"
+#include "el_parallel.h"
+
+#define isInvalid(s) ((s) == NULL)
+
+/**
+ * Initial capacity of each deque (in tasks). Must be a power of 2.
+ */
+#define EL_THREADPOOL_DEQUE_CAPACITY	256
+/**
+ * Number of chunks each thread gets on average when parallel for grain size 
+ * is not specified.
+ */
+#define EL_THREADPOOL_CHUNKS_PER_THREAD	8
+/**
+ * Minimal size of the scratch arena block (in bytes).
+ */
+#define EL_THREADPOOL_SCRATCH_BLOCK		65536
+
+/** 
+ * @brief Shared state of one parallel for call.
+ */
+typedef struct elthreadpool_range {
+	taskgroup *pGroup; /**< Group of all range tasks. */
+	size_t nBegin; /**< Start of the whole range. */
+	size_t nEnd; /**< End of the whole range. */
+	size_t nGrain; /**< Size of the chunk. */
+	void (*rangeFunc)(size_t nBegin, size_t nEnd, void *pEx); /**< Function 
+	processing the chunk. */
+	void *pEx; /**< Custom data sent to range function. */
+	struct elthreadpool_range_task *pTasks; /**< Preallocated range tasks. */
+	atomic_size_t nNextTask; /**< Index of the next free range task. */
+} elthreadpool_range;
+
+/** 
+ * @brief Range of chunks processed by one task of parallel for.
+ */
+typedef struct elthreadpool_range_task {
+	elthreadpool_range *pRange; /**< Shared state. */
+	size_t nChunkFirst; /**< First chunk. */
+	size_t nChunkLast; /**< Chunk after the last one. */
+} elthreadpool_range_task;
+
+/** 
+ * @brief Block of thread local scratch arena.
+ */
+typedef struct elthreadpool_scratch_block {
+	struct elthreadpool_scratch_block *pNext; /**< Next block. */
+	size_t nCapacity; /**< Size of data area (in bytes). */
+	size_t nUsed; /**< Number of bytes allocated from data area. */
+	max_align_t data[]; /**< Data area. */
+} elthreadpool_scratch_block;
+
+/** 
+ * @brief Thread local scratch arena.
+ */
+typedef struct elthreadpool_scratch {
+	elthreadpool_scratch_block *pFirst; /**< First block. */
+	elthreadpool_scratch_block *pCur; /**< Block used for allocations. */
+} elthreadpool_scratch;
+
+static _Thread_local threadpool *tl_pPool = NULL;
+static _Thread_local size_t tl_nWorker = 0;
+static _Thread_local uint32_t tl_nRandom = 0;
+static _Thread_local elthreadpool_scratch *tl_pScratch = NULL;
+
+static threadpool *g_pPoolDefault = NULL;
+static pthread_once_t g_onceDefault = PTHREAD_ONCE_INIT;
+static pthread_key_t g_keyScratch;
+static pthread_once_t g_onceScratch = PTHREAD_ONCE_INIT;
+
+/**
+ * Initializes empty deque.
+ * @param  pThis Deque.
+ * @return       True if operation was successful.
+ */
+static bool elthreadpoolDequeInit(elthreadpool_deque *pThis) {
+	pThis->pTasks = EL_ALLOC(sizeof(eltask) * EL_THREADPOOL_DEQUE_CAPACITY);
+	if(pThis->pTasks == NULL)
+		return false;
+
+	if(pthread_mutex_init(&pThis->mutex, NULL) != 0) {
+		EL_FREE(pThis->pTasks);
+		return false;
+	}
+
+	pThis->nCapacity = EL_THREADPOOL_DEQUE_CAPACITY;
+	pThis->nTop = 0;
+	pThis->nBottom = 0;
+
+	return true;
+}
+
+/**
+ * Frees the memory used by the deque. Tasks left in the deque are dropped.
+ * @param pThis Deque.
+ */
+static void elthreadpoolDequeFree(elthreadpool_deque *pThis) {
+	pthread_mutex_destroy(&pThis->mutex);
+	EL_FREE(pThis->pTasks);
+}
+
+/**
+ * Pushes the task to the bottom of the deque. Grows the deque if necessary.
+ * @param  pThis Deque.
+ * @param  pTask Task to push.
+ * @return       True if operation was successful.
+ */
+static bool elthreadpoolDequePush(elthreadpool_deque *pThis, eltask *pTask) {
+	pthread_mutex_lock(&pThis->mutex);
+
+	if(pThis->nBottom - pThis->nTop == pThis->nCapacity) {
+		eltask *pTasksNew = EL_ALLOC(sizeof(eltask) * pThis->nCapacity * 2);
+		if(pTasksNew == NULL) {
+			pthread_mutex_unlock(&pThis->mutex);
+			return false;
+		}
+		for(size_t i = pThis->nTop; i < pThis->nBottom; i++)
+			pTasksNew[i & (pThis->nCapacity * 2 - 1)] = 
+				pThis->pTasks[i & (pThis->nCapacity - 1)];
+		EL_FREE(pThis->pTasks);
+		pThis->pTasks = pTasksNew;
+		pThis->nCapacity *= 2;
+	}
+
+	pThis->pTasks[pThis->nBottom & (pThis->nCapacity - 1)] = *pTask;
+	pThis->nBottom++;
+
+	pthread_mutex_unlock(&pThis->mutex);
+
+	return true;
+}
+
+/**
+ * Pops the newest task from the bottom of the deque (used by the owner).
+ * @param  pThis Deque.
+ * @param  pTask The task is returned here.
+ * @return       True if the task was popped, false if the deque is empty.
+ */
+static bool elthreadpoolDequePop(elthreadpool_deque *pThis, eltask *pTask) {
+	bool bResult = false;
+
+	pthread_mutex_lock(&pThis->mutex);
+	if(pThis->nBottom != pThis->nTop) {
+		pThis->nBottom--;
+		*pTask = pThis->pTasks[pThis->nBottom & (pThis->nCapacity - 1)];
+		bResult = true;
+	}
+	pthread_mutex_unlock(&pThis->mutex);
+
+	return bResult;
+}
+
+/**
+ * Steals the oldest task from the top of the deque (used by other threads).
+ * @param  pThis Deque.
+ * @param  pTask The task is returned here.
+ * @return       True if the task was stolen, false if the deque is empty or 
+ * is busy.
+ */
+static bool elthreadpoolDequeSteal(elthreadpool_deque *pThis, eltask *pTask) {
+	bool bResult = false;
+
+	if(pthread_mutex_trylock(&pThis->mutex) != 0)
+		return false;
+	if(pThis->nBottom != pThis->nTop) {
+		*pTask = pThis->pTasks[pThis->nTop & (pThis->nCapacity - 1)];
+		pThis->nTop++;
+		bResult = true;
+	}
+	pthread_mutex_unlock(&pThis->mutex);
+
+	return bResult;
+}
+
+/**
+ * Finds a task to execute: first in own deque (if called by a worker of this 
+ * pool), then steals from the shared deque and deques of other workers.
+ * @param  pThis Thread pool.
+ * @param  pTask The task is returned here.
+ * @return       True if the task was found.
+ */
+static bool elthreadpoolFindTask(threadpool *pThis, eltask *pTask) {
+	if(atomic_load_explicit(&pThis->nQueued, memory_order_acquire) == 0)
+		return false;
+
+	size_t nDeques = pThis->nThreads + 1;
+	bool bWorker = tl_pPool == pThis;
+
+	if(bWorker && elthreadpoolDequePop(&pThis->pDeques[tl_nWorker], pTask))
+		goto found;
+
+	if(tl_nRandom == 0)
+		tl_nRandom = (uint32_t)(uintptr_t)&tl_nRandom | 1;
+	// xorshift32 to choose the victim
+	tl_nRandom ^= tl_nRandom << 13;
+	tl_nRandom ^= tl_nRandom >> 17;
+	tl_nRandom ^= tl_nRandom << 5;
+
+	size_t nStart = tl_nRandom % nDeques;
+	for(size_t i = 0; i < nDeques; i++) {
+		size_t nVictim = (nStart + i) % nDeques;
+		if(bWorker && nVictim == tl_nWorker)
+			continue;
+		if(elthreadpoolDequeSteal(&pThis->pDeques[nVictim], pTask))
+			goto found;
+	}
+
+	return false;
+
+found:
+	atomic_fetch_sub_explicit(&pThis->nQueued, 1, memory_order_relaxed);
+	return true;
+}
+
+/**
+ * Executes the task and marks it completed in its group.
+ * @param pTask Task to execute.
+ */
+static void elthreadpoolExecute(eltask *pTask) {
+	pTask->taskFunc(pTask->pArg);
+
+	if(pTask->pGroup == NULL)
+		return;
+
+	// group may be destroyed by its waiter as soon as it's completed
+	threadpool *pPool = pTask->pGroup->pPool;
+	if(atomic_fetch_sub(&pTask->pGroup->nPending, 1) == 1 && 
+		atomic_load(&pPool->nSleeping) > 0) {
+
+		pthread_mutex_lock(&pPool->mutexSleep);
+		pthread_cond_broadcast(&pPool->condWork);
+		pthread_mutex_unlock(&pPool->mutexSleep);
+	}
+}
+
+/**
+ * Pushes the task to the proper deque and wakes up sleeping worker.
+ * @param  pThis Thread pool.
+ * @param  pTask Task to push.
+ * @return       True if operation was successful.
+ */
+static bool elthreadpoolPush(threadpool *pThis, eltask *pTask) {
+	size_t nDeque = tl_pPool == pThis ? tl_nWorker : pThis->nThreads;
+
+	if(!elthreadpoolDequePush(&pThis->pDeques[nDeque], pTask))
+		return false;
+
+	atomic_fetch_add(&pThis->nQueued, 1);
+	if(atomic_load(&pThis->nSleeping) > 0) {
+		pthread_mutex_lock(&pThis->mutexSleep);
+		pthread_cond_signal(&pThis->condWork);
+		pthread_mutex_unlock(&pThis->mutexSleep);
+	}
+
+	return true;
+}
+
+/** 
+ * @brief Start parameters of the worker thread.
+ */
+typedef struct elthreadpool_start {
+	threadpool *pPool; /**< Thread pool. */
+	size_t nWorker; /**< Index of the worker. */
+} elthreadpool_start;
+
+/**
+ * Main function of the worker thread. Executes tasks until the pool is 
+ * destroyed, sleeps when there are no tasks.
+ * @param  p Start parameters (freed here).
+ * @return   Always NULL.
+ */
+static void *elthreadpoolWorker(void *p) {
+	elthreadpool_start *pStart = p;
+	threadpool *pThis = pStart->pPool;
+
+	tl_pPool = pThis;
+	tl_nWorker = pStart->nWorker;
+	EL_FREE(pStart);
+
+	eltask task;
+	while(!atomic_load_explicit(&pThis->bStop, memory_order_relaxed)) {
+		if(elthreadpoolFindTask(pThis, &task)) {
+			elthreadpoolExecute(&task);
+			continue;
+		}
+
+		pthread_mutex_lock(&pThis->mutexSleep);
+		atomic_fetch_add(&pThis->nSleeping, 1);
+		while(atomic_load(&pThis->nQueued) == 0 && 
+			!atomic_load(&pThis->bStop))
+			pthread_cond_wait(&pThis->condWork, &pThis->mutexSleep);
+		atomic_fetch_sub(&pThis->nSleeping, 1);
+		pthread_mutex_unlock(&pThis->mutexSleep);
+	}
+
+	return NULL;
+}
+
+/**
+ * Creates new thread pool.
+ * @param  nThreads Number of worker threads. If 0 - number of processors 
+ * minus one is used (but at least one worker is created) because a thread 
+ * waiting for tasks also executes them.
+ * @return          Newly created thread pool (or NULL if an error occured).
+ */
+threadpool *elthreadpoolCreate(size_t nThreads) {
+	if(nThreads == 0) {
+		nThreads = elparallelGetDefaultThreadCount() - 1;
+		if(nThreads == 0)
+			nThreads = 1;
+	}
+
+	threadpool *pThis = EL_CALLOC(1, sizeof(threadpool));
+	if(pThis == NULL)
+		return NULL;
+
+	pThis->pDeques = EL_CALLOC(nThreads + 1, sizeof(elthreadpool_deque));
+	pThis->pThreads = EL_CALLOC(nThreads, sizeof(pthread_t));
+	if(pThis->pDeques == NULL || pThis->pThreads == NULL) {
+		EL_FREE(pThis->pDeques);
+		EL_FREE(pThis->pThreads);
+		EL_FREE(pThis);
+		return NULL;
+	}
+
+	atomic_init(&pThis->nQueued, 0);
+	atomic_init(&pThis->nSleeping, 0);
+	atomic_init(&pThis->bStop, false);
+	pthread_mutex_init(&pThis->mutexSleep, NULL);
+	pthread_cond_init(&pThis->condWork, NULL);
+
+	size_t nDeques = 0;
+	for(; nDeques < nThreads + 1; nDeques++)
+		if(!elthreadpoolDequeInit(&pThis->pDeques[nDeques]))
+			break;
+
+	if(nDeques == nThreads + 1)
+		for(; pThis->nThreads < nThreads; pThis->nThreads++) {
+			elthreadpool_start *pStart = EL_ALLOC(sizeof(elthreadpool_start));
+			if(pStart == NULL)
+				break;
+			pStart->pPool = pThis;
+			pStart->nWorker = pThis->nThreads;
+			if(pthread_create(&pThis->pThreads[pThis->nThreads], NULL, 
+				elthreadpoolWorker, pStart) != 0) {
+
+				EL_FREE(pStart);
+				break;
+			}
+		}
+
+	if(pThis->nThreads < nThreads) {
+		// Deque count must match worker count, so stop everything started
+		size_t nStarted = pThis->nThreads;
+		pThis->nThreads = nThreads;
+		atomic_store(&pThis->bStop, true);
+		pthread_mutex_lock(&pThis->mutexSleep);
+		pthread_cond_broadcast(&pThis->condWork);
+		pthread_mutex_unlock(&pThis->mutexSleep);
+		for(size_t i = 0; i < nStarted; i++)
+			pthread_join(pThis->pThreads[i], NULL);
+		for(size_t i = 0; i < nDeques; i++)
+			elthreadpoolDequeFree(&pThis->pDeques[i]);
+		pthread_cond_destroy(&pThis->condWork);
+		pthread_mutex_destroy(&pThis->mutexSleep);
+		EL_FREE(pThis->pDeques);
+		EL_FREE(pThis->pThreads);
+		EL_FREE(pThis);
+		return NULL;
+	}
+
+	return pThis;
+}
+
+/**
+ * Destroys the thread pool. Waits for workers to complete tasks being executed,
+ * tasks not yet started are dropped. So all task groups should be waited for
+ * before the pool is destroyed.
+ * @param pThis Thread pool to be destroyed.
+ */
+void elthreadpoolDestroy(threadpool *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	atomic_store(&pThis->bStop, true);
+	pthread_mutex_lock(&pThis->mutexSleep);
+	pthread_cond_broadcast(&pThis->condWork);
+	pthread_mutex_unlock(&pThis->mutexSleep);
+
+	for(size_t i = 0; i < pThis->nThreads; i++)
+		pthread_join(pThis->pThreads[i], NULL);
+
+	for(size_t i = 0; i < pThis->nThreads + 1; i++)
+		elthreadpoolDequeFree(&pThis->pDeques[i]);
+
+	pthread_cond_destroy(&pThis->condWork);
+	pthread_mutex_destroy(&pThis->mutexSleep);
+
+	EL_FREE(pThis->pDeques);
+	EL_FREE(pThis->pThreads);
+	EL_FREE(pThis);
+}
+
+/**
+ * Creates the default thread pool. Called once.
+ */
+static void elthreadpoolDefaultCreate() {
+	g_pPoolDefault = elthreadpoolCreate(0);
+}
+
+/**
+ * Returns the default thread pool shared by all parallel routines of the 
+ * library. It's created on first use and lives until the process ends, so it 
+ * must not be destroyed.
+ * @return Default thread pool (or NULL if it can't be created).
+ */
+threadpool *elthreadpoolGetDefault() {
+	pthread_once(&g_onceDefault, elthreadpoolDefaultCreate);
+
+	return g_pPoolDefault;
+}
+
+/**
+ * Returns the number of worker threads of the pool.
+ * @param  pThis Thread pool.
+ * @return       Number of worker threads.
+ */
+size_t elthreadpoolGetThreadCount(threadpool *pThis) {
+	if(isInvalid(pThis))
+		return 0;
+
+	return pThis->nThreads;
+}
+
+/**
+ * Submits the task which is not waited for. Caller is responsible for knowing 
+ * when the task is completed (use task groups for this).
+ * @param  pThis    Thread pool.
+ * @param  taskFunc Function to be executed.
+ * @param  pArg     Argument passed to the function.
+ * @return          True if operation was successful.
+ */
+bool elthreadpoolSubmit(threadpool *pThis, void (*taskFunc)(void *pArg), 
+	void *pArg) {
+
+	if(isInvalid(pThis) || taskFunc == NULL)
+		return false;
+
+	eltask task = { taskFunc, pArg, NULL };
+
+	return elthreadpoolPush(pThis, &task);
+}
+
+/**
+ * Initializes task group placed in memory provided by caller.
+ * @param pThis Task group.
+ * @param pPool Thread pool.
+ */
+static void eltaskgroupInit(taskgroup *pThis, threadpool *pPool) {
+	pThis->pPool = pPool;
+	atomic_init(&pThis->nPending, 0);
+}
+
+/**
+ * Creates new task group.
+ * @param  pPool Thread pool which will execute tasks of the group.
+ * @return       Newly created task group (or NULL if an error occured).
+ */
+taskgroup *eltaskgroupCreate(threadpool *pPool) {
+	if(isInvalid(pPool))
+		return NULL;
+
+	taskgroup *pThis = EL_ALLOC(sizeof(taskgroup));
+	if(pThis == NULL)
+		return NULL;
+
+	eltaskgroupInit(pThis, pPool);
+
+	return pThis;
+}
+
+/**
+ * Destroys the task group. Group should be waited for before destroying.
+ * @param pThis Task group to be destroyed.
+ */
+void eltaskgroupDestroy(taskgroup *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	EL_FREE(pThis);
+}
+
+/**
+ * Submits the task as a part of the task group.
+ * @param  pThis    Task group.
+ * @param  taskFunc Function to be executed.
+ * @param  pArg     Argument passed to the function.
+ * @return          True if operation was successful.
+ */
+bool eltaskgroupRun(taskgroup *pThis, void (*taskFunc)(void *pArg), 
+	void *pArg) {
+
+	if(isInvalid(pThis) || taskFunc == NULL)
+		return false;
+
+	eltask task = { taskFunc, pArg, pThis };
+
+	atomic_fetch_add_explicit(&pThis->nPending, 1, memory_order_relaxed);
+	if(!elthreadpoolPush(pThis->pPool, &task)) {
+		atomic_fetch_sub_explicit(&pThis->nPending, 1, memory_order_relaxed);
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Waits until all tasks of the group are completed. Waiting thread executes 
+ * tasks of the pool meanwhile, so it's safe to wait inside of a task. When 
+ * there is nothing to execute, it sleeps until a task is submitted or the 
+ * last task of the group is completed.
+ * @param pThis Task group.
+ */
+void eltaskgroupWait(taskgroup *pThis) {
+	if(isInvalid(pThis))
+		return;
+
+	threadpool *pPool = pThis->pPool;
+	eltask task;
+	while(atomic_load(&pThis->nPending) > 0) {
+		if(elthreadpoolFindTask(pPool, &task)) {
+			elthreadpoolExecute(&task);
+			continue;
+		}
+
+		pthread_mutex_lock(&pPool->mutexSleep);
+		atomic_fetch_add(&pPool->nSleeping, 1);
+		while(atomic_load(&pPool->nQueued) == 0 && 
+			atomic_load(&pThis->nPending) > 0)
+			pthread_cond_wait(&pPool->condWork, &pPool->mutexSleep);
+		atomic_fetch_sub(&pPool->nSleeping, 1);
+		pthread_mutex_unlock(&pPool->mutexSleep);
+	}
+}
+
+/**
+ * Processes chunks of parallel for. Splits its range of chunks in halves 
+ * submitting right halves as new tasks until the single chunk is left.
+ * @param p Range task.
+ */
+static void elthreadpoolRangeTask(void *p) {
+	elthreadpool_range_task *pTask = p;
+	elthreadpool_range *pRange = pTask->pRange;
+	size_t nFirst = pTask->nChunkFirst;
+	size_t nLast = pTask->nChunkLast;
+
+	while(nLast - nFirst > 1) {
+		size_t nMiddle = nFirst + (nLast - nFirst) / 2;
+
+		elthreadpool_range_task *pTaskNew = &pRange->pTasks[
+			atomic_fetch_add_explicit(&pRange->nNextTask, 1, 
+				memory_order_relaxed)];
+		pTaskNew->pRange = pRange;
+		pTaskNew->nChunkFirst = nMiddle;
+		pTaskNew->nChunkLast = nLast;
+		if(!eltaskgroupRun(pRange->pGroup, elthreadpoolRangeTask, pTaskNew))
+			elthreadpoolRangeTask(pTaskNew);
+
+		nLast = nMiddle;
+	}
+
+	size_t nBegin = pRange->nBegin + nFirst * pRange->nGrain;
+	size_t nEnd = nBegin + pRange->nGrain;
+	if(nEnd > pRange->nEnd || nEnd < nBegin)
+		nEnd = pRange->nEnd;
+
+	pRange->rangeFunc(nBegin, nEnd, pRange->pEx);
+}
+
+/**
+ * Calls the range function for chunks of [nBegin, nEnd) index range in 
+ * parallel and waits until all chunks are processed. Each chunk contains 
+ * @e nGrain indexes (the last one may contain less).
+ * @param pThis     Thread pool. If NULL - the default pool is used.
+ * @param nBegin    First index of the range.
+ * @param nEnd      Index after the last one.
+ * @param nGrain    Chunk size. If 0 - it's chosen automatically.
+ * @param rangeFunc Function to be called for each chunk. Must be thread safe.
+ * @param pEx       Pointer to custom data to be sent to range function.
+ */
+void elthreadpoolParallelFor(threadpool *pThis, size_t nBegin, size_t nEnd, 
+	size_t nGrain, 
+	void (*rangeFunc)(size_t nBegin, size_t nEnd, void *pEx), void *pEx) {
+
+	if(rangeFunc == NULL || nEnd <= nBegin)
+		return;
+
+	if(pThis == NULL)
+		pThis = elthreadpoolGetDefault();
+
+	size_t nCount = nEnd - nBegin;
+	if(nGrain == 0 && pThis != NULL) {
+		nGrain = nCount / ((pThis->nThreads + 1) * 
+			EL_THREADPOOL_CHUNKS_PER_THREAD);
+		if(nGrain == 0)
+			nGrain = 1;
+	}
+
+	size_t nChunks = nGrain == 0 ? 1 : nCount / nGrain + 
+		(nCount % nGrain != 0);
+
+	elthreadpool_range_task *pTasks = NULL;
+	if(pThis != NULL && nChunks > 1)
+		pTasks = EL_ALLOC(sizeof(elthreadpool_range_task) * nChunks);
+
+	if(pTasks == NULL) {
+		// No pool or no memory - process the whole range here
+		rangeFunc(nBegin, nEnd, pEx);
+		return;
+	}
+
+	taskgroup group;
+	eltaskgroupInit(&group, pThis);
+
+	elthreadpool_range range;
+	range.pGroup = &group;
+	range.nBegin = nBegin;
+	range.nEnd = nEnd;
+	range.nGrain = nGrain;
+	range.rangeFunc = rangeFunc;
+	range.pEx = pEx;
+	range.pTasks = pTasks;
+	atomic_init(&range.nNextTask, 1);
+
+	pTasks[0].pRange = &range;
+	pTasks[0].nChunkFirst = 0;
+	pTasks[0].nChunkLast = nChunks;
+	elthreadpoolRangeTask(&pTasks[0]);
+
+	eltaskgroupWait(&group);
+
+	EL_FREE(pTasks);
+}
+
+/**
+ * Frees all blocks of the scratch arena. Called when the thread exits.
+ * @param p Scratch arena.
+ */
+static void elthreadpoolScratchFree(void *p) {
+	elthreadpool_scratch *pScratch = p;
+
+	elthreadpool_scratch_block *pBlock = pScratch->pFirst;
+	while(pBlock != NULL) {
+		elthreadpool_scratch_block *pNext = pBlock->pNext;
+		EL_FREE(pBlock);
+		pBlock = pNext;
+	}
+
+	EL_FREE(pScratch);
+}
+
+/**
+ * Creates the key used to free scratch arenas of exiting threads. Called once.
+ */
+static void elthreadpoolScratchKeyCreate() {
+	pthread_key_create(&g_keyScratch, elthreadpoolScratchFree);
+}
+
+/**
+ * Allocates memory from the scratch arena of the calling thread. Allocation is
+ * just a pointer increment in most cases. Memory can't be freed separately, 
+ * instead all allocations of the thread are released by 
+ * elthreadpoolScratchReset(). Arena memory is freed when the thread exits.
+ * @param  nSize Number of bytes to allocate.
+ * @return       Pointer to the allocated memory (aligned as for any type) or 
+ * NULL if an error occured.
+ */
+void *elthreadpoolScratchAlloc(size_t nSize) {
+	if(tl_pScratch == NULL) {
+		pthread_once(&g_onceScratch, elthreadpoolScratchKeyCreate);
+
+		tl_pScratch = EL_CALLOC(1, sizeof(elthreadpool_scratch));
+		if(tl_pScratch == NULL)
+			return NULL;
+		pthread_setspecific(g_keyScratch, tl_pScratch);
+	}
+
+	nSize = (nSize + sizeof(max_align_t) - 1) & ~(sizeof(max_align_t) - 1);
+
+	elthreadpool_scratch_block *pBlock = tl_pScratch->pCur;
+	while(pBlock != NULL && pBlock->nCapacity - pBlock->nUsed < nSize) {
+		pBlock = pBlock->pNext;
+		if(pBlock != NULL)
+			pBlock->nUsed = 0;
+	}
+
+	if(pBlock == NULL) {
+		size_t nCapacity = EL_THREADPOOL_SCRATCH_BLOCK;
+		if(tl_pScratch->pCur != NULL && 
+			tl_pScratch->pCur->nCapacity * 2 > nCapacity)
+			nCapacity = tl_pScratch->pCur->nCapacity * 2;
+		if(nCapacity < nSize)
+			nCapacity = nSize;
+
+		pBlock = EL_ALLOC(sizeof(elthreadpool_scratch_block) + nCapacity);
+		if(pBlock == NULL)
+			return NULL;
+		pBlock->nCapacity = nCapacity;
+		pBlock->nUsed = 0;
+
+		// Insert after the current block so later blocks are kept for reuse
+		if(tl_pScratch->pCur != NULL) {
+			pBlock->pNext = tl_pScratch->pCur->pNext;
+			tl_pScratch->pCur->pNext = pBlock;
+		} else {
+			pBlock->pNext = NULL;
+			tl_pScratch->pFirst = pBlock;
+		}
+	}
+
+	tl_pScratch->pCur = pBlock;
+
+	void *p = (char *)pBlock->data + pBlock->nUsed;
+	pBlock->nUsed += nSize;
+
+	return p;
+}
+
+/**
+ * Releases all memory allocated from the scratch arena of the calling thread
+ * by elthreadpoolScratchAlloc(). Memory is kept for further allocations.
+ */
+void elthreadpoolScratchReset() {
+	if(tl_pScratch == NULL || tl_pScratch->pFirst == NULL)
+		return;
+
+	tl_pScratch->pCur = tl_pScratch->pFirst;
+	tl_pScratch->pCur->nUsed = 0;
+}
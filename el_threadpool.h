@@ -0,0 +1,117 @@
+/* Extreme Library (EL). Thread pool. 
+ * Copyright (c) 2014 Sergei Hrushev [hrushev DOG gmail DOT com]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef _EL_THREADPOOL_H_
+#define _EL_THREADPOOL_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct taskgroup;
+
+/** 
+ * @brief Holds a single task of the thread pool.
+ */
+typedef struct eltask {
+	void (*taskFunc)(void *pArg); /**< Function to be executed. */
+	void *pArg; /**< Argument passed to the function. */
+	struct taskgroup *pGroup; /**< Task group the task belongs to (may be 
+	NULL). */
+} eltask;
+
+/** 
+ * @brief Double ended queue of tasks. Owning worker pushes and pops tasks at 
+ * the bottom, other workers steal tasks from the top.
+ */
+typedef struct elthreadpool_deque {
+	pthread_mutex_t mutex; /**< Protects the deque. */
+	eltask *pTasks; /**< Ring buffer of tasks. */
+	size_t nCapacity; /**< Capacity of ring buffer (power of 2). */
+	size_t nTop; /**< Index of the oldest task. */
+	size_t nBottom; /**< Index after the newest task. */
+} elthreadpool_deque;
+
+/** 
+ * @brief Work stealing thread pool.
+ *
+ * Each worker has its own deque of tasks. Tasks submitted by a worker go to 
+ * its own deque, tasks submitted by other threads go to the shared deque. 
+ * Idle workers steal the oldest tasks from other deques. Threads waiting for 
+ * a task group also execute tasks, so task groups may be safely nested.
+ */
+typedef struct threadpool {
+	size_t nThreads; /**< Number of worker threads. */
+	pthread_t *pThreads; /**< Worker threads. */
+	elthreadpool_deque *pDeques; /**< Deques: one per worker and the last one 
+	is shared. */
+	pthread_mutex_t mutexSleep; /**< Protects sleeping of idle workers. */
+	pthread_cond_t condWork; /**< Signalled when new task is submitted or 
+	the last task of a group is completed. */
+	atomic_size_t nQueued; /**< Number of tasks in all deques. */
+	atomic_size_t nSleeping; /**< Number of sleeping workers and threads 
+	waiting for task groups. */
+	atomic_bool bStop; /**< Set when the pool is being destroyed. */
+} threadpool;
+
+/** 
+ * @brief Group of tasks which can be waited for.
+ */
+typedef struct taskgroup {
+	threadpool *pPool; /**< Thread pool executing tasks of the group. */
+	atomic_size_t nPending; /**< Number of tasks not yet completed. */
+} taskgroup;
+
+/** 
+ * @brief Pointer to task function.
+ */
+#define EL_CB_TASK(s) (void (*)(void *))(s)
+/** 
+ * @brief Pointer to range function called by parallel for.
+ */
+#define EL_CB_RANGE(s) (void (*)(size_t, size_t, void *))(s)
+
+threadpool *elthreadpoolCreate(size_t nThreads);
+void elthreadpoolDestroy(threadpool *pThis);
+threadpool *elthreadpoolGetDefault();
+size_t elthreadpoolGetThreadCount(threadpool *pThis);
+bool elthreadpoolSubmit(threadpool *pThis, void (*taskFunc)(void *pArg), 
+	void *pArg);
+void elthreadpoolParallelFor(threadpool *pThis, size_t nBegin, size_t nEnd, 
+	size_t nGrain, 
+	void (*rangeFunc)(size_t nBegin, size_t nEnd, void *pEx), void *pEx);
+
+taskgroup *eltaskgroupCreate(threadpool *pPool);
+void eltaskgroupDestroy(taskgroup *pThis);
+bool eltaskgroupRun(taskgroup *pThis, void (*taskFunc)(void *pArg), 
+	void *pArg);
+void eltaskgroupWait(taskgroup *pThis);
+
+void *elthreadpoolScratchAlloc(size_t nSize);
+void elthreadpoolScratchReset();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif